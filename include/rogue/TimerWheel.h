@@ -0,0 +1,154 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Hierarchical timer wheel for Rogue
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_TIMER_WHEEL_H__
+#define __ROGUE_TIMER_WHEEL_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <vector>
+
+namespace rogue {
+
+/**
+ * @brief Hierarchical timer wheel on the monotonic clock.
+ *
+ * @details
+ * Tracks many one-shot deadlines with O(1) arm and cancel. Time is kept in
+ * ticks of a fixed resolution since construction, using
+ * `std::chrono::steady_clock` (`CLOCK_MONOTONIC` on Linux), so wall-clock
+ * adjustments do not affect expiry.
+ *
+ * The wheel has four levels of 64 slots. Deadlines within 64 ticks live in
+ * level 0; longer deadlines live in coarser levels and cascade down as time
+ * advances. Deadlines beyond the range of the top level are clamped to it.
+ *
+ * Timers are intrusive: the caller owns each `Timer` and passes its address.
+ * A timer must be cancelled or expired before it is destroyed. The wheel is
+ * not thread safe; callers serialize access with their own lock.
+ *
+ * Typical loop: `arm()` deadlines as work is issued, sleep until
+ * `nextDeadline()`, then call `advance()` to collect the timers that fired.
+ */
+class TimerWheel {
+  public:
+    //! Clock used for all deadlines
+    typedef std::chrono::steady_clock Clock;
+
+    /** @brief Intrusive timer entry owned by the caller. */
+    class Timer {
+        friend class TimerWheel;
+
+        Timer* next_;
+        Timer* prev_;
+        uint64_t expire_;
+        uint8_t level_;
+        uint8_t slot_;
+        bool armed_;
+
+      public:
+        /** @brief Constructs an idle timer. */
+        Timer();
+
+        /**
+         * @brief Returns whether the timer is armed.
+         * @return True while the timer is waiting to expire.
+         */
+        bool armed() const;
+    };
+
+    /**
+     * @brief Constructs a timer wheel.
+     * @param tick Tick resolution. Deadlines are rounded up to a whole tick.
+     */
+    explicit TimerWheel(std::chrono::microseconds tick);
+
+    /**
+     * @brief Arms or re-arms a timer.
+     *
+     * @details
+     * A timer that is already armed is moved to the new deadline. A deadline
+     * in the past expires on the next `advance()`.
+     *
+     * @param timer Timer to arm.
+     * @param deadline Absolute monotonic deadline.
+     */
+    void arm(Timer* timer, Clock::time_point deadline);
+
+    /**
+     * @brief Cancels a timer. Has no effect if the timer is not armed.
+     * @param timer Timer to cancel.
+     */
+    void cancel(Timer* timer);
+
+    /**
+     * @brief Advances the wheel and collects expired timers.
+     *
+     * @details
+     * Expired timers are disarmed and appended to `expired` in deadline order
+     * at tick resolution.
+     *
+     * @param now Current monotonic time.
+     * @param expired Output list of expired timers.
+     */
+    void advance(Clock::time_point now, std::vector<Timer*>& expired);
+
+    /**
+     * @brief Returns the earliest armed deadline.
+     * @return Deadline rounded up to the tick, or `Clock::time_point::max()`
+     *         when no timer is armed.
+     */
+    Clock::time_point nextDeadline();
+
+    /**
+     * @brief Returns the number of armed timers.
+     * @return Armed timer count.
+     */
+    uint32_t count();
+
+  private:
+    static const uint32_t Levels = 4;
+    static const uint32_t Bits   = 6;
+    static const uint32_t Slots  = 1 << Bits;
+    static const uint32_t Mask   = Slots - 1;
+
+    // Slot list heads, doubly linked through Timer::next_/prev_
+    Timer* slots_[Levels][Slots];
+    uint32_t levelCount_[Levels];
+    uint32_t count_;
+
+    Clock::time_point epoch_;
+    std::chrono::microseconds tick_;
+    uint64_t now_;
+
+    // Place an armed timer in the slot for its expire tick
+    void insert(Timer* timer);
+
+    // Unlink a timer from its slot
+    void unlink(Timer* timer);
+
+    // Re-insert every timer in a higher level slot
+    void cascade(uint32_t level, uint32_t slot);
+
+    // Level for an expire tick relative to now_
+    uint32_t levelFor(uint64_t expire);
+};
+
+}  // namespace rogue
+
+#endif
@@ -69,6 +69,7 @@ inline T py_object_convert(const boost::python::object& obj) {
 
 // Forward declaration
 class Variable;
+class BlockGroup;
 
 /**
  * @brief Memory interface block device.
@@ -188,6 +189,63 @@ class Block : public Master {
     // Get data to pointer from internal block or staged memory
     void getBytes(uint8_t* data, rogue::interfaces::memory::Variable* var, uint32_t index);
 
+    // Copy one value into staged memory using the variable access plan, mtx_ held
+    void copyIn(const uint8_t* data, rogue::interfaces::memory::Variable* var, uint32_t index);
+
+    // Copy one value out of staged memory using the variable access plan, mtx_ held
+    void copyOut(uint8_t* data, rogue::interfaces::memory::Variable* var, uint32_t index);
+
+    // Mark list values first through last stale, index 0 for standard variables, mtx_ held
+    void markStale(rogue::interfaces::memory::Variable* var, uint32_t first, uint32_t last);
+
+    //////////////////////////////////////////
+    // List set/get helpers
+    //////////////////////////////////////////
+
+    // Set count list values of up to 64 bits from raw words, under one lock with one stale update
+    void setWords(const uint64_t* words, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    // Get count list values of up to 64 bits into raw words under one lock
+    void getWords(uint64_t* words, rogue::interfaces::memory::Variable* var, uint32_t index, uint32_t count);
+
+    //////////////////////////////////////////
+    // Value encoders, range checked, shared by the scalar and list setters
+    //////////////////////////////////////////
+
+    uint64_t encodeUInt(const uint64_t& value, rogue::interfaces::memory::Variable* var);
+    uint64_t encodeInt(const int64_t& value, rogue::interfaces::memory::Variable* var);
+    uint64_t encodeFloat(const float& value, rogue::interfaces::memory::Variable* var);
+    uint64_t encodeDouble(const double& value, rogue::interfaces::memory::Variable* var);
+    uint64_t encodeFixed(const double& value, rogue::interfaces::memory::Variable* var);
+    uint64_t encodeUFixed(const double& value, rogue::interfaces::memory::Variable* var);
+
+    //////////////////////////////////////////
+    // Low precision float array converters, bit exact with the scalar setters and getters
+    //////////////////////////////////////////
+
+    // Range check values for the list setters, func names the setter in the error
+    void checkFloatRange(const float* src, uint32_t count, rogue::interfaces::memory::Variable* var, const char* func);
+
+    // Float16 uses F16C where the CPU supports it
+    static void encodeFloat16Array(uint64_t* words, const float* src, uint32_t count);
+    static void decodeFloat16Array(float* dst, const uint64_t* words, uint32_t count);
+
+    static void encodeBFloat16Array(uint64_t* words, const float* src, uint32_t count);
+    static void decodeBFloat16Array(float* dst, const uint64_t* words, uint32_t count);
+
+    static void encodeTensorFloat32Array(uint64_t* words, const float* src, uint32_t count);
+    static void decodeTensorFloat32Array(float* dst, const uint64_t* words, uint32_t count);
+
+    // Float8, Float6 and Float4 are table driven
+    static void encodeFloat8Array(uint64_t* words, const float* src, uint32_t count);
+    static void decodeFloat8Array(float* dst, const uint64_t* words, uint32_t count);
+
+    static void encodeFloat6Array(uint64_t* words, const float* src, uint32_t count);
+    static void decodeFloat6Array(float* dst, const uint64_t* words, uint32_t count);
+
+    static void encodeFloat4Array(uint64_t* words, const float* src, uint32_t count);
+    static void decodeFloat4Array(float* dst, const uint64_t* words, uint32_t count);
+
     // Custom init function called after addVariables
     virtual void customInit();
 
@@ -307,6 +365,8 @@ class Block : public Master {
     bool blockPyTrans();
 
   private:
+    friend class BlockGroup;
+
     /**
      * @brief Starts an internal C++ transaction for this block.
      *
@@ -314,11 +374,14 @@ class Block : public Master {
      * @param forceWr Forces write even when block is not stale.
      * @param var Variable associated with the transaction.
      * @param index Variable index for list variables, or `-1` for full variable.
+     * @param notify Optional completion notification, see `Master::reqTransactionNotify()`.
+     * @return True if a transaction was issued.
      */
-    void intStartTransaction(uint32_t type,
+    bool intStartTransaction(uint32_t type,
                              bool forceWr,
                              rogue::interfaces::memory::Variable* var,
-                             int32_t index);
+                             int32_t index,
+                             rogue::interfaces::memory::TransactionCallback notify = nullptr);
 
   public:
     /**
@@ -0,0 +1,210 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Runs one transaction type across a group of blocks with a bounded number of
+ * transactions in flight.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_MEMORY_BLOCK_GROUP_H__
+#define __ROGUE_INTERFACES_MEMORY_BLOCK_GROUP_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Block.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace memory {
+
+/**
+ * @brief Bulk transaction engine for a group of blocks.
+ *
+ * @details
+ * Starting a transaction on each block and then checking each block in turn
+ * leaves nothing to bound the number of outstanding requests. Blocks with
+ * retries enabled also wait for every transaction before starting the next.
+ * `BlockGroup` starts the transactions of all its blocks, keeping at most
+ * `window` of them outstanding. It checks each block as soon as its
+ * transaction completes, in any order, and starts the next block in the
+ * freed slot. A failed transaction is started again, as a forced write for
+ * writes, until the retry count of its block is used up. Errors from all
+ * blocks are collected and raised together once every block is done.
+ *
+ * Per block behavior matches `Block::startTransaction()` followed by
+ * `Block::checkTransaction()`. This covers stale tracking, verify ranges and
+ * verify checks, disabled blocks and blocks with nothing to do. The whole run
+ * executes without the Python GIL. Variable update notifications are sent
+ * after the last block completes.
+ *
+ * Exposed to Python as `rogue.interfaces.memory.BlockGroup` and used by
+ * `pyrogue.bulkTransaction()`.
+ */
+class BlockGroup {
+    // Blocks in issue order
+    std::vector<std::shared_ptr<rogue::interfaces::memory::Block>> blocks_;
+
+    // Maximum transactions in flight
+    uint32_t window_;
+
+    // Serializes runs and changes to the block list
+    std::mutex mtx_;
+
+    // Logger
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Run the transactions, returns the blocks with variable updates pending
+    std::vector<rogue::interfaces::memory::Block*> intRun(uint32_t type, bool forceWr, bool skipPyTrans);
+
+  public:
+    /**
+     * @brief Creates a block group.
+     *
+     * @details
+     * Exposed to Python as `rogue.interfaces.memory.BlockGroup()`.
+     * This static factory is the preferred construction path when the object
+     * is shared across Rogue graph connections or exposed to Python.
+     * It returns `std::shared_ptr` ownership compatible with Rogue pointer typedefs.
+     *
+     * @param window Maximum number of transactions in flight, at least 1.
+     * @return Shared pointer to the created group.
+     */
+    static std::shared_ptr<rogue::interfaces::memory::BlockGroup> create(uint32_t window);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    /**
+     * @brief Constructs a block group.
+     *
+     * @details
+     * This constructor is a low-level C++ allocation path.
+     * Prefer `create()` when shared ownership or Python exposure is required.
+     *
+     * @param window Maximum number of transactions in flight, at least 1.
+     */
+    explicit BlockGroup(uint32_t window);
+
+    // Destroy the group
+    ~BlockGroup();
+
+    /**
+     * @brief Appends a block to the group.
+     *
+     * @details Exposed as `addBlock()` in Python.
+     *
+     * @param block Block to add.
+     */
+    void addBlock(std::shared_ptr<rogue::interfaces::memory::Block> block);
+
+    /**
+     * @brief Appends blocks to the group in order.
+     *
+     * @param blocks Blocks to add.
+     */
+    void addBlocks(const std::vector<std::shared_ptr<rogue::interfaces::memory::Block>>& blocks);
+
+#ifndef NO_PYTHON
+
+    /**
+     * @brief Appends blocks from a Python iterable.
+     *
+     * @details Exposed as `addBlocks()` in Python.
+     *
+     * @param blocks Iterable of blocks.
+     */
+    void addBlocksPy(boost::python::object blocks);
+
+#endif
+
+    /**
+     * @brief Removes all blocks from the group.
+     *
+     * @details Exposed as `clear()` in Python.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of blocks in the group.
+     *
+     * @details Exposed as `__len__` in Python.
+     *
+     * @return Block count.
+     */
+    uint32_t count();
+
+    /**
+     * @brief Sets the maximum number of transactions in flight.
+     *
+     * @details Exposed as `window` property in Python.
+     *
+     * @param window Window size, values below 1 are raised to 1.
+     */
+    void setWindow(uint32_t window);
+
+    /**
+     * @brief Returns the maximum number of transactions in flight.
+     *
+     * @return Window size.
+     */
+    uint32_t getWindow();
+
+    /**
+     * @brief Runs a transaction on every block and waits for all of them.
+     *
+     * @details
+     * Throws a `rogue::GeneralError` listing every block which still failed
+     * after its retries. Blocks which succeeded are not affected by failures
+     * of other blocks.
+     *
+     * @param type Transaction type, `Read`, `Write`, `Post` or `Verify`.
+     * @param forceWr Forces writes of blocks which are not stale.
+     */
+    void run(uint32_t type, bool forceWr = false);
+
+#ifndef NO_PYTHON
+
+    /**
+     * @brief Python version of `run()`.
+     *
+     * @details
+     * Skips blocks whose transactions are handled in Python, as
+     * `Block::startTransactionPy()` does, and sends variable update
+     * notifications. Exposed as `_run()` in Python.
+     *
+     * @param type Transaction type.
+     * @param forceWr Forces writes of blocks which are not stale.
+     */
+    void runPy(uint32_t type, bool forceWr);
+
+#endif
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::interfaces::memory::BlockGroup> BlockGroupPtr;
+
+}  // namespace memory
+}  // namespace interfaces
+}  // namespace rogue
+
+#endif
@@ -66,6 +66,19 @@ static const uint32_t Verify = 0x4;
  */
 static const uint32_t TcpBridgeProbe = 0xFFFFFFFE;
 
+/**
+ * @brief Highest memory TCP bridge protocol version.
+ *
+ * @details
+ * Version 1 sends one multipart message per transaction. Version 2 packs
+ * several transactions into each message and lets the server complete them
+ * out of order. A client offers its version in a readiness probe with the
+ * version in the size field, and a server which understands it replies with
+ * the version it accepts. This is an internal bridge constant and is not
+ * exported to Python.
+ */
+static const uint32_t TcpBridgeVersion = 2;
+
 //////////////////////////////
 // Block Processing Types
 //////////////////////////////
@@ -189,6 +202,61 @@ static const uint8_t Float4 = 0x0F;
  */
 static const uint8_t Custom = 0x80;
 
+//////////////////////////////
+// Cache Policy Constants
+//////////////////////////////
+
+/**
+ * @brief Shadow cache policy for ranges which are never cached.
+ *
+ * @details Exposed to Python as `rogue.interfaces.memory.CacheVolatile`.
+ */
+static const uint32_t CacheVolatile = 0x0;
+
+/**
+ * @brief Shadow cache policy for ranges which only change when written.
+ *
+ * @details
+ * Writes update the cache once they succeed, reads are served from the cache
+ * once every byte is known. Exposed to Python as
+ * `rogue.interfaces.memory.CacheWriteThrough`.
+ */
+static const uint32_t CacheWriteThrough = 0x1;
+
+/**
+ * @brief Shadow cache policy for ranges which are read from hardware once.
+ *
+ * @details
+ * Reads are served from the cache after the first read. Writes invalidate the
+ * written bytes. Exposed to Python as `rogue.interfaces.memory.CacheReadOnce`.
+ */
+static const uint32_t CacheReadOnce = 0x2;
+
+//////////////////////////////
+// Transaction Priority Constants
+//////////////////////////////
+
+/**
+ * @brief Transaction priority for background traffic such as polling.
+ *
+ * @details Exposed to Python as `rogue.interfaces.memory.PriorityBackground`.
+ */
+static const uint32_t PriorityBackground = 0x0;
+
+/**
+ * @brief Default transaction priority for user and interactive access.
+ *
+ * @details Exposed to Python as `rogue.interfaces.memory.PriorityNormal`.
+ */
+static const uint32_t PriorityNormal = 0x1;
+
+/**
+ * @brief Transaction priority for commands which should go ahead of other traffic.
+ *
+ * @details Exposed to Python as `rogue.interfaces.memory.PriorityHigh`.
+ */
+static const uint32_t PriorityHigh = 0x2;
+
 }  // namespace memory
 }  // namespace interfaces
 }  // namespace rogue
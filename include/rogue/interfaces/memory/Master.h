@@ -20,13 +20,18 @@
 
 #include <stdint.h>
 
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Transaction.h"
 
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
@@ -72,6 +77,30 @@ class Master {
     /** Logger for master activity. */
     std::shared_ptr<rogue::Logging> log_;
 
+    /** Recycled transactions for new requests. */
+    std::shared_ptr<rogue::interfaces::memory::TransactionPool> pool_;
+
+    /** Asynchronous transactions awaiting completion or timeout, in issue order. */
+    std::deque<std::shared_ptr<rogue::interfaces::memory::Transaction> > asyncQueue_;
+
+    /** Mutex protecting asynchronous transaction state. */
+    std::mutex asyncMtx_;
+
+    /** Condition signalling new asynchronous transactions. */
+    std::condition_variable asyncCond_;
+
+    /** Thread delivering asynchronous timeouts, started on first use. */
+    std::thread* asyncThread_;
+
+    /** Asynchronous requests are accepted until the master is stopped. */
+    bool asyncRun_;
+
+    /** Times out asynchronous transactions that receive no response. */
+    void runAsync();
+
+    /** Drains the asynchronous queue and stops its thread. */
+    void stopAsync();
+
   public:
     /**
      * @brief Creates a memory master instance.
@@ -210,6 +239,15 @@ class Master {
      */
     void setTimeout(uint64_t timeout);
 
+    /**
+     * @brief Returns the timeout value for future transactions.
+     *
+     * @details Exposed as `_getTimeout()` in Python.
+     *
+     * @return Timeout value in microseconds.
+     */
+    uint64_t getTimeout();
+
     /**
      * @brief Starts a new transaction.
      *
@@ -250,6 +288,85 @@ class Master {
      */
     uint32_t reqTransactionPy(uint64_t address, boost::python::object p, uint32_t size, uint32_t offset, uint32_t type);
 
+#endif
+
+    /**
+     * @brief Starts a new transaction with a completion callback.
+     *
+     * @details
+     * Issues the transaction like `reqTransaction()`, but completion is reported
+     * through `callback` instead of `waitTransaction()`. The callback is invoked
+     * exactly once with the transaction ID and the error string, which is empty
+     * on success.
+     *
+     * On a response the callback runs on the thread completing the transaction,
+     * typically the slave's receive thread, with the transaction lock held. A
+     * slave which completes synchronously calls it before this method returns.
+     * A transaction without a response is timed out by a single background
+     * thread per master, which then calls the callback. The callback must not
+     * block and must not lock the transaction.
+     *
+     * Asynchronous transactions are not waited on by `waitTransaction()` and do
+     * not update `getError()`. `data` must stay valid until the callback is called.
+     * Not exposed to Python (see `reqTransactionAsyncPy`).
+     *
+     * @param address Relative 64-bit transaction address.
+     * @param size Transaction size in bytes.
+     * @param data Pointer to transaction data storage.
+     * @param type Transaction type constant.
+     * @param callback Completion callback.
+     * @return 32-bit transaction ID.
+     */
+    uint32_t reqTransactionAsync(uint64_t address,
+                                 uint32_t size,
+                                 void* data,
+                                 uint32_t type,
+                                 rogue::interfaces::memory::TransactionCallback callback);
+
+    /**
+     * @brief Starts a new transaction and returns a future for its result.
+     *
+     * @details
+     * Wraps `reqTransactionAsync()`. The future becomes ready with the
+     * transaction error string, empty on success, once the transaction
+     * completes or times out.
+     *
+     * @param address Relative 64-bit transaction address.
+     * @param size Transaction size in bytes.
+     * @param data Pointer to transaction data storage.
+     * @param type Transaction type constant.
+     * @return Future holding the transaction error string.
+     */
+    std::future<std::string> reqTransactionFuture(uint64_t address, uint32_t size, void* data, uint32_t type);
+
+#ifndef NO_PYTHON
+
+    /**
+     * @brief Python variant of `reqTransactionAsync`.
+     *
+     * @details
+     * Buffer handling matches `reqTransactionPy()`. `callback` is called as
+     * `callback(id, error)` with the GIL held, from the thread completing the
+     * transaction. Exceptions raised by the callback are printed and dropped.
+     * Use `pyrogue.interfaces.asyncTransaction()` to await the result from
+     * asyncio code.
+     * Exposed to Python as `_reqTransactionAsync()`.
+     *
+     * @param address Relative 64-bit transaction address.
+     * @param p Python buffer-protocol object containing transaction bytes.
+     * @param size Transaction size in bytes.
+     * @param offset Byte offset within `p`.
+     * @param type Transaction type constant.
+     * @param callback Python callable invoked on completion.
+     * @return 32-bit transaction ID.
+     */
+    uint32_t reqTransactionAsyncPy(uint64_t address,
+                                   boost::python::object p,
+                                   uint32_t size,
+                                   uint32_t offset,
+                                   uint32_t type,
+                                   boost::python::object callback);
+
 #endif
 
     /**
@@ -262,7 +379,10 @@ class Master {
      * Bit numbering is least-significant-bit-first within each byte (bit 0 is the
      * LSB of byte 0). The routine preserves destination bits outside the copied
      * range and supports arbitrary unaligned source/destination bit offsets.
-     * When both offsets are byte-aligned, it uses a byte-copy fast path.
+     * After filling any partial first destination byte the copy proceeds a
+     * 64-bit word (128 bits with SSE2) at a time, shifting by the residual
+     * source offset, with a byte-copy fast path when that offset is zero. Only
+     * the bytes holding the addressed bits are read or written.
      *
      * This helper underpins variable packing/unpacking logic in the memory layer.
      * Exposed as `_copyBits()` in Python.
@@ -393,6 +513,34 @@ class Master {
     /** @brief Starts an internal transaction from an existing transaction object. */
     uint32_t intTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
 
+    /** @brief Starts an internal transaction which reports completion through a callback. */
+    uint32_t intTransactionAsync(std::shared_ptr<rogue::interfaces::memory::Transaction> tran,
+                                 rogue::interfaces::memory::TransactionCallback callback);
+
+    /**
+     * @brief Starts a transaction tracked by `waitTransaction()` which also calls `notify` on completion.
+     *
+     * @details
+     * `notify` runs under the same rules as an asynchronous callback. A timeout
+     * is only detected, and notified, by a caller of `waitTransaction()`.
+     */
+    uint32_t reqTransactionNotify(uint64_t address,
+                                  uint32_t size,
+                                  void* data,
+                                  uint32_t type,
+                                  rogue::interfaces::memory::TransactionCallback notify);
+
+#ifndef NO_PYTHON
+
+    /** @brief Creates a transaction backed by a Python buffer. */
+    std::shared_ptr<rogue::interfaces::memory::Transaction> pyTransaction(uint64_t address,
+                                                                          boost::python::object p,
+                                                                          uint32_t size,
+                                                                          uint32_t offset,
+                                                                          uint32_t type);
+
+#endif
+
   public:
     /**
      * @brief Waits for transaction completion or timeout.
@@ -0,0 +1,204 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which issues transactions by priority class.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_MEMORY_PRIORITY_SCHEDULER_H__
+#define __ROGUE_INTERFACES_MEMORY_PRIORITY_SCHEDULER_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Hub.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace memory {
+
+/**
+ * @brief Memory stage which issues transactions by priority class.
+ *
+ * @details
+ * Polling, bulk configuration and user access normally share one first in,
+ * first out path, so a single user write can wait behind a long poll sweep on
+ * a slow link. A `PriorityScheduler` keeps one queue per transaction priority
+ * (see `Transaction::priority()`) and keeps at most a window of transactions
+ * outstanding on the next stage. Each free slot goes to the oldest
+ * transaction of the highest priority waiting.
+ *
+ * To guarantee progress, a waiting lower priority queue which has been passed
+ * over for the starvation limit of issues gets the next slot. Transactions of
+ * one priority keep their order. Transactions which expire while queued are
+ * dropped. The stage copies data through its own buffer, so the original
+ * transaction is completed once the downstream one completes.
+ *
+ * The stage is a pass-through `Hub` with no offset, so it can sit anywhere
+ * between a `Root` and its memory interface.
+ */
+class PriorityScheduler : public Hub {
+    // Queued transactions, one queue per priority
+    std::deque<std::shared_ptr<rogue::interfaces::memory::Transaction>> queue_[PriorityHigh + 1];
+
+    // Issues since each queue was last served while it was waiting
+    uint32_t skip_[PriorityHigh + 1];
+
+    // Issued transactions per priority
+    uint64_t issueCount_[PriorityHigh + 1];
+
+    // Outstanding transaction limit and count
+    uint32_t window_;
+    uint32_t inFlight_;
+
+    // Issues a waiting lower priority queue may be passed over
+    uint32_t starveLimit_;
+
+    // A thread is running the dispatch loop
+    bool dispatching_;
+
+    // Stage is stopped
+    bool stopped_;
+
+    // Lock
+    std::mutex mtx_;
+
+    // Logger
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Take the next transaction to issue, called with mtx_ held
+    std::shared_ptr<rogue::interfaces::memory::Transaction> next();
+
+    // Issue transactions while the window has room
+    void dispatch();
+
+    // Issue one transaction to the next stage
+    void issue(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+  public:
+    /**
+     * @brief Creates a priority scheduling stage.
+     *
+     * @details
+     * Exposed to Python as `rogue.interfaces.memory.PriorityScheduler()`.
+     * This static factory is the preferred construction path when the object
+     * is shared across Rogue graph connections or exposed to Python.
+     * It returns `std::shared_ptr` ownership compatible with Rogue pointer typedefs.
+     *
+     * @param window Maximum number of transactions outstanding downstream.
+     * @return Shared pointer to the created stage.
+     */
+    static std::shared_ptr<rogue::interfaces::memory::PriorityScheduler> create(uint32_t window);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    /**
+     * @brief Constructs a priority scheduling stage.
+     *
+     * @details
+     * This constructor is a low-level C++ allocation path.
+     * Prefer `create()` when shared ownership or Python exposure is required.
+     *
+     * @param window Maximum number of transactions outstanding downstream.
+     */
+    explicit PriorityScheduler(uint32_t window);
+
+    // Destroy the stage
+    ~PriorityScheduler();
+
+    /**
+     * @brief Stops the stage.
+     *
+     * @details
+     * Fails every queued transaction. Later transactions are forwarded without
+     * scheduling. Exposed as `_stop()` in Python.
+     */
+    void stop();
+
+    /**
+     * @brief Sets the maximum number of transactions outstanding downstream.
+     *
+     * @details
+     * A small window keeps high priority transactions from waiting behind
+     * many issued ones. Exposed as `setWindow()` in Python.
+     *
+     * @param window Window size, at least 1.
+     */
+    void setWindow(uint32_t window);
+
+    /**
+     * @brief Sets how often a waiting lower priority queue may be passed over.
+     *
+     * @details
+     * Zero disables the guarantee and gives strict priority. Defaults to 4.
+     * Exposed as `setStarvationLimit()` in Python.
+     *
+     * @param limit Number of issues.
+     */
+    void setStarvationLimit(uint32_t limit);
+
+    /**
+     * @brief Returns the number of transactions outstanding downstream.
+     *
+     * @details Exposed as `getInFlight()` in Python.
+     *
+     * @return Outstanding transaction count.
+     */
+    uint32_t getInFlight();
+
+    /**
+     * @brief Returns the number of transactions waiting at a priority.
+     *
+     * @details Exposed as `getQueueDepth()` in Python.
+     *
+     * @param priority Transaction priority.
+     * @return Queued transaction count.
+     */
+    uint32_t getQueueDepth(uint32_t priority);
+
+    /**
+     * @brief Returns the number of transactions issued at a priority.
+     *
+     * @details Exposed as `getIssueCount()` in Python.
+     *
+     * @param priority Transaction priority.
+     * @return Issued transaction count.
+     */
+    uint64_t getIssueCount(uint32_t priority);
+
+    /**
+     * @brief Services a transaction request from an attached master.
+     *
+     * @param transaction Transaction pointer as TransactionPtr.
+     */
+    void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> transaction);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::interfaces::memory::PriorityScheduler> PrioritySchedulerPtr;
+
+}  // namespace memory
+}  // namespace interfaces
+}  // namespace rogue
+
+#endif
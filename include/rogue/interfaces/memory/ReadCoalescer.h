@@ -0,0 +1,240 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which merges reads of adjacent blocks into larger transactions.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_MEMORY_READ_COALESCER_H__
+#define __ROGUE_INTERFACES_MEMORY_READ_COALESCER_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Hub.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace memory {
+
+/**
+ * @brief Memory stage which coalesces adjacent reads.
+ *
+ * @details
+ * Devices often map many small contiguous register blocks, each read with its
+ * own transaction and round trip. A `ReadCoalescer` placed between the tree and
+ * the memory interface collects reads which arrive back to back. A read which
+ * starts exactly at the end of the previous one, or after a tolerated hole,
+ * joins the current group. The group is read as one transaction of up to
+ * `doMaxAccess()` bytes of the next stage, and the data is then copied back
+ * into each original transaction.
+ *
+ * A group is issued when it reaches the maximum access size, when a read that
+ * does not fit or any other transaction arrives, or once no new read has
+ * joined for the hold time. Transactions therefore reach the next stage in
+ * arrival order. A group of one read is forwarded unchanged.
+ *
+ * Reads skip over holes only inside ranges registered with
+ * `addOverReadRange()`, where reading unused addresses has no side effects.
+ * Reads and verify reads are grouped separately. An error on the combined
+ * read fails every transaction of the group.
+ *
+ * The stage is a pass-through `Hub` with no offset, so it can sit anywhere
+ * between a `Root` and its memory interface.
+ */
+class ReadCoalescer : public Hub {
+    // Address range where over reads are allowed
+    struct OverRead {
+        uint64_t start;
+        uint64_t end;
+        uint32_t maxGap;
+    };
+
+    // Group of reads detached for issue
+    struct Group {
+        std::vector<std::shared_ptr<rogue::interfaces::memory::Transaction>> reads;
+        uint64_t start;
+        uint64_t end;
+        uint32_t type;
+    };
+
+    // Over read ranges
+    std::vector<OverRead> overRead_;
+
+    // Reads of the current group
+    std::vector<std::shared_ptr<rogue::interfaces::memory::Transaction>> group_;
+
+    // Address range and type of the current group
+    uint64_t groupStart_;
+    uint64_t groupEnd_;
+    uint32_t groupType_;
+
+    // Time the last read joined the group
+    std::chrono::steady_clock::time_point groupTime_;
+
+    // Hold time in microseconds
+    uint32_t holdTime_;
+
+    // Counters
+    uint64_t readCount_;
+    uint64_t issueCount_;
+
+    // Issue thread
+    std::thread* thread_;
+    bool threadEn_;
+
+    // Lock and condition
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    // Held from detaching a group until it has been sent, and while passing a
+    // transaction through, so nothing reaches the next stage ahead of an
+    // earlier group. Recursive as a synchronous next stage may re-enter.
+    std::recursive_mutex issueMtx_;
+
+    // Logger
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Returns true if the hole between from and to may be read
+    bool holeAllowed(uint64_t from, uint64_t to);
+
+    // Move the current group into grp, called with mtx_ held
+    void detach(Group& grp);
+
+    // Issue a detached group, called with issueMtx_ held
+    void issue(Group& grp);
+
+    // Detach and issue the current group, called without mtx_ held
+    void send();
+
+    // Thread to issue groups once the hold time expires
+    void runThread();
+
+  public:
+    /**
+     * @brief Creates a read coalescing stage.
+     *
+     * @details
+     * Exposed to Python as `rogue.interfaces.memory.ReadCoalescer()`.
+     * This static factory is the preferred construction path when the object
+     * is shared across Rogue graph connections or exposed to Python.
+     * It returns `std::shared_ptr` ownership compatible with Rogue pointer typedefs.
+     *
+     * @param holdTime Time in microseconds to wait for the next adjacent read.
+     * @return Shared pointer to the created stage.
+     */
+    static std::shared_ptr<rogue::interfaces::memory::ReadCoalescer> create(uint32_t holdTime);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    /**
+     * @brief Constructs a read coalescing stage.
+     *
+     * @details
+     * This constructor is a low-level C++ allocation path.
+     * Prefer `create()` when shared ownership or Python exposure is required.
+     *
+     * @param holdTime Time in microseconds to wait for the next adjacent read.
+     */
+    explicit ReadCoalescer(uint32_t holdTime);
+
+    // Destroy the stage
+    ~ReadCoalescer();
+
+    /**
+     * @brief Stops the issue thread.
+     *
+     * @details
+     * Issues any pending group first. Later reads are forwarded without
+     * coalescing. Exposed as `_stop()` in Python.
+     */
+    void stop();
+
+    /**
+     * @brief Allows reads to skip over unused addresses in a range.
+     *
+     * @details
+     * Exposed as `addOverReadRange()` in Python.
+     *
+     * @param address Start address of the range.
+     * @param size Size of the range in bytes.
+     * @param maxGap Largest hole in bytes which may be read between two reads.
+     */
+    void addOverReadRange(uint64_t address, uint64_t size, uint32_t maxGap);
+
+    /**
+     * @brief Sets the time to wait for the next adjacent read.
+     *
+     * @details Exposed as `setHoldTime()` in Python.
+     *
+     * @param holdTime Hold time in microseconds.
+     */
+    void setHoldTime(uint32_t holdTime);
+
+    /**
+     * @brief Issues the current group without waiting for the hold time.
+     *
+     * @details Exposed as `flush()` in Python.
+     */
+    void flush();
+
+    /**
+     * @brief Returns the number of reads received.
+     *
+     * @details Exposed as `getReadCount()` in Python.
+     *
+     * @return Read count.
+     */
+    uint64_t getReadCount();
+
+    /**
+     * @brief Returns the number of reads issued to the next stage.
+     *
+     * @details Exposed as `getIssueCount()` in Python.
+     *
+     * @return Issued read count.
+     */
+    uint64_t getIssueCount();
+
+    /**
+     * @brief Services a transaction request from an attached master.
+     *
+     * @details
+     * Reads are added to the current group, other transactions are forwarded
+     * after the current group is issued.
+     *
+     * @param transaction Transaction pointer as TransactionPtr.
+     */
+    void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> transaction);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::interfaces::memory::ReadCoalescer> ReadCoalescerPtr;
+
+}  // namespace memory
+}  // namespace interfaces
+}  // namespace rogue
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which serves reads of registers from a shadow copy.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_MEMORY_SHADOW_CACHE_H__
+#define __ROGUE_INTERFACES_MEMORY_SHADOW_CACHE_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Hub.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace memory {
+
+/**
+ * @brief Memory stage which keeps a shadow copy of register ranges.
+ *
+ * @details
+ * Configuration registers usually only change when software writes them, yet
+ * every read and every poll goes to the hardware. A `ShadowCache` placed
+ * between the tree and the memory interface keeps a copy of the last written
+ * or read value of each byte in the ranges registered with `addRange()`.
+ * Each range has one of these policies:
+ *
+ * - `CacheVolatile`: never cached, the default outside registered ranges.
+ * - `CacheWriteThrough`: writes go to the hardware and update the copy once
+ *   they succeed. Reads are served from the copy once every byte is known,
+ *   otherwise they read the hardware and fill the copy.
+ * - `CacheReadOnce`: the first read fills the copy and later reads are served
+ *   from it. Writes go to the hardware and drop the written bytes from the copy.
+ *
+ * Verify transactions always read the hardware and refresh the copy. Reads
+ * which are not fully inside one cached range, and reads larger than the next
+ * stage accepts in one transaction, pass through. A failed write drops the
+ * written bytes from the copy. A read which completes after a write or
+ * invalidation of its range leaves the copy unchanged.
+ *
+ * The stage is a pass-through `Hub` with no offset, so it can sit anywhere
+ * between a `Root` and its memory interface.
+ */
+class ShadowCache : public Hub {
+    // Cached address range
+    struct Range {
+        uint64_t start;
+        uint64_t end;
+        uint32_t policy;
+        uint64_t epoch;  // Bumped by every write or invalidation
+        std::vector<uint8_t> data;
+        std::vector<uint8_t> valid;
+    };
+
+    // Cached ranges, only ever appended
+    std::vector<Range> ranges_;
+
+    // Counters
+    uint64_t hitCount_;
+    uint64_t missCount_;
+
+    // Lock
+    std::mutex mtx_;
+
+    // Logger
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Returns index of the cached range holding the whole access or -1, called with mtx_ held
+    int32_t findRange(uint64_t address, uint32_t size);
+
+    // Drop bytes of every overlapping range, called with mtx_ held
+    void intInvalidate(uint64_t address, uint64_t size);
+
+    // Read the hardware and fill range idx unless its epoch moved on
+    void cacheRead(std::shared_ptr<rogue::interfaces::memory::Transaction> tran, int32_t idx, uint64_t epoch);
+
+    // Write the hardware and update the listed ranges unless their epochs moved on
+    void cacheWrite(std::shared_ptr<rogue::interfaces::memory::Transaction> tran,
+                    const std::vector<std::pair<int32_t, uint64_t>>& epochs);
+
+  public:
+    /**
+     * @brief Creates a shadow cache stage.
+     *
+     * @details
+     * Exposed to Python as `rogue.interfaces.memory.ShadowCache()`.
+     * This static factory is the preferred construction path when the object
+     * is shared across Rogue graph connections or exposed to Python.
+     * It returns `std::shared_ptr` ownership compatible with Rogue pointer typedefs.
+     *
+     * @return Shared pointer to the created stage.
+     */
+    static std::shared_ptr<rogue::interfaces::memory::ShadowCache> create();
+
+    // Setup class for use in python
+    static void setup_python();
+
+    /**
+     * @brief Constructs a shadow cache stage.
+     *
+     * @details
+     * This constructor is a low-level C++ allocation path.
+     * Prefer `create()` when shared ownership or Python exposure is required.
+     */
+    ShadowCache();
+
+    // Destroy the stage
+    ~ShadowCache();
+
+    /**
+     * @brief Registers an address range with a cache policy.
+     *
+     * @details
+     * Ranges may not overlap. The copy of a new range starts empty. Exposed as
+     * `addRange()` in Python.
+     *
+     * @param address Start address of the range.
+     * @param size Size of the range in bytes.
+     * @param policy `CacheVolatile`, `CacheWriteThrough` or `CacheReadOnce`.
+     */
+    void addRange(uint64_t address, uint32_t size, uint32_t policy);
+
+    /**
+     * @brief Drops the cached copy of every range.
+     *
+     * @details Exposed as `invalidate()` in Python.
+     */
+    void invalidate();
+
+    /**
+     * @brief Drops the cached copy of an address range.
+     *
+     * @details Exposed as `invalidateRange()` in Python.
+     *
+     * @param address Start address.
+     * @param size Size in bytes.
+     */
+    void invalidateRange(uint64_t address, uint64_t size);
+
+    /**
+     * @brief Returns the number of reads served from the cache.
+     *
+     * @details Exposed as `getHitCount()` in Python.
+     *
+     * @return Hit count.
+     */
+    uint64_t getHitCount();
+
+    /**
+     * @brief Returns the number of reads of cached ranges sent to the hardware.
+     *
+     * @details Exposed as `getMissCount()` in Python.
+     *
+     * @return Miss count.
+     */
+    uint64_t getMissCount();
+
+    /**
+     * @brief Resets the hit and miss counters.
+     *
+     * @details Exposed as `resetCounters()` in Python.
+     */
+    void resetCounters();
+
+    /**
+     * @brief Services a transaction request from an attached master.
+     *
+     * @param transaction Transaction pointer as TransactionPtr.
+     */
+    void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> transaction);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::interfaces::memory::ShadowCache> ShadowCachePtr;
+
+}  // namespace memory
+}  // namespace interfaces
+}  // namespace rogue
+
+#endif
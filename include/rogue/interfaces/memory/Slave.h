@@ -20,12 +20,17 @@
 
 #include <stdint.h>
 
-#include <map>
+#include <chrono>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
+#include "rogue/TimerWheel.h"
 #include "rogue/interfaces/memory/Master.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
@@ -40,6 +45,45 @@ namespace memory {
 class Master;
 class Transaction;
 
+//! \cond INTERNAL
+/**
+ * @brief Response history used to refresh outstanding transaction timers.
+ *
+ * @details
+ * Records the start time of each transaction a `Slave` receives a response
+ * for, together with the response time. A transaction that reaches its
+ * deadline asks for the latest response to a transaction started no later
+ * than itself, and extends its deadline from that point. Refreshes are
+ * therefore applied lazily, only to transactions that would otherwise time
+ * out, instead of walking every outstanding transaction on each response.
+ *
+ * Entries are kept with both times increasing. A new entry replaces any with
+ * a later or equal start time, and entries older than the longest timeout
+ * are discarded, so the history stays small. Times are monotonic clock microseconds.
+ */
+class ResponseTracker {
+    std::mutex mtx_;
+
+    // Start and response time pairs, both increasing
+    std::deque<std::pair<int64_t, int64_t> > marks_;
+
+    // Longest transaction timeout seen
+    int64_t window_;
+
+  public:
+    ResponseTracker();
+
+    // Track the longest timeout of transactions that may query the history
+    void setWindow(int64_t window);
+
+    // Record a response for a transaction with the passed start time
+    void mark(int64_t start, int64_t now);
+
+    // Latest response to a transaction started at or before start, 0 if none
+    int64_t latest(int64_t start);
+};
+//! \endcond
+
 /**
  * @brief Memory slave device.
  *
@@ -61,15 +105,31 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
     // Unique slave ID
     uint32_t id_;
 
-    // Alias for map
-    typedef std::map<uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction> > TransactionMap;
+    // Outstanding transaction with its expiry timer
+    struct TranEntry : public rogue::TimerWheel::Timer {
+        std::shared_ptr<rogue::interfaces::memory::Transaction> tran;
+        std::chrono::microseconds timeout;
+    };
 
-    // Transaction map
-    TransactionMap tranMap_;
+    // Alias for table
+    typedef std::unordered_map<uint32_t, TranEntry> TransactionTable;
+
+    // Outstanding transactions keyed by ID
+    TransactionTable tranTable_;
+
+    // Expiry timers for outstanding transactions
+    rogue::TimerWheel expiry_;
+    std::vector<rogue::TimerWheel::Timer*> expired_;
+
+    // Response history shared with tracked transactions
+    std::shared_ptr<rogue::interfaces::memory::ResponseTracker> tracker_;
 
     // Slave lock
     std::mutex slaveMtx_;
 
+    // Remove entries for transactions that completed or timed out, lock must be held
+    void reapTransactions(rogue::TimerWheel::Clock::time_point now);
+
     // Min access
     uint32_t min_;
 
@@ -142,6 +202,10 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
      * tracking map for later retrieval. This is used when the transaction will be
      * completed later as the result of protocol data being returned to the Slave.
      *
+     * Each tracked transaction gets an expiry timer. Entries whose transaction
+     * has completed or timed out by then are removed here, when new
+     * transactions are added, so `getTransaction()` never scans the map.
+     *
      * Exposed to Python as `_addTransaction()`.
      *
      * @param transaction Pointer to transaction as TransactionPtr.
@@ -155,8 +219,10 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
      * This method is called by the sub-class to retrieve an existing transaction
      * using the unique transaction ID. If the transaction exists in the list the
      * pointer to that transaction will be returned. If not a NULL pointer will be
-     * returned. When getTransaction() is called the map will also be checked for
-     * stale transactions which will be removed from the map.
+     * returned. The lookup is constant time.
+     *
+     * The response is recorded so that outstanding transactions started after
+     * the returned one have their timers refreshed if they reach their deadline.
      *
      * Exposed to Python as `_getTransaction()`.
      *
@@ -165,6 +231,18 @@ class Slave : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Slav
      */
     std::shared_ptr<rogue::interfaces::memory::Transaction> getTransaction(uint32_t index);
 
+    /**
+     * @brief Returns the number of tracked transactions.
+     *
+     * @details
+     * Includes transactions that have timed out but not yet been removed.
+     *
+     * Exposed to Python as `_getTransactionCount()`.
+     *
+     * @return Tracked transaction count.
+     */
+    uint32_t getTransactionCount();
+
     /**
      * @brief Returns configured minimum transaction size.
      *
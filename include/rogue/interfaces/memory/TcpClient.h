@@ -25,6 +25,7 @@
 #include <string>
 #include <thread>
 #include <condition_variable>
+#include <vector>
 
 #include "rogue/Logging.h"
 #include "rogue/interfaces/memory/Slave.h"
@@ -48,6 +49,10 @@ namespace memory {
  * - Write/Post transactions include payload bytes in the outbound message.
  * - Read/Verify transactions send metadata and receive payload bytes in the response.
  * - Posted writes are completed locally after send (no response wait).
+ * - `waitReady()` also negotiates the protocol version. Against a server which
+ *   supports version 2, transactions are packed into batched messages by a
+ *   send thread and may complete out of order. Servers which do not answer
+ *   the version offer keep the version 1 one-message-per-transaction format.
  * - If the remote side is unavailable or send path is backpressured, sends may fail
  *   and in-flight transactions can time out at higher layers.
  */
@@ -65,12 +70,25 @@ class TcpClient : public rogue::interfaces::memory::Slave {
     // Thread background
     void runThread();
 
+    // Send thread for version 2 batches
+    void runSend();
+
+    // Queue a transaction into the next version 2 batch
+    void queueTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran);
+
+    // Complete the transactions of a version 2 response batch
+    void recvBatch(void* msg);
+
+    // Send a readiness probe, offering a protocol version if non-zero
+    void sendProbe(uint32_t id, uint32_t version);
+
     // Log
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
     //! \cond INTERNAL
   protected:
     std::unique_ptr<std::thread> thread_;
+    std::unique_ptr<std::thread> sendThread_;
     std::atomic<bool> threadEn_{false};
     //! \endcond
 
@@ -87,6 +105,19 @@ class TcpClient : public rogue::interfaces::memory::Slave {
     std::string probeResult_;
     bool waitReadyOnStart_;
 
+    // Protocol version state
+    uint32_t helloId_;
+    uint32_t helloVersion_;
+    uint32_t maxVersion_;
+    std::atomic<uint32_t> version_;
+
+    // Version 2 batch waiting for the send thread
+    std::mutex batchMtx_;
+    std::condition_variable batchCond_;
+    std::vector<uint8_t> batchDesc_;
+    std::vector<uint8_t> batchData_;
+    uint32_t batchCount_;
+
   public:
     /**
      * @brief Creates a TCP memory bridge client.
@@ -159,12 +190,40 @@ class TcpClient : public rogue::interfaces::memory::Slave {
      * the request/response path is usable, which is stronger than a local
      * socket-connect state.
      *
+     * Each attempt first offers the highest protocol version set by
+     * `setProtocolVersion()`. The version the server accepts before it
+     * answers the probe is used for later transactions; a server which
+     * ignores the offer is used with version 1.
+     *
      * @param timeout Maximum wait time in seconds.
      * @param period Retry period in seconds.
      * @return `true` if the probe succeeds before timeout, otherwise `false`.
      */
     bool waitReady(double timeout, double period);
 
+    /**
+     * @brief Sets the highest protocol version offered by `waitReady()`.
+     *
+     * @details
+     * Defaults to the newest version. Set to 1 to keep the one message per
+     * transaction format. Takes effect at the next `waitReady()`.
+     * Exposed as `setProtocolVersion()` in Python.
+     *
+     * @param version Highest protocol version to offer.
+     */
+    void setProtocolVersion(uint32_t version);
+
+    /**
+     * @brief Returns the protocol version in use.
+     *
+     * @details
+     * Version 1 until `waitReady()` negotiates a newer one.
+     * Exposed as `getProtocolVersion()` in Python.
+     *
+     * @return Negotiated protocol version.
+     */
+    uint32_t getProtocolVersion();
+
     /**
      * @brief Managed-lifecycle startup hook.
      *
@@ -22,8 +22,10 @@
 
 #include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
 #include "rogue/interfaces/memory/Master.h"
@@ -45,7 +47,9 @@ namespace memory {
  *
  * Operational behavior:
  * - Request messages carry transaction ID, address, size, type, and optional write data.
- * - Transactions are executed synchronously in the server worker thread.
+ * - Version 1 transactions are executed synchronously in the server worker thread.
+ * - Version 2 batches are issued to the downstream slave concurrently, and their
+ *   completions are returned in batches as they finish, possibly out of order.
  * - Responses include returned read data (when applicable) and a status/result string.
  * - The server must bind both bridge ports successfully; binding failures typically
  *   indicate address/port conflicts.
@@ -61,9 +65,38 @@ class TcpServer : public rogue::interfaces::memory::Master {
     void* zmqReq_  = nullptr;
     void* zmqResp_ = nullptr;
 
+    // Completed version 2 transaction waiting for its response
+    struct Completion {
+        uint32_t id;
+        uint32_t type;
+        uint64_t addr;
+        uint32_t size;
+        std::vector<uint8_t> data;
+        std::string result;
+    };
+
+    // Completions filled by transaction callbacks
+    std::mutex compMtx_;
+    std::vector<std::shared_ptr<Completion>> completions_;
+
+    // Pipe which wakes the worker thread when a completion arrives
+    int wakeFd_[2] = {-1, -1};
+
+    // Version 2 transactions issued and not yet responded to, worker thread only
+    uint32_t inFlight_ = 0;
+
     // Thread background
     void runThread();
 
+    // Issue the transactions of a version 2 request batch
+    void runBatch(void* msg);
+
+    // Send responses for completed version 2 transactions
+    bool sendCompletions();
+
+    // Rebuild the response socket after a failed multipart send
+    bool resetResponse();
+
     // Log
     std::shared_ptr<rogue::Logging> bridgeLog_;
 
@@ -19,13 +19,18 @@
 #include "rogue/Directives.h"
 
 #include <stdint.h>
+#include <sys/time.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
@@ -41,12 +46,24 @@ namespace memory {
 class TransactionLock;
 class Transaction;
 class Master;
+class Slave;
 class Hub;
+class ResponseTracker;
+class TransactionPool;
 
 //         using TransactionIDVec = std::vector<uint32_t>;
 //         using TransactionQueue = std::queue<std::shared_ptr<rogue::interfaces::memory::Transaction>>;
 using TransactionMap = std::map<uint32_t, std::shared_ptr<rogue::interfaces::memory::Transaction>>;
 
+/**
+ * @brief Completion callback for asynchronous transactions.
+ *
+ * @details
+ * Called once with the transaction ID and the error string, which is empty on
+ * success. See `Master::reqTransactionAsync()` for the calling context.
+ */
+typedef std::function<void(uint32_t, const std::string&)> TransactionCallback;
+
 /**
  * @brief Memory transaction container passed between master and slave.
  *
@@ -56,14 +73,18 @@ using TransactionMap = std::map<uint32_t, std::shared_ptr<rogue::interfaces::mem
  *
  * Lifecycle and ownership:
  * - Instances are created internally by `Master`; callers do not construct them directly.
+ * - A `Master` reuses instances once every reference is dropped, resetting them with a new ID.
  * - A transaction is identified by a unique 32-bit ID.
  * - Data is accessed through an internal byte iterator and guarded by `TransactionLock`.
  * - Completion is signaled via `done()` or `error*()` and may be observed by wait logic.
+ * - Asynchronous transactions carry a completion callback invoked on completion or timeout.
  *
  * Timeout and completion behavior:
  * - A per-transaction timeout is captured at creation and used by wait/refresh logic.
  * - Transactions may expire when timeout is reached before completion.
  * - Timeout refresh can propagate from parent/peer activity to avoid premature expiration.
+ *   A transaction tracked by a `Slave` refreshes from responses to transactions started
+ *   no later than itself, checked only once its deadline has passed.
  *
  * Subtransaction behavior:
  * - A transaction can be split into child subtransactions.
@@ -78,7 +99,9 @@ using TransactionMap = std::map<uint32_t, std::shared_ptr<rogue::interfaces::mem
 class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory::Transaction> {
     friend class TransactionLock;
     friend class Master;
+    friend class Slave;
     friend class Hub;
+    friend class TransactionPool;
 
   public:
     /** @brief Iterator alias for transaction byte access. */
@@ -91,21 +114,42 @@ class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory
     // Class instance lock
     static std::mutex classMtx_;
 
-    // Conditional
+    // Completion states
+    static const uint32_t Pending  = 0;
+    static const uint32_t Waiting  = 1;
+    static const uint32_t Complete = 2;
+
+    // Completion state, waiters sleep on this word without holding the lock
+    std::atomic<uint32_t> state_;
+
+    // Conditional, used where the completion word cannot be waited on directly
     std::condition_variable cond_;
 
+    // Publish completion and wake any waiters
+    void complete();
+
+    // Sleep until completion or the passed deadline
+    void sleepUntil(std::chrono::steady_clock::time_point deadline);
+
+    // Return to the initial state with a new ID, used on creation and reuse
+    void reset(struct timeval timeout);
+
+    // Drop references held for the last use before returning to a pool
+    void recycle();
+
   protected:
     // Transaction timeout
     struct timeval timeout_;
+    std::chrono::microseconds timeoutDur_;
 
-    // Transaction end time
-    struct timeval endTime_;
+    // Transaction end time, on the monotonic clock
+    std::chrono::steady_clock::time_point endTime_;
 
     // Transaction start time
-    struct timeval startTime_;
+    std::chrono::steady_clock::time_point startTime_;
 
     // Transaction warn time
-    struct timeval warnTime_;
+    std::chrono::steady_clock::time_point warnTime_;
 
 #ifndef NO_PYTHON
     // Transaction python buffer
@@ -127,6 +171,9 @@ class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory
     // Transaction type
     uint32_t type_;
 
+    // Transaction priority class
+    uint32_t priority_;
+
     // Transaction error
     std::string error_;
 
@@ -154,6 +201,15 @@ class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory
     // Weak pointer to parent transaction, where applicable
     std::weak_ptr<rogue::interfaces::memory::Transaction> parentTransaction_;
 
+    // Response history of the slave tracking this transaction, set atomically
+    std::shared_ptr<rogue::interfaces::memory::ResponseTracker> tracker_;
+
+    // Completion callback for asynchronous transactions, invoked once
+    rogue::interfaces::memory::TransactionCallback callback_;
+
+    // Extend an elapsed deadline from a later response, lock must be held
+    bool lateRefresh(std::chrono::steady_clock::time_point now);
+
     /**
      * @brief Creates a transaction container.
      *
@@ -255,6 +311,42 @@ class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory
      */
     uint32_t type();
 
+    /**
+     * @brief Returns the transaction priority class.
+     *
+     * @details
+     * Set when the transaction is created from the priority of the creating
+     * thread, see `setThreadPriority()`. Subtransactions take the priority of
+     * their parent. Values are `PriorityBackground`, `PriorityNormal` and
+     * `PriorityHigh` in `rogue/interfaces/memory/Constants.h`.
+     *
+     * Exposed as `priority()` in Python.
+     *
+     * @return Transaction priority.
+     */
+    uint32_t priority();
+
+    /**
+     * @brief Sets the priority of transactions created by the calling thread.
+     *
+     * @details
+     * Threads start at `PriorityNormal`. The poll thread lowers itself to
+     * `PriorityBackground` so scheduling stages can let user access go first.
+     * Exposed as `Transaction.setThreadPriority()` in Python.
+     *
+     * @param priority `PriorityBackground`, `PriorityNormal` or `PriorityHigh`.
+     */
+    static void setThreadPriority(uint32_t priority);
+
+    /**
+     * @brief Returns the priority of transactions created by the calling thread.
+     *
+     * @details Exposed as `Transaction.getThreadPriority()` in Python.
+     *
+     * @return Thread priority.
+     */
+    static uint32_t getThreadPriority();
+
     /**
      * @brief Creates a subtransaction linked to this parent transaction.
      *
@@ -356,6 +448,42 @@ class Transaction : public rogue::EnableSharedFromThis<rogue::interfaces::memory
 /** @brief Shared pointer alias for `Transaction`. */
 typedef std::shared_ptr<rogue::interfaces::memory::Transaction> TransactionPtr;
 
+//! \cond INTERNAL
+/**
+ * @brief Free list of transactions owned by a `Master`.
+ *
+ * @details
+ * Transactions handed out by the pool return to it when the last shared
+ * pointer is dropped, wherever that happens, including Python references.
+ * They are reset in place on reuse with a new ID, so holders never see a
+ * transaction change under them. Returns past the free list limit, or after
+ * the pool itself is gone, delete the transaction as usual.
+ */
+class TransactionPool : public std::enable_shared_from_this<rogue::interfaces::memory::TransactionPool> {
+    std::mutex mtx_;
+
+    // Idle transactions, reused most recent first
+    std::vector<rogue::interfaces::memory::Transaction*> free_;
+
+    // Free list limit
+    std::size_t max_;
+
+    // Shared pointer deleter
+    static void release(std::weak_ptr<rogue::interfaces::memory::TransactionPool> pool,
+                        rogue::interfaces::memory::Transaction* tran);
+
+  public:
+    explicit TransactionPool(std::size_t max);
+    ~TransactionPool();
+
+    // Get a reset transaction with the passed timeout
+    std::shared_ptr<rogue::interfaces::memory::Transaction> get(struct timeval timeout);
+
+    // Number of idle transactions
+    std::size_t freeCount();
+};
+//! \endcond
+
 }  // namespace memory
 }  // namespace interfaces
 }  // namespace rogue
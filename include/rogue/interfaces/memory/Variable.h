@@ -159,6 +159,46 @@ class Variable {
     // Retry count
     uint32_t retryCount_;
 
+    /////////////////////////////////
+    // Access plan, see compilePlan()
+    /////////////////////////////////
+
+    // Decoded access mode
+    enum AccessMode : uint8_t { ModeRW, ModeRO, ModeWO };
+
+    // How one value moves between the caller and the block buffer
+    enum CopyMethod : uint8_t {
+        CopyBytes,  // Byte aligned, memcpy at fastByte_
+        CopyWord,   // Value of up to 64 bits, fields moved with 64-bit shift and mask
+        CopyBits    // Wider unaligned values, copyBits per field
+    };
+
+    // One contiguous field of a value
+    struct PlanField {
+        uint32_t blockLsb;  // First bit in the block
+        uint32_t valueLsb;  // First bit in the value
+        uint32_t size;      // Field width in bits
+        uint32_t byte;      // blockLsb / 8
+        uint32_t shift;     // blockLsb % 8
+        uint32_t span;      // Block bytes holding the field
+        uint64_t mask;      // Low size bits set
+    };
+
+    // Access mode
+    AccessMode accessMode_;
+
+    // Copy method
+    CopyMethod copyMethod_;
+
+    // Mask of the bits in one value
+    uint64_t valueMask_;
+
+    // Fields of a standard variable in value order
+    std::vector<PlanField> planFields_;
+
+    // Builds the access plan from the mode and current bit layout
+    void compilePlan();
+
 #ifndef NO_PYTHON
     /////////////////////////////////
     // Python
@@ -428,7 +468,7 @@ class Variable {
      * Used by `Block` during mapping/normalization to convert an absolute bit layout
      * into block-local coordinates and to recompute cached transfer boundaries.
      * This updates derived members such as byte coverage, fast-copy regions, and
-     * per-value low/high transaction byte ranges.
+     * per-value low/high transaction byte ranges, and rebuilds the access plan.
      *
      * @param shift Number of bits to shift down.
      * @param minSize Minimum alignment/size constraint in bits.
@@ -0,0 +1,233 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which merges posted writes into larger transactions.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_MEMORY_WRITE_COMBINER_H__
+#define __ROGUE_INTERFACES_MEMORY_WRITE_COMBINER_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Hub.h"
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+#endif
+
+namespace rogue {
+namespace interfaces {
+namespace memory {
+
+/**
+ * @brief Memory stage which combines posted writes.
+ *
+ * @details
+ * Tuning loops often post long bursts of writes to adjacent registers, each
+ * sent as its own frame. A `WriteCombiner` placed between the tree and the
+ * memory interface buffers `Post` transactions and completes them right away.
+ * Buffered writes which overlap or touch are merged, with the last write
+ * winning for each byte. The buffer is sent as the fewest transactions of up
+ * to `doMaxAccess()` bytes of the next stage:
+ *
+ * - Once the hold time has passed since the oldest buffered write
+ * - Once the buffer holds the configured number of bytes
+ * - Before any other transaction which overlaps a buffered write
+ * - When `flush()` or `stop()` is called
+ *
+ * Other transactions which do not overlap the buffer pass straight through, so
+ * reads and normal writes never see stale data. Because posted writes are
+ * completed when buffered, errors on the combined writes are logged and
+ * counted by `getErrorCount()`.
+ *
+ * The stage is a pass-through `Hub` with no offset, so it can sit anywhere
+ * between a `Root` and its memory interface.
+ */
+class WriteCombiner : public Hub {
+    // Buffered bytes keyed by start address, never overlapping or touching
+    std::map<uint64_t, std::vector<uint8_t>> buffer_;
+
+    // Bytes held in the buffer
+    uint32_t buffered_;
+
+    // Maximum access size of the next stage, as seen by the last transaction
+    uint32_t maxAccess_;
+
+    // Time the oldest buffered write arrived
+    std::chrono::steady_clock::time_point firstTime_;
+
+    // Hold time in microseconds and buffer size limit in bytes
+    uint32_t holdTime_;
+    uint32_t maxBuffered_;
+
+    // Counters
+    uint64_t postCount_;
+    uint64_t issueCount_;
+    std::atomic<uint64_t> errorCount_;
+
+    // Flush thread
+    std::thread* thread_;
+    bool threadEn_;
+
+    // Lock and condition
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    // Held from detaching a batch until it has been sent, and while passing a
+    // transaction through, so nothing reaches the next stage ahead of an
+    // earlier batch. Recursive as a synchronous next stage may re-enter.
+    std::recursive_mutex issueMtx_;
+
+    // Logger
+    std::shared_ptr<rogue::Logging> log_;
+
+    // Returns true if the range overlaps the buffer, called with mtx_ held
+    bool overlaps(uint64_t address, uint32_t size);
+
+    // Merge a posted write into the buffer, called with mtx_ held
+    void merge(uint64_t address, const uint8_t* data, uint32_t size);
+
+    // Move the buffer into batch, called with mtx_ held
+    void detach(std::map<uint64_t, std::vector<uint8_t>>& batch);
+
+    // Send a detached batch to the next stage, called with issueMtx_ held
+    void issue(const std::map<uint64_t, std::vector<uint8_t>>& batch, uint32_t maxAccess);
+
+    // Detach and send the buffer, called without mtx_ held
+    void send();
+
+    // Thread to flush the buffer once the hold time expires
+    void runThread();
+
+  public:
+    /**
+     * @brief Creates a write combining stage.
+     *
+     * @details
+     * Exposed to Python as `rogue.interfaces.memory.WriteCombiner()`.
+     * This static factory is the preferred construction path when the object
+     * is shared across Rogue graph connections or exposed to Python.
+     * It returns `std::shared_ptr` ownership compatible with Rogue pointer typedefs.
+     *
+     * @param holdTime Longest time in microseconds a posted write is buffered.
+     * @param maxBuffered Buffered byte count which triggers a flush.
+     * @return Shared pointer to the created stage.
+     */
+    static std::shared_ptr<rogue::interfaces::memory::WriteCombiner> create(uint32_t holdTime, uint32_t maxBuffered);
+
+    // Setup class for use in python
+    static void setup_python();
+
+    /**
+     * @brief Constructs a write combining stage.
+     *
+     * @details
+     * This constructor is a low-level C++ allocation path.
+     * Prefer `create()` when shared ownership or Python exposure is required.
+     *
+     * @param holdTime Longest time in microseconds a posted write is buffered.
+     * @param maxBuffered Buffered byte count which triggers a flush.
+     */
+    WriteCombiner(uint32_t holdTime, uint32_t maxBuffered);
+
+    // Destroy the stage
+    ~WriteCombiner();
+
+    /**
+     * @brief Stops the flush thread.
+     *
+     * @details
+     * Sends any buffered writes first. Later posted writes are forwarded
+     * without buffering. Exposed as `_stop()` in Python.
+     */
+    void stop();
+
+    /**
+     * @brief Sets the longest time a posted write is buffered.
+     *
+     * @details Exposed as `setHoldTime()` in Python.
+     *
+     * @param holdTime Hold time in microseconds.
+     */
+    void setHoldTime(uint32_t holdTime);
+
+    /**
+     * @brief Sets the buffered byte count which triggers a flush.
+     *
+     * @details Exposed as `setMaxBuffered()` in Python.
+     *
+     * @param maxBuffered Size in bytes.
+     */
+    void setMaxBuffered(uint32_t maxBuffered);
+
+    /**
+     * @brief Sends the buffered writes without waiting for the hold time.
+     *
+     * @details Exposed as `flush()` in Python.
+     */
+    void flush();
+
+    /**
+     * @brief Returns the number of posted writes received.
+     *
+     * @details Exposed as `getPostCount()` in Python.
+     *
+     * @return Posted write count.
+     */
+    uint64_t getPostCount();
+
+    /**
+     * @brief Returns the number of combined writes sent to the next stage.
+     *
+     * @details Exposed as `getIssueCount()` in Python.
+     *
+     * @return Issued write count.
+     */
+    uint64_t getIssueCount();
+
+    /**
+     * @brief Returns the number of combined writes which failed.
+     *
+     * @details Exposed as `getErrorCount()` in Python.
+     *
+     * @return Failed write count.
+     */
+    uint64_t getErrorCount();
+
+    /**
+     * @brief Services a transaction request from an attached master.
+     *
+     * @param transaction Transaction pointer as TransactionPtr.
+     */
+    void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> transaction);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::interfaces::memory::WriteCombiner> WriteCombinerPtr;
+
+}  // namespace memory
+}  // namespace interfaces
+}  // namespace rogue
+
+#endif
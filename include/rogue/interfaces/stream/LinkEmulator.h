@@ -0,0 +1,323 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description :
+ *    Stream link impairment emulator
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_INTERFACES_STREAM_LINK_EMULATOR_H__
+#define __ROGUE_INTERFACES_STREAM_LINK_EMULATOR_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace rogue {
+namespace interfaces {
+namespace stream {
+
+/**
+ * @brief Stream link impairment emulator.
+ *
+ * @details
+ * Forwards frames like a network link with configurable impairments, so
+ * protocol stacks such as RSSI, packetizer and SRP can be exercised under
+ * loss and delay in process. Each accepted frame is copied and then, in order:
+ * - Dropped if the bandwidth limiter queue already holds `queueDepth` frames.
+ * - Serialized at the configured bandwidth. Lost frames still use the link.
+ * - Dropped with the random loss probability, or with the loss probability of
+ *   the bad state when the Gilbert-Elliott burst model is enabled.
+ * - Delayed by the fixed delay plus a uniform jitter in `[-jitter, +jitter]`.
+ * - Optionally held back by the reorder gap so later frames overtake it.
+ * - Optionally duplicated.
+ *
+ * Jitter alone never reorders frames; only the reorder setting does.
+ * Delayed frames wait in a delay line ordered by release time and are sent
+ * from a worker thread that sleeps until the next release.
+ *
+ * All random decisions come from a seeded `std::mt19937_64`, drawn in frame
+ * arrival order, with a fixed number of draws per frame. The same seed and
+ * input sequence always yield the same loss, duplicate and reorder pattern.
+ * All impairments are disabled by default.
+ */
+class LinkEmulator : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
+    typedef std::chrono::steady_clock Clock;
+
+    // Delay line entry, ordered by release time then arrival
+    struct Entry {
+        Clock::time_point release;
+        uint64_t seq;
+        std::shared_ptr<rogue::interfaces::stream::Frame> frame;
+    };
+
+    struct EntryLater {
+        bool operator()(const Entry& a, const Entry& b) const {
+            if (a.release != b.release) return (a.release > b.release);
+            return (a.seq > b.seq);
+        }
+    };
+
+    std::shared_ptr<rogue::Logging> log_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+
+    // Configurations
+    double loss_;
+    double burstEnter_;
+    double burstExit_;
+    double burstLoss_;
+    double duplicate_;
+    double reorder_;
+    std::chrono::microseconds reorderGap_;
+    std::chrono::microseconds delay_;
+    std::chrono::microseconds jitter_;
+    uint64_t bandwidth_;
+    uint32_t queueDepth_;
+    uint64_t seed_;
+
+    // Random state
+    std::mt19937_64 rng_;
+    bool burstBad_;
+
+    // Delay line
+    std::priority_queue<Entry, std::vector<Entry>, EntryLater> line_;
+    uint64_t seq_;
+    Clock::time_point lastRelease_;
+
+    // Serialization finish times of frames held by the bandwidth limiter
+    std::deque<Clock::time_point> wire_;
+    Clock::time_point wireFree_;
+
+    // Counters
+    uint64_t rxCount_;
+    uint64_t txCount_;
+    uint64_t lossCount_;
+    uint64_t overflowCount_;
+    uint64_t dupCount_;
+    uint64_t reorderCount_;
+
+    // Uniform draw in [0, 1), identical on every platform
+    double draw();
+
+    // Check a probability argument
+    static void checkProb(const char* src, double prob);
+
+    // Copy a frame for the delay line
+    std::shared_ptr<rogue::interfaces::stream::Frame> copy(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    //! \cond INTERNAL
+  protected:
+    std::atomic<bool> threadEn_{false};
+    std::thread* thread_ = nullptr;
+    //! \endcond
+
+  private:
+    // Thread background
+    void runThread();
+
+  public:
+    /**
+     * @brief Creates a link emulator.
+     *
+     * @details
+     * Exposed as `rogue.interfaces.stream.LinkEmulator()` in Python.
+     *
+     * This static factory is the preferred construction path when the object
+     * is shared across Rogue graph connections or exposed to Python.
+     * It returns `std::shared_ptr` ownership compatible with Rogue pointer typedefs.
+     *
+     * @return Shared pointer to the created link emulator.
+     */
+    static std::shared_ptr<rogue::interfaces::stream::LinkEmulator> create();
+
+    /** @brief Registers this type with Python bindings. */
+    static void setup_python();
+
+    /**
+     * @brief Constructs a link emulator with all impairments disabled.
+     *
+     * @details
+     * This constructor is a low-level C++ allocation path.
+     * Prefer `create()` when shared ownership or Python exposure is required.
+     */
+    LinkEmulator();
+
+    /** @brief Destroys the emulator and stops internal worker thread. */
+    ~LinkEmulator();
+
+    /**
+     * @brief Sets the random seed and resets the random state.
+     *
+     * @details
+     * Also returns the burst model to the good state.
+     *
+     * @param seed Seed for the random generator.
+     */
+    void setSeed(uint64_t seed);
+
+    /** @brief Returns the random seed. */
+    uint64_t getSeed();
+
+    /**
+     * @brief Sets the independent random loss probability.
+     *
+     * @details
+     * With the burst model enabled this is the loss probability of the good state.
+     *
+     * @param prob Loss probability in `[0, 1]`.
+     */
+    void setLoss(double prob);
+
+    /** @brief Returns the random loss probability. */
+    double getLoss();
+
+    /**
+     * @brief Configures the Gilbert-Elliott burst loss model.
+     *
+     * @details
+     * Before each frame the model moves from the good to the bad state with
+     * probability `enter` and from the bad to the good state with probability
+     * `exit`. Frames are lost with probability `loss` in the bad state. The
+     * mean burst length is `1 / exit` frames. Set `enter` to 0 to disable.
+     *
+     * @param enter Good to bad transition probability.
+     * @param exit Bad to good transition probability.
+     * @param loss Loss probability in the bad state.
+     */
+    void setBurstLoss(double enter, double exit, double loss);
+
+    /** @brief Returns the good to bad transition probability. */
+    double getBurstEnter();
+
+    /** @brief Returns the bad to good transition probability. */
+    double getBurstExit();
+
+    /** @brief Returns the loss probability in the bad state. */
+    double getBurstLoss();
+
+    /**
+     * @brief Sets the duplication probability.
+     * @param prob Probability in `[0, 1]` that a forwarded frame is sent twice.
+     */
+    void setDuplicate(double prob);
+
+    /** @brief Returns the duplication probability. */
+    double getDuplicate();
+
+    /**
+     * @brief Configures reordering.
+     *
+     * @details
+     * Selected frames are held for an extra `gap` microseconds, letting
+     * frames that arrive during the gap overtake them.
+     *
+     * @param prob Probability in `[0, 1]` that a frame is held back.
+     * @param gap Extra hold time in microseconds.
+     */
+    void setReorder(double prob, uint32_t gap);
+
+    /** @brief Returns the reorder probability. */
+    double getReorder();
+
+    /** @brief Returns the reorder gap in microseconds. */
+    uint32_t getReorderGap();
+
+    /**
+     * @brief Sets the propagation delay.
+     * @param delay Fixed delay in microseconds.
+     * @param jitter Maximum jitter in microseconds, applied uniformly around `delay`.
+     */
+    void setDelay(uint32_t delay, uint32_t jitter);
+
+    /** @brief Returns the fixed delay in microseconds. */
+    uint32_t getDelay();
+
+    /** @brief Returns the maximum jitter in microseconds. */
+    uint32_t getJitter();
+
+    /**
+     * @brief Sets the link bandwidth.
+     * @param rate Payload bytes per second. `0` disables the limit.
+     */
+    void setBandwidth(uint64_t rate);
+
+    /** @brief Returns the link bandwidth in bytes per second. */
+    uint64_t getBandwidth();
+
+    /**
+     * @brief Sets the bandwidth limiter queue depth.
+     *
+     * @details
+     * Frames that arrive while `depth` frames are still waiting to be
+     * serialized are dropped and counted as overflows. Only applies when a
+     * bandwidth limit is set.
+     *
+     * @param depth Queue depth in frames. `0` disables the limit.
+     */
+    void setQueueDepth(uint32_t depth);
+
+    /** @brief Returns the bandwidth limiter queue depth. */
+    uint32_t getQueueDepth();
+
+    /** @brief Returns the number of frames waiting in the delay line. */
+    uint32_t getDepth();
+
+    /** @brief Returns the number of frames accepted. */
+    uint64_t getRxCount();
+
+    /** @brief Returns the number of frames forwarded, including duplicates. */
+    uint64_t getTxCount();
+
+    /** @brief Returns the number of frames dropped by the loss models. */
+    uint64_t getLossCount();
+
+    /** @brief Returns the number of frames dropped by the queue depth limit. */
+    uint64_t getOverflowCount();
+
+    /** @brief Returns the number of duplicated frames. */
+    uint64_t getDupCount();
+
+    /** @brief Returns the number of frames held back for reordering. */
+    uint64_t getReorderCount();
+
+    /** @brief Clears all counters. */
+    void clearCnt();
+
+    /**
+     * @brief Receives a frame from upstream and schedules or drops it.
+     *
+     * @param frame Incoming frame.
+     */
+    void acceptFrame(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+};
+
+/** @brief Shared pointer alias for `LinkEmulator`. */
+typedef std::shared_ptr<rogue::interfaces::stream::LinkEmulator> LinkEmulatorPtr;
+}  // namespace stream
+}  // namespace interfaces
+}  // namespace rogue
+#endif
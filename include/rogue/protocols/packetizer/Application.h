@@ -26,6 +26,7 @@
 #include "rogue/Queue.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
+#include "rogue/protocols/packetizer/WorkerPool.h"
 
 namespace rogue {
 namespace protocols {
@@ -38,6 +39,13 @@ class Controller;
  *
  * @details
  * Provides per-destination stream ingress/egress into the packetizer stack.
+ *
+ * Received frames are delivered downstream according to the dispatch mode:
+ * - `DispatchThread` (default): a dedicated thread and queue per endpoint.
+ * - `DispatchPool`: a shared `WorkerPool`, ordered per destination.
+ * - `DispatchInline`: directly on the thread that called `pushFrame()`,
+ *   normally the transport receive thread. Downstream slaves then block the
+ *   transport path and should return quickly.
  */
 class Application : public rogue::interfaces::stream::Master, public rogue::interfaces::stream::Slave {
     // Core module
@@ -46,6 +54,10 @@ class Application : public rogue::interfaces::stream::Master, public rogue::inte
     // ID
     uint8_t id_;
 
+    // Delivery mode and optional shared pool
+    uint8_t dispatch_;
+    std::shared_ptr<rogue::protocols::packetizer::WorkerPool> pool_;
+
     //! \cond INTERNAL
   protected:
     std::unique_ptr<std::thread> thread_;
@@ -92,8 +104,24 @@ class Application : public rogue::interfaces::stream::Master, public rogue::inte
     /** @brief Destroys the application endpoint. */
     ~Application();
 
+    /**
+     * @brief Selects how received frames are delivered downstream.
+     *
+     * @details
+     * Must be called before `setController()`; later calls are ignored.
+     *
+     * @param mode `DispatchThread`, `DispatchPool` or `DispatchInline`.
+     * @param pool Shared pool used when `mode` is `DispatchPool`.
+     */
+    void setDispatch(uint8_t mode, std::shared_ptr<rogue::protocols::packetizer::WorkerPool> pool);
+
     /**
      * @brief Attaches the packetizer controller.
+     *
+     * @details
+     * Starts the endpoint delivery thread when the dispatch mode is
+     * `DispatchThread`.
+     *
      * @param cntl Controller instance that handles packetizer state.
      */
     void setController(std::shared_ptr<rogue::protocols::packetizer::Controller> cntl);
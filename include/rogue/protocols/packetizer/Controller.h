@@ -21,10 +21,14 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "rogue/Logging.h"
-#include "rogue/Queue.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -42,6 +46,14 @@ class Header;
  * @details
  * Shared controller logic for packetizer variants that route data between
  * one transport endpoint and multiple application endpoints.
+ *
+ * Outbound segments are held in one queue per destination and handed to the
+ * transport by a deficit round-robin scheduler. Each destination receives
+ * `weight * 8192` bytes of transmit credit per round, so a large frame on one
+ * destination no longer delays small frames on the others for its full
+ * duration. Variants whose receivers can reassemble interleaved destinations
+ * (v2) are scheduled per segment; otherwise (v1) a destination keeps the link
+ * until the end of its current frame.
  */
 class Controller {
   protected:
@@ -64,13 +76,55 @@ class Controller {
 
     std::shared_ptr<rogue::interfaces::stream::Frame> tranFrame_[256];
 
+    // Contiguous reassembly state, protected by tranMtx_
+    uint32_t rxSize_;
+    bool rxChain_[256];
+    std::atomic<uint32_t> rxOverflow_;
+    std::shared_ptr<rogue::interfaces::stream::Pool> rxPool_;
+
+    // Start a new reassembly frame for an index
+    void rxStart(uint32_t idx);
+
+    // Add a received segment to the reassembly frame for an index
+    void rxAppend(uint32_t idx, std::shared_ptr<rogue::interfaces::stream::Buffer> buff);
+
     std::mutex appMtx_;
     std::mutex tranMtx_;
 
     std::shared_ptr<rogue::protocols::packetizer::Transport> tran_;
     std::shared_ptr<rogue::protocols::packetizer::Application>* app_;
 
-    rogue::Queue<std::shared_ptr<rogue::interfaces::stream::Frame>> tranQueue_;
+    // Transmit scheduler entry, one per transport segment
+    struct TxEntry {
+        std::shared_ptr<rogue::interfaces::stream::Frame> frame;
+        uint32_t size;
+        bool eof;
+        std::chrono::steady_clock::time_point time;
+    };
+
+    // Transmit scheduler state, protected by txMtx_
+    bool txInterleave_;
+    bool txRun_;
+    bool txVisit_;
+    bool txLocked_;
+    std::deque<TxEntry> txQueue_[256];
+    std::deque<uint8_t> txActive_;
+    uint32_t txWeight_[256];
+    uint32_t txLimit_[256];
+    uint64_t txDeficit_[256];
+    uint64_t txFrames_[256];
+    double txDelaySum_[256];
+    double txDelayMax_[256];
+
+    std::mutex txMtx_;
+    std::condition_variable txCond_;
+    std::condition_variable txSpace_;
+
+    // Wait for room in a destination queue, returns false when stopped
+    bool txWait(uint8_t dest, const char* name);
+
+    // Queue the segments of one frame for a destination
+    void txPush(uint8_t dest, std::vector<std::shared_ptr<rogue::interfaces::stream::Frame>>& segments);
 
   public:
     /**
@@ -81,13 +135,16 @@ class Controller {
      * @param tailSize Trailer bytes inserted per packet.
      * @param alignSize Payload alignment requirement in bytes.
      * @param enSsi Enable SSI framing behavior.
+     * @param interleave True when segments from different destinations may be
+     *        interleaved on the link.
      */
     Controller(std::shared_ptr<rogue::protocols::packetizer::Transport> tran,
                std::shared_ptr<rogue::protocols::packetizer::Application>* app,
                uint32_t headSize,
                uint32_t tailSize,
                uint32_t alignSize,
-               bool enSsi);
+               bool enSsi,
+               bool interleave);
 
     /** @brief Destroys the packetizer controller base. */
     ~Controller();
@@ -105,7 +162,7 @@ class Controller {
      */
     virtual void transportRx(std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 
-    /** @brief Stops the internal transmit queue. */
+    /** @brief Stops the internal transmit queues. */
     void stopQueue();
 
     /** @brief Stops controller processing. */
@@ -113,7 +170,11 @@ class Controller {
 
     /**
      * @brief Returns the next frame for transport transmission.
-     * @return Frame ready for transport transmit, or null when none is available.
+     * @details
+     * Blocks until a segment is available and selects the destination using
+     * deficit round-robin.
+     *
+     * @return Frame ready for transport transmit, or null when stopped.
      */
     std::shared_ptr<rogue::interfaces::stream::Frame> transportTx();
 
@@ -135,6 +196,88 @@ class Controller {
      * @param timeout Timeout value in microseconds.
      */
     void setTimeout(uint32_t timeout);
+
+    /**
+     * @brief Sets the transmit scheduling weight of a destination.
+     *
+     * @details
+     * A destination with weight `w` may send up to `w * 8192` bytes per
+     * scheduler round. The default weight is 1.
+     *
+     * @param dest Destination ID.
+     * @param weight Relative weight, must be at least 1.
+     */
+    void setTxWeight(uint8_t dest, uint32_t weight);
+
+    /**
+     * @brief Sets the transmit queue limit of a destination.
+     *
+     * @details
+     * Application frames for `dest` block while its queue holds `limit` or
+     * more segments. Other destinations are not affected. The default is 64.
+     *
+     * @param dest Destination ID.
+     * @param limit Queue depth in segments, must be at least 1.
+     */
+    void setTxLimit(uint8_t dest, uint32_t limit);
+
+    /**
+     * @brief Returns the number of segments queued for a destination.
+     * @param dest Destination ID.
+     * @return Queued segment count.
+     */
+    uint32_t getTxDepth(uint8_t dest);
+
+    /**
+     * @brief Returns the number of frames transmitted for a destination.
+     * @param dest Destination ID.
+     * @return Frames sent since the last `resetTxStats()`.
+     */
+    uint64_t getTxFrameCount(uint8_t dest);
+
+    /**
+     * @brief Returns mean queueing delay for a destination.
+     *
+     * @details
+     * Delay is measured from frame acceptance to the transmit of its last
+     * segment.
+     *
+     * @param dest Destination ID.
+     * @return Mean delay in microseconds.
+     */
+    double getTxDelayMean(uint8_t dest);
+
+    /**
+     * @brief Returns maximum queueing delay for a destination.
+     * @param dest Destination ID.
+     * @return Maximum delay in microseconds.
+     */
+    double getTxDelayMax(uint8_t dest);
+
+    /** @brief Clears per-destination transmit statistics. */
+    void resetTxStats();
+
+    /**
+     * @brief Enables contiguous receive reassembly.
+     *
+     * @details
+     * By default each inbound segment buffer is chained onto the reassembled
+     * frame, so large frames arrive downstream as many buffers. With a
+     * non-zero `size`, each new frame is drawn as a single `size` byte buffer
+     * from an internal pool and segment payloads are copied into it as they
+     * arrive. Frames that outgrow the buffer fall back to chaining for the
+     * remaining segments and are counted by `getRxOverflowCount()`.
+     *
+     * @param size Reassembly buffer size in bytes, 0 disables.
+     * @param depth Number of free buffers the pool retains for reuse.
+     */
+    void setRxContiguous(uint32_t size, uint32_t depth);
+
+    /**
+     * @brief Returns the number of frames that overflowed the reassembly buffer.
+     * @return Overflow count.
+     */
+    uint32_t getRxOverflowCount();
 };
 
 // Convenience
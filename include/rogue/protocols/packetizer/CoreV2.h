@@ -29,6 +29,7 @@ namespace packetizer {
 
 class Transport;
 class Application;
+class WorkerPool;
 class ControllerV2;
 
 /**
@@ -45,6 +46,10 @@ class CoreV2 {
     // Application modules
     std::shared_ptr<rogue::protocols::packetizer::Application> app_[256];
 
+    // Application dispatch mode and shared pool
+    uint8_t dispatch_;
+    std::shared_ptr<rogue::protocols::packetizer::WorkerPool> pool_;
+
     // Core module
     std::shared_ptr<rogue::protocols::packetizer::ControllerV2> cntl_;
 
@@ -98,6 +103,22 @@ class CoreV2 {
      */
     std::shared_ptr<rogue::protocols::packetizer::Application> application(uint8_t dest);
 
+    /**
+     * @brief Selects how application endpoints deliver received frames.
+     *
+     * @details
+     * `DispatchThread` (default) gives each endpoint its own thread.
+     * `DispatchPool` shares `workers` threads across all endpoints, with
+     * frames for one destination always handled by the same worker so order
+     * is preserved. `DispatchInline` delivers on the transport receive thread
+     * for the lowest latency. Must be called before the first
+     * `application()` call.
+     *
+     * @param mode `DispatchThread`, `DispatchPool` or `DispatchInline`.
+     * @param workers Worker thread count for `DispatchPool`, ignored otherwise.
+     */
+    void setDispatch(uint8_t mode, uint32_t workers);
+
     /**
      * @brief Returns total dropped-frame count reported by the controller.
      * @return Number of dropped frames.
@@ -109,6 +130,76 @@ class CoreV2 {
      * @param timeout Timeout in microseconds.
      */
     void setTimeout(uint32_t timeout);
+
+    /**
+     * @brief Sets the transmit scheduling weight of a destination.
+     *
+     * @details
+     * Outbound frames are scheduled across destinations with deficit
+     * round-robin. A destination with weight `w` may send up to `w * 8192`
+     * bytes per round. The default weight is 1.
+     *
+     * @param dest Destination ID.
+     * @param weight Relative weight, must be at least 1.
+     */
+    void setTxWeight(uint8_t dest, uint32_t weight);
+
+    /**
+     * @brief Sets the transmit queue limit of a destination.
+     * @param dest Destination ID.
+     * @param limit Queue depth in segments, must be at least 1.
+     */
+    void setTxLimit(uint8_t dest, uint32_t limit);
+
+    /**
+     * @brief Returns the number of segments queued for a destination.
+     * @param dest Destination ID.
+     * @return Queued segment count.
+     */
+    uint32_t getTxDepth(uint8_t dest);
+
+    /**
+     * @brief Returns the number of frames transmitted for a destination.
+     * @param dest Destination ID.
+     * @return Frames sent since the last `resetTxStats()`.
+     */
+    uint64_t getTxFrameCount(uint8_t dest);
+
+    /**
+     * @brief Returns mean transmit queueing delay for a destination.
+     * @param dest Destination ID.
+     * @return Mean delay in microseconds.
+     */
+    double getTxDelayMean(uint8_t dest);
+
+    /**
+     * @brief Returns maximum transmit queueing delay for a destination.
+     * @param dest Destination ID.
+     * @return Maximum delay in microseconds.
+     */
+    double getTxDelayMax(uint8_t dest);
+
+    /** @brief Clears per-destination transmit statistics. */
+    void resetTxStats();
+
+    /**
+     * @brief Enables contiguous receive reassembly.
+     *
+     * @details
+     * With a non-zero `size`, each received frame is reassembled into a single
+     * pre-sized buffer from an internal pool, so downstream consumers see one
+     * buffer per frame. Frames larger than `size` fall back to buffer chaining.
+     *
+     * @param size Reassembly buffer size in bytes, 0 disables.
+     * @param depth Number of free buffers the pool retains for reuse.
+     */
+    void setRxContiguous(uint32_t size, uint32_t depth);
+
+    /**
+     * @brief Returns the number of frames that overflowed the reassembly buffer.
+     * @return Overflow count.
+     */
+    uint32_t getRxOverflowCount();
 };
 
 // Convenience
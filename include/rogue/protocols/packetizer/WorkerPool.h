@@ -0,0 +1,127 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Packetizer Shared Application Worker Pool
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_PROTOCOLS_PACKETIZER_WORKER_POOL_H__
+#define __ROGUE_PROTOCOLS_PACKETIZER_WORKER_POOL_H__
+#include "rogue/Directives.h"
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "rogue/Queue.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+
+namespace rogue {
+namespace protocols {
+namespace packetizer {
+
+/** @brief Each application endpoint delivers frames from its own thread (default). */
+const uint8_t DispatchThread = 0;
+
+/** @brief Application endpoints share a destination-hashed worker pool. */
+const uint8_t DispatchPool = 1;
+
+/** @brief Application endpoints deliver frames on the transport receive thread. */
+const uint8_t DispatchInline = 2;
+
+/**
+ * @brief Shared delivery threads for packetizer application endpoints.
+ *
+ * @details
+ * A pool owns a fixed number of lanes, each with one thread and one bounded
+ * queue. Frames for destination `dest` always use lane `dest % count`, so
+ * frames for one destination are delivered in order while different
+ * destinations proceed in parallel. A full lane blocks the pushing thread,
+ * which gives the same backpressure as a per-application queue.
+ */
+class WorkerPool {
+    // Queued delivery: source endpoint and frame
+    typedef std::pair<std::shared_ptr<rogue::interfaces::stream::Master>,
+                      std::shared_ptr<rogue::interfaces::stream::Frame>>
+        Entry;
+
+    // One worker thread and its queue
+    struct Lane {
+        rogue::Queue<Entry> queue;
+        std::unique_ptr<std::thread> thread;
+    };
+
+    std::vector<std::unique_ptr<Lane>> lanes_;
+    std::atomic<bool> threadEn_{false};
+
+    // Worker thread body
+    void runThread(Lane* lane);
+
+  public:
+    /**
+     * @brief Creates a worker pool.
+     *
+     * @details
+     * Parameter semantics are identical to the constructor.
+     *
+     * @param count Number of worker lanes, at least 1.
+     * @return Shared pointer to the created pool.
+     */
+    static std::shared_ptr<rogue::protocols::packetizer::WorkerPool> create(uint32_t count);
+
+    /**
+     * @brief Constructs a worker pool and starts its threads.
+     * @param count Number of worker lanes, at least 1.
+     */
+    explicit WorkerPool(uint32_t count);
+
+    /** @brief Stops and joins all worker threads. */
+    ~WorkerPool();
+
+    /**
+     * @brief Stops the worker threads and discards queued frames.
+     *
+     * @details
+     * Safe to call more than once.
+     */
+    void stop();
+
+    /**
+     * @brief Returns the number of worker lanes.
+     * @return Lane count.
+     */
+    uint32_t count();
+
+    /**
+     * @brief Queues a frame for delivery by `src->sendFrame()`.
+     * @param dest Destination ID used to select the lane.
+     * @param src Endpoint that forwards the frame to its slaves.
+     * @param frame Frame to deliver.
+     */
+    void push(uint8_t dest,
+              std::shared_ptr<rogue::interfaces::stream::Master> src,
+              std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+};
+
+// Convenience
+typedef std::shared_ptr<rogue::protocols::packetizer::WorkerPool> WorkerPoolPtr;
+
+}  // namespace packetizer
+}  // namespace protocols
+};  // namespace rogue
+
+#endif
@@ -203,6 +203,41 @@ class Client {
     /** @brief Resets runtime counters. */
     void resetCounters();
 
+    /**
+     * @brief Enables or disables adaptive retransmission timeouts.
+     * @param enable True to estimate the retransmit timeout from round trip times.
+     */
+    void setAdaptiveRetran(bool enable);
+    /** @brief Returns whether adaptive retransmission is enabled. */
+    bool getAdaptiveRetran();
+    /** @brief Returns the smoothed round trip time in microseconds. */
+    uint32_t getRttMean();
+    /** @brief Returns the round trip time variation in microseconds. */
+    uint32_t getRttVar();
+    /** @brief Returns the retransmit timeout applied to new segments in microseconds. */
+    uint32_t getRetranTimeout();
+    /** @brief Returns the count of retransmits caused by timer expiry. */
+    uint32_t getRetranToutCount();
+    /** @brief Returns the count of retransmits caused by duplicate ACKs. */
+    uint32_t getRetranFastCount();
+
+    /** @brief Sets the transmit pacing rate in bytes per second, 0 disables pacing. */
+    void setTxPacingRate(uint64_t rate);
+    /** @brief Returns the configured transmit pacing rate in bytes per second. */
+    uint64_t getTxPacingRate();
+    /** @brief Sets the transmit pacing burst size in bytes. */
+    void setTxPacingBurst(uint32_t burst);
+    /** @brief Returns the transmit pacing burst size in bytes. */
+    uint32_t getTxPacingBurst();
+    /** @brief Enables automatic pacing back off on retransmit bursts. */
+    void setTxPacingAuto(bool enable);
+    /** @brief Returns whether automatic pacing back off is enabled. */
+    bool getTxPacingAuto();
+    /** @brief Returns the pacing rate currently applied in bytes per second. */
+    uint64_t getTxPacingActiveRate();
+    /** @brief Returns the count of segments that waited for pacing tokens. */
+    uint32_t getTxPacedCount();
+
     /**
      * @brief Sets timeout in microseconds for frame transmits.
      * @param timeout Timeout in microseconds.
@@ -21,12 +21,16 @@
 #include <stdint.h>
 
 #include <atomic>
-#include <map>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "rogue/EnableSharedFromThis.h"
 #include "rogue/Logging.h"
 #include "rogue/Queue.h"
+#include "rogue/TimerWheel.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/Slave.h"
 
@@ -37,6 +41,7 @@ namespace rssi {
 class Application;
 class Transport;
 class Header;
+class HeaderPool;
 
 /**
  * @brief RSSI protocol controller.
@@ -60,11 +65,21 @@ class Header;
  * Operationally, frames received from `Transport` are decoded and processed for
  * ACK/SYN/state transitions and delivery, while `Application` frames are
  * segmented/tracked for reliable delivery according to negotiated parameters.
+ *
+ * All protocol timers (per-segment retransmit, cumulative ACK, NULL keepalive
+ * and connection retry) are deadlines on a `rogue::TimerWheel` driven by the
+ * monotonic clock. The background thread sleeps until the earliest deadline or
+ * until a frame event needs attention, so an idle link only wakes for its
+ * keepalive traffic.
  */
 class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Controller> {
     // Hard coded values
     static const uint8_t Version     = 1;
     static const uint8_t TimeoutUnit = 3;  // rssiTime * std::pow(10,-TimeoutUnit) = 3 = ms
+    static const uint8_t DupAckThold = 3;  // Duplicate acks before a fast retransmit
+
+    // Pending retransmit reasons
+    enum RetranReason : uint8_t { RetranNone = 0, RetranTimer = 1, RetranFast = 2 };
 
     // Local parameters
     uint32_t locTryPeriod_;
@@ -106,11 +121,16 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     std::atomic<bool> remBusy_;
     std::atomic<bool> locBusy_;
 
+    // Recycled header storage for this link
+    std::shared_ptr<rogue::protocols::rssi::HeaderPool> headerPool_;
+
     // Application queue
     rogue::Queue<std::shared_ptr<rogue::protocols::rssi::Header>> appQueue_;
 
-    // Sequence Out of Order ("OOO") queue
-    std::map<uint8_t, std::shared_ptr<rogue::protocols::rssi::Header>> oooQueue_;
+    // Sequence Out of Order ("OOO") buffer, indexed by sequence number with an occupancy bitmap
+    std::shared_ptr<rogue::protocols::rssi::Header> oooQueue_[256];
+    uint64_t oooMask_[4];
+    uint32_t oooCount_;
 
     // State queue
     rogue::Queue<std::shared_ptr<rogue::protocols::rssi::Header>> stQueue_;
@@ -122,8 +142,9 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     // State Tracking
     std::condition_variable stCond_;
     std::mutex stMtx_;
+    bool stEvent_;
     uint32_t state_;
-    struct timeval stTime_;
+    rogue::TimerWheel::Clock::time_point stTime_;
     std::atomic<uint32_t> downCount_;
     std::atomic<uint32_t> retranCount_;
     std::atomic<uint32_t> locBusyCnt_;
@@ -137,16 +158,49 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     uint8_t txListCount_;
     uint8_t lastAckTx_;
     uint8_t locSequence_;
-    struct timeval txTime_;
+    rogue::TimerWheel::Clock::time_point txTime_;
+    std::condition_variable txCond_;
+
+    // Protocol timers, protected by txMtx_
+    rogue::TimerWheel wheel_;
+    rogue::TimerWheel::Timer retranTimer_[256];
+    rogue::TimerWheel::Timer nullTimer_;
+    rogue::TimerWheel::Timer ackTimer_;
+    rogue::TimerWheel::Timer stTimer_;
+    uint8_t retranDue_[256];
+    rogue::TimerWheel::Clock::time_point wakeTime_;
+    std::vector<rogue::TimerWheel::Timer*> expired_;
+
+    // Adaptive retransmission, estimates protected by txMtx_
+    std::atomic<bool> adaptive_;
+    rogue::TimerWheel::Clock::time_point txSent_[256];
+    bool rttValid_;
+    std::chrono::microseconds rttMean_;
+    std::chrono::microseconds rttVar_;
+    std::chrono::microseconds rto_;
+    uint8_t dupAckCount_;
+    bool fastDone_;
+    std::atomic<uint32_t> dupAckReq_;
+    std::atomic<uint32_t> retranToutCnt_;
+    std::atomic<uint32_t> retranFastCnt_;
+
+    // Transmit pacing token bucket, protected by paceMtx_
+    std::mutex paceMtx_;
+    std::condition_variable paceCond_;
+    uint64_t paceRate_;
+    uint32_t paceBurst_;
+    bool paceAuto_;
+    double paceActive_;
+    double paceTokens_;
+    rogue::TimerWheel::Clock::time_point paceTime_;
+    rogue::TimerWheel::Clock::time_point paceBackoff_;
+    std::atomic<uint32_t> pacedCount_;
 
     // Time values
-    struct timeval retranToutD1_;  // retranTout_ / 1
-    struct timeval tryPeriodD1_;   // TryPeriod   / 1
-    struct timeval tryPeriodD4_;   // TryPeriod   / 4
-    struct timeval cumAckToutD1_;  // cumAckTout_ / 1
-    struct timeval cumAckToutD2_;  // cumAckTout_ / 2
-    struct timeval nullToutD3_;    // nullTout_   / 3
-    struct timeval zeroTme_;       // 0
+    std::chrono::microseconds retranToutD1_;  // retranTout_ / 1
+    std::chrono::microseconds tryPeriodD1_;   // TryPeriod   / 1
+    std::chrono::microseconds cumAckToutD1_;  // cumAckTout_ / 1
+    std::chrono::microseconds nullToutD3_;    // nullTout_   / 3
 
     //! \cond INTERNAL
   protected:
@@ -404,6 +458,124 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     /** @brief Resets runtime counters. */
     void resetCounters();
 
+    /**
+     * @brief Enables or disables adaptive retransmission timeouts.
+     *
+     * @details
+     * When enabled, the first transmission of each segment uses a retransmit
+     * timeout estimated from measured round trip times (Jacobson smoothing,
+     * with Karn's rule excluding retransmitted segments), clamped between the
+     * negotiated cumulative ACK timeout and the negotiated retransmit timeout.
+     * Retransmissions back off to the negotiated timeout. Out of order
+     * arrivals are answered with immediate duplicate ACKs, and three duplicate
+     * ACKs trigger a fast retransmit of the oldest unacknowledged segment.
+     *
+     * Intended for links where both ends are Rogue endpoints. Disabled by
+     * default, which keeps the fixed negotiated timeout.
+     *
+     * @param enable True to enable adaptive retransmission.
+     */
+    void setAdaptiveRetran(bool enable);
+
+    /**
+     * @brief Returns whether adaptive retransmission is enabled.
+     * @return True when adaptive retransmission is enabled.
+     */
+    bool getAdaptiveRetran();
+
+    /**
+     * @brief Returns the smoothed round trip time estimate.
+     * @return Smoothed RTT in microseconds, or 0 before the first sample.
+     */
+    uint32_t getRttMean();
+
+    /**
+     * @brief Returns the round trip time variation estimate.
+     * @return RTT variation in microseconds, or 0 before the first sample.
+     */
+    uint32_t getRttVar();
+
+    /**
+     * @brief Returns the retransmit timeout applied to new segments.
+     * @return Timeout in microseconds.
+     */
+    uint32_t getRetranTimeout();
+
+    /**
+     * @brief Returns the count of retransmits caused by timer expiry.
+     * @return Number of timeout retransmits.
+     */
+    uint32_t getRetranToutCount();
+
+    /**
+     * @brief Returns the count of retransmits caused by duplicate ACKs.
+     * @return Number of fast retransmits.
+     */
+    uint32_t getRetranFastCount();
+
+    /**
+     * @brief Sets the transmit pacing rate.
+     *
+     * @details
+     * Segments sent to the transport are paced by a token bucket refilled at
+     * this rate and holding at most the burst size. A sender that runs out
+     * of tokens sleeps until enough have accumulated. Retransmissions are
+     * sent without waiting but are charged to the bucket, which slows the
+     * following new segments. Zero disables pacing.
+     *
+     * @param rate Rate in bytes per second, or 0 to disable pacing.
+     */
+    void setTxPacingRate(uint64_t rate);
+
+    /**
+     * @brief Gets the configured transmit pacing rate.
+     * @return Rate in bytes per second, 0 when pacing is disabled.
+     */
+    uint64_t getTxPacingRate();
+
+    /**
+     * @brief Sets the token bucket size for transmit pacing.
+     * @param burst Maximum burst in bytes. Must be non-zero.
+     */
+    void setTxPacingBurst(uint32_t burst);
+
+    /**
+     * @brief Gets the token bucket size for transmit pacing.
+     * @return Maximum burst in bytes.
+     */
+    uint32_t getTxPacingBurst();
+
+    /**
+     * @brief Enables automatic pacing back off.
+     *
+     * @details
+     * When enabled, each burst of retransmissions halves the active pacing
+     * rate, at most once per retransmit timeout and never below 1/64 of the
+     * configured rate. Acknowledged segments raise the active rate back
+     * toward the configured rate. Has no effect while pacing is disabled.
+     *
+     * @param enable True to enable automatic back off.
+     */
+    void setTxPacingAuto(bool enable);
+
+    /**
+     * @brief Returns whether automatic pacing back off is enabled.
+     * @return True when automatic back off is enabled.
+     */
+    bool getTxPacingAuto();
+
+    /**
+     * @brief Returns the pacing rate currently applied.
+     * @return Active rate in bytes per second, 0 when pacing is disabled.
+     */
+    uint64_t getTxPacingActiveRate();
+
+    /**
+     * @brief Returns the count of segments that waited for pacing tokens.
+     * @return Number of paced segment transmits.
+     */
+    uint32_t getTxPacedCount();
+
     /**
      * @brief Sets timeout in microseconds for frame transmits.
      * @param timeout Timeout in microseconds.
@@ -423,29 +595,64 @@ class Controller : public rogue::EnableSharedFromThis<rogue::protocols::rssi::Co
     // Method to retransmit a frame
     int8_t retransmit(uint8_t id);
 
-    /** Convert rssi time to time structure */
-    static void convTime(struct timeval& tme, uint32_t rssiTime);
+    /** Out of order buffer occupancy for a sequence number */
+    bool oooValid(uint8_t seq);
+
+    /** Store a segment in the out of order buffer */
+    void oooInsert(std::shared_ptr<rogue::protocols::rssi::Header> head);
+
+    /** Remove and return a segment from the out of order buffer */
+    std::shared_ptr<rogue::protocols::rssi::Header> oooTake(uint8_t seq);
+
+    /** Empty the out of order buffer */
+    void oooReset();
+
+    /** Add tokens for the time elapsed. Requires paceMtx_ */
+    void paceRefill(rogue::TimerWheel::Clock::time_point now);
 
-    /** Helper function to determine if time has elapsed in current state */
-    static bool timePassed(struct timeval& lastTime, struct timeval& tme);
+    /** Sleep until the bucket holds enough tokens, then take them */
+    void paceWait(uint32_t bytes);
+
+    /** Take tokens without waiting */
+    void paceCharge(uint32_t bytes);
+
+    /** Automatic pacing adjustment after retransmits or acknowledged segments */
+    void paceAdjust(bool backoff, uint32_t acked);
+
+    /** Fold a round trip sample into the estimates. Requires txMtx_ */
+    void rttSample(std::chrono::microseconds rtt);
+
+    /** Convert rssi time to a duration */
+    static std::chrono::microseconds convTime(uint32_t rssiTime);
+
+    /** Arm a timer, waking the thread if it fires before the current sleep ends. Requires txMtx_ */
+    void armTimer(rogue::TimerWheel::Timer* timer, rogue::TimerWheel::Clock::time_point deadline);
+
+    /** Wake the background thread */
+    void notify();
+
+    /** Schedule or request an acknowledge after receive side progress */
+    void ackCheck();
 
     /** Thread background */
     void runThread();
 
+    // State handlers return true when the state machine should run again immediately
+
     /** Closed/Waiting for Syn */
-    struct timeval& stateClosedWait();
+    bool stateClosedWait();
 
     /** Send syn ack */
-    struct timeval& stateSendSynAck();
+    bool stateSendSynAck();
 
     /** Send sequence ack */
-    struct timeval& stateSendSeqAck();
+    bool stateSendSeqAck();
 
     /** Open state */
-    struct timeval& stateOpen();
+    bool stateOpen();
 
     /** Error state */
-    struct timeval& stateError();
+    bool stateError();
 };
 
 // Convenience
@@ -19,9 +19,13 @@
 #include "rogue/Directives.h"
 
 #include <stdint.h>
+#include <sys/time.h>
 
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "rogue/interfaces/stream/Frame.h"
 
@@ -29,6 +33,56 @@ namespace rogue {
 namespace protocols {
 namespace rssi {
 
+/**
+ * @brief Free list of recycled RSSI header blocks.
+ *
+ * @details
+ * Each block holds a header and its shared pointer control block. Every
+ * `Controller` owns its own pool, so separate links never contend on it.
+ * Blocks stay in the pool until it is destroyed, which happens once the
+ * owning controller and all headers created from the pool are released.
+ */
+class HeaderPool {
+    // Lock for the free list
+    std::mutex mtx_;
+
+    // Released blocks
+    std::vector<void*> free_;
+
+    // Block size, set by the first request
+    std::size_t size_;
+
+  public:
+    /**
+     * @brief Creates an empty header pool.
+     * @return Shared pointer to the created pool.
+     */
+    static std::shared_ptr<rogue::protocols::rssi::HeaderPool> create();
+
+    /** @brief Constructs an empty header pool. */
+    HeaderPool();
+
+    /** @brief Frees the blocks held by the pool. */
+    ~HeaderPool();
+
+    /**
+     * @brief Takes a block from the pool, or from the heap when it is empty.
+     * @param size Block size in bytes.
+     * @return Pointer to the block.
+     */
+    void* get(std::size_t size);
+
+    /**
+     * @brief Returns a block to the pool.
+     * @param ptr Block pointer.
+     * @param size Block size in bytes.
+     */
+    void put(void* ptr, std::size_t size);
+};
+
+// Convienence
+typedef std::shared_ptr<rogue::protocols::rssi::HeaderPool> HeaderPoolPtr;
+
 /**
  * @brief RSSI header container and codec.
  *
@@ -42,6 +96,14 @@ namespace rssi {
  *   checksum/size.
  * - `update()` writes members back to frame bytes and updates checksum.
  * - SYN-only fields are meaningful when `syn == true`.
+ *
+ * Headers are created once per RSSI segment on both transmit and receive.
+ * `create()` with a `HeaderPool` places each header and its shared pointer
+ * control block in a recycled block, so once the link has reached its
+ * working set no further heap allocation is made for headers. Frames and
+ * their buffers are not covered, they come from the stream pools.
+ * `getHeapBlockCount()` reports how many header blocks have been taken from
+ * the heap.
  */
 class Header {
   private:
@@ -63,7 +125,7 @@ class Header {
     // Underlying frame carrying RSSI header bytes.
     std::shared_ptr<rogue::interfaces::stream::Frame> frame_;
 
-    // Last transmit/update timestamp.
+    // Timestamp set by rstTime().
     struct timeval time_;
 
     // Number of times update() has been called.
@@ -92,6 +154,33 @@ class Header {
     static std::shared_ptr<rogue::protocols::rssi::Header> create(
         std::shared_ptr<rogue::interfaces::stream::Frame> frame);
 
+    /**
+     * @brief Creates a header wrapper in a block recycled through a pool.
+     *
+     * @details
+     * The header holds a reference to the pool, so its block is returned
+     * there even if the owner of the pool has been released.
+     *
+     * @param pool Pool providing the block.
+     * @param frame Frame containing RSSI header bytes.
+     * @return Shared pointer to the created header wrapper.
+     */
+    static std::shared_ptr<rogue::protocols::rssi::Header> create(
+        std::shared_ptr<rogue::protocols::rssi::HeaderPool> pool,
+        std::shared_ptr<rogue::interfaces::stream::Frame> frame);
+
+    /**
+     * @brief Returns the number of header blocks taken from the heap.
+     *
+     * @details
+     * Counts blocks taken by all pools. Blocks are recycled when headers are
+     * released, so this count stops growing once the number of headers alive
+     * at once on each link reaches its peak.
+     *
+     * @return Heap allocations made for pooled headers since process start.
+     */
+    static uint64_t getHeapBlockCount();
+
     /**
      * @brief Constructs a header wrapper for an existing frame.
      *
@@ -122,7 +211,13 @@ class Header {
     void update();
 
     /**
-     * @brief Returns the last transmit timestamp.
+     * @brief Returns the header timestamp.
+     *
+     * @details
+     * The timestamp is set by `rstTime()` and is zero until then. `update()`
+     * does not read the clock, so callers which time transmissions call
+     * `rstTime()` when the header is sent.
+     *
      * @return Reference to timestamp associated with this header.
      */
     struct timeval& getTime();
@@ -133,7 +228,7 @@ class Header {
      */
     uint32_t count();
 
-    /** @brief Resets transmit timestamp to the current time. */
+    /** @brief Resets the header timestamp to the current time. */
     void rstTime();
 
     /**
@@ -28,6 +28,7 @@
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 #include "rogue/Logging.h"
 
@@ -49,6 +50,9 @@ const uint32_t MaxJumboPayload = JumboMTU - HdrSize;
 /** @brief Maximum UDP payload for standard MTU (`1500 - 28 = 1472` bytes). */
 const uint32_t MaxStdPayload   = StdMTU - HdrSize;
 
+/** @brief Maximum number of datagrams moved per batched socket call. */
+const uint32_t MaxBatchSize = 1024;
+
 /**
  * @brief Shared UDP transport base for stream client/server endpoints.
  *
@@ -60,6 +64,11 @@ const uint32_t MaxStdPayload   = StdMTU - HdrSize;
  *
  * Concrete data-path behavior (background receive thread, stream callbacks, and
  * socket lifecycle) is implemented by `udp::Client` and `udp::Server`.
+ *
+ * When the batch size is set above 1 on Linux, both endpoints move datagrams
+ * with `recvmmsg()`/`sendmmsg()` so that a burst of packets costs a single
+ * system call in each direction. Platforms without these calls, or kernels
+ * that reject them, fall back to the single-datagram path.
  */
 class Core {
   protected:
@@ -83,6 +92,21 @@ class Core {
     // Synchronizes shared socket/address updates in derived classes.
     std::mutex udpMtx_;
 
+    // Datagrams per recvmmsg()/sendmmsg() call, 1 selects the legacy path.
+    std::atomic<uint32_t> batchSize_{1};
+
+#ifndef __MACH__
+    // Transmit message headers reused across acceptFrame() calls, guarded by udpMtx_.
+    std::vector<struct iovec> txIov_;
+    std::vector<struct mmsghdr> txMsg_;
+
+    // Transmits the prepared txMsg_ entries in as few sendmmsg() calls as possible.
+    void sendBatch(uint32_t count, const char* name);
+#endif
+
+    // Disables batching after the kernel rejected a batched call.
+    void batchFailed(const char* call);
+
   public:
     /** @brief Registers Python bindings for this class. */
     static void setup_python();
@@ -139,6 +163,30 @@ class Core {
      * @param timeout Timeout in microseconds.
      */
     void setTimeout(uint32_t timeout);
+
+    /**
+     * @brief Sets the number of datagrams moved per batched socket call.
+     *
+     * @details
+     * A value of 1 (the default) keeps the single-datagram `recvfrom()` /
+     * `sendmsg()` path. Larger values enable `recvmmsg()` / `sendmmsg()`
+     * batching on Linux, limited to `MaxBatchSize`. The value is forced to 1
+     * on platforms without batched socket calls.
+     *
+     * @param size Maximum datagrams per receive or transmit call.
+     */
+    void setBatchSize(uint32_t size);
+
+    /**
+     * @brief Returns the active datagram batch size.
+     *
+     * @details
+     * Returns 1 when batching is disabled or was disabled after the kernel
+     * rejected a batched call.
+     *
+     * @return Datagrams per batched socket call.
+     */
+    uint32_t getBatchSize();
 };
 
 // Convenience
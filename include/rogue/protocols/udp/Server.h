@@ -60,6 +60,9 @@ class Server : public rogue::protocols::udp::Core,
     // Background receive thread entry point.
     void runThread(std::weak_ptr<int>);
 
+    // Updates the transmit peer from the source of a received datagram.
+    void updatePeer(const struct sockaddr_in& addr);
+
   public:
     /**
      * @brief Creates a UDP server endpoint.
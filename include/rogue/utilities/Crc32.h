@@ -0,0 +1,85 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description :
+ *    Accelerated CRC-32 engine
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#ifndef __ROGUE_UTILITIES_CRC32_H__
+#define __ROGUE_UTILITIES_CRC32_H__
+#include "rogue/Directives.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace rogue {
+namespace utilities {
+
+/**
+ * @brief Runtime-dispatched CRC-32 (IEEE 802.3) engine.
+ *
+ * @details
+ * Computes the reflected CRC-32 with polynomial `0x04C11DB7`, initial value
+ * `0xFFFFFFFF` and final XOR `0xFFFFFFFF`. This is the CRC used by the
+ * packetizer V2 firmware, zlib and Ethernet, and it matches
+ * `CRC::Calculate(data, size, CRC::CRC_32())` from the bundled CRC++ header.
+ *
+ * The engine is selected once at first use:
+ * - x86-64 with PCLMULQDQ/SSE4.1: carry-less multiply folding, 64 bytes per step.
+ * - AArch64 with the CRC32 extension: `crc32x` instruction, 8 bytes per step.
+ * - Otherwise: portable slice-by-16 table lookup.
+ *
+ * All engines are bit-exact with each other. Inputs may have any alignment
+ * and length.
+ */
+class Crc32 {
+  public:
+    /**
+     * @brief Computes or continues a CRC-32.
+     *
+     * @details
+     * Passing the result of a previous call as `crc` continues the checksum
+     * over concatenated data, so a buffer may be checksummed in pieces. The
+     * default of 0 starts a new checksum.
+     *
+     * @param data Input bytes.
+     * @param size Number of bytes to process.
+     * @param crc CRC returned by the previous call, or 0 to start.
+     * @return CRC-32 of all data processed so far.
+     */
+    static uint32_t calculate(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+    /**
+     * @brief Computes or continues a CRC-32 using the portable slice-by-16 path.
+     *
+     * @details
+     * Same semantics as `calculate()` without hardware dispatch. Intended as a
+     * reference for validation and benchmarking.
+     *
+     * @param data Input bytes.
+     * @param size Number of bytes to process.
+     * @param crc CRC returned by the previous call, or 0 to start.
+     * @return CRC-32 of all data processed so far.
+     */
+    static uint32_t calculateSlice16(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+    /**
+     * @brief Returns the name of the engine selected for this host.
+     * @return One of `"pclmul"`, `"armv8-crc"` or `"slice16"`.
+     */
+    static const char* engine();
+};
+
+}  // namespace utilities
+}  // namespace rogue
+
+#endif
@@ -313,6 +313,54 @@ def readAndCheckBlocks(
     )
     readAndWaitBlocks(blocks, checkEach=checkEach, waitEach=waitEach, **kwargs)
 
+def bulkTransaction(
+    blocks: Iterable[rim.Block],
+    *,
+    type: int,
+    force: bool = False,
+    window: int = 64,
+    **kwargs: Any,
+) -> None:
+    """Run one transaction type on a list of blocks and wait for all of them.
+
+    Hardware blocks are handed to a ``rim.BlockGroup``, which keeps at most
+    ``window`` transactions outstanding, checks blocks in completion order and
+    retries failed blocks without holding back the others. The whole run
+    releases the GIL. Errors from all blocks are raised together after every
+    block completes. Local blocks are handled as in ``readAndWaitBlocks()``.
+
+    Parameters
+    ----------
+    blocks : iterable[rim.Block]
+        Blocks to operate on.
+    type : {rim.Read, rim.Write, rim.Post, rim.Verify}
+        Transaction type
+    force : bool, optional (default = False)
+        Force the write even if values are unchanged.
+    window : int, optional (default = 64)
+        Maximum number of transactions in flight.
+    **kwargs : Any
+        Additional arguments passed through to startTransaction() for local blocks.
+    """
+    native = []
+    local  = []
+
+    for b in blocks:
+        if isinstance(b, rim.Block):
+            native.append(b)
+        else:
+            local.append(b)
+
+    for b in local:
+        startTransaction(b, type=type, forceWr=force, **kwargs)
+
+    if len(native) > 0:
+        group = rim.BlockGroup(window)
+        group.addBlocks(native)
+        group._run(type, force)
+
+    waitBlocks(local)
+
 
 
 
@@ -159,6 +159,9 @@ class PollQueue(object):
 
     def _poll(self) -> None:
         """Run by the poll thread"""
+        # Let scheduling stages put user access ahead of polling
+        rogue.interfaces.memory.Transaction.setThreadPriority(rogue.interfaces.memory.PriorityBackground)
+
         while True:
 
             if self.empty() or self.paused():
@@ -0,0 +1,78 @@
+#-----------------------------------------------------------------------------
+# Company    : SLAC National Accelerator Laboratory
+#-----------------------------------------------------------------------------
+# Description:
+# Asyncio support for memory master transactions
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import asyncio
+import pyrogue
+import rogue.interfaces.memory
+from typing import Any
+
+
+def asyncTransaction(
+    master: rogue.interfaces.memory.Master,
+    address: int,
+    data: Any,
+    *,
+    size: int = 0,
+    offset: int = 0,
+    type: int = rogue.interfaces.memory.Read,
+) -> asyncio.Future:
+    """Issue a memory transaction and return an awaitable for its completion.
+
+    The transaction is issued immediately through ``master._reqTransactionAsync``.
+    Completion arrives on the thread which finishes the transaction and is
+    handed to the running event loop, so many transactions can be outstanding
+    without a blocked thread for each.
+
+    Parameters
+    ----------
+    master : rogue.interfaces.memory.Master
+        Master used to issue the transaction.
+    address : int
+        Relative transaction address.
+    data : object
+        Buffer-protocol object holding the transaction bytes. Must stay
+        unchanged until the returned future completes.
+    size : int, optional (default = 0)
+        Transaction size in bytes, ``0`` uses the full buffer.
+    offset : int, optional (default = 0)
+        Byte offset within ``data``.
+    type : int, optional (default = rogue.interfaces.memory.Read)
+        Transaction type constant.
+
+    Returns
+    -------
+    asyncio.Future
+        Resolves to the transaction ID, or raises ``pyrogue.MemoryError`` on
+        error or timeout.
+    """
+    loop = asyncio.get_running_loop()
+    fut  = loop.create_future()
+
+    def _resolve(tid: int, error: str) -> None:
+        if fut.done():
+            return
+        if error != "":
+            fut.set_exception(pyrogue.MemoryError(name=str(master), address=address, msg=error, size=size))
+        else:
+            fut.set_result(tid)
+
+    def _done(tid: int, error: str) -> None:
+        try:
+            loop.call_soon_threadsafe(_resolve, tid, error)
+        except RuntimeError:
+            pass  # Loop closed while the transaction was outstanding
+
+    master._reqTransactionAsync(address, data, size, offset, type, _done)
+    return fut
@@ -15,6 +15,7 @@ from pyrogue.interfaces._Virtual   import *
 from pyrogue.interfaces._SimpleClient import *
 from pyrogue.interfaces._SqlLogging   import *
 from pyrogue.interfaces._OsCommandMemorySlave import *
+from pyrogue.interfaces._AsyncMemory import *
 
 import time
 import json
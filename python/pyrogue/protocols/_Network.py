@@ -146,6 +146,35 @@ class UdpRssiPack(pr.Device):
             pollInterval= pollInterval,
         ))
 
+        self.add(pr.LocalVariable(
+            name        = 'rssiRetranToutCount',
+            mode        = 'RO',
+            value       = 0,
+            typeStr     = 'UInt32',
+            localGet    = lambda: self._rssi.getRetranToutCount(),
+            pollInterval= pollInterval,
+        ))
+
+        self.add(pr.LocalVariable(
+            name        = 'rssiRetranFastCount',
+            mode        = 'RO',
+            value       = 0,
+            typeStr     = 'UInt32',
+            localGet    = lambda: self._rssi.getRetranFastCount(),
+            pollInterval= pollInterval,
+        ))
+
+        self.add(pr.LocalVariable(
+            name        = 'rssiRttMean',
+            description = 'Smoothed round trip time in microseconds, measured in adaptive retransmit mode',
+            mode        = 'RO',
+            value       = 0,
+            typeStr     = 'UInt32',
+            units       = 'us',
+            localGet    = lambda: self._rssi.getRttMean(),
+            pollInterval= pollInterval,
+        ))
+
         self.add(pr.LocalVariable(
             name        = 'locBusy',
             mode        = 'RO',
@@ -254,6 +283,56 @@ class UdpRssiPack(pr.Device):
             localSet    = lambda value: self._rssi.setLocMaxCumAck(value)
         ))
 
+        self.add(pr.LocalVariable(
+            name        = 'adaptiveRetran',
+            description = 'Estimate the retransmit timeout from round trip times. Only for Rogue to Rogue links',
+            mode        = 'RW',
+            value       = self._rssi.getAdaptiveRetran(),
+            localGet    = lambda: self._rssi.getAdaptiveRetran(),
+            localSet    = lambda value: self._rssi.setAdaptiveRetran(value)
+        ))
+
+        self.add(pr.LocalVariable(
+            name        = 'txPacingRate',
+            description = 'Transmit pacing rate in bytes per second, 0 disables pacing',
+            mode        = 'RW',
+            value       = self._rssi.getTxPacingRate(),
+            typeStr     = 'UInt64',
+            units       = 'B/s',
+            localGet    = lambda: self._rssi.getTxPacingRate(),
+            localSet    = lambda value: self._rssi.setTxPacingRate(value)
+        ))
+
+        self.add(pr.LocalVariable(
+            name        = 'txPacingBurst',
+            description = 'Transmit pacing burst size in bytes',
+            mode        = 'RW',
+            value       = self._rssi.getTxPacingBurst(),
+            typeStr     = 'UInt32',
+            units       = 'B',
+            localGet    = lambda: self._rssi.getTxPacingBurst(),
+            localSet    = lambda value: self._rssi.setTxPacingBurst(value)
+        ))
+
+        self.add(pr.LocalVariable(
+            name        = 'txPacingAuto',
+            description = 'Halve the pacing rate on retransmit bursts and recover as segments are acknowledged',
+            mode        = 'RW',
+            value       = self._rssi.getTxPacingAuto(),
+            localGet    = lambda: self._rssi.getTxPacingAuto(),
+            localSet    = lambda value: self._rssi.setTxPacingAuto(value)
+        ))
+
+        self.add(pr.LocalVariable(
+            name        = 'txPacingActiveRate',
+            mode        = 'RO',
+            value       = 0,
+            typeStr     = 'UInt64',
+            units       = 'B/s',
+            localGet    = lambda: self._rssi.getTxPacingActiveRate(),
+            pollInterval= pollInterval,
+        ))
+
         self.add(pr.LocalVariable(
             name        = 'curMaxBuffers',
             mode        = 'RO',
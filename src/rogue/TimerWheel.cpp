@@ -0,0 +1,229 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Hierarchical timer wheel for Rogue
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/TimerWheel.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+//! Timer creator
+rogue::TimerWheel::Timer::Timer() {
+    next_   = NULL;
+    prev_   = NULL;
+    expire_ = 0;
+    level_  = 0;
+    slot_   = 0;
+    armed_  = false;
+}
+
+//! Timer state
+bool rogue::TimerWheel::Timer::armed() const {
+    return (armed_);
+}
+
+//! Creator
+rogue::TimerWheel::TimerWheel(std::chrono::microseconds tick) {
+    uint32_t l;
+    uint32_t s;
+
+    for (l = 0; l < Levels; l++) {
+        levelCount_[l] = 0;
+        for (s = 0; s < Slots; s++) slots_[l][s] = NULL;
+    }
+
+    count_ = 0;
+    now_   = 0;
+    tick_  = (tick.count() > 0) ? tick : std::chrono::microseconds(1);
+    epoch_ = Clock::now();
+}
+
+//! Arm a timer
+void rogue::TimerWheel::arm(Timer* timer, Clock::time_point deadline) {
+    uint64_t expire;
+
+    if (timer->armed_) unlink(timer);
+
+    // Round up so a timer never fires before its deadline
+    if (deadline <= epoch_) {
+        expire = 0;
+    } else {
+        expire = std::chrono::duration_cast<std::chrono::microseconds>(deadline - epoch_).count();
+        expire = (expire + tick_.count() - 1) / tick_.count();
+    }
+
+    // Past deadlines fire on the next tick
+    if (expire <= now_) expire = now_ + 1;
+
+    timer->expire_ = expire;
+    timer->armed_  = true;
+    insert(timer);
+}
+
+//! Cancel a timer
+void rogue::TimerWheel::cancel(Timer* timer) {
+    if (timer->armed_) {
+        unlink(timer);
+        timer->armed_ = false;
+    }
+}
+
+//! Advance to the passed time and collect expired timers
+void rogue::TimerWheel::advance(Clock::time_point now, std::vector<Timer*>& expired) {
+    uint64_t target;
+    uint64_t wrap;
+    uint32_t slot;
+    int32_t l;
+    Timer* timer;
+
+    if (now <= epoch_) return;
+    target = std::chrono::duration_cast<std::chrono::microseconds>(now - epoch_).count() / tick_.count();
+
+    while (now_ < target) {
+        if (count_ == 0) {
+            now_ = target;
+            break;
+        }
+
+        // Nothing in level 0, skip to the next wrap where higher levels cascade
+        if (levelCount_[0] == 0) {
+            wrap = now_ | Mask;
+            if (wrap >= target) {
+                now_ = target;
+                break;
+            }
+            now_ = wrap;
+        }
+
+        now_++;
+
+        // Cascade from the highest level whose boundary was crossed
+        if ((now_ & Mask) == 0) {
+            for (l = Levels - 1; l > 0; l--) {
+                if ((now_ & ((static_cast<uint64_t>(1) << (Bits * l)) - 1)) == 0)
+                    cascade(l, (now_ >> (Bits * l)) & Mask);
+            }
+        }
+
+        // Every timer in the current level 0 slot expires now
+        slot = now_ & Mask;
+        while ((timer = slots_[0][slot]) != NULL) {
+            unlink(timer);
+            timer->armed_ = false;
+            expired.push_back(timer);
+        }
+    }
+}
+
+//! Earliest armed deadline
+rogue::TimerWheel::Clock::time_point rogue::TimerWheel::nextDeadline() {
+    uint64_t best;
+    uint64_t base;
+    uint32_t l;
+    uint32_t k;
+    Timer* timer;
+
+    if (count_ == 0) return (Clock::time_point::max());
+
+    best = UINT64_MAX;
+
+    // Slots ahead of the current position hold increasing ranges, so the
+    // first occupied slot of each level holds that level's earliest timer
+    for (l = 0; l < Levels; l++) {
+        if (levelCount_[l] == 0) continue;
+        base = now_ >> (Bits * l);
+
+        for (k = 1; k <= Slots; k++) {
+            if ((timer = slots_[l][(base + k) & Mask]) != NULL) {
+                for (; timer != NULL; timer = timer->next_)
+                    if (timer->expire_ < best) best = timer->expire_;
+                break;
+            }
+        }
+    }
+
+    return (epoch_ + tick_ * best);
+}
+
+//! Armed timer count
+uint32_t rogue::TimerWheel::count() {
+    return (count_);
+}
+
+//! Level for an expire tick
+uint32_t rogue::TimerWheel::levelFor(uint64_t expire) {
+    uint32_t l;
+
+    for (l = 0; l < Levels; l++)
+        if (((expire >> (Bits * l)) - (now_ >> (Bits * l))) < Slots) return (l);
+
+    return (Levels - 1);
+}
+
+//! Insert a timer into its slot
+void rogue::TimerWheel::insert(Timer* timer) {
+    uint64_t place;
+    uint64_t limit;
+    uint32_t l;
+
+    place = timer->expire_;
+    l     = levelFor(place);
+
+    // Beyond the top level, park in its furthest slot and cascade again later
+    if (l == Levels - 1) {
+        limit = ((now_ >> (Bits * l)) + Mask) << (Bits * l);
+        if (place > limit) place = limit;
+    }
+
+    timer->level_ = l;
+    timer->slot_  = (place >> (Bits * l)) & Mask;
+    timer->prev_  = NULL;
+    timer->next_  = slots_[l][timer->slot_];
+
+    if (timer->next_ != NULL) timer->next_->prev_ = timer;
+    slots_[l][timer->slot_] = timer;
+
+    levelCount_[l]++;
+    count_++;
+}
+
+//! Unlink a timer from its slot
+void rogue::TimerWheel::unlink(Timer* timer) {
+    if (timer->prev_ != NULL)
+        timer->prev_->next_ = timer->next_;
+    else
+        slots_[timer->level_][timer->slot_] = timer->next_;
+
+    if (timer->next_ != NULL) timer->next_->prev_ = timer->prev_;
+
+    timer->next_ = NULL;
+    timer->prev_ = NULL;
+
+    levelCount_[timer->level_]--;
+    count_--;
+}
+
+//! Move every timer in a higher level slot to its new level
+void rogue::TimerWheel::cascade(uint32_t level, uint32_t slot) {
+    Timer* timer;
+
+    while ((timer = slots_[level][slot]) != NULL) {
+        unlink(timer);
+        insert(timer);
+    }
+}
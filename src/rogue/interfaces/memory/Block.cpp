@@ -51,8 +51,114 @@ namespace bp = boost::python;
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/Variable.h"
 
+#if defined(__x86_64__)
+    #include <immintrin.h>
+    #define ROGUE_BLOCK_F16C
+#endif
+
 namespace rim = rogue::interfaces::memory;
 
+namespace {
+
+// Little endian load of n <= 8 bytes, upper bytes are zero. Values here are a
+// few bytes, a byte loop beats a variable length memcpy call.
+inline uint64_t loadLe(const uint8_t* src, uint32_t n) {
+    uint64_t val = 0;
+    for (uint32_t x = 0; x < n; x++) val |= static_cast<uint64_t>(src[x]) << (8 * x);
+    return val;
+}
+
+// Little endian store of the low n <= 8 bytes
+inline void storeLe(uint8_t* dst, uint64_t val, uint32_t n) {
+    for (uint32_t x = 0; x < n; x++) dst[x] = static_cast<uint8_t>(val >> (8 * x));
+}
+
+// Reverse the order of the low n bytes of a value
+inline uint64_t reverseLe(uint64_t val, uint32_t n) {
+    return __builtin_bswap64(val) >> (64 - 8 * n);
+}
+
+// Read a field of up to 57 bits starting at bit shift of the span bytes at src
+inline uint64_t readField(const uint8_t* src, uint32_t shift, uint32_t span, uint64_t mask) {
+    return (loadLe(src, span) >> shift) & mask;
+}
+
+// Write the low bits of val to a field of up to 57 bits, keeping the other bits of the span bytes at dst
+inline void writeField(uint8_t* dst, uint32_t shift, uint32_t span, uint64_t mask, uint64_t val) {
+    uint64_t cur = loadLe(dst, span);
+    cur          = (cur & ~(mask << shift)) | ((val & mask) << shift);
+    storeLe(dst, cur, span);
+}
+
+// Narrow raw words to packed values of type T, and widen them back. Plain loops
+// over fixed width types which the compiler vectorizes.
+template <typename T>
+inline void packAs(uint8_t* dst, const uint64_t* words, uint32_t count) {
+    T val;
+
+    for (uint32_t x = 0; x < count; x++) {
+        val = static_cast<T>(words[x]);
+        std::memcpy(dst + x * sizeof(T), &val, sizeof(T));
+    }
+}
+
+template <typename T>
+inline void unpackAs(uint64_t* words, const uint8_t* src, uint32_t count) {
+    T val;
+
+    for (uint32_t x = 0; x < count; x++) {
+        std::memcpy(&val, src + x * sizeof(T), sizeof(T));
+        words[x] = val;
+    }
+}
+
+// Pack raw words as contiguous little endian values of 1, 2, 4 or 8 bytes, false for other widths
+inline bool packWords(uint8_t* dst, const uint64_t* words, uint32_t bytes, uint32_t count) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    switch (bytes) {
+        case 1: packAs<uint8_t>(dst, words, count); return true;
+        case 2: packAs<uint16_t>(dst, words, count); return true;
+        case 4: packAs<uint32_t>(dst, words, count); return true;
+        case 8: packAs<uint64_t>(dst, words, count); return true;
+    }
+#endif
+    return false;
+}
+
+// Unpack contiguous little endian values of 1, 2, 4 or 8 bytes to raw words, false for other widths
+inline bool unpackWords(uint64_t* words, const uint8_t* src, uint32_t bytes, uint32_t count) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    switch (bytes) {
+        case 1: unpackAs<uint8_t>(words, src, count); return true;
+        case 2: unpackAs<uint16_t>(words, src, count); return true;
+        case 4: unpackAs<uint32_t>(words, src, count); return true;
+        case 8: unpackAs<uint64_t>(words, src, count); return true;
+    }
+#endif
+    return false;
+}
+
+// Sign extend a raw value of the given width
+inline int64_t signExtend(uint64_t raw, uint32_t bits) {
+    if (bits < 64 && (raw & (1ULL << (bits - 1))) != 0) raw |= ~0ULL << bits;
+    return static_cast<int64_t>(raw);
+}
+
+// Raw words holding float and double bits
+inline float rawToFloat(uint64_t raw) {
+    uint32_t bits = static_cast<uint32_t>(raw);
+    float val;
+    std::memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+inline double rawToDouble(uint64_t raw) {
+    double val;
+    std::memcpy(&val, &raw, sizeof(val));
+    return val;
+}
+
+}  // namespace
 
 // Class factory which returns a pointer to a Block (BlockPtr)
 rim::BlockPtr rim::Block::create(uint64_t offset, uint32_t size) {
@@ -173,7 +279,11 @@ bool rim::Block::blockPyTrans() {
 }
 
 // Start a transaction for this block
-void rim::Block::intStartTransaction(uint32_t type, bool forceWr, rim::Variable* var, int32_t index) {
+bool rim::Block::intStartTransaction(uint32_t type,
+                                     bool forceWr,
+                                     rim::Variable* var,
+                                     int32_t index,
+                                     rim::TransactionCallback notify) {
     uint32_t x;
     uint32_t tOff;
     uint32_t tSize;
@@ -188,7 +298,7 @@ void rim::Block::intStartTransaction(uint32_t type, bool forceWr, rim::Variable*
     if ((type == rim::Write && ((mode_ == "RO") || (!stale_ && !forceWr))) || (type == rim::Post && (mode_ == "RO")) ||
         (type == rim::Read && ((mode_ == "WO") || stale_)) ||
         (type == rim::Verify && ((mode_ == "WO") || (mode_ == "RO") || stale_ || !verifyReq_)))
-        return;
+        return false;
     {
         rogue::GilRelease noGil;
         std::lock_guard<std::mutex> lock(mtx_);
@@ -238,7 +348,7 @@ void rim::Block::intStartTransaction(uint32_t type, bool forceWr, rim::Variable*
         }
 
         // Device is disabled, check after clearing stale states
-        if (!enable_) return;
+        if (!enable_) return false;
 
         // Setup verify data, clear verify write flag if verify transaction
         if (type == rim::Verify) {
@@ -280,8 +390,12 @@ void rim::Block::intStartTransaction(uint32_t type, bool forceWr, rim::Variable*
                      tSize);
 
         // Start transaction
-        reqTransaction(offset_ + tOff, tSize, tData, type);
+        if (notify)
+            reqTransactionNotify(offset_ + tOff, tSize, tData, type, notify);
+        else
+            reqTransaction(offset_ + tOff, tSize, tData, type);
     }
+    return true;
 }
 
 // Start a transaction for this block, cpp version
@@ -471,6 +585,7 @@ void rim::Block::addVariables(std::vector<rim::VariablePtr> variables) {
 
     for (vit = variables_.begin(); vit != variables_.end(); ++vit) {
         (*vit)->block_ = this;
+        (*vit)->compilePlan();
 
         if (vit == variables_.begin()) {
             path_               = (*vit)->path_;
@@ -651,11 +766,6 @@ void rim::Block::reverseBytes(uint8_t* data, uint32_t byteSize) {
 
 // Set data from pointer to internal staged memory
 void rim::Block::setBytes(const uint8_t* data, rim::Variable* var, uint32_t index) {
-    uint32_t srcBit;
-    uint32_t x;
-    uint8_t tmp;
-    uint8_t* buff;
-
     // Fast path: take mtx_ without dropping the GIL. The body below is pure
     // in-memory work (memcpy/copyBits/byte-reverse) with no Python calls, so
     // holding the GIL across it is correct and avoids the release/re-acquire
@@ -669,134 +779,279 @@ void rim::Block::setBytes(const uint8_t* data, rim::Variable* var, uint32_t inde
         lock.lock();
     }
 
-    // Set stale flag
-    if (var->mode_ != "RO") stale_ = true;
-
-    // Change byte order, need to make a copy
-    if (var->byteReverse_) {
-        buff = reinterpret_cast<uint8_t*>(malloc(var->valueBytes_));
-        if (buff == NULL)
+    // List variable
+    if (var->numValues_ != 0) {
+        if (index >= var->numValues_)
             throw(rogue::GeneralError::create("Block::setBytes",
-                                              "Failed to allocate %" PRIu32 " bytes for byte-reversed copy of %s",
-                                              var->valueBytes_,
+                                              "Index %" PRIu32 " is out of range for %s",
+                                              index,
                                               var->name_.c_str()));
-        memcpy(buff, data, var->valueBytes_);
-        reverseBytes(buff, var->valueBytes_);
     } else {
-        buff = const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(data));
+        index = 0;
+    }
+
+    copyIn(data, var, index);
+    markStale(var, index, index);
+}
+
+// Get data to pointer from internal block or staged memory
+void rim::Block::getBytes(uint8_t* data, rim::Variable* var, uint32_t index) {
+    // Fast path: take mtx_ without dropping the GIL. See setBytes() for the full
+    // rationale -- the body is pure in-memory work, so we only release the GIL
+    // on the contended-wait path to preserve deadlock avoidance (SLAC rogue
+    // #1262).
+    std::unique_lock<std::mutex> lock(mtx_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        rogue::GilRelease noGil;
+        lock.lock();
     }
 
     // List variable
     if (var->numValues_ != 0) {
-        if (index >= var->numValues_) {
-            if (var->byteReverse_) free(buff);
-            throw(rogue::GeneralError::create("Block::setBytes",
+        if (index >= var->numValues_)
+            throw(rogue::GeneralError::create("Block::getBytes",
                                               "Index %" PRIu32 " is out of range for %s",
                                               index,
                                               var->name_.c_str()));
-        }
+    } else {
+        index = 0;
+    }
 
+    copyOut(data, var, index);
+}
+
+// Copy one value into staged memory
+void rim::Block::copyIn(const uint8_t* data, rim::Variable* var, uint32_t index) {
+    const uint8_t* src;
+    uint64_t val;
+    uint32_t x;
+
+    switch (var->copyMethod_) {
         // Fast copy.
         // Intentionally writes valueBytes_ (not valueStride_/8): pyrogue
         // RemoteVariable.add() rejects valueStride < valueBits before any
         // C++ caller is reachable, so a stride-cap here would silently
         // truncate writes for misconfigured direct-C++ callers and hide
         // the bug rather than surface it.
-        if (var->fastByte_ != NULL)
-            memcpy(blockData_ + var->fastByte_[index], buff, var->valueBytes_);
+        case rim::Variable::CopyBytes:
+            if (var->byteReverse_) {
+                for (x = 0; x < var->valueBytes_; x++)
+                    blockData_[var->fastByte_[index] + x] = data[var->valueBytes_ - x - 1];
+            } else {
+                memcpy(blockData_ + var->fastByte_[index], data, var->valueBytes_);
+            }
+            break;
 
-        else
-            copyBits(blockData_, var->bitOffset_[0] + (index * var->valueStride_), buff, 0, var->valueBits_);
+        case rim::Variable::CopyWord:
+            val = loadLe(data, var->valueBytes_);
+            if (var->byteReverse_) val = reverseLe(val, var->valueBytes_);
+
+            if (var->numValues_ != 0) {
+                x = var->bitOffset_[0] + (index * var->valueStride_);
+                writeField(blockData_ + x / 8, x % 8, (x % 8 + var->valueBits_ + 7) / 8, var->valueMask_, val);
+            } else {
+                for (const auto& f : var->planFields_)
+                    writeField(blockData_ + f.byte, f.shift, f.span, f.mask, val >> f.valueLsb);
+            }
+            break;
 
-        if (var->mode_ != "RO") {
-           if (var->stale_) {
-               if (var->lowTranByte_[index] < var->staleLowByte_) var->staleLowByte_ = var->lowTranByte_[index];
+        case rim::Variable::CopyBits: {
+            // Change byte order, need to make a copy
+            uint8_t buff[var->byteReverse_ ? var->valueBytes_ : 1];
 
-               if (var->highTranByte_[index] > var->staleHighByte_) var->staleHighByte_ = var->highTranByte_[index];
-           } else {
-               var->staleLowByte_  = var->lowTranByte_[index];
-               var->staleHighByte_ = var->highTranByte_[index];
-           }
-        }
+            if (var->byteReverse_) {
+                memcpy(buff, data, var->valueBytes_);
+                reverseBytes(buff, var->valueBytes_);
+                src = buff;
+            } else {
+                src = data;
+            }
 
-        // Standard variable
-    } else {
-        if (var->mode_ != "RO") {
-           var->staleLowByte_  = var->lowTranByte_[0];
-           var->staleHighByte_ = var->highTranByte_[0];
+            if (var->numValues_ != 0) {
+                copyBits(blockData_,
+                         var->bitOffset_[0] + (index * var->valueStride_),
+                         const_cast<uint8_t*>(src),
+                         0,
+                         var->valueBits_);
+            } else {
+                for (const auto& f : var->planFields_)
+                    copyBits(blockData_, f.blockLsb, const_cast<uint8_t*>(src), f.valueLsb, f.size);
+            }
+            break;
         }
+    }
+}
 
-        // Fast copy
-        if (var->fastByte_ != NULL) {
-            memcpy(blockData_ + var->fastByte_[0], buff, var->valueBytes_);
+// Copy one value out of staged memory
+void rim::Block::copyOut(uint8_t* data, rim::Variable* var, uint32_t index) {
+    uint64_t val;
+    uint32_t x;
 
-        } else if (var->bitOffset_.size() == 1) {
-            copyBits(blockData_, var->bitOffset_[0], buff, 0, var->bitSize_[0]);
+    switch (var->copyMethod_) {
+        // Fast copy. See copyIn() above for why this reads valueBytes_
+        // and not valueStride_/8 -- the read-side mirrors the write-side
+        // because pyrogue rejects valueStride < valueBits upstream.
+        case rim::Variable::CopyBytes:
+            if (var->byteReverse_) {
+                for (x = 0; x < var->valueBytes_; x++)
+                    data[x] = blockData_[var->fastByte_[index] + var->valueBytes_ - x - 1];
+            } else {
+                memcpy(data, blockData_ + var->fastByte_[index], var->valueBytes_);
+            }
+            break;
 
-        } else {
-            srcBit = 0;
-            for (x = 0; x < var->bitOffset_.size(); x++) {
-                copyBits(blockData_, var->bitOffset_[x], buff, srcBit, var->bitSize_[x]);
-                srcBit += var->bitSize_[x];
+        // Bits of data outside the value are kept, as with copyBits
+        case rim::Variable::CopyWord:
+            if (var->numValues_ != 0) {
+                x   = var->bitOffset_[0] + (index * var->valueStride_);
+                val = readField(blockData_ + x / 8, x % 8, (x % 8 + var->valueBits_ + 7) / 8, var->valueMask_);
+            } else {
+                val = 0;
+                for (const auto& f : var->planFields_)
+                    val |= readField(blockData_ + f.byte, f.shift, f.span, f.mask) << f.valueLsb;
             }
-        }
+
+            val |= loadLe(data, var->valueBytes_) & ~var->valueMask_;
+            if (var->byteReverse_) val = reverseLe(val, var->valueBytes_);
+            storeLe(data, val, var->valueBytes_);
+            break;
+
+        case rim::Variable::CopyBits:
+            if (var->numValues_ != 0) {
+                copyBits(data, 0, blockData_, var->bitOffset_[0] + (index * var->valueStride_), var->valueBits_);
+            } else {
+                for (const auto& f : var->planFields_) copyBits(data, f.valueLsb, blockData_, f.blockLsb, f.size);
+            }
+
+            // Change byte order
+            if (var->byteReverse_) reverseBytes(data, var->valueBytes_);
+            break;
     }
-    if ( var->mode_ != "RO" ) var->stale_ = true;
-    if (var->byteReverse_) free(buff);
 }
 
-// Get data to pointer from internal block or staged memory
-void rim::Block::getBytes(uint8_t* data, rim::Variable* var, uint32_t index) {
-    uint32_t dstBit;
+// Set stale flags and extend the stale range
+void rim::Block::markStale(rim::Variable* var, uint32_t first, uint32_t last) {
+    if (var->accessMode_ == rim::Variable::ModeRO) return;
+
+    stale_ = true;
+
+    if (var->numValues_ != 0 && var->stale_) {
+        if (var->lowTranByte_[first] < var->staleLowByte_) var->staleLowByte_ = var->lowTranByte_[first];
+        if (var->highTranByte_[last] > var->staleHighByte_) var->staleHighByte_ = var->highTranByte_[last];
+    } else {
+        var->staleLowByte_  = var->lowTranByte_[first];
+        var->staleHighByte_ = var->highTranByte_[last];
+    }
+    var->stale_ = true;
+}
+
+// Set a run of list values from raw words
+void rim::Block::setWords(const uint64_t* words, rim::Variable* var, uint32_t index, uint32_t count) {
+    uint8_t data[8];
+    uint64_t val;
+    uint32_t bit;
     uint32_t x;
 
-    // Fast path: take mtx_ without dropping the GIL. See setBytes() for the full
-    // rationale -- the body is pure in-memory work, so we only release the GIL
-    // on the contended-wait path to preserve deadlock avoidance (SLAC rogue
-    // #1262).
+    // See setBytes() for the locking rationale
     std::unique_lock<std::mutex> lock(mtx_, std::try_to_lock);
     if (!lock.owns_lock()) {
         rogue::GilRelease noGil;
         lock.lock();
     }
 
-    // List variable
-    if (var->numValues_ != 0) {
-        if (index >= var->numValues_)
-            throw(rogue::GeneralError::create("Block::getBytes",
-                                              "Index %" PRIu32 " is out of range for %s",
-                                              index,
-                                              var->name_.c_str()));
+    if (var->numValues_ == 0 || var->valueBytes_ > 8 || index + count > var->numValues_)
+        throw(rogue::GeneralError::create("Block::setWords",
+                                          "Invalid range of %" PRIu32 " values at index %" PRIu32 " for %s",
+                                          count,
+                                          index,
+                                          var->name_.c_str()));
 
-        // Fast copy. See setBytes() above for why this reads valueBytes_
-        // and not valueStride_/8 -- the read-side mirrors the write-side
-        // because pyrogue rejects valueStride < valueBits upstream.
-        if (var->fastByte_ != NULL)
-            memcpy(data, blockData_ + var->fastByte_[index], var->valueBytes_);
+    if (count == 0) return;
 
-        else
-            copyBits(data, 0, blockData_, var->bitOffset_[0] + (index * var->valueStride_), var->valueBits_);
+    switch (var->copyMethod_) {
+        case rim::Variable::CopyBytes:
+            // Values packed back to back move as one typed array
+            if (!var->byteReverse_ && var->valueStride_ == var->valueBytes_ * 8 &&
+                packWords(blockData_ + var->fastByte_[index], words, var->valueBytes_, count))
+                break;
 
-    } else {
-        // Fast copy
-        if (var->fastByte_ != NULL) {
-            memcpy(data, blockData_ + var->fastByte_[0], var->valueBytes_);
+            for (x = 0; x < count; x++) {
+                val = var->byteReverse_ ? reverseLe(words[x], var->valueBytes_) : words[x];
+                storeLe(blockData_ + var->fastByte_[index + x], val, var->valueBytes_);
+            }
+            break;
 
-        } else if (var->bitOffset_.size() == 1) {
-            copyBits(data, 0, blockData_, var->bitOffset_[0], var->bitSize_[0]);
+        case rim::Variable::CopyWord:
+            bit = var->bitOffset_[0] + (index * var->valueStride_);
+            for (x = 0; x < count; x++, bit += var->valueStride_) {
+                val = var->byteReverse_ ? reverseLe(words[x], var->valueBytes_) : words[x];
+                writeField(blockData_ + bit / 8, bit % 8, (bit % 8 + var->valueBits_ + 7) / 8, var->valueMask_, val);
+            }
+            break;
 
-        } else {
-            dstBit = 0;
-            for (x = 0; x < var->bitOffset_.size(); x++) {
-                copyBits(data, dstBit, blockData_, var->bitOffset_[x], var->bitSize_[x]);
-                dstBit += var->bitSize_[x];
+        case rim::Variable::CopyBits:
+            for (x = 0; x < count; x++) {
+                storeLe(data, words[x], 8);
+                copyIn(data, var, index + x);
             }
-        }
+            break;
+    }
+
+    markStale(var, index, index + count - 1);
+}
+
+// Get a run of list values into raw words
+void rim::Block::getWords(uint64_t* words, rim::Variable* var, uint32_t index, uint32_t count) {
+    uint8_t data[8];
+    uint64_t val;
+    uint32_t bit;
+    uint32_t x;
+
+    // See setBytes() for the locking rationale
+    std::unique_lock<std::mutex> lock(mtx_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        rogue::GilRelease noGil;
+        lock.lock();
     }
 
-    // Change byte order
-    if (var->byteReverse_) {
-        reverseBytes(data, var->valueBytes_);
+    if (var->numValues_ == 0 || var->valueBytes_ > 8 || index + count > var->numValues_)
+        throw(rogue::GeneralError::create("Block::getWords",
+                                          "Invalid range of %" PRIu32 " values at index %" PRIu32 " for %s",
+                                          count,
+                                          index,
+                                          var->name_.c_str()));
+
+    switch (var->copyMethod_) {
+        case rim::Variable::CopyBytes:
+            // Values packed back to back move as one typed array
+            if (!var->byteReverse_ && var->valueStride_ == var->valueBytes_ * 8 &&
+                unpackWords(words, blockData_ + var->fastByte_[index], var->valueBytes_, count))
+                break;
+
+            for (x = 0; x < count; x++) {
+                val      = loadLe(blockData_ + var->fastByte_[index + x], var->valueBytes_);
+                words[x] = var->byteReverse_ ? reverseLe(val, var->valueBytes_) : val;
+            }
+            break;
+
+        case rim::Variable::CopyWord:
+            bit = var->bitOffset_[0] + (index * var->valueStride_);
+            for (x = 0; x < count; x++, bit += var->valueStride_) {
+                val      = readField(blockData_ + bit / 8,
+                                     bit % 8,
+                                     (bit % 8 + var->valueBits_ + 7) / 8,
+                                     var->valueMask_);
+                words[x] = var->byteReverse_ ? reverseLe(val, var->valueBytes_) : val;
+            }
+            break;
+
+        case rim::Variable::CopyBits:
+            for (x = 0; x < count; x++) {
+                memset(data, 0, 8);
+                copyOut(data, var, index + x);
+                words[x] = loadLe(data, 8);
+            }
+            break;
     }
 }
 
@@ -960,9 +1215,9 @@ void rim::Block::setUIntPy(bp::object& value, rim::Variable* var, int32_t index)
 
     // Lambda to process an array of unsigned values.
     auto process_uint_array = [&](auto* src, npy_intp stride, npy_intp length) {
-        for (npy_intp i = 0; i < length; ++i) {
-            setUInt(src[i * stride], var, index + i);
-        }
+        std::vector<uint64_t> words(length);
+        for (npy_intp i = 0; i < length; ++i) words[i] = encodeUInt(src[i * stride], var);
+        setWords(words.data(), var, index, length);
     };
 
     // Passed value is a numpy value
@@ -1104,33 +1359,29 @@ bp::object rim::Block::getUIntPy(rim::Variable* var, int32_t index) {
         PyObject* obj = PyArray_SimpleNew(1, dims, npType);
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         uint32_t x;
+
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+
         switch (npType) {
             case NPY_UINT8: {
                 uint8_t* dst = reinterpret_cast<uint8_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = static_cast<uint8_t>(getUInt(var, x));
-                }
+                for (x = 0; x < var->numValues_; x++) dst[x] = static_cast<uint8_t>(words[x]);
                 break;
             }
             case NPY_UINT16: {
                 uint16_t* dst = reinterpret_cast<uint16_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = static_cast<uint16_t>(getUInt(var, x));
-                }
+                for (x = 0; x < var->numValues_; x++) dst[x] = static_cast<uint16_t>(words[x]);
                 break;
             }
             case NPY_UINT32: {
                 uint32_t* dst = reinterpret_cast<uint32_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = static_cast<uint32_t>(getUInt(var, x));
-                }
+                for (x = 0; x < var->numValues_; x++) dst[x] = static_cast<uint32_t>(words[x]);
                 break;
             }
             case NPY_UINT64: {
                 uint64_t* dst = reinterpret_cast<uint64_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = getUInt(var, x);
-                }
+                for (x = 0; x < var->numValues_; x++) dst[x] = words[x];
                 break;
             }
         }
@@ -1148,9 +1399,8 @@ bp::object rim::Block::getUIntPy(rim::Variable* var, int32_t index) {
 
 #endif
 
-// Set data using unsigned int
-void rim::Block::setUInt(const uint64_t& val, rim::Variable* var, int32_t index) {
-    // Check range
+// Range check an unsigned int
+uint64_t rim::Block::encodeUInt(const uint64_t& val, rim::Variable* var) {
     if ((var->minValue_ != 0 || var->maxValue_ != 0) && (val > var->maxValue_ || val < var->minValue_))
         throw(rogue::GeneralError::create("Block::setUInt",
                                           "Value range error for %s. Value=%" PRIu64 ", Min=%f, Max=%f",
@@ -1158,8 +1408,13 @@ void rim::Block::setUInt(const uint64_t& val, rim::Variable* var, int32_t index)
                                           val,
                                           var->minValue_,
                                           var->maxValue_));
+    return val;
+}
 
-    setBytes(reinterpret_cast<uint8_t*>(const_cast<uint64_t*>(&val)), var, index);
+// Set data using unsigned int
+void rim::Block::setUInt(const uint64_t& val, rim::Variable* var, int32_t index) {
+    uint64_t raw = encodeUInt(val, var);
+    setBytes(reinterpret_cast<uint8_t*>(&raw), var, index);
 }
 
 // Get data using unsigned int
@@ -1183,9 +1438,9 @@ void rim::Block::setIntPy(bp::object& value, rim::Variable* var, int32_t index)
 
     // Lambda to process an array of signed values.
     auto process_int_array = [&](auto* src, npy_intp stride, npy_intp length) {
-        for (npy_intp i = 0; i < length; ++i) {
-            setInt(src[i * stride], var, index + i);
-        }
+        std::vector<uint64_t> words(length);
+        for (npy_intp i = 0; i < length; ++i) words[i] = encodeInt(src[i * stride], var);
+        setWords(words.data(), var, index, length);
     };
 
      // Passed value is a numpy value
@@ -1327,33 +1582,32 @@ bp::object rim::Block::getIntPy(rim::Variable* var, int32_t index) {
         PyObject* obj = PyArray_SimpleNew(1, dims, npType);
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         uint32_t x;
+
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+
         switch (npType) {
             case NPY_INT8: {
                 int8_t* dst = reinterpret_cast<int8_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = static_cast<int8_t>(getInt(var, x));
-                }
+                for (x = 0; x < var->numValues_; x++)
+                    dst[x] = static_cast<int8_t>(signExtend(words[x], var->valueBits_));
                 break;
             }
             case NPY_INT16: {
                 int16_t* dst = reinterpret_cast<int16_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = static_cast<int16_t>(getInt(var, x));
-                }
+                for (x = 0; x < var->numValues_; x++)
+                    dst[x] = static_cast<int16_t>(signExtend(words[x], var->valueBits_));
                 break;
             }
             case NPY_INT32: {
                 int32_t* dst = reinterpret_cast<int32_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = static_cast<int32_t>(getInt(var, x));
-                }
+                for (x = 0; x < var->numValues_; x++)
+                    dst[x] = static_cast<int32_t>(signExtend(words[x], var->valueBits_));
                 break;
             }
             case NPY_INT64: {
                 int64_t* dst = reinterpret_cast<int64_t*>(PyArray_DATA(arr));
-                for (x = 0; x < var->numValues_; x++) {
-                    dst[x] = getInt(var, x);
-                }
+                for (x = 0; x < var->numValues_; x++) dst[x] = signExtend(words[x], var->valueBits_);
                 break;
             }
         }
@@ -1372,7 +1626,7 @@ bp::object rim::Block::getIntPy(rim::Variable* var, int32_t index) {
 #endif
 
 // Set data using int
-void rim::Block::setInt(const int64_t& val, rim::Variable* var, int32_t index) {
+uint64_t rim::Block::encodeInt(const int64_t& val, rim::Variable* var) {
     // Check range
     if ((var->minValue_ != 0 || var->maxValue_ != 0) && (val > var->maxValue_ || val < var->minValue_))
         throw(rogue::GeneralError::create("Block::setInt",
@@ -1383,21 +1637,21 @@ void rim::Block::setInt(const int64_t& val, rim::Variable* var, int32_t index) {
                                           var->maxValue_));
 
     // This works because all bits between the msb and bit 64 are set to '1' for a negative value
-    setBytes(reinterpret_cast<uint8_t*>(const_cast<int64_t*>(&val)), var, index);
+    return static_cast<uint64_t>(val);
+}
+
+void rim::Block::setInt(const int64_t& val, rim::Variable* var, int32_t index) {
+    uint64_t raw = encodeInt(val, var);
+    setBytes(reinterpret_cast<uint8_t*>(&raw), var, index);
 }
 
 // Get data using int
 int64_t rim::Block::getInt(rim::Variable* var, int32_t index) {
-    int64_t tmp = 0;
+    uint64_t tmp = 0;
 
     getBytes(reinterpret_cast<uint8_t*>(&tmp), var, index);
 
-    if (var->valueBits_ != 64) {
-        if (tmp >= static_cast<uint64_t>(pow(2, var->valueBits_ - 1))) {
-            tmp -= static_cast<uint64_t>(pow(2, var->valueBits_));
-        }
-    }
-    return tmp;
+    return signExtend(tmp, var->valueBits_);
 }
 
 //////////////////////////////////////////
@@ -1650,9 +1904,9 @@ void rim::Block::setFloatPy(bp::object& value, rim::Variable* var, int32_t index
         if (PyArray_TYPE(arr) == NPY_FLOAT32) {
             float* src      = reinterpret_cast<float*>(PyArray_DATA(arr));
             npy_intp stride = strides[0] / sizeof(float);
-            for (x = 0; x < dims[0]; x++) {
-                setFloat(src[x * stride], var, index + x);
-            }
+            std::vector<uint64_t> words(dims[0]);
+            for (x = 0; x < dims[0]; x++) words[x] = encodeFloat(src[x * stride], var);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFLoatPy",
                                               "Passed nparray is not of type (float32) for %s",
@@ -1720,7 +1974,9 @@ bp::object rim::Block::getFloatPy(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getFloat(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        for (x = 0; x < var->numValues_; x++) dst[x] = rawToFloat(words[x]);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -1739,7 +1995,9 @@ bp::object rim::Block::getFloatPy(rim::Variable* var, int32_t index) {
 #endif
 
 // Set data using float
-void rim::Block::setFloat(const float& val, rim::Variable* var, int32_t index) {
+uint64_t rim::Block::encodeFloat(const float& val, rim::Variable* var) {
+    uint32_t bits;
+
     // Check range
     if ((var->minValue_ != 0 || var->maxValue_ != 0) && (val > var->maxValue_ || val < var->minValue_))
         throw(rogue::GeneralError::create("Block::setFloat",
@@ -1749,7 +2007,13 @@ void rim::Block::setFloat(const float& val, rim::Variable* var, int32_t index) {
                                           var->minValue_,
                                           var->maxValue_));
 
-    setBytes(reinterpret_cast<uint8_t*>(const_cast<float*>(&val)), var, index);
+    memcpy(&bits, &val, sizeof(bits));
+    return bits;
+}
+
+void rim::Block::setFloat(const float& val, rim::Variable* var, int32_t index) {
+    uint64_t raw = encodeFloat(val, var);
+    setBytes(reinterpret_cast<uint8_t*>(&raw), var, index);
 }
 
 // Get data using float
@@ -2030,8 +2294,231 @@ float float4ToFloat(uint8_t f4) {
     return sign * std::ldexp(frac, static_cast<int>(exponent) - 1);
 }
 
+// Array conversion kernels used by the list paths, bit exact with the helpers above
+
+inline uint32_t floatBits(float value) {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    return f;
+}
+
+inline float bitsFloat(uint32_t f) {
+    float value;
+    std::memcpy(&value, &f, sizeof(value));
+    return value;
+}
+
+// Conversion tables for the 8, 6 and 4 bit formats, filled from the scalar helpers. The
+// encoded value only depends on the sign, the exponent and the leading mantissa bits that
+// the format keeps, NaN inputs whose kept mantissa bits are zero are fixed up separately.
+struct SmallFloatTable {
+    uint32_t shift;
+    uint8_t nan;
+    std::vector<uint8_t> encode;
+    float decode[256];
+
+    SmallFloatTable(uint8_t (*toSmall)(float), float (*fromSmall)(uint8_t), uint32_t mantBits) {
+        shift = 23 - mantBits;
+        nan   = toSmall(bitsFloat(0x7F800001));
+        encode.resize(1U << (32 - shift));
+        for (uint32_t x = 0; x < encode.size(); x++) encode[x] = toSmall(bitsFloat(x << shift));
+        for (uint32_t x = 0; x < 256; x++) decode[x] = fromSmall(static_cast<uint8_t>(x));
+    }
+
+    void toWords(uint64_t* words, const float* src, uint32_t count) const {
+        const uint8_t* enc = encode.data();
+        uint32_t f;
+
+        for (uint32_t x = 0; x < count; x++) {
+            f        = floatBits(src[x]);
+            words[x] = ((f & 0x7FFFFFFF) > 0x7F800000) ? nan : enc[f >> shift];
+        }
+    }
+
+    void fromWords(float* dst, const uint64_t* words, uint32_t count) const {
+        for (uint32_t x = 0; x < count; x++) dst[x] = decode[words[x] & 0xFF];
+    }
+};
+
+// Built on first use so callers from other static initializers are safe
+const SmallFloatTable& float8Table() {
+    static const SmallFloatTable table(floatToFloat8, float8ToFloat, 3);
+    return table;
+}
+
+const SmallFloatTable& float6Table() {
+    static const SmallFloatTable table(floatToFloat6, float6ToFloat, 2);
+    return table;
+}
+
+const SmallFloatTable& float4Table() {
+    static const SmallFloatTable table(floatToFloat4, float4ToFloat, 1);
+    return table;
+}
+
+void floatToHalfScalar(uint64_t* words, const float* src, uint32_t count) {
+    for (uint32_t x = 0; x < count; x++) words[x] = floatToHalf(src[x]);
+}
+
+void halfToFloatScalar(float* dst, const uint64_t* words, uint32_t count) {
+    for (uint32_t x = 0; x < count; x++) dst[x] = halfToFloat(static_cast<uint16_t>(words[x]));
+}
+
+#ifdef ROGUE_BLOCK_F16C
+
+// The scalar encoder truncates, which round toward zero reproduces. Groups holding values
+// that overflow to infinity or NaN, where the hardware saturates or quiets, use the scalar path.
+__attribute__((target("avx,f16c"))) void floatToHalfF16c(uint64_t* words, const float* src, uint32_t count) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 limit   = _mm256_set1_ps(65536.0f);
+    alignas(16) uint16_t half[8];
+    uint32_t x = 0;
+
+    for (; x + 8 <= count; x += 8) {
+        __m256 val = _mm256_loadu_ps(src + x);
+
+        if (_mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(val, absMask), limit, _CMP_NLT_UQ)) != 0) {
+            floatToHalfScalar(words + x, src + x, 8);
+        } else {
+            _mm_store_si128(reinterpret_cast<__m128i*>(half),
+                            _mm256_cvtps_ph(val, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+            for (uint32_t y = 0; y < 8; y++) words[x + y] = half[y];
+        }
+    }
+    floatToHalfScalar(words + x, src + x, count - x);
+}
+
+// Widening is exact, only NaN payloads differ as the hardware sets the quiet bit
+__attribute__((target("avx,f16c"))) void halfToFloatF16c(float* dst, const uint64_t* words, uint32_t count) {
+    alignas(16) uint16_t half[8];
+    uint32_t x = 0;
+    uint32_t nan;
+
+    for (; x + 8 <= count; x += 8) {
+        nan = 0;
+        for (uint32_t y = 0; y < 8; y++) {
+            half[y] = static_cast<uint16_t>(words[x + y]);
+            nan |= ((half[y] & 0x7FFF) > 0x7C00);
+        }
+
+        if (nan != 0)
+            halfToFloatScalar(dst + x, words + x, 8);
+        else
+            _mm256_storeu_ps(dst + x, _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(half))));
+    }
+    halfToFloatScalar(dst + x, words + x, count - x);
+}
+
+#endif
+
+typedef void (*HalfEncodeFunc)(uint64_t*, const float*, uint32_t);
+typedef void (*HalfDecodeFunc)(float*, const uint64_t*, uint32_t);
+
+struct HalfEngine {
+    HalfEncodeFunc encode;
+    HalfDecodeFunc decode;
+
+    HalfEngine() {
+        encode = floatToHalfScalar;
+        decode = halfToFloatScalar;
+
+#ifdef ROGUE_BLOCK_F16C
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c")) {
+            encode = floatToHalfF16c;
+            decode = halfToFloatF16c;
+        }
+#endif
+    }
+};
+
+const HalfEngine& halfEngine() {
+    static const HalfEngine engine;
+    return engine;
+}
+
 }  // anonymous namespace
 
+// Check the range of values converted by the list setters of the low precision float models
+void rim::Block::checkFloatRange(const float* src, uint32_t count, rim::Variable* var, const char* func) {
+    if (var->minValue_ == 0 && var->maxValue_ == 0) return;
+
+    for (uint32_t x = 0; x < count; x++) {
+        if (src[x] > var->maxValue_ || src[x] < var->minValue_)
+            throw(rogue::GeneralError::create(func,
+                                              "Value range error for %s. Value=%f, Min=%f, Max=%f",
+                                              var->name_.c_str(),
+                                              src[x],
+                                              var->minValue_,
+                                              var->maxValue_));
+    }
+}
+
+// Low precision float array converters
+void rim::Block::encodeFloat16Array(uint64_t* words, const float* src, uint32_t count) {
+    halfEngine().encode(words, src, count);
+}
+
+void rim::Block::decodeFloat16Array(float* dst, const uint64_t* words, uint32_t count) {
+    halfEngine().decode(dst, words, count);
+}
+
+void rim::Block::encodeBFloat16Array(uint64_t* words, const float* src, uint32_t count) {
+    uint32_t f;
+    uint32_t bf16;
+
+    for (uint32_t x = 0; x < count; x++) {
+        f    = floatBits(src[x]);
+        bf16 = f >> 16;
+        bf16 |= static_cast<uint32_t>((f & 0x7FFFFFFF) > 0x7F800000 && (bf16 & 0x007F) == 0);
+        words[x] = bf16;
+    }
+}
+
+void rim::Block::decodeBFloat16Array(float* dst, const uint64_t* words, uint32_t count) {
+    for (uint32_t x = 0; x < count; x++) dst[x] = bitsFloat(static_cast<uint32_t>(words[x]) << 16);
+}
+
+void rim::Block::encodeTensorFloat32Array(uint64_t* words, const float* src, uint32_t count) {
+    uint32_t f;
+    uint32_t tf32;
+
+    for (uint32_t x = 0; x < count; x++) {
+        f    = floatBits(src[x]);
+        tf32 = f & 0xFFFFE000U;
+        tf32 |= static_cast<uint32_t>((f & 0x7FFFFFFF) > 0x7F800000 && (tf32 & 0x007FFFFFU) == 0) << 13;
+        words[x] = tf32;
+    }
+}
+
+void rim::Block::decodeTensorFloat32Array(float* dst, const uint64_t* words, uint32_t count) {
+    for (uint32_t x = 0; x < count; x++) dst[x] = bitsFloat(static_cast<uint32_t>(words[x]));
+}
+
+void rim::Block::encodeFloat8Array(uint64_t* words, const float* src, uint32_t count) {
+    float8Table().toWords(words, src, count);
+}
+
+void rim::Block::decodeFloat8Array(float* dst, const uint64_t* words, uint32_t count) {
+    float8Table().fromWords(dst, words, count);
+}
+
+void rim::Block::encodeFloat6Array(uint64_t* words, const float* src, uint32_t count) {
+    float6Table().toWords(words, src, count);
+}
+
+void rim::Block::decodeFloat6Array(float* dst, const uint64_t* words, uint32_t count) {
+    float6Table().fromWords(dst, words, count);
+}
+
+void rim::Block::encodeFloat4Array(uint64_t* words, const float* src, uint32_t count) {
+    float4Table().toWords(words, src, count);
+}
+
+void rim::Block::decodeFloat4Array(float* dst, const uint64_t* words, uint32_t count) {
+    float4Table().fromWords(dst, words, count);
+}
+
 //////////////////////////////////////////
 // Float16 (half-precision)
 //////////////////////////////////////////
@@ -2070,10 +2557,16 @@ void rim::Block::setFloat16Py(bp::object& value, rim::Variable* var, int32_t ind
         if (PyArray_TYPE(arr) == NPY_HALF) {
             npy_half* src   = reinterpret_cast<npy_half*>(PyArray_DATA(arr));
             npy_intp stride = strides[0] / sizeof(npy_half);
-            for (x = 0; x < dims[0]; x++) {
-                float val = halfToFloat(src[x * stride]);
-                setFloat16(val, var, index + x);
+            std::vector<uint64_t> words(dims[0]);
+            for (x = 0; x < dims[0]; x++) words[x] = src[x * stride];
+
+            // Half values convert back to the same bits, floats are only needed for the range check
+            if (var->minValue_ != 0 || var->maxValue_ != 0) {
+                std::vector<float> vals(dims[0]);
+                decodeFloat16Array(vals.data(), words.data(), dims[0]);
+                checkFloatRange(vals.data(), dims[0], var, "Block::setFloat16");
             }
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFloat16Py",
                                               "Passed nparray is not of type (float16) for %s",
@@ -2094,6 +2587,7 @@ void rim::Block::setFloat16Py(bp::object& value, rim::Variable* var, int32_t ind
                                               var->numValues_,
                                               var->name_.c_str()));
 
+        std::vector<float> vals(vlen);
         for (x = 0; x < vlen; x++) {
             bp::extract<float> tmp(vl[x]);
 
@@ -2102,9 +2596,14 @@ void rim::Block::setFloat16Py(bp::object& value, rim::Variable* var, int32_t ind
                                                   "Failed to extract value for %s.",
                                                   var->name_.c_str()));
 
-            setFloat16(tmp, var, index + x);
+            vals[x] = tmp;
         }
 
+        std::vector<uint64_t> words(vlen);
+        checkFloatRange(vals.data(), vlen, var, "Block::setFloat16");
+        encodeFloat16Array(words.data(), vals.data(), vlen);
+        setWords(words.data(), var, index, vlen);
+
         // Passed scalar numpy value
     } else if (PyArray_CheckScalar(value.ptr())) {
         if (PyArray_DescrFromScalar(value.ptr())->type_num == NPY_HALF) {
@@ -2142,7 +2641,10 @@ bp::object rim::Block::getFloat16Py(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         npy_half* dst      = reinterpret_cast<npy_half*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = floatToHalf(getFloat16(var, x));
+        // Stored half values are returned as is, the float round trip does not change them
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        for (x = 0; x < var->numValues_; x++) dst[x] = static_cast<npy_half>(words[x]);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -2223,10 +2725,17 @@ void rim::Block::setFloat8Py(bp::object& value, rim::Variable* var, int32_t inde
         if (PyArray_TYPE(arr) == NPY_FLOAT) {
             float* src          = reinterpret_cast<float*>(PyArray_DATA(arr));
             npy_intp stride     = strides[0] / sizeof(float);
-            for (x = 0; x < dims[0]; x++) {
-                float val = src[x * stride];
-                setFloat8(val, var, index + x);
+            std::vector<float> vals;
+            if (stride != 1) {
+                vals.resize(dims[0]);
+                for (x = 0; x < dims[0]; x++) vals[x] = src[x * stride];
+                src = vals.data();
             }
+
+            std::vector<uint64_t> words(dims[0]);
+            checkFloatRange(src, dims[0], var, "Block::setFloat8");
+            encodeFloat8Array(words.data(), src, dims[0]);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFloat8Py",
                                               "Passed nparray is not of type (float32) for %s",
@@ -2247,6 +2756,7 @@ void rim::Block::setFloat8Py(bp::object& value, rim::Variable* var, int32_t inde
                                               var->numValues_,
                                               var->name_.c_str()));
 
+        std::vector<float> vals(vlen);
         for (x = 0; x < vlen; x++) {
             bp::extract<float> tmp(vl[x]);
 
@@ -2255,9 +2765,14 @@ void rim::Block::setFloat8Py(bp::object& value, rim::Variable* var, int32_t inde
                                                   "Failed to extract value for %s.",
                                                   var->name_.c_str()));
 
-            setFloat8(tmp, var, index + x);
+            vals[x] = tmp;
         }
 
+        std::vector<uint64_t> words(vlen);
+        checkFloatRange(vals.data(), vlen, var, "Block::setFloat8");
+        encodeFloat8Array(words.data(), vals.data(), vlen);
+        setWords(words.data(), var, index, vlen);
+
     } else {
         bp::extract<float> tmp(value);
 
@@ -2273,7 +2788,6 @@ void rim::Block::setFloat8Py(bp::object& value, rim::Variable* var, int32_t inde
 // Get data using float8
 bp::object rim::Block::getFloat8Py(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
@@ -2282,7 +2796,9 @@ bp::object rim::Block::getFloat8Py(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getFloat8(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        decodeFloat8Array(dst, words.data(), var->numValues_);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -2363,10 +2879,17 @@ void rim::Block::setBFloat16Py(bp::object& value, rim::Variable* var, int32_t in
         if (PyArray_TYPE(arr) == NPY_FLOAT) {
             float* src          = reinterpret_cast<float*>(PyArray_DATA(arr));
             npy_intp stride     = strides[0] / sizeof(float);
-            for (x = 0; x < dims[0]; x++) {
-                float val = src[x * stride];
-                setBFloat16(val, var, index + x);
+            std::vector<float> vals;
+            if (stride != 1) {
+                vals.resize(dims[0]);
+                for (x = 0; x < dims[0]; x++) vals[x] = src[x * stride];
+                src = vals.data();
             }
+
+            std::vector<uint64_t> words(dims[0]);
+            checkFloatRange(src, dims[0], var, "Block::setBFloat16");
+            encodeBFloat16Array(words.data(), src, dims[0]);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setBFloat16Py",
                                               "Passed nparray is not of type (float32) for %s",
@@ -2387,6 +2910,7 @@ void rim::Block::setBFloat16Py(bp::object& value, rim::Variable* var, int32_t in
                                               var->numValues_,
                                               var->name_.c_str()));
 
+        std::vector<float> vals(vlen);
         for (x = 0; x < vlen; x++) {
             bp::extract<float> tmp(vl[x]);
 
@@ -2395,9 +2919,14 @@ void rim::Block::setBFloat16Py(bp::object& value, rim::Variable* var, int32_t in
                                                   "Failed to extract value for %s.",
                                                   var->name_.c_str()));
 
-            setBFloat16(tmp, var, index + x);
+            vals[x] = tmp;
         }
 
+        std::vector<uint64_t> words(vlen);
+        checkFloatRange(vals.data(), vlen, var, "Block::setBFloat16");
+        encodeBFloat16Array(words.data(), vals.data(), vlen);
+        setWords(words.data(), var, index, vlen);
+
     } else {
         bp::extract<float> tmp(value);
 
@@ -2413,7 +2942,6 @@ void rim::Block::setBFloat16Py(bp::object& value, rim::Variable* var, int32_t in
 // Get data using bfloat16
 bp::object rim::Block::getBFloat16Py(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
@@ -2422,7 +2950,9 @@ bp::object rim::Block::getBFloat16Py(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getBFloat16(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        decodeBFloat16Array(dst, words.data(), var->numValues_);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -2503,10 +3033,17 @@ void rim::Block::setTensorFloat32Py(bp::object& value, rim::Variable* var, int32
         if (PyArray_TYPE(arr) == NPY_FLOAT) {
             float* src          = reinterpret_cast<float*>(PyArray_DATA(arr));
             npy_intp stride     = strides[0] / sizeof(float);
-            for (x = 0; x < dims[0]; x++) {
-                float val = src[x * stride];
-                setTensorFloat32(val, var, index + x);
+            std::vector<float> vals;
+            if (stride != 1) {
+                vals.resize(dims[0]);
+                for (x = 0; x < dims[0]; x++) vals[x] = src[x * stride];
+                src = vals.data();
             }
+
+            std::vector<uint64_t> words(dims[0]);
+            checkFloatRange(src, dims[0], var, "Block::setTensorFloat32");
+            encodeTensorFloat32Array(words.data(), src, dims[0]);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setTensorFloat32Py",
                                               "Passed nparray is not of type (float32) for %s",
@@ -2527,6 +3064,7 @@ void rim::Block::setTensorFloat32Py(bp::object& value, rim::Variable* var, int32
                                               var->numValues_,
                                               var->name_.c_str()));
 
+        std::vector<float> vals(vlen);
         for (x = 0; x < vlen; x++) {
             bp::extract<float> tmp(vl[x]);
 
@@ -2535,9 +3073,14 @@ void rim::Block::setTensorFloat32Py(bp::object& value, rim::Variable* var, int32
                                                   "Failed to extract value for %s.",
                                                   var->name_.c_str()));
 
-            setTensorFloat32(tmp, var, index + x);
+            vals[x] = tmp;
         }
 
+        std::vector<uint64_t> words(vlen);
+        checkFloatRange(vals.data(), vlen, var, "Block::setTensorFloat32");
+        encodeTensorFloat32Array(words.data(), vals.data(), vlen);
+        setWords(words.data(), var, index, vlen);
+
     } else {
         bp::extract<float> tmp(value);
 
@@ -2553,7 +3096,6 @@ void rim::Block::setTensorFloat32Py(bp::object& value, rim::Variable* var, int32
 // Get data using TensorFloat32
 bp::object rim::Block::getTensorFloat32Py(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
@@ -2562,7 +3104,9 @@ bp::object rim::Block::getTensorFloat32Py(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getTensorFloat32(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        decodeTensorFloat32Array(dst, words.data(), var->numValues_);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -2643,10 +3187,17 @@ void rim::Block::setFloat6Py(bp::object& value, rim::Variable* var, int32_t inde
         if (PyArray_TYPE(arr) == NPY_FLOAT) {
             float* src          = reinterpret_cast<float*>(PyArray_DATA(arr));
             npy_intp stride     = strides[0] / sizeof(float);
-            for (x = 0; x < dims[0]; x++) {
-                float val = src[x * stride];
-                setFloat6(val, var, index + x);
+            std::vector<float> vals;
+            if (stride != 1) {
+                vals.resize(dims[0]);
+                for (x = 0; x < dims[0]; x++) vals[x] = src[x * stride];
+                src = vals.data();
             }
+
+            std::vector<uint64_t> words(dims[0]);
+            checkFloatRange(src, dims[0], var, "Block::setFloat6");
+            encodeFloat6Array(words.data(), src, dims[0]);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFloat6Py",
                                               "Passed nparray is not of type (float32) for %s",
@@ -2667,6 +3218,7 @@ void rim::Block::setFloat6Py(bp::object& value, rim::Variable* var, int32_t inde
                                               var->numValues_,
                                               var->name_.c_str()));
 
+        std::vector<float> vals(vlen);
         for (x = 0; x < vlen; x++) {
             bp::extract<float> tmp(vl[x]);
 
@@ -2675,9 +3227,14 @@ void rim::Block::setFloat6Py(bp::object& value, rim::Variable* var, int32_t inde
                                                   "Failed to extract value for %s.",
                                                   var->name_.c_str()));
 
-            setFloat6(tmp, var, index + x);
+            vals[x] = tmp;
         }
 
+        std::vector<uint64_t> words(vlen);
+        checkFloatRange(vals.data(), vlen, var, "Block::setFloat6");
+        encodeFloat6Array(words.data(), vals.data(), vlen);
+        setWords(words.data(), var, index, vlen);
+
     } else {
         bp::extract<float> tmp(value);
 
@@ -2693,7 +3250,6 @@ void rim::Block::setFloat6Py(bp::object& value, rim::Variable* var, int32_t inde
 // Get data using float6
 bp::object rim::Block::getFloat6Py(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
@@ -2702,7 +3258,9 @@ bp::object rim::Block::getFloat6Py(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getFloat6(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        decodeFloat6Array(dst, words.data(), var->numValues_);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -2783,10 +3341,17 @@ void rim::Block::setFloat4Py(bp::object& value, rim::Variable* var, int32_t inde
         if (PyArray_TYPE(arr) == NPY_FLOAT) {
             float* src          = reinterpret_cast<float*>(PyArray_DATA(arr));
             npy_intp stride     = strides[0] / sizeof(float);
-            for (x = 0; x < dims[0]; x++) {
-                float val = src[x * stride];
-                setFloat4(val, var, index + x);
+            std::vector<float> vals;
+            if (stride != 1) {
+                vals.resize(dims[0]);
+                for (x = 0; x < dims[0]; x++) vals[x] = src[x * stride];
+                src = vals.data();
             }
+
+            std::vector<uint64_t> words(dims[0]);
+            checkFloatRange(src, dims[0], var, "Block::setFloat4");
+            encodeFloat4Array(words.data(), src, dims[0]);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFloat4Py",
                                               "Passed nparray is not of type (float32) for %s",
@@ -2807,6 +3372,7 @@ void rim::Block::setFloat4Py(bp::object& value, rim::Variable* var, int32_t inde
                                               var->numValues_,
                                               var->name_.c_str()));
 
+        std::vector<float> vals(vlen);
         for (x = 0; x < vlen; x++) {
             bp::extract<float> tmp(vl[x]);
 
@@ -2815,9 +3381,14 @@ void rim::Block::setFloat4Py(bp::object& value, rim::Variable* var, int32_t inde
                                                   "Failed to extract value for %s.",
                                                   var->name_.c_str()));
 
-            setFloat4(tmp, var, index + x);
+            vals[x] = tmp;
         }
 
+        std::vector<uint64_t> words(vlen);
+        checkFloatRange(vals.data(), vlen, var, "Block::setFloat4");
+        encodeFloat4Array(words.data(), vals.data(), vlen);
+        setWords(words.data(), var, index, vlen);
+
     } else {
         bp::extract<float> tmp(value);
 
@@ -2833,7 +3404,6 @@ void rim::Block::setFloat4Py(bp::object& value, rim::Variable* var, int32_t inde
 // Get data using float4
 bp::object rim::Block::getFloat4Py(rim::Variable* var, int32_t index) {
     bp::object ret;
-    uint32_t x;
 
     // Unindexed with a list variable
     if (index < 0 && var->numValues_ > 0) {
@@ -2842,7 +3412,9 @@ bp::object rim::Block::getFloat4Py(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         float* dst         = reinterpret_cast<float*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getFloat4(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        decodeFloat4Array(dst, words.data(), var->numValues_);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -2923,9 +3495,9 @@ void rim::Block::setDoublePy(bp::object& value, rim::Variable* var, int32_t inde
         if (PyArray_TYPE(arr) == NPY_FLOAT64) {
             double* src     = reinterpret_cast<double*>(PyArray_DATA(arr));
             npy_intp stride = strides[0] / sizeof(double);
-            for (x = 0; x < dims[0]; x++) {
-                setDouble(src[x * stride], var, index + x);
-            }
+            std::vector<uint64_t> words(dims[0]);
+            for (x = 0; x < dims[0]; x++) words[x] = encodeDouble(src[x * stride], var);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFLoatPy",
                                               "Passed nparray is not of type (double) for %s",
@@ -2993,7 +3565,9 @@ bp::object rim::Block::getDoublePy(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         double* dst        = reinterpret_cast<double*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getDouble(var, x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+        for (x = 0; x < var->numValues_; x++) dst[x] = rawToDouble(words[x]);
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -3012,7 +3586,9 @@ bp::object rim::Block::getDoublePy(rim::Variable* var, int32_t index) {
 #endif
 
 // Set data using double
-void rim::Block::setDouble(const double& val, rim::Variable* var, int32_t index) {
+uint64_t rim::Block::encodeDouble(const double& val, rim::Variable* var) {
+    uint64_t bits;
+
     // Check range
     if ((var->minValue_ != 0 || var->maxValue_ != 0) && (val > var->maxValue_ || val < var->minValue_))
         throw(rogue::GeneralError::create("Block::setDouble",
@@ -3022,7 +3598,13 @@ void rim::Block::setDouble(const double& val, rim::Variable* var, int32_t index)
                                           var->minValue_,
                                           var->maxValue_));
 
-    setBytes(reinterpret_cast<uint8_t*>(const_cast<double*>(&val)), var, index);
+    memcpy(&bits, &val, sizeof(bits));
+    return bits;
+}
+
+void rim::Block::setDouble(const double& val, rim::Variable* var, int32_t index) {
+    uint64_t raw = encodeDouble(val, var);
+    setBytes(reinterpret_cast<uint8_t*>(&raw), var, index);
 }
 
 // Get data using double
@@ -3080,9 +3662,11 @@ void rim::Block::setFixedPy(bp::object& value, rim::Variable* var, int32_t index
         if (PyArray_TYPE(arr) == NPY_FLOAT64) {
             double* src     = reinterpret_cast<double*>(PyArray_DATA(arr));
             npy_intp stride = strides[0] / sizeof(double);
-            for (x = 0; x < dims[0]; x++) {
-                setScalar(src[x * stride], index + x);
-            }
+            std::vector<uint64_t> words(dims[0]);
+            for (x = 0; x < dims[0]; x++)
+                words[x] = (var->modelId_ == rim::UFixed) ? encodeUFixed(src[x * stride], var)
+                                                          : encodeFixed(src[x * stride], var);
+            setWords(words.data(), var, index, dims[0]);
         } else {
             throw(rogue::GeneralError::create("Block::setFixedPy",
                                               "Passed nparray is not of type (double) for %s",
@@ -3155,7 +3739,16 @@ bp::object rim::Block::getFixedPy(rim::Variable* var, int32_t index) {
         PyArrayObject* arr = reinterpret_cast<PyArrayObject*>(obj);
         double* dst        = reinterpret_cast<double*>(PyArray_DATA(arr));
 
-        for (x = 0; x < var->numValues_; x++) dst[x] = getScalar(x);
+        std::vector<uint64_t> words(var->numValues_);
+        getWords(words.data(), var, 0, var->numValues_);
+
+        const double scale = pow(2, var->binPoint_);
+        for (x = 0; x < var->numValues_; x++) {
+            if (var->modelId_ == rim::UFixed)
+                dst[x] = static_cast<double>(words[x]) / scale;
+            else
+                dst[x] = static_cast<double>(signExtend(words[x], var->valueBits_)) / scale;
+        }
 
         boost::python::handle<> handle(obj);
         ret = bp::object(handle);
@@ -3174,7 +3767,7 @@ bp::object rim::Block::getFixedPy(rim::Variable* var, int32_t index) {
 #endif
 
 // Set data using fixed point
-void rim::Block::setFixed(const double& val, rim::Variable* var, int32_t index) {
+uint64_t rim::Block::encodeFixed(const double& val, rim::Variable* var) {
     // Check range
     if ((var->minValue_ != 0 || var->maxValue_ != 0) && (val > var->maxValue_ || val < var->minValue_))
         throw(rogue::GeneralError::create("Block::setFixed",
@@ -3200,32 +3793,26 @@ void rim::Block::setFixed(const double& val, rim::Variable* var, int32_t index)
                                           static_cast<double>(minInt) / pow(2, var->binPoint_),
                                           static_cast<double>(maxInt) / pow(2, var->binPoint_)));
 
-    setBytes(reinterpret_cast<uint8_t*>(&fPoint), var, index);
+    return static_cast<uint64_t>(fPoint);
+}
+
+void rim::Block::setFixed(const double& val, rim::Variable* var, int32_t index) {
+    uint64_t raw = encodeFixed(val, var);
+    setBytes(reinterpret_cast<uint8_t*>(&raw), var, index);
 }
 
 // Get data using fixed point
 double rim::Block::getFixed(rim::Variable* var, int32_t index) {
-    int64_t fPoint = 0;
-    double tmp;
+    uint64_t fPoint = 0;
 
     getBytes(reinterpret_cast<uint8_t*>(&fPoint), var, index);
-    // Sign-extend from valueBits_ to 64 bits. Use 1LL to avoid shifting a
-    // plain int by >= 32 (UB) and guard the valueBits_ == 64 case, where
-    // fPoint already holds the signed two's-complement value directly.
-    if (var->valueBits_ < 64) {
-        const int64_t signBit = 1LL << (var->valueBits_ - 1);
-        const int64_t modulus = 1LL << var->valueBits_;
-        if ((fPoint & signBit) != 0) fPoint -= modulus;
-    }
 
     // Convert to float
-    tmp = static_cast<double>(fPoint);
-    tmp = tmp / pow(2, var->binPoint_);
-    return tmp;
+    return static_cast<double>(signExtend(fPoint, var->valueBits_)) / pow(2, var->binPoint_);
 }
 
 // Set data using unsigned fixed point
-void rim::Block::setUFixed(const double& val, rim::Variable* var, int32_t index) {
+uint64_t rim::Block::encodeUFixed(const double& val, rim::Variable* var) {
     // Check range
     if ((var->minValue_ != 0 || var->maxValue_ != 0) && (val > var->maxValue_ || val < var->minValue_))
         throw(rogue::GeneralError::create("Block::setUFixed",
@@ -3256,7 +3843,12 @@ void rim::Block::setUFixed(const double& val, rim::Variable* var, int32_t index)
                                           val,
                                           static_cast<double>(maxUInt) / pow(2, var->binPoint_)));
 
-    setBytes(reinterpret_cast<uint8_t*>(&fPoint), var, index);
+    return fPoint;
+}
+
+void rim::Block::setUFixed(const double& val, rim::Variable* var, int32_t index) {
+    uint64_t raw = encodeUFixed(val, var);
+    setBytes(reinterpret_cast<uint8_t*>(&raw), var, index);
 }
 
 // Get data using unsigned fixed point
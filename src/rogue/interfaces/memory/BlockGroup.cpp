@@ -0,0 +1,286 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Runs one transaction type across a group of blocks with a bounded number of
+ * transactions in flight.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/memory/BlockGroup.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Block.h"
+#include "rogue/interfaces/memory/Transaction.h"
+
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Completions reported from the transaction threads, shared with the callbacks
+// so late notifications never touch a finished run
+struct Completions {
+    std::mutex mtx;
+    std::condition_variable cond;
+    std::deque<std::pair<uint32_t, uint32_t>> done;  // Block index and issue number
+};
+
+// Transaction in flight, in issue order
+struct Flight {
+    uint32_t index;
+    uint32_t issue;
+    Clock::time_point deadline;
+};
+
+}  // namespace
+
+//! Class creation
+rim::BlockGroupPtr rim::BlockGroup::create(uint32_t window) {
+    rim::BlockGroupPtr r = std::make_shared<rim::BlockGroup>(window);
+    return (r);
+}
+
+//! Setup class for use in python
+void rim::BlockGroup::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rim::BlockGroup, rim::BlockGroupPtr, boost::noncopyable>("BlockGroup", bp::init<uint32_t>())
+        .def("addBlock", &rim::BlockGroup::addBlock)
+        .def("addBlocks", &rim::BlockGroup::addBlocksPy)
+        .def("clear", &rim::BlockGroup::clear)
+        .def("__len__", &rim::BlockGroup::count)
+        .add_property("window", &rim::BlockGroup::getWindow, &rim::BlockGroup::setWindow)
+        .def("_run", &rim::BlockGroup::runPy);
+#endif
+}
+
+//! Creator
+rim::BlockGroup::BlockGroup(uint32_t window) {
+    window_ = (window == 0) ? 1 : window;
+    log_    = rogue::Logging::create("memory.BlockGroup");
+}
+
+//! Destructor
+rim::BlockGroup::~BlockGroup() {}
+
+//! Add a block
+void rim::BlockGroup::addBlock(rim::BlockPtr block) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    blocks_.push_back(block);
+}
+
+//! Add a list of blocks
+void rim::BlockGroup::addBlocks(const std::vector<rim::BlockPtr>& blocks) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    blocks_.insert(blocks_.end(), blocks.begin(), blocks.end());
+}
+
+#ifndef NO_PYTHON
+
+//! Add blocks from a python iterable
+void rim::BlockGroup::addBlocksPy(bp::object blocks) {
+    addBlocks(rim::py_list_to_std_vector<rim::BlockPtr>(blocks));
+}
+
+#endif
+
+//! Remove all blocks
+void rim::BlockGroup::clear() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    blocks_.clear();
+}
+
+//! Get block count
+uint32_t rim::BlockGroup::count() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return blocks_.size();
+}
+
+//! Set the window size
+void rim::BlockGroup::setWindow(uint32_t window) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    window_ = (window == 0) ? 1 : window;
+}
+
+//! Get the window size
+uint32_t rim::BlockGroup::getWindow() {
+    return window_;
+}
+
+//! Run the transactions, returns the blocks with variable updates pending
+std::vector<rim::Block*> rim::BlockGroup::intRun(uint32_t type, bool forceWr, bool skipPyTrans) {
+    std::shared_ptr<Completions> comp = std::make_shared<Completions>();
+    std::vector<std::pair<uint32_t, uint32_t>> done;
+    std::vector<std::string> failed;
+    std::string first;
+    std::vector<rim::Block*> updates;
+    std::deque<uint32_t> pending;
+    std::deque<Flight> flights;
+    std::vector<uint32_t> issues;
+    std::vector<uint32_t> tries;
+    std::vector<bool> forced;
+    std::vector<bool> inFlight;
+    Clock::time_point deadline;
+    uint32_t active;
+    uint32_t index;
+    std::string msg;
+    rim::Block* block;
+    bool started;
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    issues.assign(blocks_.size(), 0);
+    tries.assign(blocks_.size(), 0);
+    forced.assign(blocks_.size(), forceWr);
+    inFlight.assign(blocks_.size(), false);
+    active = 0;
+
+    for (index = 0; index < blocks_.size(); index++)
+        if (!(skipPyTrans && blocks_[index]->blockPyTrans())) pending.push_back(index);
+
+    // Check one completed block, failures are started again until the block retry count is used up
+    auto complete = [&](uint32_t idx) {
+        block         = blocks_[idx].get();
+        inFlight[idx] = false;
+
+        try {
+            if (block->checkTransaction()) updates.push_back(block);
+        } catch (rogue::GeneralError& err) {
+            if (tries[idx] < block->retryCount_) {
+                tries[idx]++;
+                forced[idx] = true;  // Stale state is now lost
+                pending.push_front(idx);
+                log_->warning("Error on try %" PRIu32 " out of %" PRIu32 ": %s",
+                              tries[idx],
+                              block->retryCount_ + 1,
+                              err.what());
+            } else {
+                if (failed.empty()) first = err.what();
+                failed.push_back(block->path_);
+                log_->error("Error on try %" PRIu32 " out of %" PRIu32 ": %s",
+                            tries[idx] + 1,
+                            block->retryCount_ + 1,
+                            err.what());
+            }
+        }
+    };
+
+    while (active > 0 || !pending.empty()) {
+        // Fill the window
+        while (active < window_ && !pending.empty()) {
+            index = pending.front();
+            pending.pop_front();
+            block = blocks_[index].get();
+
+            uint32_t issue                  = ++issues[index];
+            rim::TransactionCallback notify = [comp, index, issue](uint32_t, const std::string&) {
+                std::lock_guard<std::mutex> lock(comp->mtx);
+                comp->done.emplace_back(index, issue);
+                comp->cond.notify_one();
+            };
+
+            started = block->intStartTransaction(type, forced[index], NULL, -1, notify);
+
+            // Nothing to send, the check still runs as it would after startTransaction()
+            if (!started) {
+                complete(index);
+            } else {
+                inFlight[index] = true;
+                active++;
+                flights.push_back({index, issue, Clock::now() + std::chrono::microseconds(block->getTimeout())});
+            }
+        }
+        if (active == 0) continue;
+
+        // Oldest transaction still in flight bounds the wait
+        while (!inFlight[flights.front().index] || issues[flights.front().index] != flights.front().issue)
+            flights.pop_front();
+        deadline = flights.front().deadline;
+
+        done.clear();
+        {
+            std::unique_lock<std::mutex> lock(comp->mtx);
+            while (comp->done.empty() && comp->cond.wait_until(lock, deadline) == std::cv_status::no_timeout) {
+            }
+            done.assign(comp->done.begin(), comp->done.end());
+            comp->done.clear();
+        }
+
+        // Timeouts are detected by the waiter, let the block wait for the oldest
+        if (done.empty()) done.emplace_back(flights.front().index, flights.front().issue);
+
+        for (const auto& d : done) {
+            if (inFlight[d.first] && issues[d.first] == d.second) {
+                active--;
+                complete(d.first);
+            }
+        }
+    }
+
+    // Every error was logged above, the report names the failed blocks and the first error
+    if (!failed.empty()) {
+        msg = failed[0];
+        for (index = 1; index < failed.size(); index++) msg += ", " + failed[index];
+
+        throw(rogue::GeneralError::create("BlockGroup::run",
+                                          "%" PRIu32 " of %" PRIu32
+                                          " blocks failed. First error: %s. Failed blocks: %s",
+                                          static_cast<uint32_t>(failed.size()),
+                                          static_cast<uint32_t>(blocks_.size()),
+                                          first.c_str(),
+                                          msg.c_str()));
+    }
+    return updates;
+}
+
+//! Run a transaction on every block
+void rim::BlockGroup::run(uint32_t type, bool forceWr) {
+    intRun(type, forceWr, false);
+}
+
+#ifndef NO_PYTHON
+
+//! Run a transaction on every block, python version
+void rim::BlockGroup::runPy(uint32_t type, bool forceWr) {
+    std::vector<rim::Block*> updates = intRun(type, forceWr, true);
+
+    for (auto block : updates) block->varUpdate();
+}
+
+#endif
@@ -20,8 +20,10 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <future>
 #include <memory>
 #include <string>
 
@@ -33,11 +35,74 @@
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/Transaction.h"
 
+#if defined(__x86_64__)
+    #include <emmintrin.h>
+#endif
+
 namespace rim = rogue::interfaces::memory;
 
+namespace {
+
+// Little endian load of n <= 8 bytes, upper bytes are zero
+inline uint64_t loadLe(const uint8_t* src, uint32_t n) {
+    uint64_t val = 0;
+    std::memcpy(&val, src, n);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    return val;
+}
+
+// Little endian store of the low n <= 8 bytes
+inline void storeLe(uint8_t* dst, uint64_t val, uint32_t n) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    val = __builtin_bswap64(val);
+#endif
+    std::memcpy(dst, &val, n);
+}
+
+// Read n <= 64 bits starting at bit lsb of src, touching only the bytes which hold them.
+// Bits above n are not cleared.
+inline uint64_t readBits(const uint8_t* src, uint32_t lsb, uint32_t n) {
+    uint32_t bytes = (lsb + n + 7) / 8;
+
+    if (bytes <= 8) return loadLe(src, bytes) >> lsb;
+    return (loadLe(src, 8) >> lsb) | (static_cast<uint64_t>(src[8]) << (64 - lsb));
+}
+
+}  // namespace
+
 #ifndef NO_PYTHON
     #include <boost/python.hpp>
 namespace bp = boost::python;
+
+namespace {
+
+// Python completion callable, its reference is only touched with the GIL held
+class PyTransactionCallback {
+    PyObject* cb_;
+
+  public:
+    explicit PyTransactionCallback(bp::object cb) : cb_(cb.ptr()) {
+        Py_INCREF(cb_);
+    }
+
+    ~PyTransactionCallback() {
+        rogue::ScopedGil gil;
+        Py_DECREF(cb_);
+    }
+
+    void operator()(uint32_t id, const std::string& error) {
+        rogue::ScopedGil gil;
+        try {
+            bp::call<void>(cb_, id, error);
+        } catch (...) {
+            PyErr_Print();
+        }
+    }
+};
+
+}  // namespace
 #endif
 
 //! Create a master container
@@ -59,7 +124,9 @@ void rim::Master::setup_python() {
         .def("_getError", &rim::Master::getError)
         .def("_clearError", &rim::Master::clearError)
         .def("_setTimeout", &rim::Master::setTimeout)
+        .def("_getTimeout", &rim::Master::getTimeout)
         .def("_reqTransaction", &rim::Master::reqTransactionPy)
+        .def("_reqTransactionAsync", &rim::Master::reqTransactionAsyncPy)
         .def("_waitTransaction", &rim::Master::waitTransaction)
         .def("_copyBits", &rim::Master::copyBits)
         .staticmethod("_copyBits")
@@ -74,8 +141,11 @@ void rim::Master::setup_python() {
 
 //! Create object
 rim::Master::Master() {
-    error_ = "";
-    slave_ = rim::Slave::create(4, 0);  // Empty placeholder
+    error_       = "";
+    slave_       = rim::Slave::create(4, 0);  // Empty placeholder
+    asyncThread_ = NULL;
+    asyncRun_    = true;
+    pool_        = std::make_shared<rim::TransactionPool>(256);
 
     rogue::defaultTimeout(sumTime_);
 
@@ -83,10 +153,14 @@ rim::Master::Master() {
 }
 
 //! Destroy object
-rim::Master::~Master() {}
+rim::Master::~Master() {
+    stopAsync();
+}
 
 //! Stop the interface
-void rim::Master::stop() {}
+void rim::Master::stop() {
+    stopAsync();
+}
 
 //! Set slave
 void rim::Master::setSlave(rim::SlavePtr slave) {
@@ -149,9 +223,16 @@ void rim::Master::setTimeout(uint64_t timeout) {
     }
 }
 
+//! Get timeout
+uint64_t rim::Master::getTimeout() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mastMtx_);
+    return static_cast<uint64_t>(sumTime_.tv_sec) * 1000000 + sumTime_.tv_usec;
+}
+
 //! Post a transaction, called locally, forwarded to slave
 uint32_t rim::Master::reqTransaction(uint64_t address, uint32_t size, void* data, uint32_t type) {
-    rim::TransactionPtr tran = rim::Transaction::create(sumTime_);
+    rim::TransactionPtr tran = pool_->get(sumTime_);
 
     tran->iter_    = reinterpret_cast<uint8_t*>(data);
     tran->size_    = size;
@@ -161,6 +242,23 @@ uint32_t rim::Master::reqTransaction(uint64_t address, uint32_t size, void* data
     return (intTransaction(tran));
 }
 
+//! Post a waitable transaction which also notifies on completion
+uint32_t rim::Master::reqTransactionNotify(uint64_t address,
+                                          uint32_t size,
+                                          void* data,
+                                          uint32_t type,
+                                          rim::TransactionCallback notify) {
+    rim::TransactionPtr tran = pool_->get(sumTime_);
+
+    tran->iter_     = reinterpret_cast<uint8_t*>(data);
+    tran->size_     = size;
+    tran->address_  = address;
+    tran->type_     = type;
+    tran->callback_ = notify;
+
+    return (intTransaction(tran));
+}
+
 #ifndef NO_PYTHON
 
 //! Post a transaction, called locally, forwarded to slave, python version
@@ -169,7 +267,29 @@ uint32_t rim::Master::reqTransactionPy(uint64_t address,
                                        uint32_t size,
                                        uint32_t offset,
                                        uint32_t type) {
-    rim::TransactionPtr tran = rim::Transaction::create(sumTime_);
+    return (intTransaction(pyTransaction(address, p, size, offset, type)));
+}
+
+//! Post an asynchronous transaction, python version
+uint32_t rim::Master::reqTransactionAsyncPy(uint64_t address,
+                                            boost::python::object p,
+                                            uint32_t size,
+                                            uint32_t offset,
+                                            uint32_t type,
+                                            boost::python::object callback) {
+    std::shared_ptr<PyTransactionCallback> cb = std::make_shared<PyTransactionCallback>(callback);
+    rim::TransactionPtr tran                  = pyTransaction(address, p, size, offset, type);
+
+    return (intTransactionAsync(tran, [cb](uint32_t id, const std::string& error) { (*cb)(id, error); }));
+}
+
+//! Create a transaction backed by a python buffer
+rim::TransactionPtr rim::Master::pyTransaction(uint64_t address,
+                                               boost::python::object p,
+                                               uint32_t size,
+                                               uint32_t offset,
+                                               uint32_t type) {
+    rim::TransactionPtr tran = pool_->get(sumTime_);
 
     if ((type == rim::Read) || (type == rim::Verify)) {
         if (PyObject_GetBuffer(p.ptr(), &(tran->pyBuf_), PyBUF_CONTIG) < 0)
@@ -199,11 +319,38 @@ uint32_t rim::Master::reqTransactionPy(uint64_t address,
     tran->type_    = type;
     tran->address_ = address;
 
-    return (intTransaction(tran));
+    return (tran);
 }
 
 #endif
 
+//! Post an asynchronous transaction, completion is reported through the callback
+uint32_t rim::Master::reqTransactionAsync(uint64_t address,
+                                          uint32_t size,
+                                          void* data,
+                                          uint32_t type,
+                                          rim::TransactionCallback callback) {
+    rim::TransactionPtr tran = pool_->get(sumTime_);
+
+    tran->iter_    = reinterpret_cast<uint8_t*>(data);
+    tran->size_    = size;
+    tran->address_ = address;
+    tran->type_    = type;
+
+    return (intTransactionAsync(tran, callback));
+}
+
+//! Post a transaction and return a future for its error string
+std::future<std::string> rim::Master::reqTransactionFuture(uint64_t address, uint32_t size, void* data, uint32_t type) {
+    std::shared_ptr<std::promise<std::string> > prom = std::make_shared<std::promise<std::string> >();
+    std::future<std::string> ret                     = prom->get_future();
+
+    reqTransactionAsync(address, size, data, type, [prom](uint32_t, const std::string& error) {
+        prom->set_value(error);
+    });
+    return ret;
+}
+
 uint32_t rim::Master::intTransaction(rim::TransactionPtr tran) {
     TransactionMap::iterator it;
     struct timeval currTime;
@@ -227,6 +374,92 @@ uint32_t rim::Master::intTransaction(rim::TransactionPtr tran) {
     return (tran->id_);
 }
 
+uint32_t rim::Master::intTransactionAsync(rim::TransactionPtr tran, rim::TransactionCallback callback) {
+    rim::SlavePtr slave;
+    bool run;
+
+    tran->callback_ = callback;
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(asyncMtx_);
+
+        if ((run = asyncRun_) && asyncThread_ == NULL) {
+            asyncThread_ = new std::thread(&rim::Master::runAsync, this);
+
+            // Set a thread name
+#ifndef __MACH__
+            pthread_setname_np(asyncThread_->native_handle(), "MemAsync");
+#endif
+        }
+    }
+
+    // Nothing would time the transaction out, fail it right away
+    if (!run) {
+        tran->error("Master is stopped.");
+        tran->wait();
+        return (tran->id_);
+    }
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mastMtx_);
+        slave = slave_;
+    }
+
+    log_->debug("Request async transaction type=%" PRIu32 " id=%" PRIu32, tran->type_, tran->id_);
+    slave->doTransaction(tran);
+    tran->refreshTimer(tran);
+
+    // Hand over to the timeout thread, which also releases buffers once complete
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(asyncMtx_);
+        asyncQueue_.push_back(tran);
+    }
+    asyncCond_.notify_one();
+    return (tran->id_);
+}
+
+//! Wait on asynchronous transactions in issue order
+void rim::Master::runAsync() {
+    rim::TransactionPtr tran;
+
+    while (1) {
+        {
+            std::unique_lock<std::mutex> lock(asyncMtx_);
+            while (asyncRun_ && asyncQueue_.empty()) asyncCond_.wait(lock);
+            if (asyncQueue_.empty()) return;
+
+            tran = asyncQueue_.front();
+            asyncQueue_.pop_front();
+        }
+
+        // Times out the transaction if still outstanding, which calls back
+        tran->wait();
+        tran.reset();
+    }
+}
+
+//! Drain asynchronous transactions and stop the timeout thread
+void rim::Master::stopAsync() {
+    std::thread* thread;
+
+    rogue::GilRelease noGil;
+    {
+        std::lock_guard<std::mutex> lock(asyncMtx_);
+        asyncRun_    = false;
+        thread       = asyncThread_;
+        asyncThread_ = NULL;
+    }
+
+    if (thread != NULL) {
+        asyncCond_.notify_all();
+        thread->join();
+        delete thread;
+    }
+}
+
 // Wait for transaction. Timeout in seconds
 void rim::Master::waitTransaction(uint32_t id) {
     TransactionMap::iterator it;
@@ -257,42 +490,82 @@ void rim::Master::waitTransaction(uint32_t id) {
 
 //! Copy bits from src to dst with lsbs and size
 void rim::Master::copyBits(uint8_t* dstData, uint32_t dstLsb, uint8_t* srcData, uint32_t srcLsb, uint32_t size) {
+    const uint8_t* src;
+    uint8_t* dst;
     uint32_t srcBit;
-    uint32_t srcByte;
     uint32_t dstBit;
-    uint32_t dstByte;
     uint32_t rem;
     uint32_t bytes;
+    uint32_t n;
+    uint64_t val;
+    uint8_t mask;
+
+    if (size == 0) return;
+
+    src    = srcData + srcLsb / 8;
+    srcBit = srcLsb % 8;
+    dst    = dstData + dstLsb / 8;
+    dstBit = dstLsb % 8;
+    rem    = size;
+
+    // Fill the partial first destination byte
+    if (dstBit != 0) {
+        n    = std::min(8 - dstBit, rem);
+        mask = static_cast<uint8_t>(((1U << n) - 1) << dstBit);
+        val  = readBits(src, srcBit, n);
+        *dst = static_cast<uint8_t>((*dst & ~mask) | ((val << dstBit) & mask));
+
+        ++dst;
+        srcBit += n;
+        src += srcBit / 8;
+        srcBit %= 8;
+        rem -= n;
+    }
 
-    srcByte = srcLsb / 8;
-    srcBit  = srcLsb % 8;
-    dstByte = dstLsb / 8;
-    dstBit  = dstLsb % 8;
-    rem     = size;
+    // Destination is byte aligned from here
+    bytes = rem / 8;
 
-    if (rem == 0) return;
+    if (srcBit == 0) {
+        std::memcpy(dst, src, bytes);
+        dst += bytes;
+        src += bytes;
+        rem -= bytes * 8;
+    } else {
+        // Each output word takes the upper bits of one source word and the lower
+        // bits of the next, two overlapping loads one byte apart cover both
+#if defined(__x86_64__)
+        const __m128i rs = _mm_cvtsi32_si128(srcBit);
+        const __m128i ls = _mm_cvtsi32_si128(8 - srcBit);
+
+        while (rem >= 128) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 1));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                             _mm_or_si128(_mm_srl_epi64(lo, rs), _mm_sll_epi64(hi, ls)));
+            dst += 16;
+            src += 16;
+            rem -= 128;
+        }
+#endif
+        while (rem >= 64) {
+            storeLe(dst, (loadLe(src, 8) >> srcBit) | (loadLe(src + 1, 8) << (8 - srcBit)), 8);
+            dst += 8;
+            src += 8;
+            rem -= 64;
+        }
+    }
 
-    do {
+    // Remaining whole bytes and the partial last byte
+    if (rem != 0) {
+        val   = readBits(src, srcBit, rem);
         bytes = rem / 8;
+        storeLe(dst, val, bytes);
 
-        // Aligned
-        if ((srcBit == 0) && (dstBit == 0) && (bytes > 0)) {
-            std::memcpy(&(dstData[dstByte]), &(srcData[srcByte]), bytes);
-            dstByte += bytes;
-            srcByte += bytes;
-            rem -= (bytes * 8);
-
-            // Not aligned
-        } else {
-            dstData[dstByte] &= ((0x1 << dstBit) ^ 0xFF);
-            dstData[dstByte] |= ((srcData[srcByte] >> srcBit) & 0x1) << dstBit;
-            srcByte += (++srcBit / 8);
-            dstByte += (++dstBit / 8);
-            srcBit %= 8;
-            dstBit %= 8;
-            rem -= 1;
+        if ((rem % 8) != 0) {
+            mask       = static_cast<uint8_t>((1U << (rem % 8)) - 1);
+            dst[bytes] = static_cast<uint8_t>((dst[bytes] & ~mask) | ((val >> (bytes * 8)) & mask));
         }
-    } while (rem != 0);
+    }
 }
 
 #ifndef NO_PYTHON
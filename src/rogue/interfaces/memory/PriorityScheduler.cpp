@@ -0,0 +1,285 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which issues transactions by priority class.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/memory/PriorityScheduler.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+rim::PrioritySchedulerPtr rim::PriorityScheduler::create(uint32_t window) {
+    rim::PrioritySchedulerPtr r = std::make_shared<rim::PriorityScheduler>(window);
+    return (r);
+}
+
+//! Setup class for use in python
+void rim::PriorityScheduler::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rim::PriorityScheduler,
+               rim::PrioritySchedulerPtr,
+               bp::bases<rim::Master, rim::Slave>,
+               boost::noncopyable>(
+        "PriorityScheduler",
+        bp::init<uint32_t>())
+        .def("setWindow", &rim::PriorityScheduler::setWindow)
+        .def("setStarvationLimit", &rim::PriorityScheduler::setStarvationLimit)
+        .def("getInFlight", &rim::PriorityScheduler::getInFlight)
+        .def("getQueueDepth", &rim::PriorityScheduler::getQueueDepth)
+        .def("getIssueCount", &rim::PriorityScheduler::getIssueCount)
+        .def("_stop", &rim::PriorityScheduler::stop);
+
+    bp::implicitly_convertible<rim::PrioritySchedulerPtr, rim::MasterPtr>();
+    bp::implicitly_convertible<rim::PrioritySchedulerPtr, rim::SlavePtr>();
+#endif
+}
+
+//! Creator
+rim::PriorityScheduler::PriorityScheduler(uint32_t window) : Hub(0, 0, 0) {
+    window_      = std::max(window, static_cast<uint32_t>(1));
+    inFlight_    = 0;
+    starveLimit_ = 4;
+    dispatching_ = false;
+    stopped_     = false;
+
+    for (uint32_t i = 0; i <= rim::PriorityHigh; i++) {
+        skip_[i]       = 0;
+        issueCount_[i] = 0;
+    }
+
+    log_ = rogue::Logging::create("memory.PriorityScheduler");
+}
+
+//! Destructor
+rim::PriorityScheduler::~PriorityScheduler() {
+    stop();
+}
+
+//! Fail queued transactions and stop the stage
+void rim::PriorityScheduler::stop() {
+    std::vector<rim::TransactionPtr> queued;
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+        stopped_ = true;
+
+        for (auto& q : queue_) {
+            queued.insert(queued.end(), q.begin(), q.end());
+            q.clear();
+        }
+    }
+
+    for (auto& tran : queued) {
+        rim::TransactionLockPtr tlock = tran->lock();
+        if (!tran->expired()) tran->errorStr("PriorityScheduler stopped");
+    }
+    rim::Master::stop();
+}
+
+//! Set window
+void rim::PriorityScheduler::setWindow(uint32_t window) {
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+        window_ = std::max(window, static_cast<uint32_t>(1));
+    }
+    dispatch();
+}
+
+//! Set starvation limit
+void rim::PriorityScheduler::setStarvationLimit(uint32_t limit) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    starveLimit_ = limit;
+}
+
+//! Get outstanding count
+uint32_t rim::PriorityScheduler::getInFlight() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return inFlight_;
+}
+
+//! Get queue depth
+uint32_t rim::PriorityScheduler::getQueueDepth(uint32_t priority) {
+    if (priority > rim::PriorityHigh)
+        throw(rogue::GeneralError::create("PriorityScheduler::getQueueDepth", "Invalid priority %" PRIu32, priority));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return queue_[priority].size();
+}
+
+//! Get issue count
+uint64_t rim::PriorityScheduler::getIssueCount(uint32_t priority) {
+    if (priority > rim::PriorityHigh)
+        throw(rogue::GeneralError::create("PriorityScheduler::getIssueCount", "Invalid priority %" PRIu32, priority));
+
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return issueCount_[priority];
+}
+
+//! Post a transaction. Master will call this method with the access attributes.
+void rim::PriorityScheduler::doTransaction(rim::TransactionPtr tran) {
+    uint32_t priority = std::min(tran->priority(), rim::PriorityHigh);
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        if (!stopped_) {
+            queue_[priority].push_back(tran);
+            tran.reset();
+        }
+    }
+
+    if (tran)
+        rim::Hub::doTransaction(tran);
+    else
+        dispatch();
+}
+
+//! Take the next transaction to issue, called with mtx_ held
+rim::TransactionPtr rim::PriorityScheduler::next() {
+    rim::TransactionPtr tran;
+    int32_t pick = -1;
+    int32_t i;
+
+    // Lower priorities which waited long enough go first
+    if (starveLimit_ != 0) {
+        for (i = 0; i < static_cast<int32_t>(rim::PriorityHigh) && pick < 0; i++)
+            if (!queue_[i].empty() && skip_[i] >= starveLimit_) pick = i;
+    }
+
+    for (i = rim::PriorityHigh; i >= 0 && pick < 0; i--)
+        if (!queue_[i].empty()) pick = i;
+
+    if (pick < 0) return tran;
+
+    for (i = 0; i < pick; i++)
+        if (!queue_[i].empty()) skip_[i]++;
+    skip_[pick] = 0;
+
+    tran = queue_[pick].front();
+    queue_[pick].pop_front();
+    issueCount_[pick]++;
+    return tran;
+}
+
+//! Issue transactions while the window has room
+void rim::PriorityScheduler::dispatch() {
+    rim::TransactionPtr tran;
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        // The running loop picks up any freed slot
+        if (dispatching_) return;
+        dispatching_ = true;
+    }
+
+    while (1) {
+        {
+            rogue::GilRelease noGil;
+            std::lock_guard<std::mutex> lock(mtx_);
+
+            if (inFlight_ >= window_ || !(tran = next())) {
+                dispatching_ = false;
+                return;
+            }
+            inFlight_++;
+        }
+        issue(tran);
+    }
+}
+
+//! Issue one transaction to the next stage
+void rim::PriorityScheduler::issue(rim::TransactionPtr tran) {
+    std::shared_ptr<std::vector<uint8_t>> buff = std::make_shared<std::vector<uint8_t>>(tran->size());
+    uint32_t type                              = tran->type();
+
+    {
+        rim::TransactionLockPtr tlock = tran->lock();
+
+        // Timed out while queued
+        if (tran->expired()) {
+            rogue::GilRelease noGil;
+            std::lock_guard<std::mutex> lock(mtx_);
+            inFlight_--;
+            return;
+        }
+
+        if (type == rim::Write || type == rim::Post) std::copy(tran->begin(), tran->end(), buff->begin());
+    }
+
+    log_->debug("Issue transaction id=%" PRIu32 ", priority=%" PRIu32 ", address=0x%016" PRIx64 ", size=%" PRIu32,
+                tran->id(),
+                tran->priority(),
+                tran->address(),
+                tran->size());
+
+    reqTransactionAsync(tran->address(),
+                        tran->size(),
+                        buff->data(),
+                        type,
+                        [this, tran, buff, type](uint32_t, const std::string& error) {
+                            {
+                                rim::TransactionLockPtr tlock = tran->lock();
+
+                                if (!tran->expired()) {
+                                    if (error != "") {
+                                        tran->errorStr(error);
+                                    } else {
+                                        if (type != rim::Write && type != rim::Post)
+                                            std::copy(buff->begin(), buff->end(), tran->begin());
+                                        tran->done();
+                                    }
+                                }
+                            }
+
+                            {
+                                rogue::GilRelease noGil;
+                                std::lock_guard<std::mutex> lock(mtx_);
+                                inFlight_--;
+                            }
+                            dispatch();
+                        });
+}
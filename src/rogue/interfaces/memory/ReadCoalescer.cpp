@@ -0,0 +1,307 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which merges reads of adjacent blocks into larger transactions.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/memory/ReadCoalescer.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+namespace {
+
+// Combined read and the transactions it serves
+struct Combined {
+    std::vector<rim::TransactionPtr> reads;
+    std::vector<uint8_t> data;
+    uint64_t address;
+};
+
+}  // namespace
+
+//! Class creation
+rim::ReadCoalescerPtr rim::ReadCoalescer::create(uint32_t holdTime) {
+    rim::ReadCoalescerPtr r = std::make_shared<rim::ReadCoalescer>(holdTime);
+    return (r);
+}
+
+//! Setup class for use in python
+void rim::ReadCoalescer::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rim::ReadCoalescer, rim::ReadCoalescerPtr, bp::bases<rim::Master, rim::Slave>, boost::noncopyable>(
+        "ReadCoalescer",
+        bp::init<uint32_t>())
+        .def("addOverReadRange", &rim::ReadCoalescer::addOverReadRange)
+        .def("setHoldTime", &rim::ReadCoalescer::setHoldTime)
+        .def("flush", &rim::ReadCoalescer::flush)
+        .def("getReadCount", &rim::ReadCoalescer::getReadCount)
+        .def("getIssueCount", &rim::ReadCoalescer::getIssueCount)
+        .def("_stop", &rim::ReadCoalescer::stop);
+
+    bp::implicitly_convertible<rim::ReadCoalescerPtr, rim::MasterPtr>();
+    bp::implicitly_convertible<rim::ReadCoalescerPtr, rim::SlavePtr>();
+#endif
+}
+
+//! Creator
+rim::ReadCoalescer::ReadCoalescer(uint32_t holdTime) : Hub(0, 0, 0) {
+    groupStart_ = 0;
+    groupEnd_   = 0;
+    groupType_  = 0;
+    holdTime_   = holdTime;
+    readCount_  = 0;
+    issueCount_ = 0;
+
+    log_ = rogue::Logging::create("memory.ReadCoalescer");
+
+    threadEn_ = true;
+    thread_   = new std::thread(&rim::ReadCoalescer::runThread, this);
+
+    // Set a thread name
+#ifndef __MACH__
+    pthread_setname_np(thread_->native_handle(), "ReadCoalescer");
+#endif
+}
+
+//! Destructor
+rim::ReadCoalescer::~ReadCoalescer() {
+    stop();
+}
+
+//! Stop the issue thread
+void rim::ReadCoalescer::stop() {
+    std::thread* thread;
+
+    {
+        rogue::GilRelease noGil;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            thread    = thread_;
+            thread_   = NULL;
+            threadEn_ = false;
+        }
+        send();
+    }
+
+    if (thread != NULL) {
+        rogue::GilRelease noGil;
+        cond_.notify_all();
+        thread->join();
+        delete thread;
+    }
+    rim::Master::stop();
+}
+
+//! Allow reads over unused addresses in a range
+void rim::ReadCoalescer::addOverReadRange(uint64_t address, uint64_t size, uint32_t maxGap) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    overRead_.push_back({address, address + size, maxGap});
+}
+
+//! Set hold time
+void rim::ReadCoalescer::setHoldTime(uint32_t holdTime) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    holdTime_ = holdTime;
+    cond_.notify_all();
+}
+
+//! Issue the current group
+void rim::ReadCoalescer::flush() {
+    rogue::GilRelease noGil;
+    send();
+}
+
+//! Get read count
+uint64_t rim::ReadCoalescer::getReadCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return readCount_;
+}
+
+//! Get issued read count
+uint64_t rim::ReadCoalescer::getIssueCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return issueCount_;
+}
+
+//! Returns true if the hole between from and to may be read
+bool rim::ReadCoalescer::holeAllowed(uint64_t from, uint64_t to) {
+    for (const auto& r : overRead_)
+        if (from >= r.start && to <= r.end && (to - from) <= r.maxGap) return true;
+    return false;
+}
+
+//! Post a transaction. Master will call this method with the access attributes.
+void rim::ReadCoalescer::doTransaction(rim::TransactionPtr tran) {
+    uint32_t maxAccess = getSlave()->doMaxAccess();
+    uint64_t address   = tran->address();
+    uint32_t type      = tran->type();
+    bool read          = (type == rim::Read || type == rim::Verify) && tran->size() <= maxAccess;
+    Group grp;
+
+    // Groups still being sent reach the hardware first
+    rogue::GilRelease noGil;
+    std::lock_guard<std::recursive_mutex> ilock(issueMtx_);
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    if (read) readCount_++;
+
+    // Join the current group
+    if (read && threadEn_ && !group_.empty() && type == groupType_ && address >= groupEnd_ &&
+        (address + tran->size() - groupStart_) <= maxAccess &&
+        (address == groupEnd_ || holeAllowed(groupEnd_, address))) {
+        group_.push_back(tran);
+        groupEnd_  = address + tran->size();
+        groupTime_ = std::chrono::steady_clock::now();
+
+        if ((groupEnd_ - groupStart_) == maxAccess) detach(grp);
+        lock.unlock();
+        issue(grp);
+        return;
+    }
+
+    // Keep arrival order
+    detach(grp);
+
+    // Start a new group
+    if (read && threadEn_) {
+        group_.push_back(tran);
+        groupStart_ = address;
+        groupEnd_   = address + tran->size();
+        groupType_  = type;
+        groupTime_  = std::chrono::steady_clock::now();
+        cond_.notify_all();
+        lock.unlock();
+        issue(grp);
+        return;
+    }
+
+    if (read) issueCount_++;
+    lock.unlock();
+    issue(grp);
+    rim::Hub::doTransaction(tran);
+}
+
+//! Move the current group into grp, called with mtx_ held
+void rim::ReadCoalescer::detach(Group& grp) {
+    if (group_.empty()) return;
+
+    issueCount_++;
+    grp.reads.swap(group_);
+    grp.start = groupStart_;
+    grp.end   = groupEnd_;
+    grp.type  = groupType_;
+}
+
+//! Detach and issue the current group, called without mtx_ held
+void rim::ReadCoalescer::send() {
+    Group grp;
+
+    std::lock_guard<std::recursive_mutex> ilock(issueMtx_);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        detach(grp);
+    }
+    issue(grp);
+}
+
+//! Issue a detached group, called with issueMtx_ held
+void rim::ReadCoalescer::issue(Group& grp) {
+    std::shared_ptr<Combined> comb;
+
+    if (grp.reads.empty()) return;
+
+    if (grp.reads.size() == 1) {
+        rim::Hub::doTransaction(grp.reads[0]);
+        return;
+    }
+
+    comb          = std::make_shared<Combined>();
+    comb->address = grp.start;
+    comb->data.resize(grp.end - grp.start);
+    comb->reads.swap(grp.reads);
+
+    log_->debug("Combining %" PRIu32 " reads into address=0x%016" PRIx64 ", size=%" PRIu32,
+                static_cast<uint32_t>(comb->reads.size()),
+                grp.start,
+                static_cast<uint32_t>(comb->data.size()));
+
+    reqTransactionAsync(comb->address,
+                        comb->data.size(),
+                        comb->data.data(),
+                        grp.type,
+                        [comb](uint32_t, const std::string& error) {
+                            for (auto& tran : comb->reads) {
+                                rim::TransactionLockPtr lock = tran->lock();
+                                if (tran->expired()) continue;
+
+                                if (error != "") {
+                                    tran->errorStr(error);
+                                } else {
+                                    auto first = comb->data.begin() + (tran->address() - comb->address);
+                                    std::copy(first, first + tran->size(), tran->begin());
+                                    tran->done();
+                                }
+                            }
+                        });
+}
+
+//! Thread to issue groups once the hold time expires
+void rim::ReadCoalescer::runThread() {
+    std::chrono::steady_clock::time_point deadline;
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (threadEn_) {
+        if (group_.empty()) {
+            cond_.wait(lock);
+            continue;
+        }
+
+        deadline = groupTime_ + std::chrono::microseconds(holdTime_);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            lock.unlock();
+            send();
+            lock.lock();
+        } else {
+            cond_.wait_until(lock, deadline);
+        }
+    }
+}
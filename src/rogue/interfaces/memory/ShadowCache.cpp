@@ -0,0 +1,317 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which serves reads of registers from a shadow copy.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/memory/ShadowCache.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+rim::ShadowCachePtr rim::ShadowCache::create() {
+    rim::ShadowCachePtr r = std::make_shared<rim::ShadowCache>();
+    return (r);
+}
+
+//! Setup class for use in python
+void rim::ShadowCache::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rim::ShadowCache, rim::ShadowCachePtr, bp::bases<rim::Master, rim::Slave>, boost::noncopyable>(
+        "ShadowCache",
+        bp::init<>())
+        .def("addRange", &rim::ShadowCache::addRange)
+        .def("invalidate", &rim::ShadowCache::invalidate)
+        .def("invalidateRange", &rim::ShadowCache::invalidateRange)
+        .def("getHitCount", &rim::ShadowCache::getHitCount)
+        .def("getMissCount", &rim::ShadowCache::getMissCount)
+        .def("resetCounters", &rim::ShadowCache::resetCounters);
+
+    bp::implicitly_convertible<rim::ShadowCachePtr, rim::MasterPtr>();
+    bp::implicitly_convertible<rim::ShadowCachePtr, rim::SlavePtr>();
+#endif
+}
+
+//! Creator
+rim::ShadowCache::ShadowCache() : Hub(0, 0, 0) {
+    hitCount_  = 0;
+    missCount_ = 0;
+    log_       = rogue::Logging::create("memory.ShadowCache");
+}
+
+//! Destructor
+rim::ShadowCache::~ShadowCache() {
+    // Outstanding callbacks use the ranges
+    rim::Master::stop();
+}
+
+//! Register an address range with a cache policy
+void rim::ShadowCache::addRange(uint64_t address, uint32_t size, uint32_t policy) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (policy != rim::CacheVolatile && policy != rim::CacheWriteThrough && policy != rim::CacheReadOnce)
+        throw(rogue::GeneralError::create("ShadowCache::addRange", "Invalid cache policy %" PRIu32, policy));
+
+    for (const auto& r : ranges_) {
+        if (address < r.end && r.start < address + size)
+            throw(rogue::GeneralError::create("ShadowCache::addRange",
+                                              "Range 0x%" PRIx64 " - 0x%" PRIx64
+                                              " overlaps existing range 0x%" PRIx64 " - 0x%" PRIx64,
+                                              address,
+                                              address + size,
+                                              r.start,
+                                              r.end));
+    }
+
+    Range r;
+    r.start  = address;
+    r.end    = address + size;
+    r.policy = policy;
+    r.epoch  = 0;
+    if (policy != rim::CacheVolatile) {
+        r.data.resize(size, 0);
+        r.valid.resize(size, 0);
+    }
+    ranges_.push_back(std::move(r));
+}
+
+//! Drop the cached copy of every range
+void rim::ShadowCache::invalidate() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    for (auto& r : ranges_) {
+        std::fill(r.valid.begin(), r.valid.end(), 0);
+        r.epoch++;
+    }
+}
+
+//! Drop the cached copy of an address range
+void rim::ShadowCache::invalidateRange(uint64_t address, uint64_t size) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    intInvalidate(address, size);
+}
+
+//! Get hit count
+uint64_t rim::ShadowCache::getHitCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return hitCount_;
+}
+
+//! Get miss count
+uint64_t rim::ShadowCache::getMissCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return missCount_;
+}
+
+//! Reset counters
+void rim::ShadowCache::resetCounters() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    hitCount_  = 0;
+    missCount_ = 0;
+}
+
+//! Returns index of the cached range holding the whole access or -1, called with mtx_ held
+int32_t rim::ShadowCache::findRange(uint64_t address, uint32_t size) {
+    for (uint32_t i = 0; i < ranges_.size(); i++) {
+        const Range& r = ranges_[i];
+        if (address >= r.start && (address + size) <= r.end) return (r.policy == rim::CacheVolatile) ? -1 : i;
+    }
+    return -1;
+}
+
+//! Drop bytes of every overlapping range, called with mtx_ held
+void rim::ShadowCache::intInvalidate(uint64_t address, uint64_t size) {
+    uint64_t first;
+    uint64_t last;
+
+    for (auto& r : ranges_) {
+        if (r.policy == rim::CacheVolatile || address >= r.end || r.start >= address + size) continue;
+
+        first = std::max(address, r.start) - r.start;
+        last  = std::min(address + size, r.end) - r.start;
+        std::fill(r.valid.begin() + first, r.valid.begin() + last, 0);
+        r.epoch++;
+    }
+}
+
+//! Post a transaction. Master will call this method with the access attributes.
+void rim::ShadowCache::doTransaction(rim::TransactionPtr tran) {
+    std::vector<std::pair<int32_t, uint64_t>> epochs;
+    uint32_t maxAccess = getSlave()->doMaxAccess();
+    uint64_t address   = tran->address();
+    uint32_t size      = tran->size();
+    uint32_t type      = tran->type();
+    uint64_t epoch     = 0;
+    int32_t idx        = -1;
+    bool hit           = false;
+    std::vector<uint8_t> data;
+
+    {
+        rogue::GilRelease noGil;
+        std::lock_guard<std::mutex> lock(mtx_);
+
+        if (type == rim::Read || type == rim::Verify) {
+            if ((idx = findRange(address, size)) >= 0 && size <= maxAccess) {
+                Range& r = ranges_[idx];
+                uint64_t off = address - r.start;
+
+                // Served from the cache
+                if (type == rim::Read &&
+                    std::find(r.valid.begin() + off, r.valid.begin() + off + size, 0) == r.valid.begin() + off + size) {
+                    hitCount_++;
+                    hit = true;
+                    data.assign(r.data.begin() + off, r.data.begin() + off + size);
+                } else {
+                    if (type == rim::Read) missCount_++;
+                    epoch = r.epoch;
+                }
+            } else {
+                idx = -1;
+            }
+        } else if (type == rim::Write || type == rim::Post) {
+            intInvalidate(address, size);
+
+            // Ranges which take the written value once the write succeeds
+            if (size <= maxAccess) {
+                for (uint32_t i = 0; i < ranges_.size(); i++) {
+                    const Range& r = ranges_[i];
+                    if (r.policy == rim::CacheWriteThrough && address < r.end && r.start < address + size)
+                        epochs.push_back(std::make_pair(static_cast<int32_t>(i), r.epoch));
+                }
+            }
+        }
+    }
+
+    // Complete hits once the cache is unlocked, done() may re-enter the stage
+    if (hit) {
+        rim::TransactionLockPtr tlock = tran->lock();
+        if (!tran->expired()) {
+            std::copy(data.begin(), data.end(), tran->begin());
+            tran->done();
+        }
+    } else if (idx >= 0) {
+        cacheRead(tran, idx, epoch);
+    } else if (!epochs.empty()) {
+        cacheWrite(tran, epochs);
+    } else {
+        rim::Hub::doTransaction(tran);
+    }
+}
+
+//! Read the hardware and fill range idx unless its epoch moved on
+void rim::ShadowCache::cacheRead(rim::TransactionPtr tran, int32_t idx, uint64_t epoch) {
+    std::shared_ptr<std::vector<uint8_t>> buff = std::make_shared<std::vector<uint8_t>>(tran->size());
+
+    reqTransactionAsync(tran->address(),
+                        tran->size(),
+                        buff->data(),
+                        tran->type(),
+                        [this, tran, buff, idx, epoch](uint32_t, const std::string& error) {
+                            if (error == "") {
+                                rogue::GilRelease noGil;
+                                std::lock_guard<std::mutex> lock(mtx_);
+                                Range& r = ranges_[idx];
+
+                                if (r.epoch == epoch) {
+                                    uint64_t off = tran->address() - r.start;
+                                    std::copy(buff->begin(), buff->end(), r.data.begin() + off);
+                                    std::fill(r.valid.begin() + off, r.valid.begin() + off + buff->size(), 1);
+                                }
+                            }
+
+                            rim::TransactionLockPtr tlock = tran->lock();
+                            if (tran->expired()) return;
+
+                            if (error != "") {
+                                tran->errorStr(error);
+                            } else {
+                                std::copy(buff->begin(), buff->end(), tran->begin());
+                                tran->done();
+                            }
+                        });
+}
+
+//! Write the hardware and update the listed ranges unless their epochs moved on
+void rim::ShadowCache::cacheWrite(rim::TransactionPtr tran, const std::vector<std::pair<int32_t, uint64_t>>& epochs) {
+    std::shared_ptr<std::vector<uint8_t>> buff = std::make_shared<std::vector<uint8_t>>(tran->size());
+
+    {
+        rim::TransactionLockPtr tlock = tran->lock();
+        std::copy(tran->begin(), tran->end(), buff->begin());
+    }
+
+    reqTransactionAsync(tran->address(),
+                        tran->size(),
+                        buff->data(),
+                        tran->type(),
+                        [this, tran, buff, epochs](uint32_t, const std::string& error) {
+                            if (error == "") {
+                                rogue::GilRelease noGil;
+                                std::lock_guard<std::mutex> lock(mtx_);
+                                uint64_t address = tran->address();
+
+                                for (const auto& e : epochs) {
+                                    Range& r = ranges_[e.first];
+                                    if (r.epoch != e.second) continue;
+
+                                    uint64_t first = std::max(address, r.start);
+                                    uint64_t last  = std::min(address + buff->size(), r.end);
+                                    std::copy(buff->begin() + (first - address),
+                                              buff->begin() + (last - address),
+                                              r.data.begin() + (first - r.start));
+                                    std::fill(r.valid.begin() + (first - r.start),
+                                              r.valid.begin() + (last - r.start),
+                                              1);
+                                }
+                            }
+
+                            rim::TransactionLockPtr tlock = tran->lock();
+                            if (tran->expired()) return;
+
+                            if (error != "")
+                                tran->errorStr(error);
+                            else
+                                tran->done();
+                        });
+}
@@ -18,8 +18,13 @@
 
 #include "rogue/interfaces/memory/Slave.h"
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -35,6 +40,44 @@ namespace bp = boost::python;
 
 namespace rim = rogue::interfaces::memory;
 
+//! Create the response history
+rim::ResponseTracker::ResponseTracker() {
+    window_ = 0;
+}
+
+//! Track the longest timeout
+void rim::ResponseTracker::setWindow(int64_t window) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (window > window_) window_ = window;
+}
+
+//! Record a response
+void rim::ResponseTracker::mark(int64_t start, int64_t now) {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    // A later response covers every transaction an entry with a later start would
+    while ((!marks_.empty()) && marks_.back().first >= start) marks_.pop_back();
+    marks_.push_back(std::make_pair(start, now));
+
+    // Entries older than the longest timeout can no longer extend a deadline
+    while (marks_.front().second + window_ < now) marks_.pop_front();
+}
+
+//! Latest response to a transaction started at or before start
+int64_t rim::ResponseTracker::latest(int64_t start) {
+    std::deque<std::pair<int64_t, int64_t> >::iterator it;
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    it = std::upper_bound(marks_.begin(),
+                          marks_.end(),
+                          start,
+                          [](int64_t s, const std::pair<int64_t, int64_t>& m) { return s < m.first; });
+
+    if (it == marks_.begin()) return 0;
+    return (--it)->second;
+}
+
 // Init class counter
 uint32_t rim::Slave::classIdx_ = 0;
 
@@ -48,7 +91,9 @@ rim::SlavePtr rim::Slave::create(uint32_t min, uint32_t max) {
 }
 
 //! Create object
-rim::Slave::Slave(uint32_t min, uint32_t max) {
+rim::Slave::Slave(uint32_t min, uint32_t max) : expiry_(std::chrono::milliseconds(1)) {
+    tracker_ = std::make_shared<rim::ResponseTracker>();
+
     min_ = min;
     max_ = max;
 
@@ -69,42 +114,74 @@ void rim::Slave::stop() {}
 
 //! Register a master.
 void rim::Slave::addTransaction(rim::TransactionPtr tran) {
+    rogue::TimerWheel::Clock::time_point now;
+    std::chrono::microseconds timeout;
+
+    timeout = std::chrono::seconds(tran->timeout_.tv_sec) + std::chrono::microseconds(tran->timeout_.tv_usec);
+
+    // Set before the request goes out, read by the transaction at its deadline
+    std::atomic_store(&(tran->tracker_), tracker_);
+    tracker_->setWindow(timeout.count());
+
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> lock(slaveMtx_);
-    tranMap_[tran->id()] = tran;
+
+    now = rogue::TimerWheel::Clock::now();
+    reapTransactions(now);
+
+    TranEntry& entry = tranTable_[tran->id()];
+    entry.tran       = tran;
+    entry.timeout    = timeout;
+    expiry_.arm(&entry, now + timeout);
 }
 
 //! Get transaction with index, called by sub classes
 rim::TransactionPtr rim::Slave::getTransaction(uint32_t index) {
     rim::TransactionPtr ret;
-    TransactionMap::iterator it;
-    TransactionMap::iterator exp;
+    TransactionTable::iterator it;
 
     rogue::GilRelease noGil;
-    std::lock_guard<std::mutex> lock(slaveMtx_);
+    {
+        std::lock_guard<std::mutex> lock(slaveMtx_);
 
-    if ((it = tranMap_.find(index)) != tranMap_.end()) {
-        ret = it->second;
+        if ((it = tranTable_.find(index)) == tranTable_.end()) return ret;
 
-        // Remove from list
-        tranMap_.erase(it);
+        ret = it->second.tran;
+        expiry_.cancel(&(it->second));
+        tranTable_.erase(it);
+    }
 
-        // Update any timers for transactions started after received transaction
-        exp = tranMap_.end();
-        for (it = tranMap_.begin(); it != tranMap_.end(); ++it) {
-            if (it->second->expired())
-                exp = it;
-            else
-                it->second->refreshTimer(ret);
-        }
+    // Later transactions refresh from this response if they reach their deadline
+    tracker_->mark(
+        std::chrono::duration_cast<std::chrono::microseconds>(ret->startTime_.time_since_epoch()).count(),
+        std::chrono::duration_cast<std::chrono::microseconds>(rogue::TimerWheel::Clock::now().time_since_epoch())
+            .count());
+    return ret;
+}
 
-        // Clean up if we found an expired transaction, overtime this will clean up
-        // the list, even if it deletes one expired transaction per call
-        if (exp != tranMap_.end()) {
-            tranMap_.erase(exp);
-        }
+//! Remove finished entries whose expiry timer fired
+void rim::Slave::reapTransactions(rogue::TimerWheel::Clock::time_point now) {
+    TranEntry* entry;
+
+    expiry_.advance(now, expired_);
+
+    for (rogue::TimerWheel::Timer* timer : expired_) {
+        entry = static_cast<TranEntry*>(timer);
+
+        // Still pending after a timer refresh, check again later
+        if (!entry->tran->expired())
+            expiry_.arm(entry, now + entry->timeout);
+        else
+            tranTable_.erase(entry->tran->id());
     }
-    return ret;
+    expired_.clear();
+}
+
+//! Get the tracked transaction count
+uint32_t rim::Slave::getTransactionCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(slaveMtx_);
+    return tranTable_.size();
 }
 
 //! Get min size from slave
@@ -168,6 +245,7 @@ void rim::Slave::setup_python() {
         .def("setName", &rim::Slave::setName)
         .def("_addTransaction", &rim::Slave::addTransaction)
         .def("_getTransaction", &rim::Slave::getTransaction)
+        .def("_getTransactionCount", &rim::Slave::getTransactionCount)
         .def("_doMinAccess", &rim::Slave::doMinAccess, &rim::SlaveWrap::defDoMinAccess)
         .def("_doMaxAccess", &rim::Slave::doMaxAccess, &rim::SlaveWrap::defDoMaxAccess)
         .def("_doAddress", &rim::Slave::doAddress, &rim::SlaveWrap::defDoAddress)
@@ -21,10 +21,12 @@
 #include <inttypes.h>
 #include <zmq.h>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <chrono>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -43,6 +45,9 @@ namespace bp = boost::python;
 namespace {
 static constexpr double DefaultReadyTimeout = 10.0;
 static constexpr double DefaultReadyPeriod  = 0.1;
+
+// Version 2 record: id, type, address, size and result length
+static constexpr uint32_t RecordSize = 24;
 }  // namespace
 
 //! Class creation
@@ -67,6 +72,11 @@ rim::TcpClient::TcpClient(std::string addr, uint16_t port, bool waitReady) : rim
     this->probeDone_ = false;
     this->probeResult_.clear();
     this->waitReadyOnStart_ = waitReady;
+    this->helloId_ = 0;
+    this->helloVersion_ = 0;
+    this->maxVersion_ = rim::TcpBridgeVersion;
+    this->version_ = 1;
+    this->batchCount_ = 0;
 
     // Format address
     this->respAddr_ = "tcp://";
@@ -118,10 +128,12 @@ rim::TcpClient::TcpClient(std::string addr, uint16_t port, bool waitReady) : rim
         // Start rx thread
         threadEn_     = true;
         this->thread_ = std::make_unique<std::thread>(&rim::TcpClient::runThread, this);
+        this->sendThread_ = std::make_unique<std::thread>(&rim::TcpClient::runSend, this);
 
         // Set a thread name
 #ifndef __MACH__
         pthread_setname_np(thread_->native_handle(), "TcpClient");
+        pthread_setname_np(sendThread_->native_handle(), "TcpClientTx");
 #endif
     } catch (...) {
         // ~std::thread on a joinable thread calls std::terminate(); join first.
@@ -138,6 +150,14 @@ rim::TcpClient::TcpClient(std::string addr, uint16_t port, bool waitReady) : rim
             }
             thread_.reset();
         }
+        if (sendThread_) {
+            {
+                rogue::GilRelease noGil;
+                batchCond_.notify_all();
+                sendThread_->join();
+            }
+            sendThread_.reset();
+        }
         if (zmqResp_ != nullptr) {
             zmq_close(zmqResp_);
             zmqResp_ = nullptr;
@@ -170,6 +190,9 @@ void rim::TcpClient::stop() {
         threadEn_ = false;
         thread_->join();
         thread_.reset();
+        batchCond_.notify_all();
+        sendThread_->join();
+        sendThread_.reset();
         zmq_close(this->zmqResp_);
         zmqResp_ = nullptr;
         zmq_close(this->zmqReq_);
@@ -179,19 +202,64 @@ void rim::TcpClient::stop() {
     }
 }
 
-bool rim::TcpClient::waitReady(double timeout, double period) {
-    uint32_t id;
+void rim::TcpClient::sendProbe(uint32_t id, uint32_t version) {
     uint64_t addr = 0;
-    uint32_t size = 0;
     uint32_t type = rim::TcpBridgeProbe;
     zmq_msg_t msg[4];
+
+    // Build a minimal internal bridge-control request. The server handles
+    // this locally and responds with the normal six-part completion
+    // message, but without touching downstream memory. A version offer is
+    // carried in the size field.
+    zmq_msg_init_size(&(msg[0]), 4);
+    std::memcpy(zmq_msg_data(&(msg[0])), &id, 4);
+    zmq_msg_init_size(&(msg[1]), 8);
+    std::memcpy(zmq_msg_data(&(msg[1])), &addr, 8);
+    zmq_msg_init_size(&(msg[2]), 4);
+    std::memcpy(zmq_msg_data(&(msg[2])), &version, 4);
+    zmq_msg_init_size(&(msg[3]), 4);
+    std::memcpy(zmq_msg_data(&(msg[3])), &type, 4);
+
+    {
+        std::lock_guard<std::mutex> block(bridgeMtx_);
+        // Send through the same request socket and multipart framing used
+        // by normal memory transactions so this exercises the real bridge
+        // path end-to-end.
+        for (uint32_t x = 0; x < 4; ++x) {
+            if (zmq_sendmsg(this->zmqReq_, &(msg[x]), (x == 3 ? 0 : ZMQ_SNDMORE) | ZMQ_DONTWAIT) < 0) {
+                bridgeLog_->debug("Readiness probe send failed for port %s", this->reqAddr_.c_str());
+                break;
+            }
+        }
+    }
+
+    for (uint32_t x = 0; x < 4; ++x) zmq_msg_close(&(msg[x]));
+}
+
+bool rim::TcpClient::waitReady(double timeout, double period) {
+    uint32_t id;
+    uint32_t helloId;
+    uint32_t offer;
     auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout);
 
+    rogue::GilRelease noGil;
+
+    // Renegotiate, the server may have been replaced
+    version_ = 1;
+
     // Retry the probe until the overall timeout expires. This verifies the
     // full request/response bridge path, not just local socket setup.
     while (std::chrono::steady_clock::now() < deadline) {
         {
             std::lock_guard<std::mutex> probeLock(probeMtx_);
+            offer = maxVersion_;
+
+            // The version offer goes first, so a server which accepts it
+            // replies before answering the plain probe.
+            helloId_ = (offer > 1) ? ++probeSeq_ : 0;
+            helloVersion_ = 0;
+            helloId = helloId_;
+
             // Track the current probe ID so the response thread can match the
             // incoming bridge reply back to this wait operation.
             probeId_ = ++probeSeq_;
@@ -200,32 +268,8 @@ bool rim::TcpClient::waitReady(double timeout, double period) {
             id = probeId_;
         }
 
-        // Build a minimal internal bridge-control request. The server handles
-        // this locally and responds with the normal six-part completion
-        // message, but without touching downstream memory.
-        zmq_msg_init_size(&(msg[0]), 4);
-        std::memcpy(zmq_msg_data(&(msg[0])), &id, 4);
-        zmq_msg_init_size(&(msg[1]), 8);
-        std::memcpy(zmq_msg_data(&(msg[1])), &addr, 8);
-        zmq_msg_init_size(&(msg[2]), 4);
-        std::memcpy(zmq_msg_data(&(msg[2])), &size, 4);
-        zmq_msg_init_size(&(msg[3]), 4);
-        std::memcpy(zmq_msg_data(&(msg[3])), &type, 4);
-
-        {
-            std::lock_guard<std::mutex> block(bridgeMtx_);
-            // Send through the same request socket and multipart framing used
-            // by normal memory transactions so this exercises the real bridge
-            // path end-to-end.
-            for (uint32_t x = 0; x < 4; ++x) {
-                if (zmq_sendmsg(this->zmqReq_, &(msg[x]), (x == 3 ? 0 : ZMQ_SNDMORE) | ZMQ_DONTWAIT) < 0) {
-                    bridgeLog_->debug("Readiness probe send failed for port %s", this->reqAddr_.c_str());
-                    break;
-                }
-            }
-        }
-
-        for (uint32_t x = 0; x < 4; ++x) zmq_msg_close(&(msg[x]));
+        if (helloId != 0) sendProbe(helloId, offer);
+        sendProbe(id, 0);
 
         std::unique_lock<std::mutex> probeLock(probeMtx_);
         // The receive thread sets probeDone_/probeResult_ when it sees a probe
@@ -234,7 +278,10 @@ bool rim::TcpClient::waitReady(double timeout, double period) {
         probeCond_.wait_for(probeLock, std::chrono::duration<double>(period), [&]() { return probeDone_ && probeId_ == id; });
 
         if (probeDone_ && probeId_ == id && probeResult_ == "OK") {
-            bridgeLog_->debug("Readiness probe succeeded for port %s", this->reqAddr_.c_str());
+            version_ = (helloVersion_ >= rim::TcpBridgeVersion) ? rim::TcpBridgeVersion : 1;
+            bridgeLog_->debug("Readiness probe succeeded for port %s, protocol version %" PRIu32,
+                              this->reqAddr_.c_str(),
+                              version_.load());
             return true;
         }
     }
@@ -243,6 +290,16 @@ bool rim::TcpClient::waitReady(double timeout, double period) {
     return false;
 }
 
+void rim::TcpClient::setProtocolVersion(uint32_t version) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> probeLock(probeMtx_);
+    maxVersion_ = std::min(std::max(version, static_cast<uint32_t>(1)), rim::TcpBridgeVersion);
+}
+
+uint32_t rim::TcpClient::getProtocolVersion() {
+    return version_;
+}
+
 void rim::TcpClient::start() {
     if (!waitReadyOnStart_) return;
 
@@ -263,6 +320,12 @@ void rim::TcpClient::doTransaction(rim::TransactionPtr tran) {
     uint32_t size;
     uint32_t type;
 
+    // Batched once a newer protocol is negotiated
+    if (version_ >= rim::TcpBridgeVersion) {
+        queueTransaction(tran);
+        return;
+    }
+
     rogue::GilRelease noGil;
     std::lock_guard<std::mutex> block(bridgeMtx_);
     rim::TransactionLockPtr lock = tran->lock();
@@ -363,6 +426,13 @@ void rim::TcpClient::runThread() {
             }
         } while (threadEn_ && more);
 
+        // Version 2 response batch
+        if (threadEn_ && (msgCnt == 3)) {
+            recvBatch(msg);
+            for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
+            continue;  // while (1)
+        }
+
         // Proper message received
         if (threadEn_ && (msgCnt == 6)) {
             // Check sizes
@@ -390,7 +460,9 @@ void rim::TcpClient::runThread() {
 
             if (type == rim::TcpBridgeProbe) {
                 std::lock_guard<std::mutex> probeLock(probeMtx_);
-                if (id == probeId_) {
+                if (id == helloId_ && id != 0 && strcmp(result, "OK") == 0) {
+                    helloVersion_ = size;
+                } else if (id == probeId_) {
                     probeResult_ = result;
                     probeDone_   = true;
                     probeCond_.notify_all();
@@ -451,6 +523,202 @@ void rim::TcpClient::runThread() {
     }
 }
 
+//! Queue a transaction into the next version 2 batch
+void rim::TcpClient::queueTransaction(rim::TransactionPtr tran) {
+    uint8_t rec[RecordSize];
+    uint32_t id;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t type;
+
+    rogue::GilRelease noGil;
+    rim::TransactionLockPtr lock = tran->lock();
+
+    id   = tran->id();
+    addr = tran->address();
+    size = tran->size();
+    type = tran->type();
+
+    std::memset(rec, 0, RecordSize);
+    std::memcpy(rec, &id, 4);
+    std::memcpy(rec + 4, &type, 4);
+    std::memcpy(rec + 8, &addr, 8);
+    std::memcpy(rec + 16, &size, 4);
+
+    bridgeLog_->debug("Queued transaction id=%" PRIu32 ", addr=0x%" PRIx64 ", size=%" PRIu32 ", type=%" PRIu32
+                      ", port: %s",
+                      id,
+                      addr,
+                      size,
+                      type,
+                      this->reqAddr_.c_str());
+
+    // Tracked before the response can arrive
+    if (type != rim::Post) addTransaction(tran);
+
+    {
+        std::lock_guard<std::mutex> block(batchMtx_);
+        batchDesc_.insert(batchDesc_.end(), rec, rec + RecordSize);
+        if (type == rim::Write || type == rim::Post) batchData_.insert(batchData_.end(), tran->begin(), tran->end());
+        batchCount_++;
+    }
+    batchCond_.notify_one();
+
+    if (type == rim::Post) tran->done();
+}
+
+//! Send thread for version 2 batches
+void rim::TcpClient::runSend() {
+    std::vector<uint8_t> desc;
+    std::vector<uint8_t> data;
+    zmq_msg_t msg[3];
+    uint32_t head[2];
+    uint32_t x;
+
+    bridgeLog_->logThreadId();
+
+    while (threadEn_) {
+        // Transactions queued while the last batch was sent go out together
+        {
+            std::unique_lock<std::mutex> lock(batchMtx_);
+            if (batchCount_ == 0) {
+                batchCond_.wait_for(lock, std::chrono::milliseconds(100));
+                continue;
+            }
+
+            head[0] = rim::TcpBridgeVersion;
+            head[1] = batchCount_;
+            desc.swap(batchDesc_);
+            data.swap(batchData_);
+            batchCount_ = 0;
+        }
+
+        zmq_msg_init_size(&(msg[0]), 8);
+        std::memcpy(zmq_msg_data(&(msg[0])), head, 8);
+        zmq_msg_init_size(&(msg[1]), desc.size());
+        std::memcpy(zmq_msg_data(&(msg[1])), desc.data(), desc.size());
+        zmq_msg_init_size(&(msg[2]), data.size());
+        std::memcpy(zmq_msg_data(&(msg[2])), data.data(), data.size());
+
+        bridgeLog_->debug("Sending batch of %" PRIu32 " transactions, %zu data bytes, port: %s",
+                          head[1],
+                          data.size(),
+                          this->reqAddr_.c_str());
+
+        {
+            std::lock_guard<std::mutex> block(bridgeMtx_);
+            for (x = 0; x < 3; x++) {
+                if (zmq_sendmsg(this->zmqReq_, &(msg[x]), ((x == 2) ? 0 : ZMQ_SNDMORE) | ZMQ_DONTWAIT) < 0) {
+                    bridgeLog_->warning("Failed to send batch of %" PRIu32 " transactions, msg %" PRIu32 " on %s: %s",
+                                        head[1],
+                                        x,
+                                        this->reqAddr_.c_str(),
+                                        zmq_strerror(zmq_errno()));
+                    break;
+                }
+            }
+        }
+
+        for (x = 0; x < 3; x++) zmq_msg_close(&(msg[x]));
+        desc.clear();
+        data.clear();
+    }
+}
+
+//! Complete the transactions of a version 2 response batch
+void rim::TcpClient::recvBatch(void* parts) {
+    zmq_msg_t* msg = reinterpret_cast<zmq_msg_t*>(parts);
+    rim::TransactionPtr tran;
+    const uint8_t* rec;
+    const uint8_t* data;
+    uint64_t dataSize;
+    uint64_t offset;
+    uint32_t version;
+    uint32_t count;
+    uint32_t id;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t type;
+    uint32_t len;
+    uint32_t x;
+
+    if (zmq_msg_size(&(msg[0])) != 8) {
+        bridgeLog_->warning("Bad batch header size %zu", zmq_msg_size(&(msg[0])));
+        return;
+    }
+    std::memcpy(&version, zmq_msg_data(&(msg[0])), 4);
+    std::memcpy(&count, reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[0]))) + 4, 4);
+
+    if ((version != rim::TcpBridgeVersion) ||
+        (zmq_msg_size(&(msg[1])) != (static_cast<uint64_t>(count) * RecordSize))) {
+        bridgeLog_->warning("Bad batch. version=%" PRIu32 " count=%" PRIu32 " records=%zu",
+                            version,
+                            count,
+                            zmq_msg_size(&(msg[1])));
+        return;
+    }
+
+    rec      = reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[1])));
+    data     = reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[2])));
+    dataSize = zmq_msg_size(&(msg[2]));
+    offset   = 0;
+
+    for (x = 0; x < count; x++, rec += RecordSize) {
+        std::memcpy(&id, rec, 4);
+        std::memcpy(&type, rec + 4, 4);
+        std::memcpy(&addr, rec + 8, 8);
+        std::memcpy(&size, rec + 16, 4);
+        std::memcpy(&len, rec + 20, 4);
+
+        // Result string then any read data
+        uint64_t need = static_cast<uint64_t>(len) + ((type != rim::Write) ? size : 0);
+        if ((offset + need) > dataSize) {
+            bridgeLog_->warning("Truncated batch data. Id=%" PRIu32, id);
+            return;
+        }
+        std::string result(reinterpret_cast<const char*>(data + offset), len);
+        const uint8_t* read = data + offset + len;
+        offset += need;
+
+        // Find Transaction
+        if ((tran = getTransaction(id)) == NULL) {
+            bridgeLog_->warning("Failed to find transaction id=%" PRIu32, id);
+            continue;
+        }
+
+        // Lock transaction
+        rim::TransactionLockPtr lock = tran->lock();
+
+        if (tran->expired()) {
+            bridgeLog_->warning("Dropping late response for expired transaction. Id=%" PRIu32, id);
+            continue;
+        }
+
+        // Double check transaction
+        if ((addr != tran->address()) || (size != tran->size()) || (type != tran->type())) {
+            bridgeLog_->warning("Transaction data mismatch. Id=%" PRIu32, id);
+            tran->errorStr("Transaction data mismatch in TcpClient");
+            continue;
+        }
+
+        if (type != rim::Write) std::memcpy(tran->begin(), read, size);
+
+        if (result != "")
+            tran->errorStr(result);
+        else
+            tran->done();
+
+        bridgeLog_->debug("Response for batched transaction id=%" PRIu32 ", addr=0x%" PRIx64 ", size=%" PRIu32
+                          ", type=%" PRIu32 ", port: %s, Result: (%s)",
+                          id,
+                          addr,
+                          size,
+                          type,
+                          this->respAddr_.c_str(),
+                          result.c_str());
+    }
+}
+
 void rim::TcpClient::setup_python() {
 #ifndef NO_PYTHON
 
@@ -461,6 +729,8 @@ void rim::TcpClient::setup_python() {
         bp::init<std::string, uint16_t, bp::optional<bool> >())
         .def("close", &rim::TcpClient::close)
         .def("waitReady", &rim::TcpClient::waitReady)
+        .def("setProtocolVersion", &rim::TcpClient::setProtocolVersion)
+        .def("getProtocolVersion", &rim::TcpClient::getProtocolVersion)
         .def("_start", &rim::TcpClient::start)
         .def("_stop", &rim::TcpClient::stop);
 #pragma GCC diagnostic pop
@@ -18,12 +18,17 @@
 
 #include "rogue/interfaces/memory/TcpServer.h"
 
+#include <fcntl.h>
 #include <inttypes.h>
+#include <unistd.h>
 #include <zmq.h>
 
+#include <algorithm>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -37,6 +42,14 @@ namespace rim = rogue::interfaces::memory;
 namespace bp = boost::python;
 #endif
 
+namespace {
+// Version 2 record: id, type, address, size and result length
+static constexpr uint32_t RecordSize = 24;
+
+// Version 2 transactions outstanding before requests stop being read
+static constexpr uint32_t MaxInFlight = 256;
+}  // namespace
+
 //! Class creation
 rim::TcpServerPtr rim::TcpServer::create(std::string addr, uint16_t port) {
     rim::TcpServerPtr r = std::make_shared<rim::TcpServer>(addr, port);
@@ -83,6 +96,10 @@ rim::TcpServer::TcpServer(std::string addr, uint16_t port) {
         if (zmq_setsockopt(this->zmqReq_, ZMQ_RCVTIMEO, &opt, sizeof(int32_t)) != 0)
             throw(rogue::GeneralError("memory::TcpServer::TcpServer", "Failed to set socket receive timeout"));
 
+        if (pipe(this->wakeFd_) != 0 || fcntl(this->wakeFd_[0], F_SETFL, O_NONBLOCK) != 0 ||
+            fcntl(this->wakeFd_[1], F_SETFL, O_NONBLOCK) != 0)
+            throw(rogue::GeneralError("memory::TcpServer::TcpServer", "Failed to create completion pipe"));
+
         if (zmq_bind(this->zmqResp_, this->respAddr_.c_str()) < 0)
             throw(rogue::GeneralError::create("memory::TcpServer::TcpServer",
                                               "Failed to bind server to port %" PRIu16
@@ -137,6 +154,10 @@ rim::TcpServer::TcpServer(std::string addr, uint16_t port) {
             zmq_ctx_destroy(zmqCtx_);
             zmqCtx_ = nullptr;
         }
+        for (int& fd : wakeFd_) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
         throw;
     }
 }
@@ -169,6 +190,13 @@ void rim::TcpServer::stop() {
         this->bridgeLog_->debug("Stopping TCP memory bridge. request=%s response=%s",
                                 this->reqAddr_.c_str(),
                                 this->respAddr_.c_str());
+
+        // Outstanding version 2 transactions call back before the pipe closes
+        rim::Master::stop();
+        for (int& fd : wakeFd_) {
+            if (fd >= 0) ::close(fd);
+            fd = -1;
+        }
         if (zmqResp_ != nullptr) {
             zmq_close(zmqResp_);
             zmqResp_ = nullptr;
@@ -192,6 +220,7 @@ void rim::TcpServer::runThread() {
     uint32_t x;
     uint32_t msgCnt;
     zmq_msg_t msg[6];
+    zmq_pollitem_t items[2];
     uint32_t id;
     uint64_t addr;
     uint32_t size;
@@ -201,6 +230,21 @@ void rim::TcpServer::runThread() {
     bridgeLog_->logThreadId();
 
     while (threadEn_) {
+        // Completions always wake the thread, requests only while below the in-flight limit
+        items[0].socket  = nullptr;
+        items[0].fd      = this->wakeFd_[0];
+        items[0].events  = ZMQ_POLLIN;
+        items[0].revents = 0;
+        items[1].socket  = this->zmqReq_;
+        items[1].fd      = 0;
+        items[1].events  = ZMQ_POLLIN;
+        items[1].revents = 0;
+
+        if (zmq_poll(items, (inFlight_ < MaxInFlight) ? 2 : 1, 100) <= 0) continue;
+
+        if ((items[0].revents & ZMQ_POLLIN) && !sendCompletions()) return;
+        if (!(items[1].revents & ZMQ_POLLIN)) continue;
+
         for (x = 0; x < 6; x++) zmq_msg_init(&(msg[x]));
         msgCnt = 0;
         x      = 0;
@@ -221,8 +265,13 @@ void rim::TcpServer::runThread() {
             }
         } while (threadEn_ && more);
 
+        // Version 2 request batch
+        if (threadEn_ && msgCnt == 3) {
+            runBatch(msg);
+            for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
+
         // Proper message received
-        if (threadEn_ && (msgCnt == 4 || msgCnt == 5)) {
+        } else if (threadEn_ && (msgCnt == 4 || msgCnt == 5)) {
             // Check sizes
             if ((zmq_msg_size(&(msg[0])) != 4) || (zmq_msg_size(&(msg[1])) != 8) || (zmq_msg_size(&(msg[2])) != 4) ||
                 (zmq_msg_size(&(msg[3])) != 4)) {
@@ -244,11 +293,18 @@ void rim::TcpServer::runThread() {
 
             // Bridge readiness probe is handled locally.
             if (type == rim::TcpBridgeProbe) {
-                if ((msgCnt != 4) || (size != 0)) {
+                if (msgCnt != 4) {
                     bridgeLog_->warning("Malformed readiness probe. Id=%" PRIu32, id);
                     for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
                     continue;  // while (1)
                 }
+
+                // A non-zero size offers a protocol version, reply with the accepted one
+                if (size != 0) {
+                    size = std::min(size, rim::TcpBridgeVersion);
+                    std::memcpy(zmq_msg_data(&(msg[2])), &size, 4);
+                    bridgeLog_->debug("Accepted protocol version %" PRIu32 ". Id=%" PRIu32, size, id);
+                }
                 zmq_msg_init_size(&(msg[4]), 0);
                 result = "OK";
 
@@ -317,42 +373,7 @@ void rim::TcpServer::runThread() {
                                   "Resetting response socket to clear PUSH multipart FSM.",
                                   id, x);
 
-                // Rebuild response socket to reset multipart FSM.
-                if (this->zmqResp_ != nullptr) {
-                    if (zmq_unbind(this->zmqResp_, this->respAddr_.c_str()) != 0) {
-                        bridgeLog_->warning("Failed to unbind response socket from %s during recovery: %s",
-                                            this->respAddr_.c_str(), zmq_strerror(zmq_errno()));
-                    }
-                    zmq_close(this->zmqResp_);
-                    this->zmqResp_ = nullptr;
-                }
-
-                this->zmqResp_ = zmq_socket(this->zmqCtx_, ZMQ_PUSH);
-                bool rebuilt = (this->zmqResp_ != nullptr);
-
-                if (rebuilt) {
-                    int32_t lopt = 0;
-                    if (zmq_setsockopt(this->zmqResp_, ZMQ_LINGER, &lopt, sizeof(lopt)) != 0) {
-                        bridgeLog_->error("Failed to set ZMQ_LINGER on rebuilt response socket: %s",
-                                          zmq_strerror(zmq_errno()));
-                        rebuilt = false;
-                    } else if (zmq_bind(this->zmqResp_, this->respAddr_.c_str()) < 0) {
-                        bridgeLog_->error("Failed to rebind response socket to %s: %s",
-                                          this->respAddr_.c_str(), zmq_strerror(zmq_errno()));
-                        rebuilt = false;
-                    }
-                }
-
-                if (!rebuilt) {
-                    if (this->zmqResp_ != nullptr) {
-                        zmq_close(this->zmqResp_);
-                        this->zmqResp_ = nullptr;
-                    }
-                    bridgeLog_->error("Unable to recover TcpServer response socket; "
-                                      "exiting bridge worker thread (stop()/dtor will "
-                                      "complete teardown)");
-                    return;
-                }
+                if (!resetResponse()) return;
             }
         } else {
             for (x = 0; x < msgCnt; x++) zmq_msg_close(&(msg[x]));
@@ -360,6 +381,225 @@ void rim::TcpServer::runThread() {
     }
 }
 
+//! Issue the transactions of a version 2 request batch
+void rim::TcpServer::runBatch(void* parts) {
+    zmq_msg_t* msg = reinterpret_cast<zmq_msg_t*>(parts);
+    std::shared_ptr<Completion> comp;
+    const uint8_t* rec;
+    const uint8_t* data;
+    uint64_t dataSize;
+    uint64_t total;
+    uint32_t version;
+    uint32_t count;
+    uint32_t x;
+
+    if (zmq_msg_size(&(msg[0])) != 8) {
+        bridgeLog_->warning("Bad batch header size %zu", zmq_msg_size(&(msg[0])));
+        return;
+    }
+    std::memcpy(&version, zmq_msg_data(&(msg[0])), 4);
+    std::memcpy(&count, reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[0]))) + 4, 4);
+
+    if ((version != rim::TcpBridgeVersion) ||
+        (zmq_msg_size(&(msg[1])) != (static_cast<uint64_t>(count) * RecordSize))) {
+        bridgeLog_->warning("Bad batch. version=%" PRIu32 " count=%" PRIu32 " records=%zu",
+                            version,
+                            count,
+                            zmq_msg_size(&(msg[1])));
+        return;
+    }
+
+    rec      = reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[1])));
+    data     = reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[2])));
+    dataSize = zmq_msg_size(&(msg[2]));
+
+    // Check the write data before issuing anything
+    total = 0;
+    for (x = 0; x < count; x++) {
+        uint32_t size;
+        uint32_t type;
+        std::memcpy(&type, rec + x * RecordSize + 4, 4);
+        std::memcpy(&size, rec + x * RecordSize + 16, 4);
+        if ((type == rim::Write) || (type == rim::Post)) total += size;
+    }
+
+    if (total != dataSize) {
+        bridgeLog_->warning("Batch write data error. expected=%" PRIu64 " received=%" PRIu64, total, dataSize);
+        return;
+    }
+
+    for (x = 0; x < count; x++) {
+        comp = std::make_shared<Completion>();
+        std::memcpy(&(comp->id), rec + x * RecordSize, 4);
+        std::memcpy(&(comp->type), rec + x * RecordSize + 4, 4);
+        std::memcpy(&(comp->addr), rec + x * RecordSize + 8, 8);
+        std::memcpy(&(comp->size), rec + x * RecordSize + 16, 4);
+
+        if ((comp->type == rim::Write) || (comp->type == rim::Post)) {
+            comp->data.assign(data, data + comp->size);
+            data += comp->size;
+        } else {
+            comp->data.resize(comp->size);
+        }
+
+        bridgeLog_->debug("Starting batched transaction id=%" PRIu32 ", addr=0x%" PRIx64 ", size=%" PRIu32
+                          ", type=%" PRIu32,
+                          comp->id,
+                          comp->addr,
+                          comp->size,
+                          comp->type);
+
+        // The callback runs in the completing thread, hand the result to the worker thread
+        inFlight_++;
+        reqTransactionAsync(comp->addr,
+                            comp->size,
+                            comp->data.data(),
+                            comp->type,
+                            [this, comp](uint32_t, const std::string& error) {
+                                uint8_t wake = 0;
+                                comp->result = error;
+                                {
+                                    std::lock_guard<std::mutex> lock(compMtx_);
+                                    completions_.push_back(comp);
+                                }
+
+                                // A full pipe already wakes the worker
+                                if (write(wakeFd_[1], &wake, 1) < 0) return;
+                            });
+    }
+}
+
+//! Send responses for completed version 2 transactions
+bool rim::TcpServer::sendCompletions() {
+    std::vector<std::shared_ptr<Completion>> done;
+    zmq_msg_t msg[3];
+    uint8_t drain[64];
+    uint8_t* rec;
+    uint8_t* data;
+    uint64_t dataSize;
+    uint32_t head[2];
+    uint32_t count;
+    uint32_t len;
+    uint32_t x;
+
+    while (read(wakeFd_[0], drain, sizeof(drain)) > 0) {
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(compMtx_);
+        done.swap(completions_);
+    }
+    inFlight_ -= done.size();
+
+    // Posted writes have no response
+    count    = 0;
+    dataSize = 0;
+    for (auto& comp : done) {
+        if (comp->type == rim::Post) {
+            if (comp->result != "")
+                bridgeLog_->warning("Posted write failed. Id=%" PRIu32 ": %s", comp->id, comp->result.c_str());
+            continue;
+        }
+        count++;
+        dataSize += comp->result.length();
+        if (comp->type != rim::Write) dataSize += comp->size;
+    }
+    if (count == 0) return true;
+
+    head[0] = rim::TcpBridgeVersion;
+    head[1] = count;
+    zmq_msg_init_size(&(msg[0]), 8);
+    std::memcpy(zmq_msg_data(&(msg[0])), head, 8);
+    zmq_msg_init_size(&(msg[1]), count * RecordSize);
+    zmq_msg_init_size(&(msg[2]), dataSize);
+
+    // Each record is followed in the data by its result and then any read data
+    rec  = reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[1])));
+    data = reinterpret_cast<uint8_t*>(zmq_msg_data(&(msg[2])));
+    for (auto& comp : done) {
+        if (comp->type == rim::Post) continue;
+
+        len = comp->result.length();
+        std::memcpy(rec, &(comp->id), 4);
+        std::memcpy(rec + 4, &(comp->type), 4);
+        std::memcpy(rec + 8, &(comp->addr), 8);
+        std::memcpy(rec + 16, &(comp->size), 4);
+        std::memcpy(rec + 20, &len, 4);
+        rec += RecordSize;
+
+        std::memcpy(data, comp->result.c_str(), len);
+        data += len;
+        if (comp->type != rim::Write) {
+            std::memcpy(data, comp->data.data(), comp->size);
+            data += comp->size;
+        }
+
+        bridgeLog_->debug("Done batched transaction id=%" PRIu32 ", addr=0x%" PRIx64 ", size=%" PRIu32
+                          ", type=%" PRIu32 ", result=(%s)",
+                          comp->id,
+                          comp->addr,
+                          comp->size,
+                          comp->type,
+                          comp->result.c_str());
+    }
+
+    for (x = 0; x < 3; x++) {
+        if (this->sendResponseMsg_(&(msg[x]), (x == 2) ? 0 : ZMQ_SNDMORE) < 0) {
+            bridgeLog_->warning("zmq_sendmsg failed on part %" PRIu32 " for batch of %" PRIu32 ": %s",
+                                x,
+                                count,
+                                zmq_strerror(zmq_errno()));
+            for (uint32_t y = x; y < 3; y++) zmq_msg_close(&(msg[y]));
+            bridgeLog_->error("Batch reply failed mid-stream on part %" PRIu32
+                              ". Resetting response socket to clear PUSH multipart FSM.",
+                              x);
+            return resetResponse();
+        }
+    }
+    return true;
+}
+
+//! Rebuild the response socket after a failed multipart send
+bool rim::TcpServer::resetResponse() {
+    // Rebuild response socket to reset multipart FSM.
+    if (this->zmqResp_ != nullptr) {
+        if (zmq_unbind(this->zmqResp_, this->respAddr_.c_str()) != 0) {
+            bridgeLog_->warning("Failed to unbind response socket from %s during recovery: %s",
+                                this->respAddr_.c_str(), zmq_strerror(zmq_errno()));
+        }
+        zmq_close(this->zmqResp_);
+        this->zmqResp_ = nullptr;
+    }
+
+    this->zmqResp_ = zmq_socket(this->zmqCtx_, ZMQ_PUSH);
+    bool rebuilt = (this->zmqResp_ != nullptr);
+
+    if (rebuilt) {
+        int32_t lopt = 0;
+        if (zmq_setsockopt(this->zmqResp_, ZMQ_LINGER, &lopt, sizeof(lopt)) != 0) {
+            bridgeLog_->error("Failed to set ZMQ_LINGER on rebuilt response socket: %s",
+                              zmq_strerror(zmq_errno()));
+            rebuilt = false;
+        } else if (zmq_bind(this->zmqResp_, this->respAddr_.c_str()) < 0) {
+            bridgeLog_->error("Failed to rebind response socket to %s: %s",
+                              this->respAddr_.c_str(), zmq_strerror(zmq_errno()));
+            rebuilt = false;
+        }
+    }
+
+    if (!rebuilt) {
+        if (this->zmqResp_ != nullptr) {
+            zmq_close(this->zmqResp_);
+            this->zmqResp_ = nullptr;
+        }
+        bridgeLog_->error("Unable to recover TcpServer response socket; "
+                          "exiting bridge worker thread (stop()/dtor will "
+                          "complete teardown)");
+        return false;
+    }
+    return true;
+}
+
 void rim::TcpServer::setup_python() {
 #ifndef NO_PYTHON
 
@@ -22,15 +22,27 @@
 #include <stdarg.h>
 #include <sys/time.h>
 
+#include <algorithm>
+#include <chrono>
+#include <climits>
 #include <cstdio>
+#include <exception>
 #include <memory>
 #include <string>
+#include <thread>
+
+#ifndef __MACH__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/ScopedGil.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/TransactionLock.h"
 
 namespace rim = rogue::interfaces::memory;
@@ -60,6 +72,11 @@ void rim::Transaction::setup_python() {
         .def("address", &rim::Transaction::address)
         .def("size", &rim::Transaction::size)
         .def("type", &rim::Transaction::type)
+        .def("priority", &rim::Transaction::priority)
+        .def("setThreadPriority", &rim::Transaction::setThreadPriority)
+        .staticmethod("setThreadPriority")
+        .def("getThreadPriority", &rim::Transaction::getThreadPriority)
+        .staticmethod("getThreadPriority")
         .def("done", &rim::Transaction::done)
         .def("error", &rim::Transaction::errorStr)
         .def("expired", &rim::Transaction::expired)
@@ -68,14 +85,36 @@ void rim::Transaction::setup_python() {
 #endif
 }
 
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Local slaves usually complete within a few microseconds, spin this long before sleeping
+const std::chrono::microseconds SpinTime(20);
+
+// Priority given to transactions created by this thread
+thread_local uint32_t threadPriority = rim::PriorityNormal;
+
+}  // namespace
+
 //! Create object
-rim::Transaction::Transaction(struct timeval timeout) : timeout_(timeout) {
-    gettimeofday(&startTime_, NULL);
+rim::Transaction::Transaction(struct timeval timeout) : state_(Pending) {
+    log_ = rogue::Logging::create("memory.Transaction", true);
+    reset(timeout);
+}
 
-    endTime_.tv_sec   = 0;
-    endTime_.tv_usec  = 0;
-    warnTime_.tv_sec  = 0;
-    warnTime_.tv_usec = 0;
+//! Destroy object
+rim::Transaction::~Transaction() {}
+
+//! Reset to the initial state with a new ID
+void rim::Transaction::reset(struct timeval timeout) {
+    timeout_    = timeout;
+    timeoutDur_ = std::chrono::seconds(timeout_.tv_sec) + std::chrono::microseconds(timeout_.tv_usec);
+    startTime_  = Clock::now();
+    endTime_    = Clock::time_point();
+    warnTime_   = Clock::time_point();
+
+    state_.store(Pending, std::memory_order_relaxed);
 
     pyValid_ = false;
 
@@ -83,14 +122,14 @@ rim::Transaction::Transaction(struct timeval timeout) : timeout_(timeout) {
     address_ = 0;
     size_    = 0;
     type_    = 0;
-    error_   = "";
     done_    = false;
 
+    priority_ = threadPriority;
+    error_.clear();
+
     isSubTransaction_            = false;
     doneCreatingSubTransactions_ = false;
 
-    log_ = rogue::Logging::create("memory.Transaction", true);
-
     classMtx_.lock();
     if (classIdx_ == 0) classIdx_ = 1;
     id_ = classIdx_;
@@ -98,8 +137,64 @@ rim::Transaction::Transaction(struct timeval timeout) : timeout_(timeout) {
     classMtx_.unlock();
 }
 
-//! Destroy object
-rim::Transaction::~Transaction() {}
+//! Drop references held for the last use, no other reference exists at this point
+void rim::Transaction::recycle() {
+    subTranMap_.clear();
+    parentTransaction_.reset();
+    tracker_.reset();
+    callback_ = nullptr;
+}
+
+//! Create a pool with the passed free list limit
+rim::TransactionPool::TransactionPool(std::size_t max) : max_(max) {}
+
+//! Destroy the pool and its idle transactions
+rim::TransactionPool::~TransactionPool() {
+    for (rim::Transaction* tran : free_) delete tran;
+}
+
+//! Get a transaction from the free list, allocating when it is empty
+rim::TransactionPtr rim::TransactionPool::get(struct timeval timeout) {
+    std::weak_ptr<rim::TransactionPool> pool = shared_from_this();
+    rim::Transaction* tran                   = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!free_.empty()) {
+            tran = free_.back();
+            free_.pop_back();
+        }
+    }
+
+    if (tran == NULL)
+        tran = new rim::Transaction(timeout);
+    else
+        tran->reset(timeout);
+
+    return rim::TransactionPtr(tran, [pool](rim::Transaction* t) { rim::TransactionPool::release(pool, t); });
+}
+
+//! Return a transaction whose last reference was dropped
+void rim::TransactionPool::release(std::weak_ptr<rim::TransactionPool> pool, rim::Transaction* tran) {
+    std::shared_ptr<rim::TransactionPool> p = pool.lock();
+
+    if (p) {
+        tran->recycle();
+
+        std::lock_guard<std::mutex> lock(p->mtx_);
+        if (p->free_.size() < p->max_) {
+            p->free_.push_back(tran);
+            return;
+        }
+    }
+    delete tran;
+}
+
+//! Number of idle transactions
+std::size_t rim::TransactionPool::freeCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return free_.size();
+}
 
 //! Get lock
 rim::TransactionLockPtr rim::Transaction::lock() {
@@ -135,12 +230,30 @@ uint32_t rim::Transaction::type() {
     return type_;
 }
 
+//! Get priority
+uint32_t rim::Transaction::priority() {
+    return priority_;
+}
+
+//! Set the priority of transactions created by the calling thread
+void rim::Transaction::setThreadPriority(uint32_t priority) {
+    if (priority > rim::PriorityHigh)
+        throw(rogue::GeneralError::create("Transaction::setThreadPriority", "Invalid priority %" PRIu32, priority));
+    threadPriority = priority;
+}
+
+//! Get the priority of transactions created by the calling thread
+uint32_t rim::Transaction::getThreadPriority() {
+    return threadPriority;
+}
+
 //! Create a subtransaction
 rim::TransactionPtr rim::Transaction::createSubTransaction() {
     // Create a new transaction and set up pointers back and forth
     rim::TransactionPtr subTran = std::make_shared<rim::Transaction>(timeout_);
     subTran->parentTransaction_ = shared_from_this();
     subTran->isSubTransaction_  = true;
+    subTran->priority_          = priority_;
     subTranMap_[subTran->id()]  = subTran;
     log_->debug("Created subTransaction id=%" PRIu32 ", parent=%" PRIu32, subTran->id_, this->id_);
 
@@ -162,13 +275,15 @@ void rim::Transaction::done() {
 
     error_ = "";
     done_  = true;
-    cond_.notify_all();
+    complete();
 
     // If applicable, notify parent transaction about completion of a sub-transaction
     if (isSubTransaction_) {
         // Get a shared_ptr to the parent transaction
         rim::TransactionPtr parentTran = this->parentTransaction_.lock();
         if (parentTran) {
+            std::lock_guard<std::mutex> lock(parentTran->lock_);
+
             // Remove own ID from parent subtransaction map
             parentTran->subTranMap_.erase(id_);
 
@@ -191,13 +306,15 @@ void rim::Transaction::errorStr(std::string error) {
                 size_,
                 error_.c_str());
 
-    cond_.notify_all();
+    complete();
 
     // If applicable, notify parent transaction about completion of a sub-transaction
     if (isSubTransaction_) {
         // Get a shared_ptr to the parent transaction
         rim::TransactionPtr parentTran = parentTransaction_.lock();
         if (parentTran) {
+            std::lock_guard<std::mutex> lock(parentTran->lock_);
+
             // Remove own ID from parent subtransaction map
             parentTran->subTranMap_.erase(id_);
 
@@ -222,32 +339,98 @@ void rim::Transaction::error(const char* fmt, ...) {
     errorStr(std::string(buffer));
 }
 
-//! Wait for the transaction to complete
-std::string rim::Transaction::wait() {
-    struct timeval currTime;
+//! Publish completion and wake waiters, lock must be held
+void rim::Transaction::complete() {
+    rim::TransactionCallback cb;
+
+#ifndef __MACH__
+    // Only enter the kernel when a waiter has gone to sleep
+    if (state_.exchange(Complete, std::memory_order_acq_rel) == Waiting)
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state_), FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+    state_.store(Complete, std::memory_order_release);
+    cond_.notify_all();
+#endif
 
+    // Asynchronous completion, released so repeated errors do not call it again
+    if (callback_) {
+        cb.swap(callback_);
+        try {
+            cb(id_, error_);
+        } catch (const std::exception& e) {
+            log_->warning("Transaction callback failed. id=%" PRIu32 ", error=%s", id_, e.what());
+        }
+    }
+}
+
+//! Sleep until completion or the passed deadline, lock must not be held
+void rim::Transaction::sleepUntil(Clock::time_point deadline) {
+#ifndef __MACH__
+    uint32_t expect = Pending;
+    Clock::duration rem;
+    struct timespec ts;
+
+    // Announce the sleeper, a completion in between leaves the state at Complete
+    if (!state_.compare_exchange_strong(expect, Waiting, std::memory_order_acq_rel) && expect != Waiting) return;
+
+    if ((rem = deadline - Clock::now()) <= Clock::duration::zero()) return;
+    ts.tv_sec  = std::chrono::duration_cast<std::chrono::seconds>(rem).count();
+    ts.tv_nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(rem).count() % 1000000000;
+
+    // Returns at once if the state has already moved on from Waiting
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&state_), FUTEX_WAIT_PRIVATE, Waiting, &ts, NULL, 0);
+#else
     std::unique_lock<std::mutex> lock(lock_);
 
-    while (!done_) {
-        // Timeout?
-        gettimeofday(&currTime, NULL);
-        if (endTime_.tv_sec != 0 && endTime_.tv_usec != 0 && timercmp(&currTime, &(endTime_), >)) {
-            done_  = true;
-            error_ = "Timeout waiting for register transaction " + std::to_string(id_) + " message response.";
-
-            log_->debug("Transaction timeout. type=%" PRIu32 " id=%" PRIu32
-                        ", address=0x%" PRIx64 ", size=%" PRIu32 ", timeout=%" PRId64 ".%06" PRId64 "s",
-                        type_,
-                        id_,
-                        address_,
-                        size_,
-                        static_cast<int64_t>(timeout_.tv_sec),
-                        static_cast<int64_t>(timeout_.tv_usec));
-        } else {
-            cond_.wait_for(lock, std::chrono::microseconds(1000));
+    // Completions may come from paths which do not hold the lock, bound the wait
+    if (!done_) cond_.wait_until(lock, std::min(deadline, Clock::now() + std::chrono::milliseconds(1)));
+#endif
+}
+
+//! Wait for the transaction to complete
+std::string rim::Transaction::wait() {
+    Clock::time_point deadline;
+    Clock::time_point now;
+
+    // Fast round trips finish before a sleep would pay off
+    deadline = Clock::now() + SpinTime;
+    while (state_.load(std::memory_order_acquire) != Complete && Clock::now() < deadline) std::this_thread::yield();
+
+    while (state_.load(std::memory_order_acquire) != Complete) {
+        {
+            std::lock_guard<std::mutex> lock(lock_);
+            if (done_) break;
+
+            now = Clock::now();
+
+            // Timer is not armed until the request has been issued, check back after a timeout period
+            if (endTime_ == Clock::time_point()) {
+                deadline = now + timeoutDur_;
+
+            // Timeout?
+            } else if (now >= endTime_ && !lateRefresh(now)) {
+                done_  = true;
+                error_ = "Timeout waiting for register transaction " + std::to_string(id_) + " message response.";
+                complete();
+
+                log_->debug("Transaction timeout. type=%" PRIu32 " id=%" PRIu32
+                            ", address=0x%" PRIx64 ", size=%" PRIu32 ", timeout=%" PRId64 ".%06" PRId64 "s",
+                            type_,
+                            id_,
+                            address_,
+                            size_,
+                            static_cast<int64_t>(timeout_.tv_sec),
+                            static_cast<int64_t>(timeout_.tv_usec));
+                break;
+            } else {
+                deadline = endTime_;
+            }
         }
+        sleepUntil(deadline);
     }
 
+    std::lock_guard<std::mutex> lock(lock_);
+
     // Reset
     if (pyValid_) {
         rogue::ScopedGil gil;
@@ -263,19 +446,16 @@ std::string rim::Transaction::wait() {
 
 //! Refresh the timer
 void rim::Transaction::refreshTimer(rim::TransactionPtr ref) {
-    struct timeval currTime;
-    struct timeval nextTime;
-
-    gettimeofday(&currTime, NULL);
+    Clock::time_point currTime = Clock::now();
     std::lock_guard<std::mutex> lock(lock_);
 
     // Refresh if start time is later then the reference
-    if (ref == NULL || timercmp(&startTime_, &(ref->startTime_), >=)) {
-        timeradd(&currTime, &timeout_, &endTime_);
+    if (ref == NULL || startTime_ >= ref->startTime_) {
+        endTime_ = currTime + timeoutDur_;
 
-        if (warnTime_.tv_sec == 0 && warnTime_.tv_usec == 0) {
+        if (warnTime_ == Clock::time_point()) {
             warnTime_ = endTime_;
-        } else if (timercmp(&warnTime_, &currTime, >=)) {
+        } else if (warnTime_ >= currTime) {
             log_->warning("Transaction timer refresh! Possible slow link! type=%" PRIu32 " id=%" PRIu32
                           ", address=0x%016" PRIx64 ", size=%" PRIu32 ", timeout=%" PRId64 ".%06" PRId64 "s",
                           type_,
@@ -289,6 +469,33 @@ void rim::Transaction::refreshTimer(rim::TransactionPtr ref) {
     }
 }
 
+//! Extend an elapsed deadline from a later response, lock must be held
+bool rim::Transaction::lateRefresh(Clock::time_point now) {
+    std::shared_ptr<rim::ResponseTracker> tracker;
+    Clock::time_point nextTime;
+    int64_t resp;
+
+    if ((tracker = std::atomic_load(&tracker_)) == NULL) return false;
+    if ((resp = tracker->latest(
+             std::chrono::duration_cast<std::chrono::microseconds>(startTime_.time_since_epoch()).count())) == 0)
+        return false;
+
+    nextTime = Clock::time_point(std::chrono::microseconds(resp)) + timeoutDur_;
+
+    if (nextTime <= now) return false;
+    endTime_ = nextTime;
+
+    log_->warning("Transaction timer refresh! Possible slow link! type=%" PRIu32 " id=%" PRIu32
+                  ", address=0x%016" PRIx64 ", size=%" PRIu32 ", timeout=%" PRId64 ".%06" PRId64 "s",
+                  type_,
+                  id_,
+                  address_,
+                  size_,
+                  static_cast<int64_t>(timeout_.tv_sec),
+                  static_cast<int64_t>(timeout_.tv_usec));
+    return true;
+}
+
 //! start iterator, caller must lock around access
 rim::Transaction::iterator rim::Transaction::begin() {
     if (iter_ == NULL) throw(rogue::GeneralError("Transaction::begin", "Invalid data"));
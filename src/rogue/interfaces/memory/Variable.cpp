@@ -624,6 +624,53 @@ void rim::Variable::shiftOffsetDown(uint32_t shift, uint32_t minSize) {
     }
 
     staleLowByte_ = lowTranByte_[0];
+
+    compilePlan();
+}
+
+// Build the access plan used by Block::setBytes() and Block::getBytes()
+void rim::Variable::compilePlan() {
+    PlanField field;
+    uint32_t valueLsb;
+    uint32_t x;
+
+    if (mode_ == "RO")
+        accessMode_ = ModeRO;
+    else if (mode_ == "WO")
+        accessMode_ = ModeWO;
+    else
+        accessMode_ = ModeRW;
+
+    valueMask_ = (valueBits_ >= 64) ? ~0ULL : ((1ULL << valueBits_) - 1);
+    planFields_.clear();
+
+    if (fastByte_ != NULL) {
+        copyMethod_ = CopyBytes;
+
+        // List values sit at a fixed stride from bitOffset_[0], so the field is located per index.
+        // A field of up to 57 bits spans at most 8 bytes from any starting bit.
+    } else if (numValues_ != 0) {
+        copyMethod_ = (valueBits_ <= 57) ? CopyWord : CopyBits;
+
+    } else {
+        copyMethod_ = (bitTotal_ <= 64) ? CopyWord : CopyBits;
+        valueLsb    = 0;
+
+        for (x = 0; x < bitOffset_.size(); x++) {
+            field.blockLsb = bitOffset_[x];
+            field.valueLsb = valueLsb;
+            field.size     = bitSize_[x];
+            field.byte     = field.blockLsb / 8;
+            field.shift    = field.blockLsb % 8;
+            field.span     = (field.shift + field.size + 7) / 8;
+            field.mask     = (field.size >= 64) ? ~0ULL : ((1ULL << field.size) - 1);
+            valueLsb += field.size;
+
+            if (field.size == 0) continue;
+            if (field.size > 57) copyMethod_ = CopyBits;
+            planFields_.push_back(field);
+        }
+    }
 }
 
 void rim::Variable::updatePath(std::string path) {
@@ -0,0 +1,339 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Memory stage which merges posted writes into larger transactions.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/memory/WriteCombiner.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+rim::WriteCombinerPtr rim::WriteCombiner::create(uint32_t holdTime, uint32_t maxBuffered) {
+    rim::WriteCombinerPtr r = std::make_shared<rim::WriteCombiner>(holdTime, maxBuffered);
+    return (r);
+}
+
+//! Setup class for use in python
+void rim::WriteCombiner::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<rim::WriteCombiner, rim::WriteCombinerPtr, bp::bases<rim::Master, rim::Slave>, boost::noncopyable>(
+        "WriteCombiner",
+        bp::init<uint32_t, uint32_t>())
+        .def("setHoldTime", &rim::WriteCombiner::setHoldTime)
+        .def("setMaxBuffered", &rim::WriteCombiner::setMaxBuffered)
+        .def("flush", &rim::WriteCombiner::flush)
+        .def("getPostCount", &rim::WriteCombiner::getPostCount)
+        .def("getIssueCount", &rim::WriteCombiner::getIssueCount)
+        .def("getErrorCount", &rim::WriteCombiner::getErrorCount)
+        .def("_stop", &rim::WriteCombiner::stop);
+
+    bp::implicitly_convertible<rim::WriteCombinerPtr, rim::MasterPtr>();
+    bp::implicitly_convertible<rim::WriteCombinerPtr, rim::SlavePtr>();
+#endif
+}
+
+//! Creator
+rim::WriteCombiner::WriteCombiner(uint32_t holdTime, uint32_t maxBuffered) : Hub(0, 0, 0) {
+    buffered_    = 0;
+    maxAccess_   = 0;
+    holdTime_    = holdTime;
+    maxBuffered_ = maxBuffered;
+    postCount_   = 0;
+    issueCount_  = 0;
+    errorCount_  = 0;
+
+    log_ = rogue::Logging::create("memory.WriteCombiner");
+
+    threadEn_ = true;
+    thread_   = new std::thread(&rim::WriteCombiner::runThread, this);
+
+    // Set a thread name
+#ifndef __MACH__
+    pthread_setname_np(thread_->native_handle(), "WriteCombiner");
+#endif
+}
+
+//! Destructor
+rim::WriteCombiner::~WriteCombiner() {
+    stop();
+}
+
+//! Stop the flush thread
+void rim::WriteCombiner::stop() {
+    std::thread* thread;
+
+    {
+        rogue::GilRelease noGil;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            thread    = thread_;
+            thread_   = NULL;
+            threadEn_ = false;
+        }
+        send();
+    }
+
+    if (thread != NULL) {
+        rogue::GilRelease noGil;
+        cond_.notify_all();
+        thread->join();
+        delete thread;
+    }
+    rim::Master::stop();
+}
+
+//! Set hold time
+void rim::WriteCombiner::setHoldTime(uint32_t holdTime) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    holdTime_ = holdTime;
+    cond_.notify_all();
+}
+
+//! Set buffer size limit
+void rim::WriteCombiner::setMaxBuffered(uint32_t maxBuffered) {
+    bool full;
+
+    rogue::GilRelease noGil;
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        maxBuffered_ = maxBuffered;
+        full         = !buffer_.empty() && buffered_ >= maxBuffered_;
+    }
+    if (full) send();
+}
+
+//! Send the buffered writes
+void rim::WriteCombiner::flush() {
+    rogue::GilRelease noGil;
+    send();
+}
+
+//! Get posted write count
+uint64_t rim::WriteCombiner::getPostCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return postCount_;
+}
+
+//! Get issued write count
+uint64_t rim::WriteCombiner::getIssueCount() {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(mtx_);
+    return issueCount_;
+}
+
+//! Get failed write count
+uint64_t rim::WriteCombiner::getErrorCount() {
+    return errorCount_;
+}
+
+//! Returns true if the range overlaps the buffer, called with mtx_ held
+bool rim::WriteCombiner::overlaps(uint64_t address, uint32_t size) {
+    auto it = buffer_.lower_bound(address + size);
+
+    if (it == buffer_.begin()) return false;
+    --it;
+    return (it->first + it->second.size()) > address;
+}
+
+//! Merge a posted write into the buffer, called with mtx_ held
+void rim::WriteCombiner::merge(uint64_t address, const uint8_t* data, uint32_t size) {
+    std::vector<uint8_t> merged;
+    uint64_t start = address;
+    uint64_t end   = address + size;
+
+    // First segment which may touch the write
+    auto first = buffer_.upper_bound(address);
+    if (first != buffer_.begin()) {
+        auto prev = std::prev(first);
+        if ((prev->first + prev->second.size()) >= address) first = prev;
+    }
+
+    // Extent of the segments which overlap or touch the write
+    auto last = first;
+    while (last != buffer_.end() && last->first <= end) {
+        start = std::min(start, last->first);
+        end   = std::max(end, last->first + last->second.size());
+        ++last;
+    }
+
+    // Older bytes first, the new write wins
+    merged.resize(end - start);
+    for (auto it = first; it != last; ++it) {
+        std::copy(it->second.begin(), it->second.end(), merged.begin() + (it->first - start));
+        buffered_ -= it->second.size();
+    }
+    std::copy(data, data + size, merged.begin() + (address - start));
+
+    buffer_.erase(first, last);
+    buffered_ += merged.size();
+    buffer_[start].swap(merged);
+}
+
+//! Post a transaction. Master will call this method with the access attributes.
+void rim::WriteCombiner::doTransaction(rim::TransactionPtr tran) {
+    uint32_t maxAccess = getSlave()->doMaxAccess();
+    uint64_t address   = tran->address();
+    uint32_t size      = tran->size();
+    bool buffered      = false;
+    bool full          = false;
+    std::map<uint64_t, std::vector<uint8_t>> batch;
+
+    // Buffer and complete posted writes, completion is outside mtx_ as callbacks may post again
+    if (tran->type() == rim::Post && size <= maxAccess) {
+        rim::TransactionLockPtr tlock = tran->lock();
+        if (tran->expired()) return;
+
+        {
+            rogue::GilRelease noGil;
+            std::lock_guard<std::mutex> lock(mtx_);
+            maxAccess_ = maxAccess;
+
+            if ((buffered = threadEn_)) {
+                postCount_++;
+                if (buffer_.empty()) {
+                    firstTime_ = std::chrono::steady_clock::now();
+                    cond_.notify_all();
+                }
+                merge(address, tran->begin(), size);
+                full = buffered_ >= maxBuffered_;
+            }
+        }
+
+        if (buffered) {
+            tran->done();
+            tlock.reset();
+
+            // A full buffer is sent once the transaction is released
+            if (full) {
+                rogue::GilRelease noGil;
+                send();
+            }
+            return;
+        }
+    }
+
+    // Buffered writes, including batches still being sent, reach the hardware first
+    rogue::GilRelease noGil;
+    std::lock_guard<std::recursive_mutex> ilock(issueMtx_);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        maxAccess_ = maxAccess;
+        if (overlaps(address, size)) detach(batch);
+    }
+    issue(batch, maxAccess);
+    rim::Hub::doTransaction(tran);
+}
+
+//! Move the buffer into batch, called with mtx_ held
+void rim::WriteCombiner::detach(std::map<uint64_t, std::vector<uint8_t>>& batch) {
+    for (const auto& seg : buffer_) issueCount_ += (seg.second.size() + maxAccess_ - 1) / maxAccess_;
+
+    batch.swap(buffer_);
+    buffer_.clear();
+    buffered_ = 0;
+}
+
+//! Send a detached batch to the next stage, called with issueMtx_ held
+void rim::WriteCombiner::issue(const std::map<uint64_t, std::vector<uint8_t>>& batch, uint32_t maxAccess) {
+    std::shared_ptr<std::vector<uint8_t>> chunk;
+    uint64_t address;
+    uint32_t size;
+
+    for (const auto& seg : batch) {
+        for (uint64_t off = 0; off < seg.second.size(); off += maxAccess) {
+            address = seg.first + off;
+            size    = std::min(static_cast<uint64_t>(maxAccess), seg.second.size() - off);
+            chunk   = std::make_shared<std::vector<uint8_t>>(seg.second.begin() + off, seg.second.begin() + off + size);
+
+            log_->debug("Issue combined write address=0x%016" PRIx64 ", size=%" PRIu32, address, size);
+
+            reqTransactionAsync(address,
+                                size,
+                                chunk->data(),
+                                rim::Post,
+                                [this, chunk, address](uint32_t, const std::string& error) {
+                                    if (error == "") return;
+                                    errorCount_++;
+                                    log_->warning("Combined write to address=0x%016" PRIx64 " failed: %s",
+                                                  address,
+                                                  error.c_str());
+                                });
+        }
+    }
+}
+
+//! Detach and send the buffer, called without mtx_ held
+void rim::WriteCombiner::send() {
+    std::map<uint64_t, std::vector<uint8_t>> batch;
+    uint32_t maxAccess;
+
+    std::lock_guard<std::recursive_mutex> ilock(issueMtx_);
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        maxAccess = maxAccess_;
+        detach(batch);
+    }
+    issue(batch, maxAccess);
+}
+
+//! Thread to flush the buffer once the hold time expires
+void rim::WriteCombiner::runThread() {
+    std::chrono::steady_clock::time_point deadline;
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (threadEn_) {
+        if (buffer_.empty()) {
+            cond_.wait(lock);
+            continue;
+        }
+
+        deadline = firstTime_ + std::chrono::microseconds(holdTime_);
+        if (std::chrono::steady_clock::now() >= deadline) {
+            lock.unlock();
+            send();
+            lock.lock();
+        } else {
+            cond_.wait_until(lock, deadline);
+        }
+    }
+}
@@ -22,16 +22,21 @@
 #include <boost/python.hpp>
 
 #include "rogue/interfaces/memory/Block.h"
+#include "rogue/interfaces/memory/BlockGroup.h"
 #include "rogue/interfaces/memory/Constants.h"
 #include "rogue/interfaces/memory/Emulate.h"
 #include "rogue/interfaces/memory/Hub.h"
 #include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/PriorityScheduler.h"
+#include "rogue/interfaces/memory/ReadCoalescer.h"
+#include "rogue/interfaces/memory/ShadowCache.h"
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/TcpClient.h"
 #include "rogue/interfaces/memory/TcpServer.h"
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/TransactionLock.h"
 #include "rogue/interfaces/memory/Variable.h"
+#include "rogue/interfaces/memory/WriteCombiner.h"
 
 namespace bp  = boost::python;
 namespace rim = rogue::interfaces::memory;
@@ -72,14 +77,29 @@ void rim::setup_module() {
     bp::scope().attr("Float4")        = rim::Float4;
     bp::scope().attr("Custom")        = rim::Custom;
 
+    // Cache policy constants
+    bp::scope().attr("CacheVolatile")     = rim::CacheVolatile;
+    bp::scope().attr("CacheWriteThrough") = rim::CacheWriteThrough;
+    bp::scope().attr("CacheReadOnce")     = rim::CacheReadOnce;
+
+    // Transaction priority constants
+    bp::scope().attr("PriorityBackground") = rim::PriorityBackground;
+    bp::scope().attr("PriorityNormal")     = rim::PriorityNormal;
+    bp::scope().attr("PriorityHigh")       = rim::PriorityHigh;
+
     rim::Master::setup_python();
     rim::Slave::setup_python();
     rim::Hub::setup_python();
+    rim::ReadCoalescer::setup_python();
+    rim::ShadowCache::setup_python();
+    rim::PriorityScheduler::setup_python();
+    rim::WriteCombiner::setup_python();
     rim::Transaction::setup_python();
     rim::TransactionLock::setup_python();
     rim::TcpClient::setup_python();
     rim::TcpServer::setup_python();
     rim::Block::setup_python();
+    rim::BlockGroup::setup_python();
     rim::Variable::setup_python();
     rim::Emulate::setup_python();
 }
@@ -0,0 +1,482 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description :
+ *    Stream link impairment emulator
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/interfaces/stream/LinkEmulator.h"
+
+#include <stdint.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/FrameIterator.h"
+#include "rogue/interfaces/stream/FrameLock.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+
+namespace ris = rogue::interfaces::stream;
+
+#ifndef NO_PYTHON
+    #include <boost/python.hpp>
+namespace bp = boost::python;
+#endif
+
+//! Class creation
+ris::LinkEmulatorPtr ris::LinkEmulator::create() {
+    ris::LinkEmulatorPtr p = std::make_shared<ris::LinkEmulator>();
+    return (p);
+}
+
+//! Setup class in python
+void ris::LinkEmulator::setup_python() {
+#ifndef NO_PYTHON
+    bp::class_<ris::LinkEmulator, ris::LinkEmulatorPtr, bp::bases<ris::Master, ris::Slave>, boost::noncopyable>(
+        "LinkEmulator",
+        bp::init<>())
+        .def("setSeed", &LinkEmulator::setSeed)
+        .def("getSeed", &LinkEmulator::getSeed)
+        .def("setLoss", &LinkEmulator::setLoss)
+        .def("getLoss", &LinkEmulator::getLoss)
+        .def("setBurstLoss", &LinkEmulator::setBurstLoss)
+        .def("getBurstEnter", &LinkEmulator::getBurstEnter)
+        .def("getBurstExit", &LinkEmulator::getBurstExit)
+        .def("getBurstLoss", &LinkEmulator::getBurstLoss)
+        .def("setDuplicate", &LinkEmulator::setDuplicate)
+        .def("getDuplicate", &LinkEmulator::getDuplicate)
+        .def("setReorder", &LinkEmulator::setReorder)
+        .def("getReorder", &LinkEmulator::getReorder)
+        .def("getReorderGap", &LinkEmulator::getReorderGap)
+        .def("setDelay", &LinkEmulator::setDelay)
+        .def("getDelay", &LinkEmulator::getDelay)
+        .def("getJitter", &LinkEmulator::getJitter)
+        .def("setBandwidth", &LinkEmulator::setBandwidth)
+        .def("getBandwidth", &LinkEmulator::getBandwidth)
+        .def("setQueueDepth", &LinkEmulator::setQueueDepth)
+        .def("getQueueDepth", &LinkEmulator::getQueueDepth)
+        .def("getDepth", &LinkEmulator::getDepth)
+        .def("getRxCount", &LinkEmulator::getRxCount)
+        .def("getTxCount", &LinkEmulator::getTxCount)
+        .def("getLossCount", &LinkEmulator::getLossCount)
+        .def("getOverflowCount", &LinkEmulator::getOverflowCount)
+        .def("getDupCount", &LinkEmulator::getDupCount)
+        .def("getReorderCount", &LinkEmulator::getReorderCount)
+        .def("clearCnt", &LinkEmulator::clearCnt);
+#endif
+}
+
+//! Creator
+ris::LinkEmulator::LinkEmulator()
+    : ris::Master(),
+      ris::Slave(),
+      log_(rogue::Logging::create("stream.LinkEmulator")),
+      loss_(0.0),
+      burstEnter_(0.0),
+      burstExit_(1.0),
+      burstLoss_(1.0),
+      duplicate_(0.0),
+      reorder_(0.0),
+      reorderGap_(0),
+      delay_(0),
+      jitter_(0),
+      bandwidth_(0),
+      queueDepth_(0),
+      seed_(0),
+      rng_(0),
+      burstBad_(false),
+      seq_(0),
+      lastRelease_(Clock::time_point::min()),
+      wireFree_(Clock::time_point::min()),
+      rxCount_(0),
+      txCount_(0),
+      lossCount_(0),
+      overflowCount_(0),
+      dupCount_(0),
+      reorderCount_(0),
+      threadEn_(true),
+      thread_(new std::thread(&ris::LinkEmulator::runThread, this)) {
+    // Set a thread name
+#ifndef __MACH__
+    pthread_setname_np(thread_->native_handle(), "LinkEmulator");
+#endif
+}
+
+//! Deconstructor
+ris::LinkEmulator::~LinkEmulator() {
+    if (thread_ != nullptr) {
+        rogue::GilRelease noGil;
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            threadEn_ = false;
+        }
+        cond_.notify_all();
+        thread_->join();
+        delete thread_;
+        thread_ = nullptr;
+    }
+}
+
+//! Uniform draw from the top 53 bits, avoiding library specific distributions
+double ris::LinkEmulator::draw() {
+    return (static_cast<double>(rng_() >> 11) * (1.0 / 9007199254740992.0));
+}
+
+//! Check a probability argument
+void ris::LinkEmulator::checkProb(const char* src, double prob) {
+    if (!(prob >= 0.0 && prob <= 1.0))
+        throw(rogue::GeneralError::create(src, "Probability %f is outside of [0, 1]", prob));
+}
+
+//! Set the random seed
+void ris::LinkEmulator::setSeed(uint64_t seed) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    seed_ = seed;
+    rng_.seed(seed);
+    burstBad_ = false;
+}
+
+//! Get the random seed
+uint64_t ris::LinkEmulator::getSeed() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return seed_;
+}
+
+//! Set the random loss probability
+void ris::LinkEmulator::setLoss(double prob) {
+    checkProb("LinkEmulator::setLoss", prob);
+    std::lock_guard<std::mutex> lock(mtx_);
+    loss_ = prob;
+}
+
+//! Get the random loss probability
+double ris::LinkEmulator::getLoss() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return loss_;
+}
+
+//! Configure the burst loss model
+void ris::LinkEmulator::setBurstLoss(double enter, double exit, double loss) {
+    checkProb("LinkEmulator::setBurstLoss", enter);
+    checkProb("LinkEmulator::setBurstLoss", exit);
+    checkProb("LinkEmulator::setBurstLoss", loss);
+
+    std::lock_guard<std::mutex> lock(mtx_);
+    burstEnter_ = enter;
+    burstExit_  = exit;
+    burstLoss_  = loss;
+    if (enter == 0.0) burstBad_ = false;
+}
+
+//! Get the good to bad transition probability
+double ris::LinkEmulator::getBurstEnter() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return burstEnter_;
+}
+
+//! Get the bad to good transition probability
+double ris::LinkEmulator::getBurstExit() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return burstExit_;
+}
+
+//! Get the bad state loss probability
+double ris::LinkEmulator::getBurstLoss() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return burstLoss_;
+}
+
+//! Set the duplication probability
+void ris::LinkEmulator::setDuplicate(double prob) {
+    checkProb("LinkEmulator::setDuplicate", prob);
+    std::lock_guard<std::mutex> lock(mtx_);
+    duplicate_ = prob;
+}
+
+//! Get the duplication probability
+double ris::LinkEmulator::getDuplicate() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return duplicate_;
+}
+
+//! Configure reordering
+void ris::LinkEmulator::setReorder(double prob, uint32_t gap) {
+    checkProb("LinkEmulator::setReorder", prob);
+    std::lock_guard<std::mutex> lock(mtx_);
+    reorder_    = prob;
+    reorderGap_ = std::chrono::microseconds(gap);
+}
+
+//! Get the reorder probability
+double ris::LinkEmulator::getReorder() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return reorder_;
+}
+
+//! Get the reorder gap
+uint32_t ris::LinkEmulator::getReorderGap() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return reorderGap_.count();
+}
+
+//! Set the propagation delay
+void ris::LinkEmulator::setDelay(uint32_t delay, uint32_t jitter) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    delay_  = std::chrono::microseconds(delay);
+    jitter_ = std::chrono::microseconds(jitter);
+}
+
+//! Get the fixed delay
+uint32_t ris::LinkEmulator::getDelay() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return delay_.count();
+}
+
+//! Get the jitter
+uint32_t ris::LinkEmulator::getJitter() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return jitter_.count();
+}
+
+//! Set the link bandwidth
+void ris::LinkEmulator::setBandwidth(uint64_t rate) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    bandwidth_ = rate;
+}
+
+//! Get the link bandwidth
+uint64_t ris::LinkEmulator::getBandwidth() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return bandwidth_;
+}
+
+//! Set the bandwidth limiter queue depth
+void ris::LinkEmulator::setQueueDepth(uint32_t depth) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    queueDepth_ = depth;
+}
+
+//! Get the bandwidth limiter queue depth
+uint32_t ris::LinkEmulator::getQueueDepth() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return queueDepth_;
+}
+
+//! Get the delay line depth
+uint32_t ris::LinkEmulator::getDepth() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return line_.size();
+}
+
+//! Get the accepted frame count
+uint64_t ris::LinkEmulator::getRxCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return rxCount_;
+}
+
+//! Get the forwarded frame count
+uint64_t ris::LinkEmulator::getTxCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return txCount_;
+}
+
+//! Get the lost frame count
+uint64_t ris::LinkEmulator::getLossCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return lossCount_;
+}
+
+//! Get the overflow frame count
+uint64_t ris::LinkEmulator::getOverflowCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return overflowCount_;
+}
+
+//! Get the duplicate frame count
+uint64_t ris::LinkEmulator::getDupCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return dupCount_;
+}
+
+//! Get the reordered frame count
+uint64_t ris::LinkEmulator::getReorderCount() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return reorderCount_;
+}
+
+//! Clear counters
+void ris::LinkEmulator::clearCnt() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    rxCount_       = 0;
+    txCount_       = 0;
+    lossCount_     = 0;
+    overflowCount_ = 0;
+    dupCount_      = 0;
+    reorderCount_  = 0;
+}
+
+//! Copy a frame, caller holds the frame lock
+ris::FramePtr ris::LinkEmulator::copy(ris::FramePtr frame) {
+    uint32_t size;
+    ris::FramePtr nFrame;
+    ris::FrameIterator src;
+    ris::FrameIterator dst;
+
+    size   = frame->getPayload();
+    nFrame = reqFrame(size, true);
+    nFrame->setPayload(size);
+
+    src = frame->begin();
+    dst = nFrame->begin();
+
+    ris::copyFrame(src, size, dst);
+    nFrame->setError(frame->getError());
+    nFrame->setChannel(frame->getChannel());
+    nFrame->setFlags(frame->getFlags());
+    return nFrame;
+}
+
+//! Accept a frame from master
+void ris::LinkEmulator::acceptFrame(ris::FramePtr frame) {
+    Clock::time_point now;
+    Clock::time_point release;
+    ris::FramePtr nFrame;
+    ris::FramePtr dFrame;
+    double stateDraw;
+    double lossDraw;
+    double jitterDraw;
+    double reorderDraw;
+    double dupDraw;
+    double lossProb;
+    uint32_t size;
+    int64_t hold;
+    bool notify;
+
+    rogue::GilRelease noGil;
+    ris::FrameLockPtr lock = frame->lock();
+
+    size   = frame->getPayload();
+    nFrame = copy(frame);
+
+    // Allocate the duplicate up front so no buffer request is made under mtx_
+    if (getDuplicate() > 0.0) dFrame = copy(frame);
+
+    std::unique_lock<std::mutex> lk(mtx_);
+    now = Clock::now();
+    ++rxCount_;
+
+    // Fixed number of draws per frame keeps the pattern independent of timing
+    stateDraw   = draw();
+    lossDraw    = draw();
+    jitterDraw  = draw();
+    reorderDraw = draw();
+    dupDraw     = draw();
+
+    // Gilbert-Elliott state transition
+    if (burstEnter_ > 0.0) {
+        if (burstBad_)
+            burstBad_ = !(stateDraw < burstExit_);
+        else
+            burstBad_ = (stateDraw < burstEnter_);
+    }
+
+    // Serialize on the link, dropping when the limiter queue is full
+    release = now;
+    if (bandwidth_ > 0) {
+        while ((!wire_.empty()) && wire_.front() <= now) wire_.pop_front();
+
+        if (queueDepth_ > 0 && wire_.size() >= queueDepth_) {
+            ++overflowCount_;
+            return;
+        }
+
+        if (wireFree_ < now) wireFree_ = now;
+        wireFree_ += std::chrono::duration_cast<Clock::duration>(
+            std::chrono::nanoseconds((static_cast<uint64_t>(size) * 1000000000ULL) / bandwidth_));
+        wire_.push_back(wireFree_);
+        release = wireFree_;
+    }
+
+    lossProb = burstBad_ ? burstLoss_ : loss_;
+    if (lossDraw < lossProb) {
+        ++lossCount_;
+        return;
+    }
+
+    // Delay with uniform jitter, never releasing ahead of an earlier frame
+    hold = delay_.count();
+    if (jitter_.count() > 0)
+        hold += static_cast<int64_t>(jitterDraw * static_cast<double>(2 * jitter_.count() + 1)) - jitter_.count();
+    if (hold > 0) release += std::chrono::microseconds(hold);
+
+    if (release < lastRelease_) release = lastRelease_;
+    lastRelease_ = release;
+
+    // Held back frames do not move lastRelease_, so later frames overtake them
+    if (reorderDraw < reorder_) {
+        ++reorderCount_;
+        release += reorderGap_;
+    }
+
+    notify = line_.empty() || release < line_.top().release;
+    line_.push(Entry{release, seq_++, nFrame});
+
+    // No copy exists if duplication was enabled after the check above
+    if (dupDraw < duplicate_ && dFrame) {
+        ++dupCount_;
+        line_.push(Entry{release, seq_++, dFrame});
+    }
+
+    lk.unlock();
+    if (notify) cond_.notify_one();
+}
+
+//! Thread background
+void ris::LinkEmulator::runThread() {
+    Clock::time_point release;
+    ris::FramePtr frame;
+
+    log_->logThreadId();
+
+    std::unique_lock<std::mutex> lock(mtx_);
+
+    while (threadEn_) {
+        if (line_.empty()) {
+            cond_.wait(lock);
+            continue;
+        }
+
+        release = line_.top().release;
+        if (release > Clock::now()) {
+            cond_.wait_until(lock, release);
+            continue;
+        }
+
+        frame = line_.top().frame;
+        line_.pop();
+        ++txCount_;
+
+        lock.unlock();
+        sendFrame(frame);
+        frame.reset();
+        lock.lock();
+    }
+}
@@ -25,6 +25,7 @@
 #include "rogue/interfaces/stream/Filter.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
+#include "rogue/interfaces/stream/LinkEmulator.h"
 #include "rogue/interfaces/stream/Master.h"
 #include "rogue/interfaces/stream/RateDrop.h"
 #include "rogue/interfaces/stream/Slave.h"
@@ -57,4 +58,5 @@ void ris::setup_module() {
     ris::TcpClient::setup_python();
     ris::TcpServer::setup_python();
     ris::RateDrop::setup_python();
+    ris::LinkEmulator::setup_python();
 }
@@ -18,6 +18,8 @@
 
 #include "rogue/protocols/packetizer/Application.h"
 
+#include <inttypes.h>
+
 #include <memory>
 
 #include "rogue/GeneralError.h"
@@ -55,7 +57,8 @@ void rpp::Application::setup_python() {
 
 //! Creator
 rpp::Application::Application(uint8_t id) {
-    id_ = id;
+    id_       = id;
+    dispatch_ = rpp::DispatchThread;
     queue_.setMax(8);
 }
 
@@ -70,11 +73,28 @@ rpp::Application::~Application() {
     }
 }
 
+//! Select delivery mode
+void rpp::Application::setDispatch(uint8_t mode, rpp::WorkerPoolPtr pool) {
+    if (cntl_) return;
+
+    if ((mode == rpp::DispatchPool && !pool) || mode > rpp::DispatchInline)
+        throw(rogue::GeneralError::create("Application::setDispatch", "Invalid dispatch mode %" PRIu8, mode));
+
+    dispatch_ = mode;
+    pool_     = pool;
+}
+
 //! Setup links
 void rpp::Application::setController(rpp::ControllerPtr cntl) {
     // One-shot: re-assigning a joinable std::thread triggers std::terminate.
     if (thread_) return;
 
+    // Pool and inline delivery do not need a per-endpoint thread
+    if (dispatch_ != rpp::DispatchThread) {
+        cntl_ = cntl;
+        return;
+    }
+
     // threadEn_ must precede thread ctor; rollback both on spawn failure.
     rpp::ControllerPtr prevCntl = cntl_;
     cntl_ = cntl;
@@ -105,7 +125,12 @@ void rpp::Application::acceptFrame(ris::FramePtr frame) {
 
 //! Push frame for transmit
 void rpp::Application::pushFrame(ris::FramePtr frame) {
-    queue_.push(frame);
+    if (dispatch_ == rpp::DispatchPool)
+        pool_->push(id_, ris::Master::shared_from_this(), frame);
+    else if (dispatch_ == rpp::DispatchInline)
+        sendFrame(frame);
+    else
+        queue_.push(frame);
 }
 
 //! Thread background
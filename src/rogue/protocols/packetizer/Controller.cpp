@@ -18,8 +18,12 @@
 
 #include <inttypes.h>
 
+#include <string.h>
+
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -27,30 +31,40 @@
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
+#include "rogue/interfaces/stream/Pool.h"
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/Transport.h"
 
 namespace rpp = rogue::protocols::packetizer;
 namespace ris = rogue::interfaces::stream;
 
+// Scheduler credit per weight unit per round, in bytes
+static const uint64_t TxQuantum = 8192;
+
 //! Creator
 rpp::Controller::Controller(rpp::TransportPtr tran,
                             rpp::ApplicationPtr* app,
                             uint32_t headSize,
                             uint32_t tailSize,
                             uint32_t alignSize,
-                            bool enSsi) {
+                            bool enSsi,
+                            bool interleave) {
     uint32_t x;
 
-    enSsi_     = enSsi;
-    app_       = app;
-    tran_      = tran;
-    appIndex_  = 0;
-    tranIndex_ = 0;
-    tranDest_  = 0;
-    dropCount_ = 0;
-    tranQueue_.setThold(64);
-    log_ = rogue::Logging::create("packetizer.Controller");
+    enSsi_        = enSsi;
+    app_          = app;
+    tran_         = tran;
+    appIndex_     = 0;
+    tranIndex_    = 0;
+    tranDest_     = 0;
+    dropCount_    = 0;
+    txInterleave_ = interleave;
+    txRun_        = true;
+    txVisit_      = false;
+    txLocked_     = false;
+    rxSize_       = 0;
+    rxOverflow_   = 0;
+    log_          = rogue::Logging::create("packetizer.Controller");
 
     rogue::defaultTimeout(timeout_);
 
@@ -59,9 +73,16 @@ rpp::Controller::Controller(rpp::TransportPtr tran,
     alignSize_ = alignSize;
 
     for (x = 0; x < 256; x++) {
-        transSof_[x]  = true;
-        crc_[x]       = 0;
-        tranCount_[x] = 0;
+        transSof_[x]   = true;
+        crc_[x]        = 0;
+        tranCount_[x]  = 0;
+        rxChain_[x]    = true;
+        txWeight_[x]   = 1;
+        txLimit_[x]    = 64;
+        txDeficit_[x]  = 0;
+        txFrames_[x]   = 0;
+        txDelaySum_[x] = 0.0;
+        txDelayMax_[x] = 0.0;
     }
 }
 
@@ -73,7 +94,10 @@ rpp::Controller::~Controller() {
 //! Stop TX
 void rpp::Controller::stopQueue() {
     rogue::GilRelease noGil;
-    tranQueue_.stop();
+    std::lock_guard<std::mutex> lock(txMtx_);
+    txRun_ = false;
+    txCond_.notify_all();
+    txSpace_.notify_all();
 }
 
 //! Transport frame allocation request
@@ -126,14 +150,142 @@ ris::FramePtr rpp::Controller::reqFrame(uint32_t size) {
 //! Frame received at transport interface
 void rpp::Controller::transportRx(ris::FramePtr frame) {}
 
+//! Start a new reassembly frame
+// Called with tranMtx_ held
+void rpp::Controller::rxStart(uint32_t idx) {
+    if (rxSize_ > 0) {
+        tranFrame_[idx] = rxPool_->acceptReq(rxSize_, false);
+        rxChain_[idx]   = false;
+    } else {
+        tranFrame_[idx] = ris::Frame::create();
+        rxChain_[idx]   = true;
+    }
+}
+
+//! Add a segment to the reassembly frame
+// Called with tranMtx_ held
+void rpp::Controller::rxAppend(uint32_t idx, ris::BufferPtr buff) {
+    ris::BufferPtr dst;
+
+    if (!rxChain_[idx]) {
+        dst = *(tranFrame_[idx]->beginBuffer());
+
+        // Copy into the contiguous buffer while it fits
+        if (dst->getAvailable() >= buff->getPayload()) {
+            memcpy(dst->endPayload(), buff->begin(), buff->getPayload());
+            dst->adjustPayload(buff->getPayload());
+            return;
+        }
+
+        // Chain the remaining segments
+        log_->debug("Reassembly buffer overflow at %" PRIu32 " bytes, chaining remaining segments",
+                    dst->getPayload());
+        rxChain_[idx] = true;
+        rxOverflow_++;
+    }
+    tranFrame_[idx]->appendBuffer(buff);
+}
+
 //! Frame transmit at transport interface
 // Called by transport class thread
 ris::FramePtr rpp::Controller::transportTx() {
     ris::FramePtr frame;
-    frame = tranQueue_.pop();
+    uint8_t dest;
+    double delay;
+    bool eof;
+
+    std::unique_lock<std::mutex> lock(txMtx_);
+
+    while (txRun_ && txActive_.empty()) txCond_.wait(lock);
+    if (!txRun_) return (ris::FramePtr());
+
+    // Deficit round-robin across active destinations
+    while (1) {
+        dest = txActive_.front();
+        std::deque<TxEntry>& queue = txQueue_[dest];
+
+        // Credit the destination once per visit
+        if (!txVisit_) {
+            txDeficit_[dest] += txWeight_[dest] * TxQuantum;
+            txVisit_ = true;
+        }
+
+        // Head segment does not fit, move to the next destination
+        // A destination that must not be interleaved keeps the link until EOF
+        if (!txLocked_ && queue.front().size > txDeficit_[dest]) {
+            txActive_.pop_front();
+            txActive_.push_back(dest);
+            txVisit_ = false;
+            continue;
+        }
+
+        frame = queue.front().frame;
+        eof   = queue.front().eof;
+        txDeficit_[dest] -= std::min(txDeficit_[dest], static_cast<uint64_t>(queue.front().size));
+
+        if (eof) {
+            delay = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - queue.front().time)
+                        .count();
+            txFrames_[dest]++;
+            txDelaySum_[dest] += delay;
+            if (delay > txDelayMax_[dest]) txDelayMax_[dest] = delay;
+        }
+
+        queue.pop_front();
+        txLocked_ = (!txInterleave_) && (!eof);
+
+        // Idle destinations do not keep credit
+        if (queue.empty()) {
+            txDeficit_[dest] = 0;
+            txActive_.pop_front();
+            txVisit_ = false;
+        }
+        break;
+    }
+
+    txSpace_.notify_all();
     return (frame);
 }
 
+//! Wait for room in a destination queue
+bool rpp::Controller::txWait(uint8_t dest, const char* name) {
+    std::unique_lock<std::mutex> lock(txMtx_);
+
+    while (txRun_ && txQueue_[dest].size() >= txLimit_[dest]) {
+        if (txSpace_.wait_for(lock,
+                              std::chrono::seconds(timeout_.tv_sec) + std::chrono::microseconds(timeout_.tv_usec)) ==
+            std::cv_status::timeout) {
+            log_->critical("%s: Timeout waiting for outbound queue after %" PRIu32 ".%" PRIu32
+                           " seconds! May be caused by outbound backpressure.",
+                           name,
+                           timeout_.tv_sec,
+                           timeout_.tv_usec);
+        }
+    }
+    return (txRun_);
+}
+
+//! Queue the segments of one frame
+void rpp::Controller::txPush(uint8_t dest, std::vector<ris::FramePtr>& segments) {
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    TxEntry entry;
+    uint32_t x;
+
+    std::lock_guard<std::mutex> lock(txMtx_);
+    if (!txRun_ || segments.empty()) return;
+
+    if (txQueue_[dest].empty()) txActive_.push_back(dest);
+
+    for (x = 0; x < segments.size(); x++) {
+        entry.frame = segments[x];
+        entry.size  = segments[x]->getPayload();
+        entry.eof   = (x == (segments.size() - 1));
+        entry.time  = now;
+        txQueue_[dest].push_back(entry);
+    }
+    txCond_.notify_one();
+}
+
 //! Frame received at application interface
 void rpp::Controller::applicationRx(ris::FramePtr frame, uint8_t tDest) {}
 
@@ -148,3 +300,78 @@ void rpp::Controller::setTimeout(uint32_t timeout) {
     timeout_.tv_sec  = divResult.quot;
     timeout_.tv_usec = divResult.rem;
 }
+
+//! Set destination scheduling weight
+void rpp::Controller::setTxWeight(uint8_t dest, uint32_t weight) {
+    if (weight == 0) throw(rogue::GeneralError("packetizer::Controller::setTxWeight", "Weight must be at least 1"));
+
+    std::lock_guard<std::mutex> lock(txMtx_);
+    txWeight_[dest] = weight;
+}
+
+//! Set destination queue limit
+void rpp::Controller::setTxLimit(uint8_t dest, uint32_t limit) {
+    if (limit == 0) throw(rogue::GeneralError("packetizer::Controller::setTxLimit", "Limit must be at least 1"));
+
+    std::lock_guard<std::mutex> lock(txMtx_);
+    txLimit_[dest] = limit;
+    txSpace_.notify_all();
+}
+
+//! Get destination queue depth
+uint32_t rpp::Controller::getTxDepth(uint8_t dest) {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    return (txQueue_[dest].size());
+}
+
+//! Get destination transmitted frame count
+uint64_t rpp::Controller::getTxFrameCount(uint8_t dest) {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    return (txFrames_[dest]);
+}
+
+//! Get destination mean queueing delay in microseconds
+double rpp::Controller::getTxDelayMean(uint8_t dest) {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    if (txFrames_[dest] == 0) return (0.0);
+    return (txDelaySum_[dest] / txFrames_[dest]);
+}
+
+//! Get destination maximum queueing delay in microseconds
+double rpp::Controller::getTxDelayMax(uint8_t dest) {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    return (txDelayMax_[dest]);
+}
+
+//! Clear transmit statistics
+void rpp::Controller::resetTxStats() {
+    uint32_t x;
+
+    std::lock_guard<std::mutex> lock(txMtx_);
+    for (x = 0; x < 256; x++) {
+        txFrames_[x]   = 0;
+        txDelaySum_[x] = 0.0;
+        txDelayMax_[x] = 0.0;
+    }
+}
+
+//! Enable contiguous receive reassembly
+void rpp::Controller::setRxContiguous(uint32_t size, uint32_t depth) {
+    rogue::GilRelease noGil;
+    std::lock_guard<std::mutex> lock(tranMtx_);
+
+    // Frames in progress keep the buffers of the old pool
+    rxPool_.reset();
+    rxSize_ = size;
+
+    if (size > 0) {
+        rxPool_ = std::make_shared<ris::Pool>();
+        rxPool_->setFixedSize(size);
+        rxPool_->setPoolSize(depth);
+    }
+}
+
+//! Get reassembly overflow count
+uint32_t rpp::Controller::getRxOverflowCount() {
+    return (rxOverflow_);
+}
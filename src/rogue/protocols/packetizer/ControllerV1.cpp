@@ -23,6 +23,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -43,7 +44,7 @@ rpp::ControllerV1Ptr rpp::ControllerV1::create(bool enSsi, rpp::TransportPtr tra
 
 //! Creator
 rpp::ControllerV1::ControllerV1(bool enSsi, rpp::TransportPtr tran, rpp::ApplicationPtr* app)
-    : rpp::Controller::Controller(tran, app, 8, 1, 8, enSsi) {}
+    : rpp::Controller::Controller(tran, app, 8, 1, 8, enSsi, false) {}
 
 //! Destructor
 rpp::ControllerV1::~ControllerV1() {}
@@ -150,7 +151,7 @@ void rpp::ControllerV1::transportRx(ris::FramePtr frame) {
                           tranIndex_,
                           tranCount_[0]);
 
-        tranFrame_[0] = ris::Frame::create();
+        rxStart(0);
         tranIndex_    = tmpIdx;
         tranDest_     = tmpDest;
         tranCount_[0] = 0;
@@ -158,7 +159,7 @@ void rpp::ControllerV1::transportRx(ris::FramePtr frame) {
         tranFrame_[0]->setFirstUser(tmpFuser);
     }
 
-    tranFrame_[0]->appendBuffer(buff);
+    rxAppend(0, buff);
     frame->clear();  // Empty old frame
 
     // Last of transfer
@@ -186,12 +187,7 @@ void rpp::ControllerV1::applicationRx(ris::FramePtr frame, uint8_t tDest) {
     uint32_t size;
     uint8_t fUser;
     uint8_t lUser;
-    struct timeval startTime;
-    struct timeval currTime;
-    struct timeval endTime;
-
-    gettimeofday(&startTime, NULL);
-    timeradd(&startTime, &timeout_, &endTime);
+    std::vector<ris::FramePtr> segments;
 
     if (frame->isEmpty()) log_->warning("Empty frame received on application input");
 
@@ -199,21 +195,11 @@ void rpp::ControllerV1::applicationRx(ris::FramePtr frame, uint8_t tDest) {
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr flock = frame->lock();
-    std::lock_guard<std::mutex> lock(appMtx_);
 
-    // Wait while queue is busy
-    while (tranQueue_.busy()) {
-        usleep(10);
-        gettimeofday(&currTime, NULL);
-        if (timercmp(&currTime, &endTime, >)) {
-            log_->critical("ControllerV1::applicationRx: Timeout waiting for outbound queue after %" PRIu32 ".%" PRIu32
-                           " seconds! May be caused by outbound backpressure.",
-                           timeout_.tv_sec,
-                           timeout_.tv_usec);
-            gettimeofday(&startTime, NULL);
-            timeradd(&startTime, &timeout_, &endTime);
-        }
-    }
+    // Wait for room in this destination's queue, other destinations are not blocked
+    if (!txWait(tDest, "ControllerV1::applicationRx")) return;
+
+    std::lock_guard<std::mutex> lock(appMtx_);
 
     // User fields
     fUser = frame->getFirstUser();
@@ -252,9 +238,10 @@ void rpp::ControllerV1::applicationRx(ris::FramePtr frame, uint8_t tDest) {
         if (it == (frame->endBuffer() - 1)) data[size - 1] |= 0x80;
 
         tFrame->appendBuffer(*it);
-        tranQueue_.push(tFrame);
+        segments.push_back(tFrame);
         segment++;
     }
+    txPush(tDest, segments);
     appIndex_++;
     frame->clear();  // Empty old frame
 }
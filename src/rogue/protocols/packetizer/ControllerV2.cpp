@@ -23,6 +23,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -31,15 +32,11 @@
 #include "rogue/interfaces/stream/FrameLock.h"
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/Transport.h"
+#include "rogue/utilities/Crc32.h"
 
 namespace rpp = rogue::protocols::packetizer;
 namespace ris = rogue::interfaces::stream;
-
-// Local CRC library
-#include "rogue/protocols/packetizer/CRC.h"
-
-// CRC Lookup table for later use
-static const CRC::Table<uint32_t, 32> crcTable_(CRC::CRC_32());
+namespace ru  = rogue::utilities;
 
 //! Class creation
 rpp::ControllerV2Ptr rpp::ControllerV2::create(bool enIbCrc,
@@ -57,7 +54,7 @@ rpp::ControllerV2::ControllerV2(bool enIbCrc,
                                 bool enSsi,
                                 rpp::TransportPtr tran,
                                 rpp::ApplicationPtr* app)
-    : rpp::Controller::Controller(tran, app, 8, 8, 8, enSsi) {
+    : rpp::Controller::Controller(tran, app, 8, 8, 8, enSsi, true) {
     enIbCrc_ = enIbCrc;
     enObCrc_ = enObCrc;
 }
@@ -136,9 +133,9 @@ void rpp::ControllerV2::transportRx(ris::FramePtr frame) {
 
         // Compute CRC
         if (tmpSof)
-            crc_[tmpDest] = CRC::Calculate(data, size - 4, crcTable_);
+            crc_[tmpDest] = ru::Crc32::calculate(data, size - 4);
         else
-            crc_[tmpDest] = CRC::Calculate(data, size - 4, crcTable_, crc_[tmpDest]);
+            crc_[tmpDest] = ru::Crc32::calculate(data, size - 4, crc_[tmpDest]);
 
         crcErr = (tmpCrc != crc_[tmpDest]);
     } else {
@@ -219,13 +216,13 @@ void rpp::ControllerV2::transportRx(ris::FramePtr frame) {
             return;
         }
 
-        tranFrame_[tmpDest] = ris::Frame::create();
+        rxStart(tmpDest);
         tranCount_[tmpDest] = 0;
 
         tranFrame_[tmpDest]->setFirstUser(tmpFuser);
     }
 
-    tranFrame_[tmpDest]->appendBuffer(buff);
+    rxAppend(tmpDest, buff);
     frame->clear();  // Empty old frame
 
     // Last of transfer
@@ -256,12 +253,7 @@ void rpp::ControllerV2::applicationRx(ris::FramePtr frame, uint8_t tDest) {
     uint8_t lUser;
     uint32_t crc;
     uint32_t last;
-    struct timeval startTime;
-    struct timeval currTime;
-    struct timeval endTime;
-
-    gettimeofday(&startTime, NULL);
-    timeradd(&startTime, &timeout_, &endTime);
+    std::vector<ris::FramePtr> segments;
 
     if (frame->isEmpty()) {
         log_->warning("Empty frame received on application input");
@@ -272,21 +264,11 @@ void rpp::ControllerV2::applicationRx(ris::FramePtr frame, uint8_t tDest) {
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr flock = frame->lock();
-    std::lock_guard<std::mutex> lock(appMtx_);
 
-    // Wait while queue is busy
-    while (tranQueue_.busy()) {
-        usleep(10);
-        gettimeofday(&currTime, NULL);
-        if (timercmp(&currTime, &endTime, >)) {
-            log_->critical("ControllerV2::applicationRx: Timeout waiting for outbound queue after %" PRIu32 ".%" PRIu32
-                           " seconds! May be caused by outbound backpressure.",
-                           timeout_.tv_sec,
-                           timeout_.tv_usec);
-            gettimeofday(&startTime, NULL);
-            timeradd(&startTime, &timeout_, &endTime);
-        }
-    }
+    // Wait for room in this destination's queue, other destinations are not blocked
+    if (!txWait(tDest, "ControllerV2::applicationRx")) return;
+
+    std::lock_guard<std::mutex> lock(appMtx_);
 
     fUser = frame->getFirstUser();
     lUser = frame->getLastUser();
@@ -336,9 +318,9 @@ void rpp::ControllerV2::applicationRx(ris::FramePtr frame, uint8_t tDest) {
         if (enObCrc_) {
             // Compute CRC
             if (segment == 0)
-                crc = CRC::Calculate(data, size - 4, crcTable_);
+                crc = ru::Crc32::calculate(data, size - 4);
             else
-                crc = CRC::Calculate(data, size - 4, crcTable_, crc);
+                crc = ru::Crc32::calculate(data, size - 4, crc);
 
             // Tail  word 1
             data[size - 1] = (crc >> 0) & 0xFF;
@@ -385,9 +367,10 @@ void rpp::ControllerV2::applicationRx(ris::FramePtr frame, uint8_t tDest) {
                     data[size - 1]);
 
         tFrame->appendBuffer(*it);
-        tranQueue_.push(tFrame);
+        segments.push_back(tFrame);
         segment++;
     }
+    txPush(tDest, segments);
     appIndex_++;
     frame->clear();  // Empty old frame
 }
@@ -18,6 +18,8 @@
 
 #include "rogue/protocols/packetizer/Core.h"
 
+#include <inttypes.h>
+
 #include <memory>
 
 #include "rogue/GeneralError.h"
@@ -25,6 +27,7 @@
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/ControllerV1.h"
 #include "rogue/protocols/packetizer/Transport.h"
+#include "rogue/protocols/packetizer/WorkerPool.h"
 
 namespace rpp = rogue::protocols::packetizer;
 namespace ris = rogue::interfaces::stream;
@@ -46,12 +49,25 @@ void rpp::Core::setup_python() {
     bp::class_<rpp::Core, rpp::CorePtr, boost::noncopyable>("Core", bp::init<bool>())
         .def("transport", &rpp::Core::transport)
         .def("application", &rpp::Core::application)
-        .def("getDropCount", &rpp::Core::getDropCount);
+        .def("getDropCount", &rpp::Core::getDropCount)
+        .def("setDispatch", &rpp::Core::setDispatch)
+        .def("setTimeout", &rpp::Core::setTimeout)
+        .def("setTxWeight", &rpp::Core::setTxWeight)
+        .def("setTxLimit", &rpp::Core::setTxLimit)
+        .def("getTxDepth", &rpp::Core::getTxDepth)
+        .def("getTxFrameCount", &rpp::Core::getTxFrameCount)
+        .def("getTxDelayMean", &rpp::Core::getTxDelayMean)
+        .def("getTxDelayMax", &rpp::Core::getTxDelayMax)
+        .def("resetTxStats", &rpp::Core::resetTxStats)
+        .def("setRxContiguous", &rpp::Core::setRxContiguous)
+        .def("getRxOverflowCount", &rpp::Core::getRxOverflowCount);
 #endif
 }
 
 //! Creator
 rpp::Core::Core(bool enSsi) {
+    dispatch_ = rpp::DispatchThread;
+
     tran_ = rpp::Transport::create();
     cntl_ = rpp::ControllerV1::create(enSsi, tran_, app_);
 
@@ -62,6 +78,9 @@ rpp::Core::Core(bool enSsi) {
 rpp::Core::~Core() {
     uint32_t x;
 
+    // Join shared workers before releasing the endpoints they deliver for
+    if (pool_) pool_->stop();
+
     tran_.reset();
     cntl_.reset();
 
@@ -77,11 +96,31 @@ rpp::TransportPtr rpp::Core::transport() {
 rpp::ApplicationPtr rpp::Core::application(uint8_t dest) {
     if (!app_[dest]) {
         app_[dest] = rpp::Application::create(dest);
+        app_[dest]->setDispatch(dispatch_, pool_);
         app_[dest]->setController(cntl_);
     }
     return (app_[dest]);
 }
 
+//! Set application dispatch mode
+void rpp::Core::setDispatch(uint8_t mode, uint32_t workers) {
+    uint32_t x;
+
+    for (x = 0; x < 256; x++)
+        if (app_[x])
+            throw(rogue::GeneralError("Core::setDispatch",
+                                      "Dispatch mode must be set before application endpoints are created"));
+
+    if (mode > rpp::DispatchInline)
+        throw(rogue::GeneralError::create("Core::setDispatch", "Invalid dispatch mode %" PRIu8, mode));
+
+    if (pool_) pool_->stop();
+    pool_.reset();
+
+    if (mode == rpp::DispatchPool) pool_ = rpp::WorkerPool::create(workers);
+    dispatch_ = mode;
+}
+
 //! Get drop count
 uint32_t rpp::Core::getDropCount() {
     return (cntl_->getDropCount());
@@ -90,3 +129,48 @@ uint32_t rpp::Core::getDropCount() {
 void rpp::Core::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
 }
+
+//! Set destination scheduling weight
+void rpp::Core::setTxWeight(uint8_t dest, uint32_t weight) {
+    cntl_->setTxWeight(dest, weight);
+}
+
+//! Set destination queue limit
+void rpp::Core::setTxLimit(uint8_t dest, uint32_t limit) {
+    cntl_->setTxLimit(dest, limit);
+}
+
+//! Get destination queue depth
+uint32_t rpp::Core::getTxDepth(uint8_t dest) {
+    return (cntl_->getTxDepth(dest));
+}
+
+//! Get destination transmitted frame count
+uint64_t rpp::Core::getTxFrameCount(uint8_t dest) {
+    return (cntl_->getTxFrameCount(dest));
+}
+
+//! Get destination mean queueing delay
+double rpp::Core::getTxDelayMean(uint8_t dest) {
+    return (cntl_->getTxDelayMean(dest));
+}
+
+//! Get destination maximum queueing delay
+double rpp::Core::getTxDelayMax(uint8_t dest) {
+    return (cntl_->getTxDelayMax(dest));
+}
+
+//! Clear transmit statistics
+void rpp::Core::resetTxStats() {
+    cntl_->resetTxStats();
+}
+
+//! Enable contiguous receive reassembly
+void rpp::Core::setRxContiguous(uint32_t size, uint32_t depth) {
+    cntl_->setRxContiguous(size, depth);
+}
+
+//! Get reassembly overflow count
+uint32_t rpp::Core::getRxOverflowCount() {
+    return (cntl_->getRxOverflowCount());
+}
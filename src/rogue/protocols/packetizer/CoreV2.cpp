@@ -18,6 +18,8 @@
 
 #include "rogue/protocols/packetizer/CoreV2.h"
 
+#include <inttypes.h>
+
 #include <memory>
 
 #include "rogue/GeneralError.h"
@@ -25,6 +27,7 @@
 #include "rogue/protocols/packetizer/Application.h"
 #include "rogue/protocols/packetizer/ControllerV2.h"
 #include "rogue/protocols/packetizer/Transport.h"
+#include "rogue/protocols/packetizer/WorkerPool.h"
 
 namespace rpp = rogue::protocols::packetizer;
 namespace ris = rogue::interfaces::stream;
@@ -46,12 +49,25 @@ void rpp::CoreV2::setup_python() {
     bp::class_<rpp::CoreV2, rpp::CoreV2Ptr, boost::noncopyable>("CoreV2", bp::init<bool, bool, bool>())
         .def("transport", &rpp::CoreV2::transport)
         .def("application", &rpp::CoreV2::application)
-        .def("getDropCount", &rpp::CoreV2::getDropCount);
+        .def("getDropCount", &rpp::CoreV2::getDropCount)
+        .def("setDispatch", &rpp::CoreV2::setDispatch)
+        .def("setTimeout", &rpp::CoreV2::setTimeout)
+        .def("setTxWeight", &rpp::CoreV2::setTxWeight)
+        .def("setTxLimit", &rpp::CoreV2::setTxLimit)
+        .def("getTxDepth", &rpp::CoreV2::getTxDepth)
+        .def("getTxFrameCount", &rpp::CoreV2::getTxFrameCount)
+        .def("getTxDelayMean", &rpp::CoreV2::getTxDelayMean)
+        .def("getTxDelayMax", &rpp::CoreV2::getTxDelayMax)
+        .def("resetTxStats", &rpp::CoreV2::resetTxStats)
+        .def("setRxContiguous", &rpp::CoreV2::setRxContiguous)
+        .def("getRxOverflowCount", &rpp::CoreV2::getRxOverflowCount);
 #endif
 }
 
 //! Creator
 rpp::CoreV2::CoreV2(bool enIbCrc, bool enObCrc, bool enSsi) {
+    dispatch_ = rpp::DispatchThread;
+
     tran_ = rpp::Transport::create();
     cntl_ = rpp::ControllerV2::create(enIbCrc, enObCrc, enSsi, tran_, app_);
 
@@ -62,6 +78,9 @@ rpp::CoreV2::CoreV2(bool enIbCrc, bool enObCrc, bool enSsi) {
 rpp::CoreV2::~CoreV2() {
     uint32_t x;
 
+    // Join shared workers before releasing the endpoints they deliver for
+    if (pool_) pool_->stop();
+
     tran_.reset();
     cntl_.reset();
 
@@ -77,11 +96,31 @@ rpp::TransportPtr rpp::CoreV2::transport() {
 rpp::ApplicationPtr rpp::CoreV2::application(uint8_t dest) {
     if (!app_[dest]) {
         app_[dest] = rpp::Application::create(dest);
+        app_[dest]->setDispatch(dispatch_, pool_);
         app_[dest]->setController(cntl_);
     }
     return (app_[dest]);
 }
 
+//! Set application dispatch mode
+void rpp::CoreV2::setDispatch(uint8_t mode, uint32_t workers) {
+    uint32_t x;
+
+    for (x = 0; x < 256; x++)
+        if (app_[x])
+            throw(rogue::GeneralError("CoreV2::setDispatch",
+                                      "Dispatch mode must be set before application endpoints are created"));
+
+    if (mode > rpp::DispatchInline)
+        throw(rogue::GeneralError::create("CoreV2::setDispatch", "Invalid dispatch mode %" PRIu8, mode));
+
+    if (pool_) pool_->stop();
+    pool_.reset();
+
+    if (mode == rpp::DispatchPool) pool_ = rpp::WorkerPool::create(workers);
+    dispatch_ = mode;
+}
+
 //! Get drop count
 uint32_t rpp::CoreV2::getDropCount() {
     return (cntl_->getDropCount());
@@ -90,3 +129,48 @@ uint32_t rpp::CoreV2::getDropCount() {
 void rpp::CoreV2::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
 }
+
+//! Set destination scheduling weight
+void rpp::CoreV2::setTxWeight(uint8_t dest, uint32_t weight) {
+    cntl_->setTxWeight(dest, weight);
+}
+
+//! Set destination queue limit
+void rpp::CoreV2::setTxLimit(uint8_t dest, uint32_t limit) {
+    cntl_->setTxLimit(dest, limit);
+}
+
+//! Get destination queue depth
+uint32_t rpp::CoreV2::getTxDepth(uint8_t dest) {
+    return (cntl_->getTxDepth(dest));
+}
+
+//! Get destination transmitted frame count
+uint64_t rpp::CoreV2::getTxFrameCount(uint8_t dest) {
+    return (cntl_->getTxFrameCount(dest));
+}
+
+//! Get destination mean queueing delay
+double rpp::CoreV2::getTxDelayMean(uint8_t dest) {
+    return (cntl_->getTxDelayMean(dest));
+}
+
+//! Get destination maximum queueing delay
+double rpp::CoreV2::getTxDelayMax(uint8_t dest) {
+    return (cntl_->getTxDelayMax(dest));
+}
+
+//! Clear transmit statistics
+void rpp::CoreV2::resetTxStats() {
+    cntl_->resetTxStats();
+}
+
+//! Enable contiguous receive reassembly
+void rpp::CoreV2::setRxContiguous(uint32_t size, uint32_t depth) {
+    cntl_->setRxContiguous(size, depth);
+}
+
+//! Get reassembly overflow count
+uint32_t rpp::CoreV2::getRxOverflowCount() {
+    return (cntl_->getRxOverflowCount());
+}
@@ -0,0 +1,109 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Packetizer Shared Application Worker Pool
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/protocols/packetizer/WorkerPool.h"
+
+#include <memory>
+
+#include "rogue/GeneralError.h"
+#include "rogue/GilRelease.h"
+#include "rogue/Logging.h"
+#include "rogue/interfaces/stream/Frame.h"
+
+namespace rpp = rogue::protocols::packetizer;
+namespace ris = rogue::interfaces::stream;
+
+//! Class creation
+rpp::WorkerPoolPtr rpp::WorkerPool::create(uint32_t count) {
+    rpp::WorkerPoolPtr r = std::make_shared<rpp::WorkerPool>(count);
+    return (r);
+}
+
+//! Creator
+rpp::WorkerPool::WorkerPool(uint32_t count) {
+    uint32_t x;
+
+    if (count == 0) throw(rogue::GeneralError("WorkerPool::WorkerPool", "Worker count must be at least 1"));
+
+    for (x = 0; x < count; x++) {
+        lanes_.push_back(std::make_unique<Lane>());
+        lanes_.back()->queue.setMax(8);
+    }
+
+    threadEn_ = true;
+    try {
+        for (auto& lane : lanes_) {
+            lane->thread = std::make_unique<std::thread>(&rpp::WorkerPool::runThread, this, lane.get());
+
+            // Set a thread name
+#ifndef __MACH__
+            pthread_setname_np(lane->thread->native_handle(), "PackPool");
+#endif
+        }
+    } catch (...) {
+        stop();
+        throw;
+    }
+}
+
+//! Destructor
+rpp::WorkerPool::~WorkerPool() {
+    stop();
+}
+
+//! Stop all lanes
+void rpp::WorkerPool::stop() {
+    rogue::GilRelease noGil;
+    threadEn_ = false;
+
+    for (auto& lane : lanes_) lane->queue.stop();
+
+    for (auto& lane : lanes_) {
+        if (lane->thread) {
+            lane->thread->join();
+            lane->thread.reset();
+        }
+
+        // Drop queued entries so endpoints are released
+        lane->queue.reset();
+    }
+}
+
+//! Get lane count
+uint32_t rpp::WorkerPool::count() {
+    return lanes_.size();
+}
+
+//! Queue a frame on the destination lane
+void rpp::WorkerPool::push(uint8_t dest, ris::MasterPtr src, ris::FramePtr frame) {
+    lanes_[dest % lanes_.size()]->queue.push(std::make_pair(src, frame));
+}
+
+//! Thread background
+void rpp::WorkerPool::runThread(Lane* lane) {
+    Entry entry;
+    Logging log("packetizer.WorkerPool");
+    log.logThreadId();
+
+    while (threadEn_) {
+        entry = lane->queue.pop();
+        if (entry.first) entry.first->sendFrame(entry.second);
+        entry.first.reset();
+        entry.second.reset();
+    }
+}
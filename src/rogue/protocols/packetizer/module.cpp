@@ -25,6 +25,7 @@
 #include "rogue/protocols/packetizer/Core.h"
 #include "rogue/protocols/packetizer/CoreV2.h"
 #include "rogue/protocols/packetizer/Transport.h"
+#include "rogue/protocols/packetizer/WorkerPool.h"
 
 namespace bp  = boost::python;
 namespace rpp = rogue::protocols::packetizer;
@@ -39,6 +40,11 @@ void rpp::setup_module() {
     // set the current scope to the new sub-module
     bp::scope io_scope = module;
 
+    // Application dispatch modes
+    bp::scope().attr("DispatchThread") = rpp::DispatchThread;
+    bp::scope().attr("DispatchPool")   = rpp::DispatchPool;
+    bp::scope().attr("DispatchInline") = rpp::DispatchInline;
+
     rpp::Application::setup_python();
     rpp::Transport::setup_python();
     rpp::Core::setup_python();
@@ -78,6 +78,21 @@ void rpr::Client::setup_python() {
         .def("curMaxRetran", &rpr::Client::curMaxRetran)
         .def("curMaxCumAck", &rpr::Client::curMaxCumAck)
         .def("resetCounters", &rpr::Client::resetCounters)
+        .def("setAdaptiveRetran", &rpr::Client::setAdaptiveRetran)
+        .def("getAdaptiveRetran", &rpr::Client::getAdaptiveRetran)
+        .def("getRttMean", &rpr::Client::getRttMean)
+        .def("getRttVar", &rpr::Client::getRttVar)
+        .def("getRetranTimeout", &rpr::Client::getRetranTimeout)
+        .def("getRetranToutCount", &rpr::Client::getRetranToutCount)
+        .def("getRetranFastCount", &rpr::Client::getRetranFastCount)
+        .def("setTxPacingRate", &rpr::Client::setTxPacingRate)
+        .def("getTxPacingRate", &rpr::Client::getTxPacingRate)
+        .def("setTxPacingBurst", &rpr::Client::setTxPacingBurst)
+        .def("getTxPacingBurst", &rpr::Client::getTxPacingBurst)
+        .def("setTxPacingAuto", &rpr::Client::setTxPacingAuto)
+        .def("getTxPacingAuto", &rpr::Client::getTxPacingAuto)
+        .def("getTxPacingActiveRate", &rpr::Client::getTxPacingActiveRate)
+        .def("getTxPacedCount", &rpr::Client::getTxPacedCount)
         .def("setTimeout", &rpr::Client::setTimeout)
         .def("_stop", &rpr::Client::stop)
         .def("_start", &rpr::Client::start);
@@ -245,6 +260,67 @@ void rpr::Client::resetCounters() {
     cntl_->resetCounters();
 }
 
+//! Enable adaptive retransmission
+void rpr::Client::setAdaptiveRetran(bool enable) {
+    cntl_->setAdaptiveRetran(enable);
+}
+
+bool rpr::Client::getAdaptiveRetran() {
+    return cntl_->getAdaptiveRetran();
+}
+
+uint32_t rpr::Client::getRttMean() {
+    return cntl_->getRttMean();
+}
+
+uint32_t rpr::Client::getRttVar() {
+    return cntl_->getRttVar();
+}
+
+uint32_t rpr::Client::getRetranTimeout() {
+    return cntl_->getRetranTimeout();
+}
+
+uint32_t rpr::Client::getRetranToutCount() {
+    return cntl_->getRetranToutCount();
+}
+
+uint32_t rpr::Client::getRetranFastCount() {
+    return cntl_->getRetranFastCount();
+}
+
+void rpr::Client::setTxPacingRate(uint64_t rate) {
+    cntl_->setTxPacingRate(rate);
+}
+
+uint64_t rpr::Client::getTxPacingRate() {
+    return cntl_->getTxPacingRate();
+}
+
+void rpr::Client::setTxPacingBurst(uint32_t burst) {
+    cntl_->setTxPacingBurst(burst);
+}
+
+uint32_t rpr::Client::getTxPacingBurst() {
+    return cntl_->getTxPacingBurst();
+}
+
+void rpr::Client::setTxPacingAuto(bool enable) {
+    cntl_->setTxPacingAuto(enable);
+}
+
+bool rpr::Client::getTxPacingAuto() {
+    return cntl_->getTxPacingAuto();
+}
+
+uint64_t rpr::Client::getTxPacingActiveRate() {
+    return cntl_->getTxPacingActiveRate();
+}
+
+uint32_t rpr::Client::getTxPacedCount() {
+    return cntl_->getTxPacedCount();
+}
+
 //! Set timeout for frame transmits in microseconds
 void rpr::Client::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
@@ -20,17 +20,19 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <cmath>
 #include <cstdlib>
 #include <cstring>
-#include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
 #include "rogue/Helpers.h"
 #include "rogue/Logging.h"
+#include "rogue/TimerWheel.h"
 #include "rogue/interfaces/stream/Buffer.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameLock.h"
@@ -41,6 +43,8 @@
 namespace rpr = rogue::protocols::rssi;
 namespace ris = rogue::interfaces::stream;
 
+typedef rogue::TimerWheel::Clock Clock;
+
 //! Class creation
 rpr::ControllerPtr rpr::Controller::create(uint32_t segSize,
                                            rpr::TransportPtr tran,
@@ -51,7 +55,8 @@ rpr::ControllerPtr rpr::Controller::create(uint32_t segSize,
 }
 
 //! Creator
-rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::ApplicationPtr app, bool server) {
+rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::ApplicationPtr app, bool server)
+    : wheel_(std::chrono::microseconds(100)) {
     app_    = app;
     tran_   = tran;
     server_ = server;
@@ -70,15 +75,33 @@ rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::Appli
     lastSeqRx_ = 0;
     ackSeqRx_  = 0;
 
-    state_ = StClosed;
-    gettimeofday(&stTime_, NULL);
+    oooMask_[0] = 0;
+    oooMask_[1] = 0;
+    oooMask_[2] = 0;
+    oooMask_[3] = 0;
+    oooCount_   = 0;
+
+    state_       = StClosed;
+    stEvent_     = false;
+    stTime_      = Clock::now();
     downCount_   = 0;
     retranCount_ = 0;
 
     txListCount_ = 0;
     lastAckTx_   = 0;
     locSequence_ = 100;
-    gettimeofday(&txTime_, NULL);
+    txTime_      = Clock::now();
+    wakeTime_    = Clock::time_point::min();
+
+    for (uint32_t x = 0; x < 256; x++) retranDue_[x] = RetranNone;
+
+    adaptive_    = false;
+    rttValid_    = false;
+    rttMean_     = std::chrono::microseconds(0);
+    rttVar_      = std::chrono::microseconds(0);
+    dupAckCount_ = 0;
+    fastDone_    = false;
+    dupAckReq_   = 0;
 
     locMaxBuffers_ = 32;  // MAX_NUM_OUTS_SEG_G in FW
     locMaxSegment_ = segSize;
@@ -99,19 +122,29 @@ rpr::Controller::Controller(uint32_t segSize, rpr::TransportPtr tran, rpr::Appli
     locConnId_ = 0x12345678;
     remConnId_ = 0;
 
-    convTime(tryPeriodD1_, locTryPeriod_);
-    convTime(tryPeriodD4_, locTryPeriod_ / 4);
-    convTime(retranToutD1_, curRetranTout_);
-    convTime(nullToutD3_, curNullTout_ / 3);
-    convTime(cumAckToutD1_, curCumAckTout_);
-    convTime(cumAckToutD2_, curCumAckTout_ / 2);
-
-    memset(&zeroTme_, 0, sizeof(struct timeval));
+    tryPeriodD1_  = convTime(locTryPeriod_);
+    retranToutD1_ = convTime(curRetranTout_);
+    nullToutD3_   = convTime(curNullTout_ / 3);
+    cumAckToutD1_ = convTime(curCumAckTout_);
+    rto_          = retranToutD1_;
 
     rogue::defaultTimeout(timeout_);
 
-    locBusyCnt_ = 0;
-    remBusyCnt_ = 0;
+    locBusyCnt_    = 0;
+    remBusyCnt_    = 0;
+    retranToutCnt_ = 0;
+    retranFastCnt_ = 0;
+
+    paceRate_    = 0;
+    paceBurst_   = 16384;
+    paceAuto_    = false;
+    paceActive_  = 0.0;
+    paceTokens_  = 0.0;
+    paceTime_    = Clock::now();
+    paceBackoff_ = paceTime_;
+    pacedCount_  = 0;
+
+    headerPool_ = rpr::HeaderPool::create();
 
     log_ = rogue::Logging::create("rssi.controller");
 
@@ -133,6 +166,11 @@ void rpr::Controller::stop() {
     if (thread_ != NULL) {
         rogue::GilRelease noGil;
         threadEn_ = false;
+        notify();
+        {
+            std::lock_guard<std::mutex> lock(paceMtx_);
+            paceCond_.notify_all();
+        }
         thread_->join();
         delete thread_;
         thread_ = NULL;
@@ -182,8 +220,10 @@ ris::FramePtr rpr::Controller::reqFrame(uint32_t size) {
     buffer->adjustHeader(rpr::Header::HeaderSize);
 
     // Recreate frame to ensure outbound only has a single buffer
-    frame = ris::Frame::create();
-    frame->appendBuffer(buffer);
+    if (frame->bufferCount() != 1) {
+        frame = ris::Frame::create();
+        frame->appendBuffer(buffer);
+    }
 
     // Return frame
     return (frame);
@@ -191,9 +231,10 @@ ris::FramePtr rpr::Controller::reqFrame(uint32_t size) {
 
 //! Frame received at transport interface
 void rpr::Controller::transportRx(ris::FramePtr frame) {
-    std::map<uint8_t, rpr::HeaderPtr>::iterator it;
+    rpr::HeaderPtr ooo;
+    uint32_t acked;
 
-    rpr::HeaderPtr head = rpr::Header::create(frame);
+    rpr::HeaderPtr head = rpr::Header::create(headerPool_, frame);
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr flock = frame->lock();
@@ -222,15 +263,45 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
     if (head->ack && (head->acknowledge != lastAckRx_)) {
         std::unique_lock<std::mutex> lock(txMtx_);
 
+        // Karn's rule, only segments sent once give a valid round trip sample
+        if (adaptive_ && txList_[head->acknowledge] != NULL && txList_[head->acknowledge]->count() == 1)
+            rttSample(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                                            txSent_[head->acknowledge]));
+
+        acked = 0;
         do {
             txList_[++lastAckRx_].reset();
+            wheel_.cancel(&retranTimer_[lastAckRx_]);
+            retranDue_[lastAckRx_] = RetranNone;
             if (txListCount_ != 0) txListCount_--;
+            acked++;
         } while (lastAckRx_ != head->acknowledge);
+
+        paceAdjust(false, acked);
+
+        dupAckCount_ = 0;
+        fastDone_    = false;
+        txCond_.notify_all();
+
+        // Duplicate ack only segment while data is outstanding, the oldest segment is likely lost
+    } else if (head->ack && adaptive_ && !(head->syn || head->rst || head->nul || head->busy) &&
+               frame->getPayload() == rpr::Header::HeaderSize) {
+        std::unique_lock<std::mutex> lock(txMtx_);
+        uint8_t idx = lastAckRx_ + 1;
+
+        if (txListCount_ != 0 && ++dupAckCount_ >= DupAckThold && !fastDone_ && txList_[idx] != NULL) {
+            retranDue_[idx] = RetranFast;
+            fastDone_       = true;
+            notify();
+        }
     }
 
     // Check for busy state transition
     if (!remBusy_ && head->busy) remBusyCnt_++;
 
+    // Retransmissions held while the remote was busy may now proceed
+    if (remBusy_ && !head->busy) notify();
+
     // Update busy bit
     remBusy_ = head->busy;
 
@@ -238,6 +309,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
     if (head->rst) {
         if (state_ == StOpen || state_ == StWaitSyn) {
             stQueue_.push(head);
+            notify();
         }
 
         // Syn frame goes to state machine if state = open
@@ -247,6 +319,7 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
             lastSeqRx_ = head->sequence;
             nextSeqRx_ = lastSeqRx_ + 1;
             stQueue_.push(head);
+            notify();
         }
 
         // Data or NULL in the correct sequence go to application
@@ -259,39 +332,39 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
             nextSeqRx_ = nextSeqRx_ + 1;
             appQueue_.push(head);
 
-            // There are elements in ooo (out-of-order) queue
-            if (!oooQueue_.empty()) {
-                // First remove received sequence number from queue to avoid duplicates
-                if ((it = oooQueue_.find(head->sequence)) != oooQueue_.end()) {
+            // There are elements in ooo (out-of-order) buffer
+            if (oooCount_ != 0) {
+                // First remove received sequence number from buffer to avoid duplicates
+                if (oooValid(head->sequence)) {
                     log_->warning("Removed duplicate frame. server=%d, head->sequence=%" PRIu8
                                   ", next sequence=%" PRIu8,
                                   server_,
                                   head->sequence,
                                   nextSeqRx_);
                     dropCount_++;
-                    oooQueue_.erase(it);
+                    oooTake(head->sequence);
                 }
 
-                // Get next entries from ooo (out-of-order) queue if they exist
+                // Get next entries from ooo (out-of-order) buffer if they exist
                 // This works because max outstanding will never be the full range of ids
                 // otherwise this could be stale data from previous ids
-                while ((it = oooQueue_.find(nextSeqRx_)) != oooQueue_.end()) {
+                while (oooValid(nextSeqRx_)) {
+                    ooo        = oooTake(nextSeqRx_);
                     lastSeqRx_ = nextSeqRx_;
                     nextSeqRx_ = nextSeqRx_ + 1;
 
-                    appQueue_.push(it->second);
+                    appQueue_.push(ooo);
                     log_->info("Using frame from ooo queue. server=%d, head->sequence=%" PRIu8,
                                server_,
-                               (it->second)->sequence);
-                    oooQueue_.erase(it);
+                               ooo->sequence);
                 }
             }
 
-            // Notify after the last sequence update
-            stCond_.notify_all();
+            // Schedule the acknowledge after the last sequence update
+            ackCheck();
 
-            // Check if received frame is already in out of order queue
-        } else if ((it = oooQueue_.find(head->sequence)) != oooQueue_.end()) {
+            // Check if received frame is already in out of order buffer
+        } else if (oooValid(head->sequence)) {
             log_->warning("Dropped duplicate frame. server=%d, head->sequence=%" PRIu8
                           ", next sequence=%" PRIu8,
                           server_,
@@ -308,7 +381,13 @@ void rpr::Controller::transportRx(ris::FramePtr frame) {
 
             while (++x != windowEnd) {
                 if (head->sequence == x) {
-                    oooQueue_.insert(std::make_pair(head->sequence, head));
+                    oooInsert(head);
+
+                    // Gap in the sequence, tell an adaptive peer right away
+                    if (adaptive_) {
+                        dupAckReq_++;
+                        notify();
+                    }
                     log_->info("Adding frame to ooo queue. server=%d, head->sequence=%" PRIu8
                                ", nextSeqRx_=%" PRIu8 ", windowsEnd=%" PRIu8,
                                server_,
@@ -342,12 +421,12 @@ ris::FramePtr rpr::Controller::applicationTx() {
 
     do {
         if ((head = appQueue_.pop()) == NULL) return (frame);
-        stCond_.notify_all();
 
         frame                   = head->getFrame();
         ris::FrameLockPtr flock = frame->lock();
 
         ackSeqRx_ = head->sequence;
+        ackCheck();
 
         // Drop NULL frames
         if (head->nul) {
@@ -364,9 +443,7 @@ ris::FramePtr rpr::Controller::applicationTx() {
 //! Frame received at application interface
 void rpr::Controller::applicationRx(ris::FramePtr frame) {
     ris::FramePtr tranFrame;
-    struct timeval startTime;
-
-    gettimeofday(&startTime, NULL);
+    std::chrono::microseconds timeout;
 
     rogue::GilRelease noGil;
     ris::FrameLockPtr flock = frame->lock();
@@ -385,7 +462,7 @@ void rpr::Controller::applicationRx(ris::FramePtr frame) {
     (*(frame->beginBuffer()))->adjustHeader(-rpr::Header::HeaderSize);
 
     // Map to RSSI
-    rpr::HeaderPtr head = rpr::Header::create(frame);
+    rpr::HeaderPtr head = rpr::Header::create(headerPool_, frame);
     head->ack           = true;
     flock->unlock();
 
@@ -394,21 +471,25 @@ void rpr::Controller::applicationRx(ris::FramePtr frame) {
         return;
     }
 
-    // Wait while busy either by flow control or buffer starvation
-    while (txListCount_ >= curMaxBuffers_) {
-        usleep(10);
-        if (timePassed(startTime, timeout_)) {
-            gettimeofday(&startTime, NULL);
-            log_->critical("Controller::applicationRx: Timeout waiting for outbound queue after %" PRIu32 ".%" PRIu32
-                           " seconds! May be caused by outbound backpressure.",
-                           timeout_.tv_sec,
-                           timeout_.tv_usec);
+    // Wait while busy either by flow control or buffer starvation, woken as acks free entries
+    timeout = std::chrono::seconds(timeout_.tv_sec) + std::chrono::microseconds(timeout_.tv_usec);
+    {
+        std::unique_lock<std::mutex> lock(txMtx_);
+        while (txListCount_ >= curMaxBuffers_) {
+            if (txCond_.wait_for(lock, timeout) == std::cv_status::timeout && txListCount_ >= curMaxBuffers_) {
+                log_->critical("Controller::applicationRx: Timeout waiting for outbound queue after %" PRIu32
+                               ".%" PRIu32 " seconds! May be caused by outbound backpressure.",
+                               timeout_.tv_sec,
+                               timeout_.tv_usec);
+            }
         }
     }
 
+    // Hold to the pacing rate
+    paceWait(frame->getPayload());
+
     // Transmit
     transportTx(head, true, false);
-    stCond_.notify_all();
 }
 
 //! Get state
@@ -460,8 +541,7 @@ void rpr::Controller::setLocTryPeriod(uint32_t val) {
                                           "Invalid LocTryPeriod Value = %" PRIu32,
                                           val);
     locTryPeriod_ = val;
-    convTime(tryPeriodD1_, locTryPeriod_);
-    convTime(tryPeriodD4_, locTryPeriod_ / 4);
+    tryPeriodD1_  = convTime(locTryPeriod_);
 }
 
 uint32_t rpr::Controller::getLocTryPeriod() {
@@ -580,43 +660,153 @@ uint8_t rpr::Controller::curMaxCumAck() {
 }
 
 void rpr::Controller::resetCounters() {
-    dropCount_   = 0;
-    downCount_   = 0;
-    retranCount_ = 0;
-    locBusyCnt_  = 0;
-    remBusyCnt_  = 0;
+    dropCount_     = 0;
+    downCount_     = 0;
+    retranCount_   = 0;
+    locBusyCnt_    = 0;
+    remBusyCnt_    = 0;
+    retranToutCnt_ = 0;
+    retranFastCnt_ = 0;
+    pacedCount_    = 0;
+}
+
+//! Enable adaptive retransmission
+void rpr::Controller::setAdaptiveRetran(bool enable) {
+    adaptive_ = enable;
+}
+
+//! Adaptive retransmission state
+bool rpr::Controller::getAdaptiveRetran() {
+    return (adaptive_);
+}
+
+//! Smoothed round trip time in microseconds
+uint32_t rpr::Controller::getRttMean() {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    return (rttMean_.count());
+}
+
+//! Round trip variation in microseconds
+uint32_t rpr::Controller::getRttVar() {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    return (rttVar_.count());
+}
+
+//! Retransmit timeout for new segments in microseconds
+uint32_t rpr::Controller::getRetranTimeout() {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    return ((adaptive_ ? rto_ : retranToutD1_).count());
+}
+
+//! Timeout retransmit count
+uint32_t rpr::Controller::getRetranToutCount() {
+    return (retranToutCnt_);
+}
+
+//! Fast retransmit count
+uint32_t rpr::Controller::getRetranFastCount() {
+    return (retranFastCnt_);
+}
+
+//! Set transmit pacing rate in bytes per second
+void rpr::Controller::setTxPacingRate(uint64_t rate) {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+
+    paceRefill(Clock::now());
+    paceRate_   = rate;
+    paceActive_ = rate;
+    paceTokens_ = paceBurst_;
+    paceCond_.notify_all();
+}
+
+uint64_t rpr::Controller::getTxPacingRate() {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    return (paceRate_);
+}
+
+//! Set transmit pacing burst in bytes
+void rpr::Controller::setTxPacingBurst(uint32_t burst) {
+    if (burst == 0)
+        throw rogue::GeneralError::create("Rssi::Controller::setTxPacingBurst",
+                                          "Invalid TxPacingBurst Value = %" PRIu32,
+                                          burst);
+
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    paceBurst_ = burst;
+    if (paceTokens_ > paceBurst_) paceTokens_ = paceBurst_;
+    paceCond_.notify_all();
+}
+
+uint32_t rpr::Controller::getTxPacingBurst() {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    return (paceBurst_);
+}
+
+//! Enable automatic pacing back off
+void rpr::Controller::setTxPacingAuto(bool enable) {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    paceAuto_   = enable;
+    paceActive_ = paceRate_;
+}
+
+bool rpr::Controller::getTxPacingAuto() {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    return (paceAuto_);
+}
+
+uint64_t rpr::Controller::getTxPacingActiveRate() {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    return (static_cast<uint64_t>(paceActive_));
+}
+
+uint32_t rpr::Controller::getTxPacedCount() {
+    return (pacedCount_);
 }
 
 // Method to transit a frame with proper updates
 void rpr::Controller::transportTx(rpr::HeaderPtr head, bool seqUpdate, bool txReset) {
     std::unique_lock<std::mutex> lock(txMtx_);
+    Clock::time_point now = Clock::now();
 
     head->sequence = locSequence_;
 
-    // Update sequence numbers
+    // Update sequence numbers, each tracked segment arms its own retransmit deadline
     if (seqUpdate) {
-        txList_[locSequence_] = head;
+        txList_[locSequence_]    = head;
+        txSent_[locSequence_]    = now;
+        retranDue_[locSequence_] = RetranNone;
+        armTimer(&retranTimer_[locSequence_], now + (adaptive_ ? rto_ : retranToutD1_));
         txListCount_++;
         locSequence_++;
     }
 
     // Reset tx list
     if (txReset) {
-        for (uint32_t x = 0; x < 256; x++) txList_[x].reset();
+        for (uint32_t x = 0; x < 256; x++) {
+            txList_[x].reset();
+            wheel_.cancel(&retranTimer_[x]);
+            retranDue_[x] = RetranNone;
+        }
         txListCount_ = 0;
+        txCond_.notify_all();
     }
 
     if (getLocBusy()) {
         head->acknowledge = lastAckTx_;
         head->busy        = true;
+
+        // Busy acknowledge is repeated every ack timeout
+        armTimer(&ackTimer_, now + cumAckToutD1_);
     } else {
         head->acknowledge = ackSeqRx_;
         lastAckTx_        = ackSeqRx_;
         head->busy        = false;
+        wheel_.cancel(&ackTimer_);
     }
 
-    // Track last tx time
-    gettimeofday(&txTime_, NULL);
+    // Track last tx time, any transmit defers the NULL keepalive
+    txTime_ = now;
+    armTimer(&nullTimer_, now + nullToutD3_);
 
     ris::FrameLockPtr flock = head->getFrame()->lock();
     head->update();
@@ -652,12 +842,21 @@ int8_t rpr::Controller::retransmit(uint8_t id) {
     if (head == NULL) return 0;
 
     // retransmit timer has not expired
-    if (!timePassed(head->getTime(), retranToutD1_)) return 0;
+    if (retranDue_[id] == RetranNone) return 0;
 
     // max retransmission count has been reached
     if (head->count() >= curMaxRetran_) return -1;
 
     retranCount_++;
+    if (retranDue_[id] == RetranFast)
+        retranFastCnt_++;
+    else
+        retranToutCnt_++;
+    retranDue_[id] = RetranNone;
+
+    // Retransmits are not delayed but count against the pacing budget
+    paceAdjust(true, 0);
+    paceCharge(head->getFrame()->getPayload());
 
     if (getLocBusy()) {
         head->acknowledge = lastAckTx_;
@@ -668,8 +867,10 @@ int8_t rpr::Controller::retransmit(uint8_t id) {
         head->busy        = false;
     }
 
-    // Track last tx time
-    gettimeofday(&txTime_, NULL);
+    // Track last tx time and arm the next retransmit deadline
+    txTime_ = Clock::now();
+    armTimer(&retranTimer_[id], txTime_ + retranToutD1_);
+    armTimer(&nullTimer_, txTime_ + nullToutD3_);
 
     log_->log(rogue::Logging::Warning,
               "Retran frame: state=%" PRIu32 " server=%d size=%" PRIu32 " syn=%d ack=%d"
@@ -696,70 +897,233 @@ int8_t rpr::Controller::retransmit(uint8_t id) {
     return 1;
 }
 
+//! Add pacing tokens for the elapsed time, caller holds paceMtx_
+void rpr::Controller::paceRefill(Clock::time_point now) {
+    paceTokens_ += paceActive_ * std::chrono::duration<double>(now - paceTime_).count();
+    if (paceTokens_ > paceBurst_) paceTokens_ = paceBurst_;
+    paceTime_ = now;
+}
+
+//! Wait for pacing tokens
+void rpr::Controller::paceWait(uint32_t bytes) {
+    std::unique_lock<std::mutex> lock(paceMtx_);
+    double need;
+
+    if (paceRate_ == 0) return;
+
+    // A segment larger than the bucket waits for a full bucket
+    need = (bytes < paceBurst_) ? bytes : paceBurst_;
+    paceRefill(Clock::now());
+
+    if (paceTokens_ < need) {
+        pacedCount_++;
+
+        while (threadEn_ && paceRate_ != 0 && paceTokens_ < need) {
+            paceCond_.wait_until(
+                lock,
+                paceTime_ + std::chrono::duration_cast<Clock::duration>(
+                                std::chrono::duration<double>((need - paceTokens_) / paceActive_)));
+            paceRefill(Clock::now());
+        }
+    }
+    paceTokens_ -= bytes;
+}
+
+//! Take pacing tokens without waiting
+void rpr::Controller::paceCharge(uint32_t bytes) {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+
+    if (paceRate_ == 0) return;
+    paceRefill(Clock::now());
+    paceTokens_ -= bytes;
+}
+
+//! Automatic pacing back off and recovery
+void rpr::Controller::paceAdjust(bool backoff, uint32_t acked) {
+    std::lock_guard<std::mutex> lock(paceMtx_);
+    Clock::time_point now;
+    double floor;
+
+    if (paceRate_ == 0 || !paceAuto_) return;
+
+    floor = static_cast<double>(paceRate_) / 64.0;
+
+    if (backoff) {
+        // One halving per retransmit burst
+        now = Clock::now();
+        if (now < paceBackoff_ + retranToutD1_) return;
+        paceBackoff_ = now;
+
+        paceRefill(now);
+        paceActive_ /= 2.0;
+        if (paceActive_ < floor) paceActive_ = floor;
+    } else {
+        paceRefill(Clock::now());
+        paceActive_ += floor * acked / 4.0;
+        if (paceActive_ > paceRate_) paceActive_ = paceRate_;
+    }
+}
+
+//! Fold a round trip sample into the estimates, caller holds txMtx_
+void rpr::Controller::rttSample(std::chrono::microseconds rtt) {
+    std::chrono::microseconds err;
+    std::chrono::microseconds low;
+
+    // Jacobson smoothing with gains of 1/8 for the mean and 1/4 for the variation
+    if (!rttValid_) {
+        rttMean_  = rtt;
+        rttVar_   = rtt / 2;
+        rttValid_ = true;
+    } else {
+        err      = (rtt > rttMean_) ? (rtt - rttMean_) : (rttMean_ - rtt);
+        rttVar_  = (rttVar_ * 3 + err) / 4;
+        rttMean_ = (rttMean_ * 7 + rtt) / 8;
+    }
+
+    // Never below the peer's ack delay, never above the negotiated timeout
+    low  = (cumAckToutD1_ < retranToutD1_) ? cumAckToutD1_ : retranToutD1_;
+    rto_ = rttMean_ + rttVar_ * 4;
+    if (rto_ < low) rto_ = low;
+    if (rto_ > retranToutD1_) rto_ = retranToutD1_;
+}
+
+//! Out of order buffer occupancy
+bool rpr::Controller::oooValid(uint8_t seq) {
+    return ((oooMask_[seq >> 6] >> (seq & 0x3F)) & 0x1);
+}
+
+//! Store a segment in the out of order buffer
+void rpr::Controller::oooInsert(rpr::HeaderPtr head) {
+    uint8_t seq = head->sequence;
+
+    oooQueue_[seq] = head;
+    oooMask_[seq >> 6] |= (static_cast<uint64_t>(1) << (seq & 0x3F));
+    oooCount_++;
+}
+
+//! Remove a segment from the out of order buffer
+rpr::HeaderPtr rpr::Controller::oooTake(uint8_t seq) {
+    rpr::HeaderPtr head;
+
+    head.swap(oooQueue_[seq]);
+    oooMask_[seq >> 6] &= ~(static_cast<uint64_t>(1) << (seq & 0x3F));
+    oooCount_--;
+    return (head);
+}
+
+//! Empty the out of order buffer
+void rpr::Controller::oooReset() {
+    uint32_t x;
+
+    if (oooCount_ == 0) return;
+
+    for (x = 0; x < 256; x++) {
+        if (oooValid(x)) oooTake(x);
+    }
+}
+
 //! Convert rssi time to microseconds
-void rpr::Controller::convTime(struct timeval& tme, uint32_t rssiTime) {
+std::chrono::microseconds rpr::Controller::convTime(uint32_t rssiTime) {
     float units = std::pow(10, -TimeoutUnit);
     float value = units * static_cast<float>(rssiTime);
 
-    uint32_t usec = static_cast<uint32_t>(value / 1e-6);
+    return (std::chrono::microseconds(static_cast<uint32_t>(value / 1e-6)));
+}
+
+//! Arm a timer, caller holds txMtx_
+void rpr::Controller::armTimer(rogue::TimerWheel::Timer* timer, Clock::time_point deadline) {
+    wheel_.arm(timer, deadline);
 
-    div_t divResult = div(usec, 1000000);
-    tme.tv_sec      = divResult.quot;
-    tme.tv_usec     = divResult.rem;
+    // Thread is sleeping past the new deadline
+    if (deadline < wakeTime_) notify();
 }
 
-//! Helper function to determine if time has elapsed
-bool rpr::Controller::timePassed(struct timeval& lastTime, struct timeval& tme) {
-    struct timeval endTime;
-    struct timeval currTime;
+//! Wake the background thread
+void rpr::Controller::notify() {
+    std::lock_guard<std::mutex> lock(stMtx_);
+    stEvent_ = true;
+    stCond_.notify_all();
+}
+
+//! Request an immediate acknowledge or schedule a cumulative one
+void rpr::Controller::ackCheck() {
+    std::lock_guard<std::mutex> lock(txMtx_);
+    uint8_t ackPend;
+    bool busy;
+
+    if (state_ != StOpen) return;
+
+    ackPend = ackSeqRx_ - lastAckTx_;
+    busy    = getLocBusy();
 
-    gettimeofday(&currTime, NULL);
-    timeradd(&lastTime, &tme, &endTime);
-    return (timercmp(&currTime, &endTime, >=));
+    if ((!busy) && ackPend >= curMaxCumAck_)
+        notify();
+    else if ((ackPend > 0 || busy) && !ackTimer_.armed())
+        armTimer(&ackTimer_, txTime_ + cumAckToutD1_);
 }
 
 //! Background thread
 void rpr::Controller::runThread() {
-    struct timeval wait;
+    Clock::time_point next;
+    std::vector<rogue::TimerWheel::Timer*>::iterator it;
+    bool again;
 
     log_->logThreadId();
 
-    wait = zeroTme_;
-
     while (threadEn_) {
-        // Lock context
-        if (wait.tv_sec != 0 || wait.tv_usec != 0) {
-            // Wait on condition or timeout
-            std::unique_lock<std::mutex> lock(stMtx_);
-
-            // Adjustable wait
-            stCond_.wait_for(lock, std::chrono::microseconds(wait.tv_usec) + std::chrono::seconds(wait.tv_sec));
+        // Collect expired timers, retransmit deadlines are flagged per segment
+        {
+            std::lock_guard<std::mutex> lock(txMtx_);
+            wakeTime_ = Clock::time_point::min();
+
+            expired_.clear();
+            wheel_.advance(Clock::now(), expired_);
+            for (it = expired_.begin(); it != expired_.end(); ++it) {
+                if (*it >= retranTimer_ && *it < retranTimer_ + 256) retranDue_[*it - retranTimer_] = RetranTimer;
+            }
         }
 
         switch (state_) {
             case StClosed:
             case StWaitSyn:
-                wait = stateClosedWait();
+                again = stateClosedWait();
                 break;
 
             case StSendSynAck:
-                wait = stateSendSynAck();
+                again = stateSendSynAck();
                 break;
 
             case StSendSeqAck:
-                wait = stateSendSeqAck();
+                again = stateSendSeqAck();
                 break;
 
             case StOpen:
-                wait = stateOpen();
+                again = stateOpen();
                 break;
 
             case StError:
-                wait = stateError();
+                again = stateError();
                 break;
             default:
+                again = false;
                 break;
         }
+
+        if (again) continue;
+
+        // Sleep until the next deadline, arming an earlier one wakes the thread
+        {
+            std::lock_guard<std::mutex> lock(txMtx_);
+            next      = wheel_.nextDeadline();
+            wakeTime_ = next;
+        }
+
+        std::unique_lock<std::mutex> lock(stMtx_);
+        if (next == Clock::time_point::max())
+            stCond_.wait(lock, [&] { return stEvent_ || !threadEn_; });
+        else
+            stCond_.wait_until(lock, next, [&] { return stEvent_ || !threadEn_; });
+        stEvent_ = false;
     }
 
     // Send reset on exit
@@ -767,7 +1131,7 @@ void rpr::Controller::runThread() {
 }
 
 //! Closed/Waiting for Syn
-struct timeval& rpr::Controller::stateClosedWait() {
+bool rpr::Controller::stateClosedWait() {
     rpr::HeaderPtr head;
 
     // got syn or reset
@@ -791,18 +1155,28 @@ struct timeval& rpr::Controller::stateClosedWait() {
             lastAckRx_     = head->acknowledge;
 
             // Convert times
-            convTime(retranToutD1_, curRetranTout_);
-            convTime(cumAckToutD1_, curCumAckTout_);
-            convTime(cumAckToutD2_, curCumAckTout_ / 2);
-            convTime(nullToutD3_, curNullTout_ / 3);
+            retranToutD1_ = convTime(curRetranTout_);
+            cumAckToutD1_ = convTime(curCumAckTout_);
+            nullToutD3_   = convTime(curNullTout_ / 3);
+
+            // Round trip estimates start over for the new connection
+            {
+                std::lock_guard<std::mutex> lock(txMtx_);
+                rttValid_    = false;
+                rttMean_     = std::chrono::microseconds(0);
+                rttVar_      = std::chrono::microseconds(0);
+                rto_         = retranToutD1_;
+                dupAckCount_ = 0;
+                fastDone_    = false;
+            }
 
             if (server_) {
                 state_ = StSendSynAck;
-                return (zeroTme_);
             } else {
                 state_ = StSendSeqAck;
             }
-            gettimeofday(&stTime_, NULL);
+            stTime_ = Clock::now();
+            return (true);
 
             // reset counters
         } else {
@@ -816,9 +1190,9 @@ struct timeval& rpr::Controller::stateClosedWait() {
         }
 
         // Generate syn after try period passes
-    } else if ((!server_) && timePassed(stTime_, tryPeriodD1_)) {
+    } else if ((!server_) && Clock::now() >= stTime_ + tryPeriodD1_) {
         // Allocate frame
-        head = rpr::Header::create(tran_->reqFrame(rpr::Header::SynSize, false));
+        head = rpr::Header::create(headerPool_, tran_->reqFrame(rpr::Header::SynSize, false));
 
         // Set frame
         head->syn                    = true;
@@ -834,22 +1208,28 @@ struct timeval& rpr::Controller::stateClosedWait() {
         head->timeoutUnit            = TimeoutUnit;
         head->connectionId           = locConnId_;
 
-        transportTx(head, true, false);
+        // Update state before the syn leaves, a fast peer may answer before transportTx() returns
+        stTime_ = Clock::now();
+        state_  = StWaitSyn;
 
-        // Update state
-        gettimeofday(&stTime_, NULL);
-        state_ = StWaitSyn;
+        transportTx(head, true, false);
     } else if (server_) {
         state_ = StWaitSyn;
     }
 
-    return (tryPeriodD4_);
+    // Next syn attempt
+    if (!server_) {
+        std::lock_guard<std::mutex> lock(txMtx_);
+        armTimer(&stTimer_, stTime_ + tryPeriodD1_);
+    }
+
+    return (!stQueue_.empty());
 }
 
 //! Send Syn ack
-struct timeval& rpr::Controller::stateSendSynAck() {
+bool rpr::Controller::stateSendSynAck() {
     // Allocate frame
-    rpr::HeaderPtr head = rpr::Header::create(tran_->reqFrame(rpr::Header::SynSize, false));
+    rpr::HeaderPtr head = rpr::Header::create(headerPool_, tran_->reqFrame(rpr::Header::SynSize, false));
 
     // Set frame
     head->syn                    = true;
@@ -866,39 +1246,41 @@ struct timeval& rpr::Controller::stateSendSynAck() {
     head->timeoutUnit            = TimeoutUnit;
     head->connectionId           = locConnId_;
 
-    transportTx(head, true, true);
-
-    // Update state
+    // Update state before the syn ack leaves so the first data from the peer is accepted
     log_->info("Link state is open. Server=%d", server_);
     state_ = StOpen;
-    return (cumAckToutD2_);
+
+    transportTx(head, true, true);
+    return (false);
 }
 
 //! Send sequence ack
-struct timeval& rpr::Controller::stateSendSeqAck() {
+bool rpr::Controller::stateSendSeqAck() {
     // Allocate frame
-    rpr::HeaderPtr ack = rpr::Header::create(tran_->reqFrame(rpr::Header::HeaderSize, false));
+    rpr::HeaderPtr ack = rpr::Header::create(headerPool_, tran_->reqFrame(rpr::Header::HeaderSize, false));
 
     // Setup frame
     ack->ack  = true;
     ack->nul  = false;
     ackSeqRx_ = lastSeqRx_;
 
-    transportTx(ack, false, true);
-
     // Update state
     state_ = StOpen;
     log_->info("Link state is open. Server=%d", server_);
-    return (cumAckToutD2_);
+
+    transportTx(ack, false, true);
+    return (false);
 }
 
 //! Idle with open state
-struct timeval& rpr::Controller::stateOpen() {
+bool rpr::Controller::stateOpen() {
     rpr::HeaderPtr head;
     uint8_t idx;
     bool doNull;
     uint8_t ackPend;
-    struct timeval locTime;
+    Clock::time_point locTime;
+    Clock::time_point now;
+    uint32_t dupAcks;
 
     // Pending frame may be reset
     while (!stQueue_.empty()) {
@@ -906,9 +1288,9 @@ struct timeval& rpr::Controller::stateOpen() {
 
         // Reset or syn without ack is an error
         if ((head->rst) || (head->syn && (!head->ack))) {
-            state_ = StError;
-            gettimeofday(&stTime_, NULL);
-            return (zeroTme_);
+            state_  = StError;
+            stTime_ = Clock::now();
+            return (true);
         }
     }
 
@@ -919,41 +1301,58 @@ struct timeval& rpr::Controller::stateOpen() {
         ackPend = ackSeqRx_ - lastAckTx_;
     }
 
+    now = Clock::now();
+
     // NULL required
-    if (timePassed(locTime, nullToutD3_))
-        doNull = true;
-    else
-        doNull = false;
+    doNull = (now >= locTime + nullToutD3_);
 
     // Outbound frame required
     if ((doNull || ((!getLocBusy()) && ackPend >= curMaxCumAck_) ||
-         ((ackPend > 0 || getLocBusy()) && timePassed(locTime, cumAckToutD1_)))) {
-        head      = rpr::Header::create(tran_->reqFrame(rpr::Header::HeaderSize, false));
+         ((ackPend > 0 || getLocBusy()) && now >= locTime + cumAckToutD1_))) {
+        head      = rpr::Header::create(headerPool_, tran_->reqFrame(rpr::Header::HeaderSize, false));
         head->ack = true;
         head->nul = doNull;
         transportTx(head, doNull, false);
     }
 
+    // Duplicate acks for out of order arrivals, an adaptive peer fast retransmits on these
+    dupAcks = dupAckReq_.exchange(0);
+    if (dupAcks > DupAckThold) dupAcks = DupAckThold;
+    while (dupAcks-- > 0) {
+        head      = rpr::Header::create(headerPool_, tran_->reqFrame(rpr::Header::HeaderSize, false));
+        head->ack = true;
+        transportTx(head, false, false);
+    }
+
     // Retransmission processing, don't process when busy
     idx = lastAckRx_;
     while ((!remBusy_) && (idx != locSequence_)) {
         if (retransmit(idx++) < 0) {
-            state_ = StError;
-            gettimeofday(&stTime_, NULL);
-            return (zeroTme_);
+            state_  = StError;
+            stTime_ = Clock::now();
+            return (true);
         }
     }
 
-    return (cumAckToutD2_);
+    // Keep the keepalive and pending acknowledge deadlines armed
+    {
+        std::lock_guard<std::mutex> lock(txMtx_);
+        if (!nullTimer_.armed()) armTimer(&nullTimer_, txTime_ + nullToutD3_);
+
+        ackPend = ackSeqRx_ - lastAckTx_;
+        if ((ackPend > 0 || getLocBusy()) && !ackTimer_.armed()) armTimer(&ackTimer_, txTime_ + cumAckToutD1_);
+    }
+
+    return (false);
 }
 
 //! Error
-struct timeval& rpr::Controller::stateError() {
+bool rpr::Controller::stateError() {
     rpr::HeaderPtr rst;
 
     log_->warning("Entering reset state. Server=%d", server_);
 
-    rst      = rpr::Header::create(tran_->reqFrame(rpr::Header::HeaderSize, false));
+    rst      = rpr::Header::create(headerPool_, tran_->reqFrame(rpr::Header::HeaderSize, false));
     rst->rst = true;
 
     transportTx(rst, true, true);
@@ -964,11 +1363,18 @@ struct timeval& rpr::Controller::stateError() {
 
     // Reset queues
     appQueue_.reset();
-    oooQueue_.clear();
+    oooReset();
     stQueue_.reset();
 
-    gettimeofday(&stTime_, NULL);
-    return (tryPeriodD1_);
+    // Hold off the next connection attempt for a try period
+    stTime_ = Clock::now();
+    {
+        std::lock_guard<std::mutex> lock(txMtx_);
+        wheel_.cancel(&nullTimer_);
+        wheel_.cancel(&ackTimer_);
+        armTimer(&stTimer_, stTime_ + tryPeriodD1_);
+    }
+    return (false);
 }
 
 //! Set timeout for frame transmits in microseconds
@@ -21,12 +21,16 @@
 #include <stdint.h>
 #include <sys/time.h>
 
+#include <atomic>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -35,6 +39,83 @@
 namespace rpr = rogue::protocols::rssi;
 namespace ris = rogue::interfaces::stream;
 
+namespace {
+
+// Blocks taken from the heap by all pools
+std::atomic<uint64_t> heapAllocs(0);
+
+template <typename T>
+struct HeaderAllocator {
+    typedef T value_type;
+
+    rpr::HeaderPoolPtr pool;
+
+    explicit HeaderAllocator(rpr::HeaderPoolPtr p) : pool(p) {}
+
+    template <typename U>
+    HeaderAllocator(const HeaderAllocator<U>& other) : pool(other.pool) {}
+
+    T* allocate(std::size_t n) {
+        return (static_cast<T*>(pool->get(n * sizeof(T))));
+    }
+
+    void deallocate(T* ptr, std::size_t n) {
+        pool->put(ptr, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const HeaderAllocator<T>& a, const HeaderAllocator<U>& b) {
+    return (a.pool == b.pool);
+}
+
+template <typename T, typename U>
+bool operator!=(const HeaderAllocator<T>& a, const HeaderAllocator<U>& b) {
+    return (a.pool != b.pool);
+}
+
+}  // namespace
+
+//! Create a pool
+rpr::HeaderPoolPtr rpr::HeaderPool::create() {
+    rpr::HeaderPoolPtr r = std::make_shared<rpr::HeaderPool>();
+    return (r);
+}
+
+//! Creator
+rpr::HeaderPool::HeaderPool() : size_(0) {
+    free_.reserve(256);
+}
+
+//! Destructor
+rpr::HeaderPool::~HeaderPool() {
+    for (void* ptr : free_) ::operator delete(ptr);
+}
+
+//! Take a block
+void* rpr::HeaderPool::get(std::size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (size_ == 0) size_ = size;
+        if (size == size_ && !free_.empty()) {
+            void* ptr = free_.back();
+            free_.pop_back();
+            return (ptr);
+        }
+    }
+    heapAllocs++;
+    return (::operator new(size));
+}
+
+//! Return a block
+void rpr::HeaderPool::put(void* ptr, std::size_t size) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (size == size_)
+        free_.push_back(ptr);
+    else
+        ::operator delete(ptr);
+}
+
 //! Set 16-bit uint value
 void rpr::Header::setUInt16(uint8_t* data, uint8_t byte, uint16_t value) {
     *reinterpret_cast<uint16_t*>(&data[byte]) = htons(value);
@@ -74,11 +155,25 @@ rpr::HeaderPtr rpr::Header::create(ris::FramePtr frame) {
     return (r);
 }
 
+//! Create in a pooled block
+rpr::HeaderPtr rpr::Header::create(rpr::HeaderPoolPtr pool, ris::FramePtr frame) {
+    rpr::HeaderPtr r = std::allocate_shared<rpr::Header>(HeaderAllocator<rpr::Header>(pool), frame);
+    return (r);
+}
+
+//! Header blocks taken from the heap by all pools
+uint64_t rpr::Header::getHeapBlockCount() {
+    return (heapAllocs);
+}
+
 //! Creator
 rpr::Header::Header(ris::FramePtr frame) {
     frame_ = frame;
     count_ = 0;
 
+    time_.tv_sec  = 0;
+    time_.tv_usec = 0;
+
     syn  = false;
     ack  = false;
     rst  = false;
@@ -150,7 +245,7 @@ bool rpr::Header::verify() {
     return (true);
 }
 
-//! Update checksum, set tx time and increment tx count
+//! Update checksum and increment tx count
 void rpr::Header::update() {
     uint8_t size;
 
@@ -200,7 +295,6 @@ void rpr::Header::update() {
     }
 
     setUInt16(data, size - 2, compSum(data, size));
-    gettimeofday(&time_, NULL);
     count_++;
 }
 
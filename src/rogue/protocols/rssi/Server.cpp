@@ -78,6 +78,21 @@ void rpr::Server::setup_python() {
         .def("curMaxRetran", &rpr::Server::curMaxRetran)
         .def("curMaxCumAck", &rpr::Server::curMaxCumAck)
         .def("resetCounters", &rpr::Server::resetCounters)
+        .def("setAdaptiveRetran", &rpr::Server::setAdaptiveRetran)
+        .def("getAdaptiveRetran", &rpr::Server::getAdaptiveRetran)
+        .def("getRttMean", &rpr::Server::getRttMean)
+        .def("getRttVar", &rpr::Server::getRttVar)
+        .def("getRetranTimeout", &rpr::Server::getRetranTimeout)
+        .def("getRetranToutCount", &rpr::Server::getRetranToutCount)
+        .def("getRetranFastCount", &rpr::Server::getRetranFastCount)
+        .def("setTxPacingRate", &rpr::Server::setTxPacingRate)
+        .def("getTxPacingRate", &rpr::Server::getTxPacingRate)
+        .def("setTxPacingBurst", &rpr::Server::setTxPacingBurst)
+        .def("getTxPacingBurst", &rpr::Server::getTxPacingBurst)
+        .def("setTxPacingAuto", &rpr::Server::setTxPacingAuto)
+        .def("getTxPacingAuto", &rpr::Server::getTxPacingAuto)
+        .def("getTxPacingActiveRate", &rpr::Server::getTxPacingActiveRate)
+        .def("getTxPacedCount", &rpr::Server::getTxPacedCount)
         .def("setTimeout", &rpr::Server::setTimeout)
         .def("_stop", &rpr::Server::stop)
         .def("_start", &rpr::Server::start);
@@ -245,6 +260,67 @@ void rpr::Server::resetCounters() {
     cntl_->resetCounters();
 }
 
+//! Enable adaptive retransmission
+void rpr::Server::setAdaptiveRetran(bool enable) {
+    cntl_->setAdaptiveRetran(enable);
+}
+
+bool rpr::Server::getAdaptiveRetran() {
+    return cntl_->getAdaptiveRetran();
+}
+
+uint32_t rpr::Server::getRttMean() {
+    return cntl_->getRttMean();
+}
+
+uint32_t rpr::Server::getRttVar() {
+    return cntl_->getRttVar();
+}
+
+uint32_t rpr::Server::getRetranTimeout() {
+    return cntl_->getRetranTimeout();
+}
+
+uint32_t rpr::Server::getRetranToutCount() {
+    return cntl_->getRetranToutCount();
+}
+
+uint32_t rpr::Server::getRetranFastCount() {
+    return cntl_->getRetranFastCount();
+}
+
+void rpr::Server::setTxPacingRate(uint64_t rate) {
+    cntl_->setTxPacingRate(rate);
+}
+
+uint64_t rpr::Server::getTxPacingRate() {
+    return cntl_->getTxPacingRate();
+}
+
+void rpr::Server::setTxPacingBurst(uint32_t burst) {
+    cntl_->setTxPacingBurst(burst);
+}
+
+uint32_t rpr::Server::getTxPacingBurst() {
+    return cntl_->getTxPacingBurst();
+}
+
+void rpr::Server::setTxPacingAuto(bool enable) {
+    cntl_->setTxPacingAuto(enable);
+}
+
+bool rpr::Server::getTxPacingAuto() {
+    return cntl_->getTxPacingAuto();
+}
+
+uint64_t rpr::Server::getTxPacingActiveRate() {
+    return cntl_->getTxPacingActiveRate();
+}
+
+uint32_t rpr::Server::getTxPacedCount() {
+    return cntl_->getTxPacedCount();
+}
+
 //! Set timeout for frame transmits in microseconds
 void rpr::Server::setTimeout(uint32_t timeout) {
     cntl_->setTimeout(timeout);
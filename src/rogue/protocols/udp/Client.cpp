@@ -27,6 +27,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -150,6 +151,7 @@ void rpu::Client::acceptFrame(ris::FramePtr frame) {
     fd_set fds;
     struct timeval tout;
     uint32_t x;
+    uint32_t batch;
     struct msghdr msg;
     struct iovec msg_iov[1];
 
@@ -175,6 +177,29 @@ void rpu::Client::acceptFrame(ris::FramePtr frame) {
         return;
     }
 
+#ifndef __MACH__
+    // Batched path, one sendmmsg() per group of buffers
+    if ((batch = batchSize_) > 1) {
+        x = 0;
+        for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
+            if ((*it)->getPayload() == 0) break;
+
+            txIov_[x].iov_base        = (*it)->begin();
+            txIov_[x].iov_len         = (*it)->getPayload();
+            txMsg_[x].msg_hdr         = msg;
+            txMsg_[x].msg_hdr.msg_iov = &txIov_[x];
+            txMsg_[x].msg_len         = 0;
+
+            if (++x == batch) {
+                sendBatch(x, "Client");
+                x = 0;
+            }
+        }
+        if (x > 0) sendBatch(x, "Client");
+        return;
+    }
+#endif
+
     // Go through each buffer in the frame
     for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
         if ((*it)->getPayload() == 0) break;
@@ -220,10 +245,69 @@ void rpu::Client::runThread(std::weak_ptr<int> lockPtr) {
 
     udpLog_->logThreadId();
 
+#ifndef __MACH__
+    std::vector<ris::FramePtr> rxFrames(MaxBatchSize);
+    std::vector<struct mmsghdr> rxMsg(MaxBatchSize);
+    std::vector<struct iovec> rxIov(MaxBatchSize);
+    uint32_t batch;
+    uint32_t x;
+#endif
+
     // Preallocate frame
     frame = reqLocalFrame(maxPayload(), false);
 
     while (threadEn_) {
+#ifndef __MACH__
+        // Batched receive, one recvmmsg() returns every queued datagram up to the batch size
+        if ((batch = batchSize_) > 1) {
+            for (x = 0; x < batch; x++) {
+                if (!rxFrames[x]) rxFrames[x] = reqLocalFrame(maxPayload(), false);
+                buff = *(rxFrames[x]->beginBuffer());
+
+                rxIov[x].iov_base = buff->begin();
+                rxIov[x].iov_len  = buff->getAvailable();
+                memset(&rxMsg[x], 0, sizeof(struct mmsghdr));
+                rxMsg[x].msg_hdr.msg_iov    = &rxIov[x];
+                rxMsg[x].msg_hdr.msg_iovlen = 1;
+            }
+
+            res = recvmmsg(fd_, rxMsg.data(), batch, MSG_WAITFORONE | MSG_TRUNC, NULL);
+
+            if (res > 0) {
+                for (x = 0; x < static_cast<uint32_t>(res); x++) {
+                    // Message was too big, the frame is reused for the next batch
+                    if (rxMsg[x].msg_len > rxIov[x].iov_len) {
+                        udpLog_->warning("Receive data was too large. remote=%s:%" PRIu16 ", rx=%" PRIu32
+                                         ", avail=%" PRIu32 ". Dropping.",
+                                         address_.c_str(),
+                                         port_,
+                                         rxMsg[x].msg_len,
+                                         static_cast<uint32_t>(rxIov[x].iov_len));
+                    } else {
+                        buff = *(rxFrames[x]->beginBuffer());
+                        buff->setPayload(rxMsg[x].msg_len);
+                        sendFrame(rxFrames[x]);
+                        rxFrames[x].reset();
+                    }
+                }
+            } else if (res < 0 && errno == ENOSYS) {
+                batchFailed("recvmmsg");
+            } else {
+                // Setup fds for select call
+                FD_ZERO(&fds);
+                FD_SET(fd_, &fds);
+
+                // Setup select timeout
+                tout.tv_sec  = 0;
+                tout.tv_usec = 100;
+
+                // Select returns with available buffer
+                select(fd_ + 1, &fds, NULL, NULL, &tout);
+            }
+            continue;
+        }
+#endif
+
         // Attempt receive
         buff  = *(frame->beginBuffer());
         avail = buff->getAvailable();
@@ -19,8 +19,12 @@
 #include "rogue/protocols/udp/Core.h"
 
 #include <inttypes.h>
+#include <sys/select.h>
 #include <unistd.h>
 
+#include <cerrno>
+#include <cstring>
+
 #include "rogue/GeneralError.h"
 #include "rogue/Helpers.h"
 #include "rogue/Logging.h"
@@ -75,11 +79,88 @@ void rpu::Core::setTimeout(uint32_t timeout) {
     timeout_.tv_usec = divResult.rem;
 }
 
+//! Set number of datagrams per batched socket call
+void rpu::Core::setBatchSize(uint32_t size) {
+#ifdef __MACH__
+    if (size > 1) udpLog_->warning("Batched UDP transfers are not supported on this platform. Using batch size 1.");
+    batchSize_ = 1;
+#else
+    if (size == 0) size = 1;
+    if (size > MaxBatchSize) size = MaxBatchSize;
+
+    std::lock_guard<std::mutex> lock(udpMtx_);
+    txIov_.resize(size);
+    txMsg_.resize(size);
+    batchSize_ = size;
+#endif
+}
+
+//! Get number of datagrams per batched socket call
+uint32_t rpu::Core::getBatchSize() {
+    return batchSize_;
+}
+
+//! Disable batching after a kernel rejection
+void rpu::Core::batchFailed(const char* call) {
+    udpLog_->warning("%s is not supported by this kernel. Falling back to single datagram transfers.", call);
+    batchSize_ = 1;
+}
+
+#ifndef __MACH__
+//! Transmit prepared messages, called with udpMtx_ held
+void rpu::Core::sendBatch(uint32_t count, const char* name) {
+    fd_set fds;
+    struct timeval tout;
+    uint32_t sent;
+    int32_t res;
+
+    sent = 0;
+    while (sent < count) {
+        // Setup fds for select call
+        FD_ZERO(&fds);
+        FD_SET(fd_, &fds);
+
+        // Setup select timeout
+        tout = timeout_;
+
+        if (select(fd_ + 1, NULL, &fds, NULL, &tout) <= 0) {
+            udpLog_->critical("%s::acceptFrame: Timeout waiting for outbound transmit after %" PRIu32 ".%" PRIu32
+                              " seconds! May be caused by outbound backpressure.",
+                              name,
+                              static_cast<uint32_t>(timeout_.tv_sec),
+                              static_cast<uint32_t>(timeout_.tv_usec));
+            continue;
+        }
+
+        // Batch was disabled mid transfer, finish with single datagram sends
+        if (batchSize_ > 1)
+            res = sendmmsg(fd_, &txMsg_[sent], count - sent, 0);
+        else
+            res = (sendmsg(fd_, &(txMsg_[sent].msg_hdr), 0) < 0) ? -1 : 1;
+
+        if (res < 0) {
+            if (errno == ENOSYS) {
+                batchFailed("sendmmsg");
+                continue;
+            }
+
+            // Drop the failed datagram, matching the single datagram path
+            udpLog_->warning("UDP batched write call failed for %s: %s", name, std::strerror(errno));
+            ++sent;
+        } else {
+            sent += res;
+        }
+    }
+}
+#endif
+
 void rpu::Core::setup_python() {
 #ifndef NO_PYTHON
     bp::class_<rpu::Core, rpu::CorePtr, boost::noncopyable>("Core", bp::no_init)
         .def("maxPayload", &rpu::Core::maxPayload)
         .def("setRxBufferCount", &rpu::Core::setRxBufferCount)
-        .def("setTimeout", &rpu::Core::setTimeout);
+        .def("setTimeout", &rpu::Core::setTimeout)
+        .def("setBatchSize", &rpu::Core::setBatchSize)
+        .def("getBatchSize", &rpu::Core::getBatchSize);
 #endif
 }
@@ -27,6 +27,7 @@
 #include <cstring>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include "rogue/GeneralError.h"
 #include "rogue/GilRelease.h"
@@ -150,6 +151,7 @@ void rpu::Server::acceptFrame(ris::FramePtr frame) {
     fd_set fds;
     struct timeval tout;
     uint32_t x;
+    uint32_t batch;
     struct msghdr msg;
     struct iovec msg_iov[1];
 
@@ -174,6 +176,29 @@ void rpu::Server::acceptFrame(ris::FramePtr frame) {
     msg.msg_controllen = 0;
     msg.msg_flags      = 0;
 
+#ifndef __MACH__
+    // Batched path, one sendmmsg() per group of buffers
+    if ((batch = batchSize_) > 1) {
+        x = 0;
+        for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
+            if ((*it)->getPayload() == 0) break;
+
+            txIov_[x].iov_base        = (*it)->begin();
+            txIov_[x].iov_len         = (*it)->getPayload();
+            txMsg_[x].msg_hdr         = msg;
+            txMsg_[x].msg_hdr.msg_iov = &txIov_[x];
+            txMsg_[x].msg_len         = 0;
+
+            if (++x == batch) {
+                sendBatch(x, "Server");
+                x = 0;
+            }
+        }
+        if (x > 0) sendBatch(x, "Server");
+        return;
+    }
+#endif
+
     // Go through each buffer in the frame
     for (it = frame->beginBuffer(); it != frame->endBuffer(); ++it) {
         if ((*it)->getPayload() == 0) break;
@@ -207,6 +232,24 @@ void rpu::Server::acceptFrame(ris::FramePtr frame) {
     }
 }
 
+//! Track the most recent remote address
+void rpu::Server::updatePeer(const struct sockaddr_in& addr) {
+    // Lock before updating address
+    if (memcmp(&remAddr_, &addr, sizeof(remAddr_)) != 0) {
+        std::lock_guard<std::mutex> lock(udpMtx_);
+        char tmpIp[INET_ADDRSTRLEN];
+        if (inet_ntop(AF_INET, &(addr.sin_addr), tmpIp, sizeof(tmpIp)) != NULL) {
+            udpLog_->debug("UDP server peer updated on local port %" PRIu16 " to %s:%" PRIu16,
+                           port_,
+                           tmpIp,
+                           ntohs(addr.sin_port));
+        } else {
+            udpLog_->debug("UDP server peer updated on local port %" PRIu16, port_);
+        }
+        remAddr_ = addr;
+    }
+}
+
 //! Run thread
 void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
     ris::BufferPtr buff;
@@ -223,10 +266,74 @@ void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
 
     udpLog_->logThreadId();
 
+#ifndef __MACH__
+    std::vector<ris::FramePtr> rxFrames(MaxBatchSize);
+    std::vector<struct mmsghdr> rxMsg(MaxBatchSize);
+    std::vector<struct iovec> rxIov(MaxBatchSize);
+    std::vector<struct sockaddr_in> rxAddr(MaxBatchSize);
+    uint32_t batch;
+    uint32_t x;
+#endif
+
     // Preallocate frame
     frame = reqLocalFrame(maxPayload(), false);
 
     while (threadEn_) {
+#ifndef __MACH__
+        // Batched receive, one recvmmsg() returns every queued datagram up to the batch size
+        if ((batch = batchSize_) > 1) {
+            for (x = 0; x < batch; x++) {
+                if (!rxFrames[x]) rxFrames[x] = reqLocalFrame(maxPayload(), false);
+                buff = *(rxFrames[x]->beginBuffer());
+
+                rxIov[x].iov_base = buff->begin();
+                rxIov[x].iov_len  = buff->getAvailable();
+                memset(&rxMsg[x], 0, sizeof(struct mmsghdr));
+                rxMsg[x].msg_hdr.msg_name    = &rxAddr[x];
+                rxMsg[x].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+                rxMsg[x].msg_hdr.msg_iov     = &rxIov[x];
+                rxMsg[x].msg_hdr.msg_iovlen  = 1;
+            }
+
+            res = recvmmsg(fd_, rxMsg.data(), batch, MSG_WAITFORONE | MSG_TRUNC, NULL);
+
+            if (res > 0) {
+                for (x = 0; x < static_cast<uint32_t>(res); x++) {
+                    // Message was too big, the frame is reused for the next batch
+                    if (rxMsg[x].msg_len > rxIov[x].iov_len) {
+                        udpLog_->warning("Receive data was too large on local port %" PRIu16 ". rx=%" PRIu32
+                                         ", avail=%" PRIu32 ". Dropping.",
+                                         port_,
+                                         rxMsg[x].msg_len,
+                                         static_cast<uint32_t>(rxIov[x].iov_len));
+                    } else {
+                        buff = *(rxFrames[x]->beginBuffer());
+                        buff->setPayload(rxMsg[x].msg_len);
+                        sendFrame(rxFrames[x]);
+                        rxFrames[x].reset();
+                    }
+                }
+
+                // The most recent sender becomes the transmit peer
+                updatePeer(rxAddr[res - 1]);
+            } else if (res < 0 && errno == ENOSYS) {
+                batchFailed("recvmmsg");
+            } else {
+                // Setup fds for select call
+                FD_ZERO(&fds);
+                FD_SET(fd_, &fds);
+
+                // Setup select timeout
+                tout.tv_sec  = 0;
+                tout.tv_usec = 100;
+
+                // Select returns with available buffer
+                select(fd_ + 1, &fds, NULL, NULL, &tout);
+            }
+            continue;
+        }
+#endif
+
         // Attempt receive
         buff   = *(frame->beginBuffer());
         avail  = buff->getAvailable();
@@ -249,20 +356,7 @@ void rpu::Server::runThread(std::weak_ptr<int> lockPtr) {
             // Get new frame
             frame = reqLocalFrame(maxPayload(), false);
 
-            // Lock before updating address
-            if (memcmp(&remAddr_, &tmpAddr, sizeof(remAddr_)) != 0) {
-                std::lock_guard<std::mutex> lock(udpMtx_);
-                char tmpIp[INET_ADDRSTRLEN];
-                if (inet_ntop(AF_INET, &(tmpAddr.sin_addr), tmpIp, sizeof(tmpIp)) != NULL) {
-                    udpLog_->debug("UDP server peer updated on local port %" PRIu16 " to %s:%" PRIu16,
-                                   port_,
-                                   tmpIp,
-                                   ntohs(tmpAddr.sin_port));
-                } else {
-                    udpLog_->debug("UDP server peer updated on local port %" PRIu16, port_);
-                }
-                remAddr_ = tmpAddr;
-            }
+            updatePeer(tmpAddr);
         } else {
             // Setup fds for select call
             FD_ZERO(&fds);
@@ -0,0 +1,298 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description :
+ *    Accelerated CRC-32 engine
+ *-----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ * https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ *-----------------------------------------------------------------------------
+ **/
+#include "rogue/Directives.h"
+
+#include "rogue/utilities/Crc32.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__x86_64__)
+    #include <immintrin.h>
+    #define ROGUE_CRC32_PCLMUL
+#elif defined(__aarch64__) && (defined(__linux__) || defined(__APPLE__))
+    #include <arm_acle.h>
+    #if defined(__linux__)
+        #include <sys/auxv.h>
+    #endif
+    #define ROGUE_CRC32_ARM
+#endif
+
+namespace ru = rogue::utilities;
+
+namespace {
+
+// Reflected CRC-32 polynomial
+const uint32_t Crc32Poly = 0xEDB88320;
+
+// Slice-by-16 lookup tables, table[0] is the classic byte table
+struct Crc32Tables {
+    uint32_t t[16][256];
+
+    Crc32Tables() {
+        uint32_t i;
+        uint32_t j;
+        uint32_t c;
+
+        for (i = 0; i < 256; i++) {
+            c = i;
+            for (j = 0; j < 8; j++) c = (c & 1) ? ((c >> 1) ^ Crc32Poly) : (c >> 1);
+            t[0][i] = c;
+        }
+
+        for (i = 0; i < 256; i++)
+            for (j = 1; j < 16; j++) t[j][i] = (t[j - 1][i] >> 8) ^ t[0][t[j - 1][i] & 0xFF];
+    }
+};
+
+// Built on first use so callers from other static initializers are safe
+const Crc32Tables& crcTables() {
+    static const Crc32Tables tables;
+    return tables;
+}
+
+// Slice-by-16 on the raw (pre-inverted) state
+uint32_t crcSlice16(const uint8_t* p, size_t len, uint32_t crc) {
+    const uint32_t(*t)[256] = crcTables().t;
+    uint32_t a;
+
+    while (len >= 16) {
+        a = crc ^ (static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24));
+
+        crc = t[15][a & 0xFF] ^ t[14][(a >> 8) & 0xFF] ^ t[13][(a >> 16) & 0xFF] ^ t[12][a >> 24] ^ t[11][p[4]] ^
+              t[10][p[5]] ^ t[9][p[6]] ^ t[8][p[7]] ^ t[7][p[8]] ^ t[6][p[9]] ^ t[5][p[10]] ^ t[4][p[11]] ^
+              t[3][p[12]] ^ t[2][p[13]] ^ t[1][p[14]] ^ t[0][p[15]];
+
+        p += 16;
+        len -= 16;
+    }
+
+    while (len--) crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+
+    return crc;
+}
+
+#ifdef ROGUE_CRC32_PCLMUL
+
+// Carry-less multiply folding, see Intel "Fast CRC Computation for Generic
+// Polynomials Using PCLMULQDQ Instruction". Constants are the bit-reflected
+// fold and Barrett values for CRC-32. Requires len >= 64 and a multiple of 16.
+__attribute__((target("pclmul,sse4.1"))) uint32_t crcFold(const uint8_t* buf, size_t len, uint32_t crc) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+
+    __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+    x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x00));
+    x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x10));
+    x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x20));
+    x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x30));
+
+    x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+
+    buf += 64;
+    len -= 64;
+
+    // Fold four 128-bit lanes in parallel
+    while (len >= 64) {
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+        x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+        y5 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x00));
+        y6 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x10));
+        y7 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x20));
+        y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf + 0x30));
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+
+        buf += 64;
+        len -= 64;
+    }
+
+    // Fold the four lanes into one
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+    // Remaining 16-byte blocks
+    while (len >= 16) {
+        x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+
+        x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+        buf += 16;
+        len -= 16;
+    }
+
+    // Fold 128 bits to 64 bits
+    x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+    x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x1 = _mm_srli_si128(x1, 8);
+    x1 = _mm_xor_si128(x1, x2);
+
+    x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_and_si128(x1, x3);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    // Barrett reduction to 32 bits
+    x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+
+    x2 = _mm_and_si128(x1, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+    x2 = _mm_and_si128(x2, x3);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+uint32_t crcPclmul(const uint8_t* p, size_t len, uint32_t crc) {
+    size_t chunk;
+
+    // Short inputs do not amortize the fold setup
+    if (len >= 64) {
+        chunk = len & ~static_cast<size_t>(15);
+        crc   = crcFold(p, chunk, crc);
+        p += chunk;
+        len -= chunk;
+    }
+    return crcSlice16(p, len, crc);
+}
+
+#endif
+
+#ifdef ROGUE_CRC32_ARM
+
+    #if defined(__clang__)
+__attribute__((target("crc")))
+    #else
+__attribute__((target("+crc")))
+    #endif
+uint32_t crcArm(const uint8_t* p, size_t len, uint32_t crc) {
+    uint64_t v;
+    uint32_t w;
+
+    // Align to 8 bytes, then one instruction per 64-bit word
+    while (len > 0 && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+        crc = __crc32b(crc, *p++);
+        len--;
+    }
+
+    while (len >= 8) {
+        __builtin_memcpy(&v, p, 8);
+        crc = __crc32d(crc, v);
+        p += 8;
+        len -= 8;
+    }
+
+    if (len >= 4) {
+        __builtin_memcpy(&w, p, 4);
+        crc = __crc32w(crc, w);
+        p += 4;
+        len -= 4;
+    }
+
+    while (len--) crc = __crc32b(crc, *p++);
+
+    return crc;
+}
+
+#endif
+
+typedef uint32_t (*CrcFunc)(const uint8_t*, size_t, uint32_t);
+
+struct Crc32Engine {
+    CrcFunc func;
+    const char* name;
+
+    Crc32Engine() {
+        func = crcSlice16;
+        name = "slice16";
+
+#ifdef ROGUE_CRC32_PCLMUL
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1")) {
+            func = crcPclmul;
+            name = "pclmul";
+        }
+#endif
+
+#ifdef ROGUE_CRC32_ARM
+    #if defined(__APPLE__)
+        func = crcArm;
+        name = "armv8-crc";
+    #else
+        if (getauxval(AT_HWCAP) & HWCAP_CRC32) {
+            func = crcArm;
+            name = "armv8-crc";
+        }
+    #endif
+#endif
+    }
+};
+
+// Engine is selected once on first use
+const Crc32Engine& crcEngine() {
+    static const Crc32Engine engine;
+    return engine;
+}
+
+}  // namespace
+
+//! Compute or continue a CRC-32
+uint32_t ru::Crc32::calculate(const uint8_t* data, size_t size, uint32_t crc) {
+    return ~crcEngine().func(data, size, ~crc);
+}
+
+//! Compute or continue a CRC-32 with the portable path
+uint32_t ru::Crc32::calculateSlice16(const uint8_t* data, size_t size, uint32_t crc) {
+    return ~crcSlice16(data, size, ~crc);
+}
+
+//! Selected engine name
+const char* ru::Crc32::engine() {
+    return crcEngine().name;
+}
@@ -0,0 +1,144 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+#
+# Whole-array numpy set/get on list variables runs as one locked pass over the
+# block. These tests compare it against per-index access for packed, unaligned,
+# byte-reversed and wide layouts of each numeric model, including the low
+# precision float models which convert whole arrays at once.
+
+import numpy as np
+import pyrogue as pr
+import pytest
+import rogue.interfaces.memory
+
+Count = 64
+
+
+class ListDevice(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        def add(name, offset, base, bits, stride, **extra):
+            self.add(pr.RemoteVariable(
+                name=name,
+                offset=offset,
+                base=base,
+                mode="RW",
+                numValues=Count,
+                valueBits=bits,
+                valueStride=stride,
+                **extra,
+            ))
+
+        add("UIntPacked", 0x0000, pr.UInt, 32, 32)
+        add("UIntOdd", 0x0400, pr.UInt, 12, 13)
+        add("UIntBE", 0x0800, pr.UIntBE, 16, 16)
+        add("UIntWide", 0x0C00, pr.UInt, 60, 64, bitOffset=2)
+        add("IntOdd", 0x1400, pr.Int, 11, 16)
+        add("FloatList", 0x1800, pr.Float, 32, 32)
+        add("DoubleList", 0x1C00, pr.Double, 64, 64)
+        add("FixedList", 0x2400, pr.Fixed(16, 4), 16, 16)
+        add("UFixedList", 0x2800, pr.UFixed(20, 6), 20, 24)
+        add("Float16List", 0x2C00, pr.Float16, 16, 16)
+        add("BFloat16List", 0x2D00, pr.BFloat16, 16, 16)
+        add("TensorFloat32List", 0x2E00, pr.TensorFloat32, 32, 32)
+        add("Float8List", 0x2F00, pr.Float8, 8, 8)
+        add("Float6List", 0x3000, pr.Float6, 8, 8)
+        add("Float4List", 0x3100, pr.Float4, 8, 8)
+
+
+class ListRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="ListRoot", pollEn=False)
+        sim = rogue.interfaces.memory.Emulate(4, 0x4000)
+        self.addInterface(sim)
+        self.add(ListDevice(name="Dev", offset=0, memBase=sim))
+
+
+@pytest.mark.parametrize("name,values", [
+    ("UIntPacked", np.arange(Count, dtype=np.uint32) * 0x01010101),
+    ("UIntOdd", (np.arange(Count, dtype=np.uint16) * 67) & 0xFFF),
+    ("UIntBE", np.arange(Count, dtype=np.uint16) * 0x0102),
+    ("UIntWide", np.arange(Count, dtype=np.uint64) * 0x0123456789AB),
+    ("IntOdd", np.arange(Count, dtype=np.int16) * 31 - 1000),
+    ("FloatList", np.linspace(-4.0, 4.0, Count, dtype=np.float32)),
+    ("DoubleList", np.linspace(-1e9, 1e9, Count, dtype=np.float64)),
+    ("FixedList", np.arange(Count, dtype=np.float64) / 16.0 - 2.0),
+    ("UFixedList", np.arange(Count, dtype=np.float64) / 64.0),
+    ("Float16List", np.linspace(-4.0, 4.0, Count).astype(np.float16)),
+    ("BFloat16List", np.arange(Count, dtype=np.float32) / 4.0 - 8.0),
+    ("TensorFloat32List", np.arange(Count, dtype=np.float32) * 1.5e-3),
+    ("Float8List", np.tile(np.arange(16, dtype=np.float32) / 8.0, Count // 16)),
+    ("Float6List", -np.tile(np.arange(8, dtype=np.float32) / 4.0, Count // 8)),
+    ("Float4List", np.tile(np.array([0, 0.5, 1, 1.5, 2, 3, 4, 6], dtype=np.float32), Count // 8)),
+])
+def test_list_array_round_trip(name, values):
+    with ListRoot() as root:
+        var = getattr(root.Dev, name)
+
+        var.set(values)
+        got = var.get()
+        assert isinstance(got, np.ndarray)
+        np.testing.assert_array_equal(got, values.astype(got.dtype))
+
+        # Whole-array access matches per-index access
+        for i in (0, 1, Count // 2, Count - 1):
+            assert var.get(index=i) == pytest.approx(float(values[i]))
+
+
+def test_list_array_partial_and_strided_set():
+    with ListRoot() as root:
+        var = root.Dev.UIntOdd
+        var.set(np.zeros(Count, dtype=np.uint16))
+
+        # Strided source written at an offset, neighbours untouched
+        src = np.arange(40, dtype=np.uint16)[::4]
+        var.set(src, index=5)
+
+        expected = np.zeros(Count, dtype=np.uint16)
+        expected[5:5 + len(src)] = src
+        np.testing.assert_array_equal(var.get(), expected)
+
+        with pytest.raises(Exception):
+            var.set(np.zeros(Count, dtype=np.uint16), index=1)
+
+
+def test_list_array_range_error_leaves_values():
+    with ListRoot() as root:
+        var = root.Dev.UIntOdd
+        var.set(np.full(Count, 7, dtype=np.uint16))
+
+        # 0x1000 does not fit the 12 bit range checks of the model
+        bad = np.full(Count, 3, dtype=np.uint16)
+        bad[-1] = 0x1000
+        with pytest.raises(Exception):
+            var.set(bad)
+
+        np.testing.assert_array_equal(var.get(), np.full(Count, 7, dtype=np.uint16))
+
+
+def test_low_precision_list_matches_scalar_set():
+    with ListRoot() as root:
+        var = root.Dev.Float8List
+
+        # Values that round, saturate or are NaN go through the same conversion either way
+        values = np.linspace(-500.0, 500.0, Count, dtype=np.float32)
+        values[3] = np.nan
+        values[4] = np.inf
+        var.set(values)
+        got = var.get()
+
+        for i in range(Count):
+            var.set(float(values[i]), index=i)
+        np.testing.assert_array_equal(var.get(), got)
+
+        # Python lists convert as one array as well
+        var.set([float(v) for v in values])
+        np.testing.assert_array_equal(var.get(), got)
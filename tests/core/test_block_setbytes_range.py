@@ -12,14 +12,13 @@
 #-----------------------------------------------------------------------------
 #
 # Pins the contract that Block::setBytes raises when an index is out of range,
-# including for big-endian (byteReverse_) variables that take the malloc-copy
-# path. The malloc copy is what the new ``free(buff)`` guard in setBytes
-# protects against leaking on the throw; the throw itself is the public
-# contract this test exercises.
+# including for big-endian (byteReverse_) variables. The byte-reverse path once
+# used a malloc'd copy which leaked on the throw; the throw itself is the
+# public contract this test exercises.
 #
-# The leak fix proper requires a leak detector (ASan / Valgrind) to observe
-# directly; we still loop the offending call enough times that an unbounded
-# leak would show up under any sanitizer-enabled CI run.
+# A leak would need a leak detector (ASan / Valgrind) to observe directly; we
+# still loop the offending call enough times that an unbounded leak would show
+# up under any sanitizer-enabled CI run.
 
 import pyrogue as pr
 import pytest
@@ -54,7 +53,7 @@ def test_setbytes_out_of_range_be_raises():
         assert var.get(index=0) == 0xDEADBEEF
 
         # Out-of-range write must raise. Run the call repeatedly so any
-        # leak in the byte-reverse malloc copy would be amplified under
+        # leak on the byte-reverse path would be amplified under
         # sanitizer-enabled CI runs.
         for _ in range(64):
             with pytest.raises(Exception):
@@ -62,7 +61,7 @@ def test_setbytes_out_of_range_be_raises():
 
 
 def test_setbytes_in_range_be_roundtrip():
-    """Byte-reversed list variable preserves values across the malloc copy."""
+    """Byte-reversed list variable preserves values across the reversed copy."""
     with _BERoot() as root:
         var = root.Dev.UInt32ListBE
         for i in range(8):
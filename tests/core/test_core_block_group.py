@@ -0,0 +1,98 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue as pr
+import rogue.interfaces.memory as rim
+import pytest
+
+NumRegs = 32
+
+
+class FakeBlock:
+    def __init__(self):
+        self.started = []
+        self.checked = 0
+
+    def _startTransaction(self, tx_type, force_wr, check, variable, index):
+        self.started.append((tx_type, force_wr, check, variable, index))
+
+    def _checkTransaction(self):
+        self.checked += 1
+
+
+class ErrorSlave(rim.Slave):
+    def __init__(self):
+        super().__init__(4, 4)
+
+    def _doTransaction(self, transaction):
+        transaction.error("bad access")
+
+
+class RegDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i in range(NumRegs):
+            self.add(pr.RemoteVariable(
+                name=f"Reg{i}",
+                offset=i * 4,
+                bitSize=32,
+                mode="RW",
+            ))
+
+
+class GroupRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="GroupRoot", pollEn=False)
+        sim = rim.Emulate(4, 0x1000)
+        self.addInterface(sim)
+        self.add(RegDev(name="Dev", offset=0, memBase=sim))
+        self.add(RegDev(name="Bad", offset=0, memBase=ErrorSlave()))
+
+
+def test_bulk_transaction_writes_and_reads_blocks():
+    with GroupRoot() as root:
+        blocks = root.Dev._blocks
+
+        for i in range(NumRegs):
+            root.Dev.node(f"Reg{i}").set(i * 3, write=False)
+        pr.bulkTransaction(blocks, type=rim.Write, window=4)
+
+        for i in range(NumRegs):
+            root.Dev.node(f"Reg{i}").set(0, write=False)
+        pr.bulkTransaction(blocks, type=rim.Read, window=4)
+
+        assert [root.Dev.node(f"Reg{i}").value() for i in range(NumRegs)] == [i * 3 for i in range(NumRegs)]
+
+        group = rim.BlockGroup(0)
+        assert group.window == 1
+        group.window = 8
+        group.addBlocks(blocks)
+        group.addBlock(blocks[0])
+        assert len(group) == len(blocks) + 1
+        group.clear()
+        assert len(group) == 0
+
+
+def test_bulk_transaction_handles_local_blocks():
+    local = FakeBlock()
+
+    pr.bulkTransaction([local], type=rim.Write, force=True)
+
+    assert local.started == [(rim.Write, True, False, None, -1)]
+    assert local.checked == 1
+
+
+def test_bulk_transaction_reports_all_failed_blocks():
+    with GroupRoot() as root:
+        blocks = root.Dev._blocks + root.Bad._blocks
+
+        with pytest.raises(Exception, match=f"{NumRegs} of {2 * NumRegs} blocks failed"):
+            pr.bulkTransaction(blocks, type=rim.Read)
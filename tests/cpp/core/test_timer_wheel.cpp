@@ -0,0 +1,155 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the hierarchical timer wheel: expiry order, cancel and
+ * re-arm, long deadlines that cascade through the upper levels, next deadline
+ * reporting, and deadlines already in the past.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <chrono>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/TimerWheel.h"
+
+namespace {
+
+typedef rogue::TimerWheel::Clock Clock;
+typedef std::chrono::milliseconds ms;
+
+}  // namespace
+
+TEST_CASE("TimerWheel expires timers in deadline order and never early") {
+    Clock::time_point base = Clock::now();
+    rogue::TimerWheel wheel(ms(1));
+    rogue::TimerWheel::Timer a, b, c;
+    std::vector<rogue::TimerWheel::Timer*> expired;
+
+    wheel.arm(&c, base + ms(30));
+    wheel.arm(&a, base + ms(10));
+    wheel.arm(&b, base + ms(20));
+    CHECK(wheel.count() == 3);
+
+    wheel.advance(base + ms(5), expired);
+    CHECK(expired.empty());
+
+    wheel.advance(base + ms(40), expired);
+    REQUIRE(expired.size() == 3);
+    CHECK(expired[0] == &a);
+    CHECK(expired[1] == &b);
+    CHECK(expired[2] == &c);
+    CHECK(wheel.count() == 0);
+    CHECK(!a.armed());
+}
+
+TEST_CASE("TimerWheel cancel and re-arm") {
+    Clock::time_point base = Clock::now();
+    rogue::TimerWheel wheel(ms(1));
+    rogue::TimerWheel::Timer a, b;
+    std::vector<rogue::TimerWheel::Timer*> expired;
+
+    wheel.arm(&a, base + ms(10));
+    wheel.arm(&b, base + ms(10));
+    wheel.cancel(&a);
+    wheel.cancel(&a);
+    CHECK(!a.armed());
+    CHECK(wheel.count() == 1);
+
+    // Re-arming moves the deadline rather than adding a second entry
+    wheel.arm(&b, base + ms(50));
+    CHECK(wheel.count() == 1);
+
+    wheel.advance(base + ms(20), expired);
+    CHECK(expired.empty());
+
+    wheel.advance(base + ms(51), expired);
+    REQUIRE(expired.size() == 1);
+    CHECK(expired[0] == &b);
+}
+
+TEST_CASE("TimerWheel cascades long deadlines down to expiry") {
+    Clock::time_point base = Clock::now();
+    rogue::TimerWheel wheel(ms(1));
+    rogue::TimerWheel::Timer near, mid, far, huge;
+    std::vector<rogue::TimerWheel::Timer*> expired;
+
+    // Level 0, level 1, level 2 and beyond the top level
+    wheel.arm(&near, base + ms(3));
+    wheel.arm(&mid, base + ms(1000));
+    wheel.arm(&far, base + ms(100000));
+    wheel.arm(&huge, base + std::chrono::hours(24 * 7));
+
+    // Step through in uneven increments so several cascades happen per call
+    for (uint32_t t = 0; t <= 100000; t += 777) {
+        wheel.advance(base + ms(t), expired);
+        for (auto timer : expired) {
+            if (timer == &near) CHECK(t >= 3);
+            if (timer == &mid) CHECK(t >= 1000);
+            if (timer == &far) CHECK(t >= 100000);
+        }
+    }
+    wheel.advance(base + ms(100001), expired);
+
+    REQUIRE(expired.size() == 3);
+    CHECK(expired[0] == &near);
+    CHECK(expired[1] == &mid);
+    CHECK(expired[2] == &far);
+    CHECK(huge.armed());
+    CHECK(wheel.count() == 1);
+
+    expired.clear();
+    wheel.advance(base + std::chrono::hours(24 * 7) + ms(1), expired);
+    REQUIRE(expired.size() == 1);
+    CHECK(expired[0] == &huge);
+}
+
+TEST_CASE("TimerWheel reports the next deadline") {
+    Clock::time_point base = Clock::now();
+    rogue::TimerWheel wheel(ms(1));
+    rogue::TimerWheel::Timer a, b;
+    std::vector<rogue::TimerWheel::Timer*> expired;
+
+    CHECK(wheel.nextDeadline() == Clock::time_point::max());
+
+    wheel.arm(&a, base + ms(5000));
+    wheel.arm(&b, base + ms(200));
+
+    // Rounded up to the tick, so never earlier than the request
+    Clock::time_point next = wheel.nextDeadline();
+    CHECK(next >= base + ms(200));
+    CHECK(next <= base + ms(202));
+
+    wheel.advance(next, expired);
+    REQUIRE(expired.size() == 1);
+    CHECK(expired[0] == &b);
+
+    next = wheel.nextDeadline();
+    CHECK(next >= base + ms(5000));
+    CHECK(next <= base + ms(5002));
+}
+
+TEST_CASE("TimerWheel fires past deadlines on the next advance") {
+    rogue::TimerWheel wheel(ms(1));
+    rogue::TimerWheel::Timer a;
+    std::vector<rogue::TimerWheel::Timer*> expired;
+
+    Clock::time_point now = Clock::now() + ms(100);
+    wheel.advance(now, expired);
+
+    wheel.arm(&a, now - ms(50));
+    CHECK(wheel.nextDeadline() <= now + ms(1));
+
+    wheel.advance(now + ms(1), expired);
+    REQUIRE(expired.size() == 1);
+    CHECK(expired[0] == &a);
+}
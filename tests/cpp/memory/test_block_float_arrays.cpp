@@ -0,0 +1,217 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the low precision float array converters used by the
+ * list variable paths, checking them bit for bit against the scalar setters
+ * and getters over every stored code and a spread of float inputs.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/memory/Block.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Variable.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+const uint32_t Count = 1024;
+
+// Exposes the list word helpers and the array converters
+class FloatBlock : public rim::Block {
+  public:
+    FloatBlock() : rim::Block(0, 4 * Count) {}
+
+    using rim::Block::checkFloatRange;
+    using rim::Block::decodeBFloat16Array;
+    using rim::Block::decodeFloat16Array;
+    using rim::Block::decodeFloat4Array;
+    using rim::Block::decodeFloat6Array;
+    using rim::Block::decodeFloat8Array;
+    using rim::Block::decodeTensorFloat32Array;
+    using rim::Block::encodeBFloat16Array;
+    using rim::Block::encodeFloat16Array;
+    using rim::Block::encodeFloat4Array;
+    using rim::Block::encodeFloat6Array;
+    using rim::Block::encodeFloat8Array;
+    using rim::Block::encodeTensorFloat32Array;
+    using rim::Block::getWords;
+    using rim::Block::setWords;
+};
+
+struct Format {
+    const char* name;
+    uint8_t model;
+    uint32_t bits;
+    void (*encode)(uint64_t*, const float*, uint32_t);
+    void (*decode)(float*, const uint64_t*, uint32_t);
+    void (rim::Block::*set)(const float&, rim::Variable*, int32_t);
+    float (rim::Block::*get)(rim::Variable*, int32_t);
+};
+
+const Format Formats[] = {
+    {"Float16", rim::Float16, 16, FloatBlock::encodeFloat16Array, FloatBlock::decodeFloat16Array,
+     &rim::Block::setFloat16, &rim::Block::getFloat16},
+    {"BFloat16", rim::BFloat16, 16, FloatBlock::encodeBFloat16Array, FloatBlock::decodeBFloat16Array,
+     &rim::Block::setBFloat16, &rim::Block::getBFloat16},
+    {"TensorFloat32", rim::TensorFloat32, 32, FloatBlock::encodeTensorFloat32Array,
+     FloatBlock::decodeTensorFloat32Array, &rim::Block::setTensorFloat32, &rim::Block::getTensorFloat32},
+    {"Float8", rim::Float8, 8, FloatBlock::encodeFloat8Array, FloatBlock::decodeFloat8Array,
+     &rim::Block::setFloat8, &rim::Block::getFloat8},
+    {"Float6", rim::Float6, 8, FloatBlock::encodeFloat6Array, FloatBlock::decodeFloat6Array,
+     &rim::Block::setFloat6, &rim::Block::getFloat6},
+    {"Float4", rim::Float4, 8, FloatBlock::encodeFloat4Array, FloatBlock::decodeFloat4Array,
+     &rim::Block::setFloat4, &rim::Block::getFloat4},
+};
+
+uint32_t bitsOf(float value) {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    return f;
+}
+
+float floatOf(uint32_t f) {
+    float value;
+    std::memcpy(&value, &f, sizeof(value));
+    return value;
+}
+
+// Edge values of every format followed by random bit patterns, NaN payloads included
+std::vector<float> floatInputs() {
+    std::vector<float> in;
+    std::mt19937 rng(0x44);
+
+    const uint32_t edges[] = {0x00000000, 0x80000000, 0x00000001, 0x807FFFFF, 0x3F800000, 0xBF800000, 0x477FE000,
+                              0x477FFFFF, 0x47800000, 0xC7800000, 0x7F7FFFFF, 0x7F800000, 0xFF800000, 0x7F800001,
+                              0xFF800001, 0x7F801000, 0x7FC00000, 0xFFFFFFFF, 0x33000000, 0x387FE000, 0x43E00000,
+                              0x43E80000, 0x41E00000, 0x40C00000, 0x3E800000, 0x3F000000, 0x3D800000};
+    for (auto f : edges) in.push_back(floatOf(f));
+
+    // Every exponent with a few mantissas, then the remainder random
+    for (uint32_t e = 0; e < 256; e++)
+        for (uint32_t m : {0x000000U, 0x000001U, 0x100000U, 0x1FFFFFU, 0x400000U, 0x7FFFFFU})
+            for (uint32_t s : {0U, 0x80000000U}) in.push_back(floatOf(s | (e << 23) | m));
+
+    while (in.size() % Count != 0 || in.size() < 64 * Count) in.push_back(floatOf(rng()));
+    return in;
+}
+
+std::shared_ptr<rim::Variable> listVariable(const Format& format) {
+    return rim::Variable::create(format.name, "RW", 0, 0, 0, {0}, {format.bits * Count}, false, false, false, false,
+                                 format.model, false, false, 0, Count, format.bits, format.bits, 0);
+}
+
+}  // namespace
+
+TEST_CASE("Float array encoders match the scalar setters bit for bit") {
+    const std::vector<float> in = floatInputs();
+
+    for (const auto& format : Formats) {
+        INFO("format=" << format.name);
+
+        auto block = std::make_shared<FloatBlock>();
+        auto var   = listVariable(format);
+        block->addVariables({var});
+
+        std::vector<uint64_t> batch(Count);
+        std::vector<uint64_t> scalar(Count);
+
+        for (std::size_t base = 0; base < in.size(); base += Count) {
+            format.encode(batch.data(), in.data() + base, Count);
+
+            for (uint32_t x = 0; x < Count; x++) (block.get()->*format.set)(in[base + x], var.get(), x);
+            block->getWords(scalar.data(), var.get(), 0, Count);
+
+            for (uint32_t x = 0; x < Count; x++) {
+                if (batch[x] != scalar[x]) {
+                    INFO("input=0x" << std::hex << bitsOf(in[base + x]));
+                    CHECK_EQ(batch[x], scalar[x]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Float array decoders match the scalar getters bit for bit") {
+    std::mt19937 rng(0x44);
+
+    for (const auto& format : Formats) {
+        INFO("format=" << format.name);
+
+        auto block = std::make_shared<FloatBlock>();
+        auto var   = listVariable(format);
+        block->addVariables({var});
+
+        // Every code of the narrow formats, random patterns for TensorFloat32
+        const uint64_t codes = (format.bits == 32) ? 64 * Count : (1ULL << format.bits);
+        std::vector<uint64_t> words(Count);
+        std::vector<float> batch(Count);
+
+        for (uint64_t base = 0; base < codes; base += Count) {
+            for (uint32_t x = 0; x < Count; x++)
+                words[x] = (format.bits == 32) ? rng() : ((base + x) & ((1ULL << format.bits) - 1));
+
+            block->setWords(words.data(), var.get(), 0, Count);
+            format.decode(batch.data(), words.data(), Count);
+
+            for (uint32_t x = 0; x < Count; x++) {
+                uint32_t scalar = bitsOf((block.get()->*format.get)(var.get(), x));
+                if (bitsOf(batch[x]) != scalar) {
+                    INFO("code=0x" << std::hex << words[x]);
+                    CHECK_EQ(bitsOf(batch[x]), scalar);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Float16 codes survive the float round trip unchanged") {
+    // The numpy float16 paths store and return half bits directly
+    std::vector<uint64_t> codes(1 << 16);
+    std::vector<float> vals(codes.size());
+    std::vector<uint64_t> back(codes.size());
+
+    for (uint32_t x = 0; x < codes.size(); x++) codes[x] = x;
+    FloatBlock::decodeFloat16Array(vals.data(), codes.data(), static_cast<uint32_t>(codes.size()));
+    FloatBlock::encodeFloat16Array(back.data(), vals.data(), static_cast<uint32_t>(codes.size()));
+
+    for (uint32_t x = 0; x < codes.size(); x++) {
+        if (back[x] != codes[x]) {
+            INFO("code=0x" << std::hex << x);
+            CHECK_EQ(back[x], codes[x]);
+        }
+    }
+}
+
+TEST_CASE("Float array range check reports the first value out of range") {
+    auto block = std::make_shared<FloatBlock>();
+    auto var   = rim::Variable::create("Ranged", "RW", -2.0, 2.0, 0, {0}, {16 * Count}, false, false, false, false,
+                                       rim::Float16, false, false, 0, Count, 16, 16, 0);
+    block->addVariables({var});
+
+    std::vector<float> vals(Count, 1.5f);
+    CHECK_NOTHROW(block->checkFloatRange(vals.data(), Count, var.get(), "Block::setFloat16"));
+
+    vals[Count - 1] = 2.5f;
+    CHECK_THROWS_AS(block->checkFloatRange(vals.data(), Count, var.get(), "Block::setFloat16"), rogue::GeneralError);
+    CHECK_THROWS_AS(block->setFloat16(2.5f, var.get(), 0), rogue::GeneralError);
+}
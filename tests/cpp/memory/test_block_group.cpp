@@ -0,0 +1,274 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the bulk block transaction engine, covering the in
+ * flight window, completions in any order, retries, aggregated errors and
+ * timeouts.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/memory/Block.h"
+#include "rogue/interfaces/memory/BlockGroup.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Slave.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+#include "rogue/interfaces/memory/Variable.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+const uint32_t Count = 64;
+
+// Backing memory which holds transactions until a link thread answers them in reverse order
+class LinkSlave : public rim::Slave {
+  public:
+    explicit LinkSlave(bool deferred)
+        : rim::Slave(4, 4096), memory_(Count * 4, 0), deferred_(deferred), active_(0), peak_(0), run_(true) {
+        if (deferred_) thread_ = std::thread(&LinkSlave::link, this);
+    }
+
+    ~LinkSlave() {
+        run_ = false;
+        if (thread_.joinable()) thread_.join();
+    }
+
+    void doTransaction(rim::TransactionPtr transaction) override {
+        rim::TransactionLockPtr lock = transaction->lock();
+        std::lock_guard<std::mutex> guard(mutex_);
+
+        attempts[transaction->address()]++;
+
+        // Dropped addresses are never answered
+        if (drop.count(transaction->address())) return;
+
+        if (!deferred_) {
+            answer(transaction);
+            return;
+        }
+
+        addTransaction(transaction);
+        ids_.push_back(transaction->id());
+        peak_ = std::max(peak_, ++active_);
+    }
+
+    uint32_t peak() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return peak_;
+    }
+
+    std::vector<uint8_t> memory_;
+    std::map<uint64_t, uint32_t> attempts;  // Transactions seen per address
+    std::map<uint64_t, uint32_t> failures;  // Failures left per address
+    std::map<uint64_t, bool> drop;
+
+  private:
+    // Called with mutex_ held
+    void answer(rim::TransactionPtr tran) {
+        uint64_t addr = tran->address();
+
+        if (failures[addr] > 0) {
+            failures[addr]--;
+            tran->errorStr("link error");
+            return;
+        }
+
+        if (tran->type() == rim::Write || tran->type() == rim::Post)
+            std::copy(tran->begin(), tran->end(), memory_.begin() + addr);
+        else
+            std::copy(memory_.begin() + addr, memory_.begin() + addr + tran->size(), tran->begin());
+        tran->done();
+    }
+
+    void link() {
+        std::vector<uint32_t> ids;
+
+        while (run_) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            {
+                std::lock_guard<std::mutex> guard(mutex_);
+                ids.swap(ids_);
+            }
+
+            for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+                rim::TransactionPtr tran = getTransaction(*it);
+                if (tran == NULL) continue;
+
+                rim::TransactionLockPtr lock = tran->lock();
+                std::lock_guard<std::mutex> guard(mutex_);
+                active_--;
+                if (!tran->expired()) answer(tran);
+            }
+            ids.clear();
+        }
+    }
+
+    std::mutex mutex_;
+    std::vector<uint32_t> ids_;
+    bool deferred_;
+    uint32_t active_;
+    uint32_t peak_;
+    std::atomic<bool> run_;
+    std::thread thread_;
+};
+
+struct Group {
+    std::shared_ptr<LinkSlave> slave;
+    std::vector<rim::BlockPtr> blocks;
+    std::vector<rim::VariablePtr> vars;
+    rim::BlockGroupPtr group;
+
+    Group(bool deferred, uint32_t window, uint32_t retryCount = 0) {
+        slave = std::make_shared<LinkSlave>(deferred);
+        group = rim::BlockGroup::create(window);
+
+        for (uint32_t i = 0; i < Count; ++i) {
+            auto block = rim::Block::create(i * 4, 4);
+            auto var   = rim::Variable::create("Reg" + std::to_string(i), "RW", 0, 0, i * 4, {0}, {32}, false, false,
+                                               false, false, rim::UInt, false, false, 0, 0, 0, 0, retryCount);
+            var->updatePath("Dev.Reg" + std::to_string(i));
+
+            block->setSlave(slave);
+            block->addVariables({var});
+            block->setEnable(true);
+            block->setTimeout(200000);
+
+            blocks.push_back(block);
+            vars.push_back(var);
+        }
+        group->addBlocks(blocks);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Block group keeps the window and accepts completions in any order") {
+    Group g(true, 8);
+    REQUIRE_EQ(g.group->count(), Count);
+
+    for (uint32_t i = 0; i < Count; ++i) g.blocks[i]->setUInt(i * 0x01010101ULL, g.vars[i].get(), -1);
+    g.group->run(rim::Write);
+
+    CHECK(g.slave->peak() <= 8);
+    CHECK(g.slave->peak() > 1);
+    for (uint32_t i = 0; i < Count; ++i) CHECK_EQ(g.slave->memory_[i * 4], i & 0xFF);
+
+    // Nothing is stale, forced writes send everything again
+    g.group->run(rim::Write);
+    CHECK_EQ(g.slave->attempts[0], 1U);
+    g.group->run(rim::Write, true);
+    CHECK_EQ(g.slave->attempts[0], 2U);
+
+    std::fill(g.slave->memory_.begin(), g.slave->memory_.end(), 0x5A);
+    g.group->setWindow(3);
+    g.group->run(rim::Read);
+
+    CHECK(g.slave->peak() <= 8);
+    for (uint32_t i = 0; i < Count; ++i) CHECK_EQ(g.blocks[i]->getUInt(g.vars[i].get(), -1), 0x5A5A5A5AULL);
+}
+
+TEST_CASE("Block group window is at least one") {
+    auto group = rim::BlockGroup::create(0);
+    CHECK_EQ(group->getWindow(), 1U);
+
+    group->setWindow(0);
+    CHECK_EQ(group->getWindow(), 1U);
+
+    // Empty groups complete at once
+    CHECK_NOTHROW(group->run(rim::Read));
+}
+
+TEST_CASE("Block group retries failed blocks without stopping the others") {
+    Group g(true, 16, 2);
+
+    g.slave->failures[4 * 4]  = 2;  // Passes on the last try
+    g.slave->failures[9 * 4]  = 5;  // Never passes
+    g.slave->failures[20 * 4] = 1;
+
+    std::string error;
+    try {
+        g.group->run(rim::Read);
+    } catch (rogue::GeneralError& err) {
+        error = err.what();
+    }
+
+    CHECK(error.find("1 of 64 blocks failed") != std::string::npos);
+    CHECK(error.find("Dev.Reg9") != std::string::npos);
+    CHECK(error.find("link error") != std::string::npos);
+    CHECK(error.find("Dev.Reg4") == std::string::npos);
+
+    CHECK_EQ(g.slave->attempts[4 * 4], 3U);
+    CHECK_EQ(g.slave->attempts[9 * 4], 3U);
+    CHECK_EQ(g.slave->attempts[20 * 4], 2U);
+    CHECK_EQ(g.slave->attempts[30 * 4], 1U);
+}
+
+TEST_CASE("Block group reports every failed block of a synchronous slave") {
+    Group g(false, 4);
+
+    for (uint32_t i = 0; i < Count; i += 8) g.slave->failures[i * 4] = 1;
+    g.slave->memory_[4] = 0x33;
+
+    std::string error;
+    try {
+        g.group->run(rim::Read);
+    } catch (rogue::GeneralError& err) {
+        error = err.what();
+    }
+
+    CHECK(error.find("8 of 64 blocks failed") != std::string::npos);
+    CHECK(error.find("Dev.Reg0,") != std::string::npos);
+    CHECK(error.find("Dev.Reg56") != std::string::npos);
+    CHECK_EQ(g.blocks[1]->getUInt(g.vars[1].get(), -1), 0x33ULL);
+}
+
+TEST_CASE("Block group times out blocks which are never answered") {
+    Group g(true, 8);
+
+    for (auto& block : g.blocks) block->setTimeout(20000);
+    g.slave->drop[5 * 4]  = true;
+    g.slave->drop[40 * 4] = true;
+    g.slave->memory_[8]   = 0x77;
+
+    std::string error;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        g.group->run(rim::Read);
+    } catch (rogue::GeneralError& err) {
+        error = err.what();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    CHECK(error.find("2 of 64 blocks failed") != std::string::npos);
+    CHECK(error.find("Timeout") != std::string::npos);
+    CHECK(error.find("Dev.Reg5") != std::string::npos);
+    CHECK(error.find("Dev.Reg40") != std::string::npos);
+    CHECK_EQ(g.blocks[2]->getUInt(g.vars[2].get(), -1), 0x77ULL);
+
+    // Both timeouts overlap with the rest of the traffic
+    CHECK(elapsed < std::chrono::milliseconds(1000));
+}
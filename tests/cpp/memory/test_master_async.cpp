@@ -0,0 +1,223 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for asynchronous memory master transactions, covering
+ * callbacks from synchronous and threaded slaves, many outstanding reads
+ * without blocking waits, error and timeout delivery, futures, and requests
+ * made after the master is stopped.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/Slave.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+#include "support/test_helpers.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+// Fills reads with the low address byte and completes in the caller
+class SyncSlave : public rim::Slave {
+  public:
+    SyncSlave() : rim::Slave(4, 4096) {}
+
+    void doTransaction(rim::TransactionPtr transaction) override {
+        rim::TransactionLockPtr lock = transaction->lock();
+        std::fill(transaction->begin(), transaction->end(), transaction->address() & 0xFF);
+        transaction->done();
+    }
+};
+
+// Holds transactions until respond() is called from another thread
+class DeferredSlave : public rim::Slave {
+  public:
+    DeferredSlave() : rim::Slave(4, 4096) {}
+
+    void doTransaction(rim::TransactionPtr transaction) override {
+        rim::TransactionLockPtr lock = transaction->lock();
+        addTransaction(transaction);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        ids_.push_back(transaction->id());
+    }
+
+    void respond(uint32_t id, const std::string& error = "") {
+        rim::TransactionPtr tran = getTransaction(id);
+        if (tran == NULL) return;
+
+        rim::TransactionLockPtr lock = tran->lock();
+        if (tran->expired()) return;
+
+        if (error != "") {
+            tran->errorStr(error);
+        } else {
+            std::fill(tran->begin(), tran->end(), tran->address() & 0xFF);
+            tran->done();
+        }
+    }
+
+    std::vector<uint32_t> ids() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return ids_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<uint32_t> ids_;
+};
+
+// Collects callback results
+struct Results {
+    std::mutex mutex;
+    std::vector<uint32_t> ids;
+    std::vector<std::string> errors;
+
+    rim::TransactionCallback callback() {
+        return [this](uint32_t id, const std::string& error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ids.push_back(id);
+            errors.push_back(error);
+        };
+    }
+
+    std::size_t count() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ids.size();
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Async transaction on a synchronous slave calls back before returning") {
+    auto master = rim::Master::create();
+    master->setSlave(std::make_shared<SyncSlave>());
+
+    Results res;
+    uint8_t data[4] = {0};
+    uint32_t id     = master->reqTransactionAsync(0x12, 4, data, rim::Read, res.callback());
+
+    REQUIRE(res.count() == 1);
+    CHECK(res.ids[0] == id);
+    CHECK(res.errors[0] == "");
+    CHECK(data[0] == 0x12);
+    CHECK(data[3] == 0x12);
+}
+
+TEST_CASE("Async transactions complete out of order without waiting") {
+    const uint32_t Count = 1000;
+
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = rim::Master::create();
+    master->setSlave(slave);
+
+    Results res;
+    std::vector<uint8_t> data(Count * 4, 0);
+    for (uint32_t i = 0; i < Count; ++i)
+        master->reqTransactionAsync(i * 4, 4, &data[i * 4], rim::Read, res.callback());
+    CHECK(res.count() == 0);
+
+    std::vector<uint32_t> ids = slave->ids();
+    REQUIRE(ids.size() == Count);
+
+    std::thread link([&]() {
+        for (uint32_t i = Count; i > 0; --i) slave->respond(ids[i - 1]);
+    });
+    link.join();
+
+    REQUIRE(res.count() == Count);
+    CHECK(static_cast<uint32_t>(std::count(res.errors.begin(), res.errors.end(), "")) == Count);
+    CHECK(res.ids.front() == ids.back());
+    for (uint32_t i = 0; i < Count; ++i) CHECK(data[i * 4] == ((i * 4) & 0xFF));
+}
+
+TEST_CASE("Async transaction errors and timeouts reach the callback") {
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = rim::Master::create();
+    master->setSlave(slave);
+    master->setTimeout(20000);
+
+    Results res;
+    uint8_t data[8];
+    master->reqTransactionAsync(0, 4, data, rim::Read, res.callback());
+    master->reqTransactionAsync(4, 4, data + 4, rim::Read, res.callback());
+
+    slave->respond(slave->ids()[0], "bad access");
+    REQUIRE(res.count() == 1);
+    CHECK(res.errors[0] == "bad access");
+
+    // Second is never answered and times out on the master's thread
+    REQUIRE(rogue_test::waitUntil([&]() { return res.count() == 2; }, 1000));
+    CHECK(res.errors[1].find("Timeout") != std::string::npos);
+
+    // Slave errors from the base class propagate the same way
+    master->setSlave(rim::Slave::create(4, 4));
+    master->reqTransactionAsync(0, 4, data, rim::Write, res.callback());
+    REQUIRE(res.count() == 3);
+    CHECK(res.errors[2] != "");
+
+    // Async errors are reported only to the callback
+    CHECK(master->getError() == "");
+}
+
+TEST_CASE("Async transaction future holds the result") {
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = rim::Master::create();
+    master->setSlave(slave);
+
+    uint8_t data[4]              = {0};
+    std::future<std::string> fut = master->reqTransactionFuture(0x40, 4, data, rim::Read);
+    CHECK(fut.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout);
+
+    std::thread link([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        slave->respond(slave->ids()[0]);
+    });
+
+    CHECK(fut.get() == "");
+    CHECK(data[0] == 0x40);
+    link.join();
+}
+
+TEST_CASE("Async transaction after stop fails immediately") {
+    auto master = rim::Master::create();
+    master->setSlave(std::make_shared<DeferredSlave>());
+    master->setTimeout(1000);
+
+    Results res;
+    uint8_t data[4];
+    master->reqTransactionAsync(0, 4, data, rim::Read, res.callback());
+    master->stop();
+
+    // Outstanding transactions are drained by stop
+    REQUIRE(res.count() == 1);
+    CHECK(res.errors[0] != "");
+
+    master->reqTransactionAsync(0, 4, data, rim::Read, res.callback());
+    REQUIRE(res.count() == 2);
+    CHECK(res.errors[1].find("stopped") != std::string::npos);
+}
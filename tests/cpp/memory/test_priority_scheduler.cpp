@@ -0,0 +1,156 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for transaction priorities and the priority scheduling
+ * memory stage, covering issue order, the in-flight window, guaranteed
+ * progress for background traffic and error delivery.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/PriorityScheduler.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "support/test_helpers.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+// Transactions wait in the slave until the test releases them
+struct Stage : rogue_test::MemoryStage<rim::PriorityScheduler> {
+    explicit Stage(uint32_t window) : MemoryStage(rim::PriorityScheduler::create(window), 256, true) {
+        slave->hold = true;
+    }
+
+    ~Stage() {
+        rim::Transaction::setThreadPriority(rim::PriorityNormal);
+    }
+
+    void read(uint64_t address, uint32_t priority) {
+        rim::Transaction::setThreadPriority(priority);
+        start(address, 4);
+    }
+
+    void drain() {
+        while (slave->held() != 0) slave->release();
+        master->waitTransaction(0);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Transactions take the priority of the creating thread") {
+    CHECK_EQ(rim::Transaction::getThreadPriority(), rim::PriorityNormal);
+    CHECK_THROWS_AS(rim::Transaction::setThreadPriority(rim::PriorityHigh + 1), rogue::GeneralError);
+
+    Stage s(4);
+    s.read(0x00, rim::PriorityBackground);
+    s.read(0x04, rim::PriorityHigh);
+    s.drain();
+
+    REQUIRE_EQ(s.slave->records.size(), 2U);
+    CHECK_EQ(s.slave->records[0].priority, rim::PriorityBackground);
+    CHECK_EQ(s.slave->records[1].priority, rim::PriorityHigh);
+}
+
+TEST_CASE("User access goes ahead of queued polling") {
+    Stage s(1);
+
+    for (uint32_t i = 0; i < 6; ++i) s.read(0x100 + i * 4, rim::PriorityBackground);
+    s.read(0x00, rim::PriorityNormal);
+    s.read(0x04, rim::PriorityNormal);
+
+    CHECK_EQ(s.stage->getInFlight(), 1U);
+    CHECK_EQ(s.slave->held(), 1U);
+    CHECK_EQ(s.stage->getQueueDepth(rim::PriorityBackground), 5U);
+    CHECK_EQ(s.stage->getQueueDepth(rim::PriorityNormal), 2U);
+
+    s.drain();
+    CHECK_EQ(s.master->getError(), "");
+
+    std::vector<uint64_t> expect = {0x100, 0x00, 0x04, 0x104, 0x108, 0x10C, 0x110, 0x114};
+    CHECK_EQ(s.slave->addresses(), expect);
+    CHECK_EQ(s.data[0x04], 0x04U);
+    CHECK_EQ(s.data[0x114], 0x14U);
+    CHECK_EQ(s.stage->getIssueCount(rim::PriorityBackground), 6U);
+    CHECK_EQ(s.stage->getIssueCount(rim::PriorityNormal), 2U);
+}
+
+TEST_CASE("Background traffic keeps making progress") {
+    Stage s(1);
+    s.stage->setStarvationLimit(2);
+
+    s.read(0x100, rim::PriorityBackground);
+    s.read(0x104, rim::PriorityBackground);
+    s.read(0x108, rim::PriorityBackground);
+    for (uint32_t i = 0; i < 6; ++i) s.read(i * 4, rim::PriorityHigh);
+
+    s.drain();
+
+    std::vector<uint64_t> expect = {0x100, 0x00, 0x04, 0x104, 0x08, 0x0C, 0x108, 0x10, 0x14};
+    CHECK_EQ(s.slave->addresses(), expect);
+}
+
+TEST_CASE("The window bounds outstanding transactions") {
+    Stage s(3);
+
+    for (uint32_t i = 0; i < 10; ++i) s.read(i * 4, rim::PriorityNormal);
+    CHECK_EQ(s.slave->held(), 3U);
+    CHECK_EQ(s.stage->getInFlight(), 3U);
+
+    s.slave->release();
+    CHECK_EQ(s.slave->held(), 3U);
+
+    s.stage->setWindow(5);
+    CHECK_EQ(s.slave->held(), 5U);
+
+    s.drain();
+    CHECK_EQ(s.stage->getInFlight(), 0U);
+    CHECK_EQ(s.slave->count(), 10U);
+}
+
+TEST_CASE("Errors reach the original transaction") {
+    Stage s(1);
+
+    s.read(0x00, rim::PriorityNormal);
+    s.read(0x04, rim::PriorityNormal);
+    s.slave->release("bus error");
+    s.slave->release();
+    s.master->waitTransaction(0);
+
+    CHECK(s.master->getError().find("bus error") != std::string::npos);
+    CHECK_EQ(s.stage->getInFlight(), 0U);
+}
+
+TEST_CASE("Stopping fails queued transactions") {
+    Stage s(1);
+
+    // The held transaction times out quickly
+    s.stage->setTimeout(1000);
+
+    s.read(0x00, rim::PriorityNormal);
+    s.read(0x04, rim::PriorityNormal);
+    s.read(0x08, rim::PriorityNormal);
+    s.stage->stop();
+    s.master->waitTransaction(0);
+
+    CHECK(s.master->getError().find("stopped") != std::string::npos);
+    CHECK_EQ(s.slave->count(), 1U);
+}
@@ -0,0 +1,209 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the read coalescing memory stage, covering merged
+ * reads, the maximum access size, over read ranges, ordering against other
+ * transactions, ordering behind groups which are still being sent, error
+ * delivery, the hold time and stacking under a scheduler over a synchronous
+ * slave.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Emulate.h"
+#include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/PriorityScheduler.h"
+#include "rogue/interfaces/memory/ReadCoalescer.h"
+#include "support/test_helpers.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+struct Stage : rogue_test::MemoryStage<rim::ReadCoalescer> {
+    explicit Stage(uint32_t maxAccess, uint32_t holdTime = 1000000)
+        : MemoryStage(rim::ReadCoalescer::create(holdTime), maxAccess, true) {}
+
+    void finish() {
+        stage->flush();
+        master->waitTransaction(0);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Adjacent reads are combined and scattered back") {
+    Stage s(256);
+
+    for (uint32_t i = 0; i < 16; ++i) s.start(0x40 + i * 4, 4);
+    s.finish();
+
+    REQUIRE_EQ(s.slave->records.size(), 1U);
+    CHECK_EQ(s.slave->records[0].address, 0x40U);
+    CHECK_EQ(s.slave->records[0].size, 64U);
+    CHECK_EQ(s.master->getError(), "");
+    for (uint32_t i = 0x40; i < 0x80; ++i) CHECK_EQ(s.data[i], i & 0xFF);
+
+    CHECK_EQ(s.stage->getReadCount(), 16U);
+    CHECK_EQ(s.stage->getIssueCount(), 1U);
+}
+
+TEST_CASE("Combined reads stop at the maximum access size") {
+    Stage s(32);
+
+    for (uint32_t i = 0; i < 20; ++i) s.start(i * 4, 4);
+    s.finish();
+
+    REQUIRE_EQ(s.slave->records.size(), 3U);
+    CHECK_EQ(s.slave->records[0].size, 32U);
+    CHECK_EQ(s.slave->records[1].address, 32U);
+    CHECK_EQ(s.slave->records[1].size, 32U);
+    CHECK_EQ(s.slave->records[2].size, 16U);
+    for (uint32_t i = 0; i < 80; ++i) CHECK_EQ(s.data[i], i & 0xFF);
+}
+
+TEST_CASE("Holes are read only inside over read ranges") {
+    Stage s(256);
+
+    s.start(0x00, 4);
+    s.start(0x08, 4);
+    s.finish();
+    CHECK_EQ(s.slave->records.size(), 2U);
+
+    s.stage->addOverReadRange(0x00, 0x20, 8);
+    s.start(0x00, 4);
+    s.start(0x08, 4);
+    s.start(0x18, 4);  // Gap of 12 is too large
+    s.start(0x1C, 4);
+    s.start(0x24, 4);  // Outside the range
+    s.finish();
+
+    REQUIRE_EQ(s.slave->records.size(), 5U);
+    CHECK_EQ(s.slave->records[2].address, 0x00U);
+    CHECK_EQ(s.slave->records[2].size, 12U);
+    CHECK_EQ(s.slave->records[3].address, 0x18U);
+    CHECK_EQ(s.slave->records[3].size, 8U);
+    CHECK_EQ(s.slave->records[4].address, 0x24U);
+    CHECK_EQ(s.data[0x08], 0x08U);
+    CHECK_EQ(s.data[0x04], 0x00U);  // Hole is not copied back
+}
+
+TEST_CASE("Other transactions keep their place between reads") {
+    Stage s(256);
+
+    s.start(0x00, 4);
+    s.start(0x04, 4);
+    s.data[0x10] = 0xAA;
+    s.master->reqTransaction(0x10, 4, &s.data[0x10], rim::Write);
+    s.start(0x08, 4, rim::Verify);
+    s.start(0x0C, 4, rim::Read);
+    s.finish();
+
+    REQUIRE_EQ(s.slave->records.size(), 4U);
+    CHECK_EQ(s.slave->records[0].size, 8U);
+    CHECK_EQ(s.slave->records[1].type, rim::Write);
+    CHECK_EQ(s.slave->records[2].type, rim::Verify);
+    CHECK_EQ(s.slave->records[3].type, rim::Read);
+    CHECK_EQ(s.slave->memory[0x10], 0xAAU);
+}
+
+TEST_CASE("Errors on a combined read reach every read") {
+    Stage s(256);
+    s.slave->fail = true;
+
+    s.start(0x00, 4);
+    s.start(0x04, 4);
+    s.stage->flush();
+
+    s.master->waitTransaction(0);
+    CHECK(s.master->getError().find("bus error") != std::string::npos);
+    REQUIRE_EQ(s.slave->records.size(), 1U);
+}
+
+TEST_CASE("Reads are issued once the hold time expires") {
+    Stage s(256, 2000);
+
+    s.start(0x00, 4);
+    s.start(0x04, 4);
+    s.master->waitTransaction(0);
+
+    REQUIRE_EQ(s.slave->records.size(), 1U);
+    CHECK_EQ(s.slave->records[0].size, 8U);
+
+    // Stopped stages forward reads unchanged
+    s.stage->stop();
+    s.start(0x00, 4);
+    s.start(0x04, 4);
+    s.master->waitTransaction(0);
+    CHECK_EQ(s.slave->records.size(), 3U);
+}
+
+TEST_CASE("A write waits for a read group which is still being sent") {
+    Stage s(256, 1000);
+    auto writer    = rim::Master::create();
+    uint32_t value = 0xA5A5A5A5;
+
+    writer->setSlave(s.stage);
+
+    // The group is sent by the hold time thread and stalls in the slave
+    s.slave->delay = 200;
+    s.start(0x00, 4);
+    s.start(0x04, 4);
+    REQUIRE(rogue_test::waitUntil([&]() { return s.slave->count() == 1; }, 1000));
+    s.slave->delay = 0;
+
+    writer->reqTransaction(0x00, 4, &value, rim::Write);
+    writer->waitTransaction(0);
+    s.master->waitTransaction(0);
+
+    CHECK_EQ(s.master->getError(), "");
+    CHECK_EQ(writer->getError(), "");
+    REQUIRE_EQ(s.slave->records.size(), 2U);
+    CHECK_EQ(s.slave->records[1].type, rim::Write);
+    // The reads see the memory from before the write
+    for (uint32_t i = 0; i < 8; ++i) CHECK_EQ(s.data[i], i);
+    CHECK_EQ(s.slave->memory[0x00], 0xA5U);
+}
+
+TEST_CASE("A scheduler stacked on the coalescer over a synchronous slave does not deadlock") {
+    auto memory = rim::Emulate::create(4, 0x1000);
+    auto coal   = rim::ReadCoalescer::create(1000);
+    auto sched  = rim::PriorityScheduler::create(1);
+    auto master = rim::Master::create();
+
+    // Completions from Emulate re-enter both stages in the issuing thread
+    coal->setSlave(memory);
+    sched->setSlave(coal);
+    master->setSlave(sched);
+
+    std::vector<uint32_t> values(32);
+    std::vector<uint32_t> reads(32, 0);
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        values[i] = 0x5A000000 | i;
+        master->reqTransaction(i * 4, 4, &values[i], rim::Write);
+    }
+    for (uint32_t i = 0; i < reads.size(); ++i) master->reqTransaction(i * 4, 4, &reads[i], rim::Read);
+    coal->flush();
+    master->waitTransaction(0);
+
+    CHECK_EQ(master->getError(), "");
+    CHECK_EQ(reads, values);
+
+    sched->stop();
+    coal->stop();
+}
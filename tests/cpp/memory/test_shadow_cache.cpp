@@ -0,0 +1,162 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the shadow cache memory stage, covering each cache
+ * policy, verify reads, invalidation, counters and error handling.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/ShadowCache.h"
+#include "support/test_helpers.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+struct Stage : rogue_test::MemoryStage<rim::ShadowCache> {
+    Stage() : MemoryStage(rim::ShadowCache::create(), 256, true) {}
+
+    uint32_t read(uint64_t address, uint32_t type = rim::Read) {
+        uint32_t value = 0;
+        master->reqTransaction(address, 4, &value, type);
+        master->waitTransaction(0);
+        return value;
+    }
+
+    void write(uint64_t address, uint32_t value, uint32_t type = rim::Write) {
+        master->reqTransaction(address, 4, &value, type);
+        master->waitTransaction(0);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Write through ranges serve reads after a write") {
+    Stage s;
+    s.stage->addRange(0x100, 0x40, rim::CacheWriteThrough);
+
+    s.write(0x100, 0x12345678);
+    CHECK_EQ(s.read(0x100), 0x12345678U);
+    CHECK_EQ(s.read(0x100), 0x12345678U);
+    CHECK_EQ(s.slave->reads(), 0U);
+    CHECK_EQ(s.stage->getHitCount(), 2U);
+    CHECK_EQ(s.stage->getMissCount(), 0U);
+
+    // Unwritten bytes go to the hardware once, then hit
+    CHECK_EQ(s.read(0x104), 0x07060504U);
+    CHECK_EQ(s.read(0x104), 0x07060504U);
+    CHECK_EQ(s.slave->reads(), 1U);
+    CHECK_EQ(s.stage->getMissCount(), 1U);
+    CHECK_EQ(s.stage->getHitCount(), 3U);
+
+    // Outside any range
+    s.read(0x200);
+    s.read(0x200);
+    CHECK_EQ(s.slave->reads(), 3U);
+    CHECK_EQ(s.stage->getMissCount(), 1U);
+}
+
+TEST_CASE("Read once ranges are dropped by writes") {
+    Stage s;
+    s.stage->addRange(0x00, 0x10, rim::CacheReadOnce);
+
+    CHECK_EQ(s.read(0x00), 0x03020100U);
+    CHECK_EQ(s.read(0x00), 0x03020100U);
+    CHECK_EQ(s.slave->reads(), 1U);
+
+    s.write(0x00, 0xAABBCCDD);
+    CHECK_EQ(s.read(0x00), 0xAABBCCDDU);
+    CHECK_EQ(s.slave->reads(), 2U);
+    CHECK_EQ(s.read(0x00), 0xAABBCCDDU);
+    CHECK_EQ(s.slave->reads(), 2U);
+}
+
+TEST_CASE("Volatile ranges and verify reads always reach the hardware") {
+    Stage s;
+    s.stage->addRange(0x00, 0x10, rim::CacheVolatile);
+    s.stage->addRange(0x10, 0x10, rim::CacheWriteThrough);
+
+    s.read(0x00);
+    s.read(0x00);
+    CHECK_EQ(s.slave->reads(), 2U);
+
+    s.write(0x10, 0x11111111);
+    s.slave->memory[0x10] = 0x22;  // Changed behind the cache
+    CHECK_EQ(s.read(0x10, rim::Verify), 0x11111122U);
+    CHECK_EQ(s.slave->reads(), 3U);
+
+    // Verify refreshed the copy
+    CHECK_EQ(s.read(0x10), 0x11111122U);
+    CHECK_EQ(s.slave->reads(), 3U);
+    CHECK_EQ(s.stage->getMissCount(), 0U);
+}
+
+TEST_CASE("Invalidation drops the copy") {
+    Stage s;
+    s.stage->addRange(0x00, 0x10, rim::CacheReadOnce);
+    s.stage->addRange(0x10, 0x10, rim::CacheReadOnce);
+
+    s.read(0x00);
+    s.read(0x10);
+    CHECK_EQ(s.slave->reads(), 2U);
+
+    s.stage->invalidateRange(0x10, 4);
+    s.read(0x00);
+    s.read(0x10);
+    CHECK_EQ(s.slave->reads(), 3U);
+
+    s.stage->invalidate();
+    s.read(0x00);
+    s.read(0x10);
+    CHECK_EQ(s.slave->reads(), 5U);
+
+    s.stage->resetCounters();
+    CHECK_EQ(s.stage->getHitCount(), 0U);
+    CHECK_EQ(s.stage->getMissCount(), 0U);
+}
+
+TEST_CASE("Failed accesses leave bytes uncached") {
+    Stage s;
+    s.stage->addRange(0x00, 0x10, rim::CacheWriteThrough);
+
+    s.slave->fail = true;
+    s.write(0x00, 0x12345678);
+    CHECK(s.master->getError().find("bus error") != std::string::npos);
+    s.read(0x00);
+    CHECK(s.master->getError().find("bus error") != std::string::npos);
+
+    s.slave->fail = false;
+    s.master->clearError();
+    CHECK_EQ(s.read(0x00), 0x03020100U);
+    CHECK_EQ(s.master->getError(), "");
+    CHECK_EQ(s.slave->reads(), 2U);
+    CHECK_EQ(s.stage->getHitCount(), 0U);
+}
+
+TEST_CASE("Overlapping ranges and bad policies are rejected") {
+    Stage s;
+    s.stage->addRange(0x10, 0x10, rim::CacheWriteThrough);
+
+    CHECK_THROWS_AS(s.stage->addRange(0x1C, 0x10, rim::CacheReadOnce), rogue::GeneralError);
+    CHECK_THROWS_AS(s.stage->addRange(0x00, 0x11, rim::CacheReadOnce), rogue::GeneralError);
+    CHECK_THROWS_AS(s.stage->addRange(0x40, 0x10, 7), rogue::GeneralError);
+    CHECK_NOTHROW(s.stage->addRange(0x20, 0x10, rim::CacheReadOnce));
+}
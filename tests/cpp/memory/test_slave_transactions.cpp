@@ -0,0 +1,198 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for memory slave transaction tracking, covering lookup of
+ * many outstanding transactions answered out of order, removal of timed out
+ * entries by the expiry timers, timer refresh from responses to earlier
+ * transactions, and waiter wake up on completion and deadline.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/Slave.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+// Tracks every transaction and completes it when respond() is called
+class DeferredSlave : public rim::Slave {
+  public:
+    DeferredSlave() : rim::Slave(4, 4096) {}
+
+    void doTransaction(rim::TransactionPtr transaction) override {
+        rim::TransactionLockPtr lock = transaction->lock();
+        addTransaction(transaction);
+
+        std::lock_guard<std::mutex> guard(mutex_);
+        ids_.push_back(transaction->id());
+    }
+
+    bool respond(uint32_t id) {
+        rim::TransactionPtr tran = getTransaction(id);
+        if (tran == NULL) return false;
+
+        rim::TransactionLockPtr lock = tran->lock();
+        if (tran->expired()) return false;
+
+        for (rim::Transaction::iterator it = tran->begin(); it != tran->end(); ++it) *it = id & 0xFF;
+        tran->done();
+        return true;
+    }
+
+    std::vector<uint32_t> ids() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return ids_;
+    }
+
+  private:
+    std::mutex mutex_;
+    std::vector<uint32_t> ids_;
+};
+
+class TestMaster : public rim::Master {
+  public:
+    uint32_t read(uint8_t* data) {
+        return reqTransaction(0, 4, data, rim::Read);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Memory slave matches many outstanding transactions answered out of order") {
+    const uint32_t Count = 1000;
+
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = std::make_shared<TestMaster>();
+    master->setSlave(slave);
+
+    std::vector<uint8_t> data(Count * 4, 0);
+    for (uint32_t i = 0; i < Count; ++i) master->read(&data[i * 4]);
+    CHECK(slave->getTransactionCount() == Count);
+
+    std::vector<uint32_t> ids = slave->ids();
+    REQUIRE(ids.size() == Count);
+
+    for (uint32_t i = Count; i > 0; --i) CHECK(slave->respond(ids[i - 1]));
+    CHECK(slave->getTransactionCount() == 0);
+    CHECK_FALSE(slave->respond(ids[0]));
+
+    master->waitTransaction(0);
+    CHECK(master->getError() == "");
+    for (uint32_t i = 0; i < Count; ++i) CHECK(data[i * 4] == (ids[i] & 0xFF));
+}
+
+TEST_CASE("Memory slave removes timed out transactions when new ones are added") {
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = std::make_shared<TestMaster>();
+    master->setSlave(slave);
+    master->setTimeout(10000);
+
+    uint8_t data[8];
+    master->read(data);
+    master->waitTransaction(0);
+    CHECK(master->getError() != "");
+    CHECK(slave->getTransactionCount() == 1);
+
+    // Let the expiry timer pass its tick before the next add
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    master->clearError();
+    master->read(data + 4);
+    CHECK(slave->getTransactionCount() == 1);
+
+    CHECK(slave->respond(slave->ids()[1]));
+    master->waitTransaction(0);
+    CHECK(master->getError() == "");
+}
+
+TEST_CASE("Memory slave responses refresh later transactions only") {
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = std::make_shared<TestMaster>();
+    master->setSlave(slave);
+    master->setTimeout(100000);
+
+    // Distinct start times keep the issue order unambiguous
+    uint8_t data[12];
+    uint32_t first = master->read(data);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    uint32_t second = master->read(data + 4);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    uint32_t third            = master->read(data + 8);
+    std::vector<uint32_t> ids = slave->ids();
+
+    // Answer the second at 60ms, past the original deadline the third is refreshed
+    // from that response while the older first one times out
+    std::thread link([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(60));
+        slave->respond(ids[1]);
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+        slave->respond(ids[2]);
+    });
+
+    master->waitTransaction(second);
+    CHECK(master->getError() == "");
+
+    master->waitTransaction(third);
+    CHECK(master->getError() == "");
+
+    master->waitTransaction(first);
+    CHECK(master->getError() != "");
+
+    link.join();
+}
+
+TEST_CASE("Memory transaction wait wakes on completion and on its deadline") {
+    typedef std::chrono::steady_clock Clock;
+
+    auto slave  = std::make_shared<DeferredSlave>();
+    auto master = std::make_shared<TestMaster>();
+    master->setSlave(slave);
+    master->setTimeout(20000);
+
+    // Completion from another thread while the master sleeps
+    uint8_t data[8];
+    uint32_t id = master->read(data);
+    std::thread link([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        slave->respond(slave->ids()[0]);
+    });
+
+    Clock::time_point start = Clock::now();
+    master->waitTransaction(id);
+    Clock::duration elapsed = Clock::now() - start;
+    link.join();
+
+    CHECK(master->getError() == "");
+    CHECK(elapsed < std::chrono::milliseconds(20));
+
+    // No response, the wait ends at the deadline
+    id    = master->read(data + 4);
+    start = Clock::now();
+    master->waitTransaction(id);
+    elapsed = Clock::now() - start;
+
+    CHECK(master->getError() != "");
+    CHECK(elapsed >= std::chrono::milliseconds(19));
+    CHECK(elapsed < std::chrono::milliseconds(200));
+}
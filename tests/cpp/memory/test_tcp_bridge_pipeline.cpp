@@ -0,0 +1,201 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the pipelined memory TCP bridge protocol, covering
+ * version negotiation, batched transactions, concurrent execution with out of
+ * order completion, error delivery and the version 1 fallback.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Emulate.h"
+#include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/Slave.h"
+#include "rogue/interfaces/memory/TcpClient.h"
+#include "rogue/interfaces/memory/TcpServer.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+// Holds transactions until the test completes them
+class HoldSlave : public rim::Slave {
+  public:
+    HoldSlave() : rim::Slave(4, 256) {}
+
+    void doTransaction(rim::TransactionPtr tran) override {
+        std::lock_guard<std::mutex> guard(mutex_);
+        held_.push_back(tran);
+    }
+
+    uint32_t held() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return held_.size();
+    }
+
+    bool waitHeld(uint32_t count) {
+        for (uint32_t i = 0; i < 400; ++i) {
+            if (held() >= count) return true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return false;
+    }
+
+    // Complete the newest held transaction
+    void releaseLast(const std::string& error = "") {
+        rim::TransactionPtr tran;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            REQUIRE_FALSE(held_.empty());
+            tran = held_.back();
+            held_.pop_back();
+        }
+
+        rim::TransactionLockPtr lock = tran->lock();
+        if (error != "") {
+            tran->errorStr(error);
+        } else {
+            for (auto it = tran->begin(); it != tran->end(); ++it) *it = tran->address() & 0xFF;
+            tran->done();
+        }
+    }
+
+  private:
+    std::mutex mutex_;
+    std::deque<rim::TransactionPtr> held_;
+};
+
+struct Bridge {
+    rim::TcpServerPtr server;
+    rim::TcpClientPtr client;
+    rim::MasterPtr master;
+
+    Bridge(rim::SlavePtr slave, uint32_t version) {
+        const uint16_t start = static_cast<uint16_t>(46000 + ((getpid() % 100) * 128));
+
+        for (uint32_t offset = 0; offset < 128 && !server; offset += 2) {
+            try {
+                server = rim::TcpServer::create("127.0.0.1", start + offset);
+                client = rim::TcpClient::create("127.0.0.1", start + offset, false);
+            } catch (const rogue::GeneralError&) {
+                server.reset();
+            }
+        }
+        REQUIRE(static_cast<bool>(server));
+
+        server->setSlave(slave);
+        client->setProtocolVersion(version);
+        REQUIRE(client->waitReady(3.0, 0.05));
+
+        master = rim::Master::create();
+        master->setSlave(client);
+        master->setTimeout(1000000);
+    }
+
+    ~Bridge() {
+        client->stop();
+        server->stop();
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Clients negotiate the pipelined protocol") {
+    auto memory = rim::Emulate::create(4, 0x1000);
+    Bridge b(memory, rim::TcpBridgeVersion);
+    CHECK_EQ(b.client->getProtocolVersion(), rim::TcpBridgeVersion);
+
+    // Many outstanding transactions, sent in batches
+    std::vector<uint32_t> values(64);
+    std::vector<uint32_t> reads(64, 0);
+    for (uint32_t i = 0; i < values.size(); ++i) {
+        values[i] = 0xA5000000 | i;
+        b.master->reqTransaction(i * 4, 4, &values[i], rim::Write);
+    }
+    b.master->waitTransaction(0);
+    CHECK_EQ(b.master->getError(), "");
+
+    for (uint32_t i = 0; i < reads.size(); ++i) b.master->reqTransaction(i * 4, 4, &reads[i], rim::Read);
+    b.master->waitTransaction(0);
+    CHECK_EQ(b.master->getError(), "");
+    CHECK_EQ(reads, values);
+
+    // Posted writes have no response
+    uint32_t post = 0x12345678;
+    uint32_t read = 0;
+    b.master->reqTransaction(0x200, 4, &post, rim::Post);
+    b.master->reqTransaction(0x200, 4, &read, rim::Read);
+    b.master->waitTransaction(0);
+    CHECK_EQ(b.master->getError(), "");
+    CHECK_EQ(read, post);
+}
+
+TEST_CASE("The server runs transactions concurrently and completes them out of order") {
+    auto slave = std::make_shared<HoldSlave>();
+    Bridge b(slave, rim::TcpBridgeVersion);
+
+    std::vector<uint32_t> reads(4, 0);
+    for (uint32_t i = 0; i < reads.size(); ++i) b.master->reqTransaction(0x10 + i * 4, 4, &reads[i], rim::Read);
+
+    // All four reach the slave before any completes
+    REQUIRE(slave->waitHeld(4));
+
+    slave->releaseLast();
+    slave->releaseLast("bus error");
+    slave->releaseLast();
+    slave->releaseLast();
+    b.master->waitTransaction(0);
+
+    CHECK(b.master->getError().find("bus error") != std::string::npos);
+    CHECK_EQ(reads[0], 0x10101010U);
+    CHECK_EQ(reads[1], 0x14141414U);
+    CHECK_EQ(reads[3], 0x1C1C1C1CU);
+}
+
+TEST_CASE("Clients limited to version 1 use one message per transaction") {
+    auto slave = std::make_shared<HoldSlave>();
+    Bridge b(slave, 1);
+    CHECK_EQ(b.client->getProtocolVersion(), 1U);
+
+    std::vector<uint32_t> reads(2, 0);
+    b.master->reqTransaction(0x20, 4, &reads[0], rim::Read);
+    b.master->reqTransaction(0x24, 4, &reads[1], rim::Read);
+
+    // The server runs version 1 transactions one at a time
+    REQUIRE(slave->waitHeld(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK_EQ(slave->held(), 1U);
+
+    slave->releaseLast();
+    REQUIRE(slave->waitHeld(1));
+    slave->releaseLast();
+    b.master->waitTransaction(0);
+
+    CHECK_EQ(b.master->getError(), "");
+    CHECK_EQ(reads[0], 0x20202020U);
+    CHECK_EQ(reads[1], 0x24242424U);
+}
@@ -0,0 +1,123 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for recycled memory transactions, covering reuse with a
+ * fresh ID and state, no reuse while a reference is held, expiry of weak
+ * references from earlier uses, and the free list limit.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+#include <sys/time.h>
+
+#include <memory>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/Slave.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+// Keeps every transaction it sees and completes it with an error on request
+class HoldingSlave : public rim::Slave {
+  public:
+    HoldingSlave() : rim::Slave(4, 4096) {}
+
+    void doTransaction(rim::TransactionPtr transaction) override {
+        rim::TransactionLockPtr lock = transaction->lock();
+        held.push_back(transaction);
+        if (fail) {
+            transaction->error("failed");
+        } else {
+            transaction->done();
+        }
+    }
+
+    std::vector<rim::TransactionPtr> held;
+    bool fail = false;
+};
+
+}  // namespace
+
+TEST_CASE("TransactionPool reuses released transactions with a new ID") {
+    struct timeval timeout = {1, 0};
+    auto pool              = std::make_shared<rim::TransactionPool>(4);
+
+    rim::TransactionPtr tran = pool->get(timeout);
+    rim::Transaction* first  = tran.get();
+    uint32_t id              = tran->id();
+    std::weak_ptr<rim::Transaction> old(tran);
+    tran.reset();
+
+    CHECK(pool->freeCount() == 1);
+    CHECK(old.expired());
+
+    tran = pool->get(timeout);
+    CHECK(tran.get() == first);
+    CHECK(tran->id() != id);
+    CHECK(tran->expired());
+    CHECK(tran->size() == 0);
+    CHECK_FALSE(static_cast<bool>(old.lock()));
+
+    // shared_from_this follows the new owner
+    CHECK(static_cast<bool>(tran->lock()));
+}
+
+TEST_CASE("TransactionPool does not reuse a transaction while it is held") {
+    auto slave  = std::make_shared<HoldingSlave>();
+    auto master = rim::Master::create();
+    master->setSlave(slave);
+
+    uint32_t data = 0;
+    master->waitTransaction(master->reqTransaction(0, 4, &data, rim::Read));
+    slave->fail = true;
+    master->waitTransaction(master->reqTransaction(0, 4, &data, rim::Read));
+
+    REQUIRE(slave->held.size() == 2);
+    CHECK(slave->held[0].get() != slave->held[1].get());
+    CHECK(slave->held[0]->id() != slave->held[1]->id());
+    CHECK(master->getError() == "failed");
+
+    // Released holders make the objects available again, state is fresh
+    rim::Transaction* prev = slave->held[1].get();
+    slave->held.clear();
+    slave->fail = false;
+    master->clearError();
+
+    master->waitTransaction(master->reqTransaction(0, 4, &data, rim::Read));
+    REQUIRE(slave->held.size() == 1);
+    CHECK(slave->held[0].get() == prev);
+    CHECK(master->getError() == "");
+}
+
+TEST_CASE("TransactionPool deletes returns beyond its limit and after it is gone") {
+    struct timeval timeout = {1, 0};
+    auto pool              = std::make_shared<rim::TransactionPool>(2);
+
+    std::vector<rim::TransactionPtr> trans;
+    for (uint32_t i = 0; i < 5; ++i) trans.push_back(pool->get(timeout));
+    trans.clear();
+    CHECK(pool->freeCount() == 2);
+
+    rim::TransactionPtr tran = pool->get(timeout);
+    CHECK(pool->freeCount() == 1);
+
+    // Outlives the pool and is deleted normally
+    pool.reset();
+    tran.reset();
+}
@@ -5,7 +5,8 @@
  * Description:
  * Native C++ tests for memory variable metadata and typed access behavior,
  * including list geometry bookkeeping, offset normalization, dispatch to the
- * correct typed accessors, and indexed list access with stride/range checks.
+ * correct typed accessors, indexed list access with stride/range checks, and
+ * agreement of the compiled access plans with a bit-at-a-time reference.
  * ----------------------------------------------------------------------------
  * This file is part of the rogue software platform. It is subject to
  * the license terms in the LICENSE.txt file found in the top-level directory
@@ -23,12 +24,15 @@
 
 #include <algorithm>
 #include <memory>
+#include <random>
+#include <utility>
 #include <vector>
 
 #include "doctest/doctest.h"
 #include "rogue/GeneralError.h"
 #include "rogue/interfaces/memory/Block.h"
 #include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Master.h"
 #include "rogue/interfaces/memory/Slave.h"
 #include "rogue/interfaces/memory/Transaction.h"
 #include "rogue/interfaces/memory/Variable.h"
@@ -63,6 +67,38 @@ class RecordingMemorySlave : public rim::Slave {
     std::vector<uint8_t> memory_;
 };
 
+// Exposes the list word helpers
+class WordBlock : public rim::Block {
+  public:
+    WordBlock() : rim::Block(0, 1024) {}
+
+    using rim::Block::getWords;
+    using rim::Block::setWords;
+};
+
+struct PlanLayout {
+    const char* name;
+    std::vector<uint32_t> bitOffset;
+    std::vector<uint32_t> bitSize;
+    bool byteReverse;
+    uint32_t numValues;
+    uint32_t valueBits;
+    uint32_t valueStride;
+};
+
+// Bit positions of one value in the block, in value order
+std::vector<std::pair<uint32_t, uint32_t>> planFields(const PlanLayout& layout, uint32_t index) {
+    std::vector<std::pair<uint32_t, uint32_t>> fields;
+
+    if (layout.numValues != 0) {
+        fields.emplace_back(layout.bitOffset[0] + index * layout.valueStride, layout.valueBits);
+    } else {
+        for (std::size_t x = 0; x < layout.bitOffset.size(); ++x)
+            fields.emplace_back(layout.bitOffset[x], layout.bitSize[x]);
+    }
+    return fields;
+}
+
 }  // namespace
 
 TEST_CASE("Memory variable metadata tracks list geometry and path updates") {
@@ -130,12 +166,12 @@ TEST_CASE("Memory list variables honor stride and range checks") {
     CHECK_THROWS_AS(variable->setUInt(badIdx, 4), rogue::GeneralError);
 }
 
-// Block::setBytes mallocs a temporary on the byte-reverse path and must
-// ``free()`` it before throwing on a range-checked index. Reverting the
-// ``free(buff)`` call added in src/rogue/interfaces/memory/Block.cpp leaks
-// ``valueBytes_`` per offending call. Direct C++ invocation (no Python
-// exception machinery) gives a clean signal via ``mallinfo2()``: with the fix
-// the leak is zero; without the fix it is ``iterations * valueBytes_`` bytes.
+// Block::setBytes must not leak on the byte-reverse path when it throws on a
+// range-checked index. It once malloc'd a temporary there and had to
+// ``free()`` it before throwing; the temporary now lives on the stack and the
+// index is checked first. Direct C++ invocation (no Python exception
+// machinery) gives a clean signal via ``mallinfo2()``: the leak must stay
+// well below ``iterations * valueBytes_`` bytes.
 // ``mallinfo2`` is glibc-only, so this case is skipped on non-glibc libcs
 // (e.g. macOS, musl); the equivalent Python test handles those at runtime.
 #if defined(__GLIBC__)
@@ -194,10 +230,130 @@ TEST_CASE("Block::setBytes byte-reverse path frees its temporary on range throw"
     const auto current = mallinfo2().uordblks;
     const std::size_t delta = (current > baseline) ? (current - baseline) : 0;
 
-    // Without the free(buff) before throw, delta would be ~kIterations *
-    // kValueBytes (= 1 MiB). With the fix, only allocator bookkeeping leaks
-    // through, which is bounded by a small constant.
+    // A leaked temporary per call would be ~kIterations * kValueBytes
+    // (= 1 MiB). Only allocator bookkeeping may show up, which is bounded by
+    // a small constant.
     const std::size_t leakedIfNoFix = kIterations * kValueBytes;
     CHECK_LT(delta, leakedIfNoFix / 4);
 }
 #endif  // __GLIBC__
+
+TEST_CASE("Memory variable access plans match a bit-at-a-time reference") {
+    const std::vector<PlanLayout> layouts = {
+        {"AlignedBytes", {8}, {32}, false, 0, 0, 0},
+        {"AlignedBytesReversed", {8}, {32}, true, 0, 0, 0},
+        {"UnalignedWord", {3}, {12}, false, 0, 0, 0},
+        {"UnalignedWordReversed", {3}, {24}, true, 0, 0, 0},
+        {"ScatteredWord", {5, 21, 40}, {7, 9, 13}, false, 0, 0, 0},
+        {"ScatteredFull64", {0, 67}, {57, 7}, true, 0, 0, 0},
+        {"WideField", {4}, {60}, false, 0, 0, 0},
+        {"WideBits", {1}, {80}, true, 0, 0, 0},
+        {"ListWord", {3}, {65}, false, 5, 12, 13},
+        {"ListWordReversed", {2}, {57}, true, 3, 16, 19},
+        {"ListBytes", {8}, {64}, false, 4, 16, 16},
+        {"ListWide", {2}, {128}, false, 2, 60, 64},
+    };
+
+    std::mt19937 rng(0x1234);
+    std::uniform_int_distribution<uint32_t> byte(0, 255);
+
+    for (const auto& layout : layouts) {
+        INFO("layout=" << layout.name);
+
+        auto slave    = std::make_shared<RecordingMemorySlave>(16);
+        auto block    = rim::Block::create(0, 16);
+        auto variable = rim::Variable::create(layout.name, "RW", 0, 0, 0, layout.bitOffset, layout.bitSize, false,
+                                              false, false, false, rim::Bytes, layout.byteReverse, false, 0,
+                                              layout.numValues, layout.valueBits, layout.valueStride, 0);
+        block->setSlave(slave);
+        block->addVariables({variable});
+        block->setEnable(true);
+
+        const uint32_t count      = std::max<uint32_t>(layout.numValues, 1);
+        const uint32_t valueBytes = variable->valueBytes();
+
+        for (uint32_t index = 0; index < count; ++index) {
+            for (auto& b : slave->memory_) b = static_cast<uint8_t>(byte(rng));
+
+            // Read back through the plan
+            std::vector<uint8_t> got(valueBytes, 0);
+            std::vector<uint8_t> expected(valueBytes, 0);
+            uint32_t valueLsb = 0;
+            for (const auto& f : planFields(layout, index)) {
+                rim::Master::copyBits(expected.data(), valueLsb, slave->memory_.data(), f.first, f.second);
+                valueLsb += f.second;
+            }
+            if (layout.byteReverse) std::reverse(expected.begin(), expected.end());
+
+            variable->getByteArray(got.data(), index);
+            CHECK_EQ(got, expected);
+
+            // Write through the plan, bits outside the value are kept
+            std::vector<uint8_t> value(valueBytes);
+            for (auto& b : value) b = static_cast<uint8_t>(byte(rng));
+
+            std::vector<uint8_t> ordered = value;
+            if (layout.byteReverse) std::reverse(ordered.begin(), ordered.end());
+
+            std::vector<uint8_t> memory = slave->memory_;
+            valueLsb                    = 0;
+            for (const auto& f : planFields(layout, index)) {
+                rim::Master::copyBits(memory.data(), f.first, ordered.data(), valueLsb, f.second);
+                valueLsb += f.second;
+            }
+
+            variable->setByteArray(value.data(), index);
+            CHECK_EQ(slave->memory_, memory);
+        }
+    }
+}
+
+TEST_CASE("Memory list word access matches per-value access") {
+    const std::vector<PlanLayout> layouts = {
+        {"Packed32", {0}, {32 * 64}, false, 64, 32, 32},
+        {"Packed8Reversed", {0}, {8 * 64}, true, 64, 8, 8},
+        {"Spaced16", {8}, {32 * 64}, false, 64, 16, 32},
+        {"Odd12", {3}, {13 * 64}, false, 64, 12, 13},
+        {"Reversed24", {5}, {27 * 64}, true, 64, 24, 27},
+        {"Wide60", {2}, {64 * 64}, false, 64, 60, 64},
+    };
+
+    std::mt19937_64 rng(0xABCD);
+
+    for (const auto& layout : layouts) {
+        INFO("layout=" << layout.name);
+
+        auto words  = std::make_shared<WordBlock>();
+        auto values = std::make_shared<WordBlock>();
+        auto wordVar =
+            rim::Variable::create(layout.name, "RW", 0, 0, 0, layout.bitOffset, layout.bitSize, false, false, false,
+                                  false, rim::UInt, layout.byteReverse, false, 0, layout.numValues, layout.valueBits,
+                                  layout.valueStride, 0);
+        auto valueVar =
+            rim::Variable::create(layout.name, "RW", 0, 0, 0, layout.bitOffset, layout.bitSize, false, false, false,
+                                  false, rim::UInt, layout.byteReverse, false, 0, layout.numValues, layout.valueBits,
+                                  layout.valueStride, 0);
+        words->addVariables({wordVar});
+        values->addVariables({valueVar});
+
+        const uint64_t mask = (layout.valueBits == 64) ? ~0ULL : ((1ULL << layout.valueBits) - 1);
+        std::vector<uint64_t> in(layout.numValues - 9);
+        for (auto& v : in) v = rng() & mask;
+
+        words->setWords(in.data(), wordVar.get(), 7, static_cast<uint32_t>(in.size()));
+        for (uint32_t x = 0; x < in.size(); ++x) values->setUInt(in[x], valueVar.get(), 7 + x);
+
+        std::vector<uint64_t> out(layout.numValues, 0);
+        words->getWords(out.data(), wordVar.get(), 0, layout.numValues);
+
+        for (uint32_t x = 0; x < layout.numValues; ++x) {
+            INFO("index=" << x);
+            CHECK_EQ(out[x], values->getUInt(valueVar.get(), x));
+            if (x >= 7 && x < 7 + in.size()) CHECK_EQ(out[x], in[x - 7]);
+        }
+
+        CHECK_THROWS_AS(words->setWords(in.data(), wordVar.get(), 10, static_cast<uint32_t>(in.size())),
+                        rogue::GeneralError);
+        CHECK_THROWS_AS(words->getWords(out.data(), wordVar.get(), 1, layout.numValues), rogue::GeneralError);
+    }
+}
@@ -0,0 +1,180 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the write combining memory stage, covering merged and
+ * overlapping posted writes, the maximum access size, flushes before other
+ * transactions, the size and time windows, error counting and ordering
+ * behind batches which are still being sent.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/WriteCombiner.h"
+#include "support/test_helpers.h"
+
+namespace rim = rogue::interfaces::memory;
+
+namespace {
+
+struct Stage : rogue_test::MemoryStage<rim::WriteCombiner> {
+    explicit Stage(uint32_t maxAccess, uint32_t holdTime = 1000000, uint32_t maxBuffered = 4096)
+        : MemoryStage(rim::WriteCombiner::create(holdTime, maxBuffered), maxAccess) {}
+
+    void post(uint64_t address, uint32_t size, uint8_t value) {
+        std::fill(data.begin() + address, data.begin() + address + size, value);
+        run(address, size, rim::Post);
+    }
+};
+
+}  // namespace
+
+TEST_CASE("Adjacent posted writes are combined") {
+    Stage s(256);
+
+    for (uint32_t i = 0; i < 16; ++i) s.post(0x40 + i * 4, 4, i + 1);
+
+    // Completed without reaching the hardware
+    CHECK_EQ(s.master->getError(), "");
+    CHECK_EQ(s.slave->count(), 0U);
+
+    s.stage->flush();
+    REQUIRE_EQ(s.slave->records.size(), 1U);
+    CHECK_EQ(s.slave->records[0].type, rim::Post);
+    CHECK_EQ(s.slave->records[0].address, 0x40U);
+    CHECK_EQ(s.slave->records[0].size, 64U);
+    for (uint32_t i = 0; i < 64; ++i) CHECK_EQ(s.slave->memory[0x40 + i], i / 4 + 1);
+
+    CHECK_EQ(s.stage->getPostCount(), 16U);
+    CHECK_EQ(s.stage->getIssueCount(), 1U);
+}
+
+TEST_CASE("The last write wins for overlapping bytes") {
+    Stage s(256);
+
+    s.post(0x00, 8, 0xAA);
+    s.post(0x04, 4, 0xBB);
+    s.post(0x20, 4, 0xCC);
+    s.post(0x1C, 8, 0xDD);
+    s.stage->flush();
+
+    REQUIRE_EQ(s.slave->records.size(), 2U);
+    CHECK_EQ(s.slave->records[0].size, 8U);
+    CHECK_EQ(s.slave->records[1].address, 0x1CU);
+    CHECK_EQ(s.slave->records[1].size, 8U);
+    CHECK_EQ(s.slave->memory[0x03], 0xAAU);
+    CHECK_EQ(s.slave->memory[0x04], 0xBBU);
+    CHECK_EQ(s.slave->memory[0x20], 0xDDU);
+}
+
+TEST_CASE("Combined writes stop at the maximum access size") {
+    Stage s(32);
+
+    for (uint32_t i = 0; i < 20; ++i) s.post(i * 4, 4, 0x11);
+    s.stage->flush();
+
+    REQUIRE_EQ(s.slave->records.size(), 3U);
+    CHECK_EQ(s.slave->records[0].size, 32U);
+    CHECK_EQ(s.slave->records[1].address, 32U);
+    CHECK_EQ(s.slave->records[2].size, 16U);
+}
+
+TEST_CASE("Overlapping transactions flush the buffer first") {
+    Stage s(256);
+    uint32_t value = 0;
+
+    s.post(0x10, 4, 0x5A);
+    s.post(0x14, 4, 0x5B);
+
+    // Elsewhere, passes the buffer
+    s.master->reqTransaction(0x80, 4, &value, rim::Read);
+    s.master->waitTransaction(0);
+    REQUIRE_EQ(s.slave->records.size(), 1U);
+    CHECK_EQ(s.slave->records[0].type, rim::Read);
+
+    s.master->reqTransaction(0x14, 4, &value, rim::Read);
+    s.master->waitTransaction(0);
+    REQUIRE_EQ(s.slave->records.size(), 3U);
+    CHECK_EQ(s.slave->records[1].type, rim::Post);
+    CHECK_EQ(s.slave->records[1].size, 8U);
+    CHECK_EQ(s.slave->records[2].type, rim::Read);
+    CHECK_EQ(value, 0x5B5B5B5BU);
+}
+
+TEST_CASE("Buffers flush on the size and time windows") {
+    Stage s(256, 2000, 16);
+
+    for (uint32_t i = 0; i < 4; ++i) s.post(i * 4, 4, 0x22);
+    CHECK_EQ(s.slave->count(), 1U);
+
+    s.post(0x40, 4, 0x33);
+    for (uint32_t i = 0; i < 200 && s.slave->count() < 2; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    CHECK_EQ(s.slave->count(), 2U);
+    CHECK_EQ(s.slave->memory[0x40], 0x33U);
+}
+
+TEST_CASE("Failed combined writes are counted") {
+    Stage s(256);
+    s.slave->fail = true;
+
+    s.post(0x00, 4, 0x44);
+    s.stage->flush();
+    CHECK_EQ(s.master->getError(), "");
+    CHECK_EQ(s.stage->getErrorCount(), 1U);
+
+    // Stopped stages forward posted writes unchanged
+    s.slave->fail = false;
+    s.stage->stop();
+    s.post(0x00, 4, 0x55);
+    CHECK_EQ(s.slave->count(), 2U);
+    CHECK_EQ(s.slave->memory[0x00], 0x55U);
+}
+
+TEST_CASE("Later traffic waits for a batch which is still being sent") {
+    Stage s(256, 1000);
+    uint32_t value = 0;
+
+    // The first batch stalls in the slave
+    s.slave->delay = 200;
+    s.post(0x00, 4, 0x01);
+    REQUIRE(rogue_test::waitUntil([&]() { return s.slave->count() == 1; }, 1000));
+    s.slave->delay = 0;
+
+    // An overlapping read sees the write
+    s.master->reqTransaction(0x00, 4, &value, rim::Read);
+    s.master->waitTransaction(0);
+    CHECK_EQ(value, 0x01010101U);
+
+    // A newer batch lands after the stalled one, the last write wins
+    s.slave->delay = 200;
+    s.post(0x00, 4, 0x02);
+    REQUIRE(rogue_test::waitUntil([&]() { return s.slave->count() == 3; }, 1000));
+    s.slave->delay = 0;
+
+    s.post(0x00, 4, 0x03);
+    s.stage->flush();
+
+    // Give the stalled batch time to land if it had been overtaken
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    CHECK_EQ(s.master->getError(), "");
+    REQUIRE_EQ(s.slave->count(), 4U);
+    CHECK_EQ(s.slave->memory[0x00], 0x03U);
+}
@@ -0,0 +1,137 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Packetizer application dispatch modes. Frames sent through a V2 core
+ * loopback must arrive complete and in per-destination order whether the
+ * receiving applications use their own threads, the shared worker pool or
+ * inline delivery.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+#include "rogue/protocols/packetizer/Application.h"
+#include "rogue/protocols/packetizer/CoreV2.h"
+#include "rogue/protocols/packetizer/Transport.h"
+#include "rogue/protocols/packetizer/WorkerPool.h"
+#include "support/test_helpers.h"
+
+namespace ris = rogue::interfaces::stream;
+namespace rpp = rogue::protocols::packetizer;
+
+namespace {
+
+const uint32_t DestCount  = 8;
+const uint32_t FrameCount = 200;
+
+class SequenceSink : public ris::Slave {
+  public:
+    SequenceSink() : ris::Slave(), errors_(0) {}
+
+    void acceptFrame(ris::FramePtr frame) override {
+        std::vector<uint8_t> data = rogue_test::readFrame(frame, 4);
+        uint32_t seq              = data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (seq != seq_.size()) ++errors_;
+        seq_.push_back(seq);
+    }
+
+    std::size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return seq_.size();
+    }
+
+    uint32_t errors() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return errors_;
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<uint32_t> seq_;
+    uint32_t errors_;
+};
+
+void runLoopback(uint8_t mode, uint32_t workers) {
+    rpp::CoreV2Ptr tx = rpp::CoreV2::create(true, true, true);
+    rpp::CoreV2Ptr rx = rpp::CoreV2::create(true, true, true);
+
+    rx->setDispatch(mode, workers);
+    tx->transport()->addSlave(rx->transport());
+
+    std::vector<ris::MasterPtr> srcs;
+    std::vector<std::shared_ptr<SequenceSink>> sinks;
+
+    for (uint32_t d = 0; d < DestCount; ++d) {
+        ris::MasterPtr src = ris::Master::create();
+        src->addSlave(tx->application(d));
+        srcs.push_back(src);
+
+        std::shared_ptr<SequenceSink> sink = std::make_shared<SequenceSink>();
+        rx->application(d)->addSlave(sink);
+        sinks.push_back(sink);
+    }
+
+    // Interleave destinations so pool lanes are shared
+    for (uint32_t i = 0; i < FrameCount; ++i) {
+        for (uint32_t d = 0; d < DestCount; ++d) {
+            ris::FramePtr frame = srcs[d]->reqFrame(64, true);
+            rogue_test::writeFrame(frame, {static_cast<uint8_t>(i & 0xFF),
+                                           static_cast<uint8_t>((i >> 8) & 0xFF),
+                                           0,
+                                           0,
+                                           static_cast<uint8_t>(d)});
+            srcs[d]->sendFrame(frame);
+        }
+    }
+
+    for (uint32_t d = 0; d < DestCount; ++d) {
+        std::shared_ptr<SequenceSink> sink = sinks[d];
+        CHECK(rogue_test::waitUntil([&]() { return sink->count() == FrameCount; }, 5000));
+        CHECK(sink->errors() == 0);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Packetizer applications deliver in order with per-destination threads") {
+    runLoopback(rpp::DispatchThread, 0);
+}
+
+TEST_CASE("Packetizer applications deliver in order through the shared worker pool") {
+    runLoopback(rpp::DispatchPool, 1);
+    runLoopback(rpp::DispatchPool, 3);
+}
+
+TEST_CASE("Packetizer applications deliver in order inline on the transport thread") {
+    runLoopback(rpp::DispatchInline, 0);
+}
+
+TEST_CASE("Packetizer dispatch mode cannot change after applications exist") {
+    rpp::CoreV2Ptr core = rpp::CoreV2::create(false, false, false);
+
+    CHECK_THROWS_AS(core->setDispatch(7, 0), rogue::GeneralError);
+    CHECK_THROWS_AS(core->setDispatch(rpp::DispatchPool, 0), rogue::GeneralError);
+
+    core->application(0);
+    CHECK_THROWS_AS(core->setDispatch(rpp::DispatchInline, 0), rogue::GeneralError);
+}
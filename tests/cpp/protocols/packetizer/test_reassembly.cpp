@@ -0,0 +1,134 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Packetizer contiguous receive reassembly. Frames that fit the reassembly
+ * buffer arrive as a single buffer, larger frames fall back to chaining, and
+ * the payload is unchanged in both cases.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+#include "rogue/protocols/packetizer/Application.h"
+#include "rogue/protocols/packetizer/Core.h"
+#include "rogue/protocols/packetizer/CoreV2.h"
+#include "rogue/protocols/packetizer/Transport.h"
+#include "support/test_helpers.h"
+
+namespace ris = rogue::interfaces::stream;
+namespace rpp = rogue::protocols::packetizer;
+
+namespace {
+
+const uint32_t SegmentSize = 2048;
+const uint32_t RxSize      = 64 * 1024;
+
+class RecordingSink : public ris::Slave {
+  public:
+    void acceptFrame(ris::FramePtr frame) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        frames_.push_back(frame);
+    }
+
+    std::size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_.size();
+    }
+
+    ris::FramePtr at(std::size_t index) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return frames_.at(index);
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<ris::FramePtr> frames_;
+};
+
+std::vector<uint8_t> pattern(uint32_t size) {
+    std::vector<uint8_t> data(size);
+    for (uint32_t i = 0; i < size; ++i) data[i] = static_cast<uint8_t>((i * 7) ^ (i >> 8));
+    return data;
+}
+
+// Sends frames of the given sizes through src and checks what arrives at sink
+void checkFrames(ris::MasterPtr src,
+                 std::shared_ptr<RecordingSink> sink,
+                 const std::vector<uint32_t>& sizes,
+                 const std::vector<uint32_t>& buffers) {
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        ris::FramePtr frame = src->reqFrame(sizes[i], true);
+        rogue_test::writeFrame(frame, pattern(sizes[i]));
+        src->sendFrame(frame);
+
+        REQUIRE(rogue_test::waitUntil([&]() { return sink->count() == i + 1; }, 2000));
+
+        ris::FramePtr rx = sink->at(i);
+        CHECK(rx->getPayload() == sizes[i]);
+        CHECK(rx->bufferCount() == buffers[i]);
+        CHECK(rogue_test::readFrame(rx, sizes[i]) == pattern(sizes[i]));
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Packetizer v2 contiguous reassembly yields single-buffer frames") {
+    rpp::CoreV2Ptr tx = rpp::CoreV2::create(true, true, true);
+    rpp::CoreV2Ptr rx = rpp::CoreV2::create(true, true, true);
+    tx->transport()->addSlave(rx->transport());
+    rx->transport()->setFixedSize(SegmentSize);
+
+    ris::MasterPtr src = ris::Master::create();
+    auto sink          = std::make_shared<RecordingSink>();
+    src->addSlave(tx->application(3));
+    rx->application(3)->addSlave(sink);
+
+    rx->setRxContiguous(RxSize, 4);
+
+    // Fits, fits exactly, overflows into chained buffers
+    checkFrames(src, sink, {40000, RxSize, RxSize + 5000}, {1, 1, 4});
+    CHECK(rx->getRxOverflowCount() == 1);
+
+    // Disabled again, frames are chained per segment
+    rx->setRxContiguous(0, 0);
+    ris::FramePtr frame = src->reqFrame(10000, true);
+    rogue_test::writeFrame(frame, pattern(10000));
+    src->sendFrame(frame);
+    REQUIRE(rogue_test::waitUntil([&]() { return sink->count() == 4; }, 2000));
+    CHECK(sink->at(3)->bufferCount() > 1);
+    CHECK(rogue_test::readFrame(sink->at(3), 10000) == pattern(10000));
+}
+
+TEST_CASE("Packetizer v1 contiguous reassembly yields single-buffer frames") {
+    rpp::CorePtr tx = rpp::Core::create(true);
+    rpp::CorePtr rx = rpp::Core::create(true);
+    tx->transport()->addSlave(rx->transport());
+    rx->transport()->setFixedSize(SegmentSize);
+
+    ris::MasterPtr src = ris::Master::create();
+    auto sink          = std::make_shared<RecordingSink>();
+    src->addSlave(tx->application(1));
+    rx->application(1)->addSlave(sink);
+
+    rx->setRxContiguous(RxSize, 4);
+
+    checkFrames(src, sink, {100, 30000}, {1, 1});
+    CHECK(rx->getRxOverflowCount() == 0);
+}
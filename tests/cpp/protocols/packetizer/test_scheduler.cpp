@@ -0,0 +1,197 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Packetizer transmit scheduling. Outbound segments from different
+ * destinations are interleaved by weight on v2 links, kept whole per frame on
+ * v1 links, and per-destination queueing statistics are tracked.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/stream/Buffer.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+#include "rogue/protocols/packetizer/Application.h"
+#include "rogue/protocols/packetizer/Core.h"
+#include "rogue/protocols/packetizer/CoreV2.h"
+#include "rogue/protocols/packetizer/Transport.h"
+#include "support/test_helpers.h"
+
+namespace ris = rogue::interfaces::stream;
+namespace rpp = rogue::protocols::packetizer;
+
+namespace {
+
+const uint32_t SegmentSize = 1024;
+
+// Records the destination of each transport segment. The first segment is
+// held until release() so the scheduler queues can be filled beforehand.
+class SegmentSink : public ris::Slave {
+  public:
+    explicit SegmentSink(uint32_t destByte) : ris::Slave(), destByte_(destByte), released_(false) {
+        setFixedSize(SegmentSize);
+    }
+
+    void acceptFrame(ris::FramePtr frame) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [&]() { return released_; });
+        dests_.push_back((*frame->beginBuffer())->begin()[destByte_]);
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        condition_.notify_all();
+    }
+
+    std::vector<uint8_t> dests() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dests_;
+    }
+
+  private:
+    uint32_t destByte_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    bool released_;
+    std::vector<uint8_t> dests_;
+};
+
+void sendFrame(ris::MasterPtr src, uint32_t size) {
+    ris::FramePtr frame = src->reqFrame(size, true);
+    rogue_test::writeFrame(frame, std::vector<uint8_t>(size, 0x5A));
+    src->sendFrame(frame);
+}
+
+// Index of the last segment for a destination
+std::size_t lastIndex(const std::vector<uint8_t>& dests, uint8_t dest) {
+    std::size_t last = dests.size();
+    for (std::size_t i = 0; i < dests.size(); ++i)
+        if (dests[i] == dest) last = i;
+    return last;
+}
+
+}  // namespace
+
+TEST_CASE("Packetizer v2 interleaves a small frame ahead of a large one") {
+    rpp::CoreV2Ptr core = rpp::CoreV2::create(false, false, true);
+    auto sink           = std::make_shared<SegmentSink>(2);
+    core->transport()->addSlave(sink);
+
+    ris::MasterPtr big   = ris::Master::create();
+    ris::MasterPtr small = ris::Master::create();
+    big->addSlave(core->application(0));
+    small->addSlave(core->application(1));
+
+    // Primer segment parks the transport thread in the sink
+    sendFrame(small, 16);
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxDepth(1) == 0; }, 1000));
+
+    sendFrame(big, 48 * 1000);
+    sendFrame(small, 16);
+    CHECK(core->getTxDepth(0) >= 48);
+    CHECK(core->getTxDepth(1) == 1);
+
+    sink->release();
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxFrameCount(0) == 1; }, 2000));
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxFrameCount(1) == 2; }, 2000));
+
+    std::vector<uint8_t> dests = sink->dests();
+    CHECK(lastIndex(dests, 1) < 16);
+    CHECK(lastIndex(dests, 1) < lastIndex(dests, 0));
+
+    CHECK(core->getTxDelayMax(0) > 0.0);
+    CHECK(core->getTxDelayMean(0) <= core->getTxDelayMax(0));
+
+    core->resetTxStats();
+    CHECK(core->getTxFrameCount(0) == 0);
+    CHECK(core->getTxDelayMax(0) == 0.0);
+}
+
+TEST_CASE("Packetizer v2 divides the link by destination weight") {
+    rpp::CoreV2Ptr core = rpp::CoreV2::create(false, false, true);
+    auto sink           = std::make_shared<SegmentSink>(2);
+    core->transport()->addSlave(sink);
+
+    ris::MasterPtr srcA = ris::Master::create();
+    ris::MasterPtr srcB = ris::Master::create();
+    srcA->addSlave(core->application(0));
+    srcB->addSlave(core->application(1));
+
+    core->setTxWeight(0, 3);
+    core->setTxLimit(0, 1000);
+    core->setTxLimit(1, 1000);
+
+    sendFrame(srcB, 16);
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxDepth(1) == 0; }, 1000));
+
+    sendFrame(srcA, 200 * 1000);
+    sendFrame(srcB, 200 * 1000);
+
+    sink->release();
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxFrameCount(0) == 1; }, 2000));
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxFrameCount(1) == 2; }, 2000));
+
+    // While both destinations are backlogged dest 0 gets three times the share
+    std::vector<uint8_t> dests = sink->dests();
+    uint32_t countA            = 0;
+    uint32_t countB            = 0;
+    for (std::size_t i = 1; i < 129; ++i) {
+        if (dests[i] == 0) ++countA;
+        if (dests[i] == 1) ++countB;
+    }
+    CHECK(countA > 2 * countB);
+    CHECK(countA < 4 * countB);
+}
+
+TEST_CASE("Packetizer v1 keeps each frame contiguous on the link") {
+    rpp::CorePtr core = rpp::Core::create(true);
+    auto sink         = std::make_shared<SegmentSink>(5);
+    core->transport()->addSlave(sink);
+
+    ris::MasterPtr big   = ris::Master::create();
+    ris::MasterPtr small = ris::Master::create();
+    big->addSlave(core->application(0));
+    small->addSlave(core->application(1));
+
+    sendFrame(small, 16);
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxDepth(1) == 0; }, 1000));
+
+    sendFrame(big, 16 * 1000);
+    sendFrame(small, 16);
+
+    sink->release();
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxFrameCount(1) == 2; }, 2000));
+    REQUIRE(rogue_test::waitUntil([&]() { return core->getTxFrameCount(0) == 1; }, 2000));
+
+    // Segments of a frame are never split by another destination
+    std::vector<uint8_t> dests = sink->dests();
+    std::size_t first          = 1;
+    std::size_t last           = lastIndex(dests, 0);
+    for (std::size_t i = first; i <= last; ++i) CHECK(dests[i] == 0);
+    CHECK(last + 2 == dests.size());
+}
+
+TEST_CASE("Packetizer scheduler rejects zero weight and limit") {
+    rpp::CoreV2Ptr core = rpp::CoreV2::create(false, false, false);
+    CHECK_THROWS_AS(core->setTxWeight(0, 0), rogue::GeneralError);
+    CHECK_THROWS_AS(core->setTxLimit(0, 0), rogue::GeneralError);
+}
@@ -0,0 +1,281 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * RSSI controller timers. A client and server are linked in process through
+ * a copying stage; the link must open, deliver frames in order, recover
+ * dropped segments by retransmission, and stay quiet while idle. Adaptive
+ * mode must measure round trips and recover losses by fast retransmit, and
+ * steady-state transfer must not allocate headers. Transmit pacing must hold
+ * the configured rate and back off on retransmits in auto mode.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+#include "rogue/protocols/rssi/Application.h"
+#include "rogue/protocols/rssi/Client.h"
+#include "rogue/protocols/rssi/Header.h"
+#include "rogue/protocols/rssi/Server.h"
+#include "rogue/protocols/rssi/Transport.h"
+#include "support/test_helpers.h"
+
+namespace ris = rogue::interfaces::stream;
+namespace rpr = rogue::protocols::rssi;
+
+namespace {
+
+const uint32_t SegSize    = 1400;
+const uint32_t FrameSize  = 512;
+const uint32_t FrameCount = 500;
+
+// Copies each frame onto the far side like a wire would, optionally dropping
+// every Nth frame that carries payload.
+class LinkStage : public ris::Slave, public ris::Master {
+  public:
+    explicit LinkStage(uint32_t dropEvery) : ris::Slave(), ris::Master(), dropEvery_(dropEvery), data_(0), total_(0) {}
+
+    void acceptFrame(ris::FramePtr frame) override {
+        uint32_t size             = frame->getPayload();
+        std::vector<uint8_t> data = rogue_test::readFrame(frame, size);
+
+        ++total_;
+        if (size > FrameSize / 2 && dropEvery_ != 0 && (++data_ % dropEvery_) == 0) return;
+
+        ris::FramePtr copy = reqFrame(size, true);
+        rogue_test::writeFrame(copy, data);
+        sendFrame(copy);
+    }
+
+    uint32_t total() const {
+        return total_;
+    }
+
+  private:
+    uint32_t dropEvery_;
+    uint32_t data_;
+    std::atomic<uint32_t> total_;
+};
+
+class SequenceSink : public ris::Slave {
+  public:
+    SequenceSink() : ris::Slave(), count_(0), errors_(0) {}
+
+    void acceptFrame(ris::FramePtr frame) override {
+        std::vector<uint8_t> data = rogue_test::readFrame(frame, 4);
+        uint32_t seq              = data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+
+        if (seq != count_ || frame->getPayload() != FrameSize) ++errors_;
+        ++count_;
+    }
+
+    std::atomic<uint32_t> count_;
+    std::atomic<uint32_t> errors_;
+};
+
+struct Loopback {
+    rpr::ServerPtr server;
+    rpr::ClientPtr client;
+    std::shared_ptr<LinkStage> toServer;
+    std::shared_ptr<LinkStage> toClient;
+    ris::MasterPtr src;
+    std::shared_ptr<SequenceSink> sink;
+
+    explicit Loopback(uint32_t dropEvery, bool adaptive = false) {
+        server   = rpr::Server::create(SegSize);
+        client   = rpr::Client::create(SegSize);
+        toServer = std::make_shared<LinkStage>(dropEvery);
+        toClient = std::make_shared<LinkStage>(0);
+
+        client->transport()->addSlave(toServer);
+        toServer->addSlave(server->transport());
+        server->transport()->addSlave(toClient);
+        toClient->addSlave(client->transport());
+
+        src  = ris::Master::create();
+        sink = std::make_shared<SequenceSink>();
+        src->addSlave(client->application());
+        server->application()->addSlave(sink);
+
+        server->setAdaptiveRetran(adaptive);
+        client->setAdaptiveRetran(adaptive);
+
+        server->start();
+        client->start();
+    }
+
+    ~Loopback() {
+        client->stop();
+        server->stop();
+    }
+
+    void send(uint32_t count) {
+        for (uint32_t i = 0; i < count; ++i) {
+            std::vector<uint8_t> data(FrameSize, 0xA5);
+            data[0]             = i & 0xFF;
+            data[1]             = (i >> 8) & 0xFF;
+            data[2]             = 0;
+            data[3]             = 0;
+            ris::FramePtr frame = src->reqFrame(FrameSize, true);
+            rogue_test::writeFrame(frame, data);
+            src->sendFrame(frame);
+        }
+    }
+};
+
+}  // namespace
+
+TEST_CASE("RSSI link opens and delivers frames in order") {
+    Loopback lb(0);
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+
+    lb.send(FrameCount);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount; }, 5000));
+    CHECK(lb.sink->errors_ == 0);
+    CHECK(lb.client->getRetranCount() == 0);
+    CHECK(lb.client->getDownCount() == 0);
+}
+
+TEST_CASE("RSSI retransmit timers recover dropped segments") {
+    Loopback lb(37);
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+
+    lb.send(FrameCount);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount; }, 10000));
+    CHECK(lb.sink->errors_ == 0);
+    CHECK(lb.client->getRetranCount() > 0);
+    CHECK(lb.client->getDownCount() == 0);
+    CHECK(lb.client->getOpen());
+}
+
+TEST_CASE("RSSI idle link only carries keepalive traffic") {
+    Loopback lb(0);
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // NULL segments every third of the 1s null timeout plus their acknowledges
+    uint32_t before = lb.toServer->total() + lb.toClient->total();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    uint32_t after = lb.toServer->total() + lb.toClient->total();
+
+    CHECK(after - before <= 16);
+    CHECK(lb.client->getOpen());
+    CHECK(lb.server->getOpen());
+}
+
+TEST_CASE("RSSI adaptive retransmission measures round trips and fast retransmits") {
+    Loopback lb(37, true);
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+    CHECK(lb.client->getAdaptiveRetran());
+
+    lb.send(FrameCount);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount; }, 10000));
+    CHECK(lb.sink->errors_ == 0);
+    CHECK(lb.client->getDownCount() == 0);
+
+    // Estimate is clamped between the negotiated ack and retransmit timeouts
+    CHECK(lb.client->getRttMean() > 0);
+    CHECK(lb.client->getRetranTimeout() >= lb.client->curCumAckTout() * 1000u);
+    CHECK(lb.client->getRetranTimeout() <= lb.client->curRetranTout() * 1000u);
+
+    CHECK(lb.client->getRetranFastCount() > 0);
+    CHECK(lb.client->getRetranCount() == lb.client->getRetranFastCount() + lb.client->getRetranToutCount());
+
+    lb.client->resetCounters();
+    CHECK(lb.client->getRetranFastCount() == 0);
+    CHECK(lb.client->getRetranToutCount() == 0);
+}
+
+TEST_CASE("RSSI steady-state transfer reuses pooled header blocks") {
+    Loopback lb(0);
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+
+    // Warm up at full window so the header working set reaches its peak
+    lb.send(FrameCount * 2);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount * 2; }, 5000));
+
+    uint64_t before = rpr::Header::getHeapBlockCount();
+    lb.send(FrameCount * 4);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount * 6; }, 10000));
+    uint64_t after = rpr::Header::getHeapBlockCount();
+
+    // Only header blocks are counted, frames come from the stream pools.
+    // Scheduling jitter may grow the working set a little past the warm up, but
+    // never by more than one window
+    MESSAGE("Header blocks taken from the heap for " << FrameCount * 4 << " frames: " << (after - before));
+    CHECK(after - before <= lb.client->curMaxBuffers());
+}
+
+TEST_CASE("RSSI transmit pacing holds the configured rate") {
+    Loopback lb(0);
+    const uint64_t rate = 4 * 1024 * 1024;
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+
+    CHECK_THROWS_AS(lb.client->setTxPacingBurst(0), rogue::GeneralError);
+    lb.client->setTxPacingBurst(16384);
+    lb.client->setTxPacingRate(rate);
+    CHECK(lb.client->getTxPacingActiveRate() == rate);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    lb.send(FrameCount * 8);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount * 8; }, 10000));
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Everything past the initial burst is sent at the rate
+    double bytes = static_cast<double>(FrameCount * 8) * (FrameSize + rpr::Header::HeaderSize);
+    CHECK(elapsed >= 0.9 * (bytes - 16384) / rate);
+    CHECK(elapsed < 2.0 * bytes / rate + 0.5);
+    CHECK(lb.client->getTxPacedCount() > 0);
+    CHECK(lb.sink->errors_ == 0);
+
+    // Disabled again, no more waits
+    lb.client->setTxPacingRate(0);
+    lb.client->resetCounters();
+    lb.send(FrameCount);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount * 9; }, 5000));
+    CHECK(lb.client->getTxPacedCount() == 0);
+}
+
+TEST_CASE("RSSI automatic pacing backs off on retransmits") {
+    Loopback lb(37);
+    const uint64_t rate = 16 * 1024 * 1024;
+
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.client->getOpen() && lb.server->getOpen(); }, 5000));
+
+    lb.client->setTxPacingRate(rate);
+    lb.client->setTxPacingAuto(true);
+    CHECK(lb.client->getTxPacingAuto());
+
+    lb.send(FrameCount * 2);
+    REQUIRE(rogue_test::waitUntil([&]() { return lb.sink->count_ == FrameCount * 2; }, 10000));
+    CHECK(lb.sink->errors_ == 0);
+    CHECK(lb.client->getRetranCount() > 0);
+    CHECK(lb.client->getTxPacingActiveRate() < rate);
+    CHECK(lb.client->getTxPacingActiveRate() >= rate / 64);
+}
@@ -0,0 +1,224 @@
+/**
+ * ----------------------------------------------------------------------------
+ * Company    : SLAC National Accelerator Laboratory
+ * ----------------------------------------------------------------------------
+ * Description:
+ * Native C++ tests for the stream link emulator, covering clean forwarding,
+ * seeded repeatability of loss and duplication, Gilbert-Elliott burst loss,
+ * fixed delay, bandwidth limiting with queue overflow, and reordering.
+ * ----------------------------------------------------------------------------
+ * This file is part of the rogue software platform. It is subject to
+ * the license terms in the LICENSE.txt file found in the top-level directory
+ * of this distribution and at:
+ *    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+ * No part of the rogue software platform, including this file, may be
+ * copied, modified, propagated, or distributed except according to the terms
+ * contained in the LICENSE.txt file.
+ * ----------------------------------------------------------------------------
+ **/
+#include <stdint.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "doctest/doctest.h"
+#include "rogue/GeneralError.h"
+#include "rogue/interfaces/stream/Frame.h"
+#include "rogue/interfaces/stream/LinkEmulator.h"
+#include "rogue/interfaces/stream/Master.h"
+#include "rogue/interfaces/stream/Slave.h"
+#include "support/test_helpers.h"
+
+namespace ris = rogue::interfaces::stream;
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Records the sequence number and arrival time of each frame
+class SequenceSink : public ris::Slave {
+  public:
+    void acceptFrame(ris::FramePtr frame) override {
+        std::vector<uint8_t> data = rogue_test::readFrame(frame, 4);
+        uint32_t seq              = data[0] | (data[1] << 8) | (data[2] << 16) | (data[3] << 24);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        seq_.push_back(seq);
+        time_.push_back(Clock::now());
+    }
+
+    std::size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return seq_.size();
+    }
+
+    std::vector<uint32_t> seq() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return seq_;
+    }
+
+    Clock::time_point last() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return time_.back();
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::vector<uint32_t> seq_;
+    std::vector<Clock::time_point> time_;
+};
+
+void sendSeq(ris::MasterPtr src, uint32_t seq, uint32_t size) {
+    std::vector<uint8_t> data(size, 0xA5);
+    data[0] = seq & 0xFF;
+    data[1] = (seq >> 8) & 0xFF;
+    data[2] = (seq >> 16) & 0xFF;
+    data[3] = (seq >> 24) & 0xFF;
+
+    ris::FramePtr frame = src->reqFrame(size, true);
+    rogue_test::writeFrame(frame, data);
+    src->sendFrame(frame);
+}
+
+struct Link {
+    ris::MasterPtr src;
+    ris::LinkEmulatorPtr emu;
+    std::shared_ptr<SequenceSink> sink;
+
+    Link() {
+        src  = ris::Master::create();
+        emu  = ris::LinkEmulator::create();
+        sink = std::make_shared<SequenceSink>();
+        src->addSlave(emu);
+        emu->addSlave(sink);
+    }
+
+    // Send count frames and wait for everything not dropped to arrive
+    void run(uint32_t count, uint32_t size = 64) {
+        for (uint32_t i = 0; i < count; ++i) sendSeq(src, i, size);
+        REQUIRE(rogue_test::waitUntil([&]() { return emu->getDepth() == 0; }, 5000));
+        REQUIRE(rogue_test::waitUntil([&]() { return sink->count() == emu->getTxCount(); }, 1000));
+    }
+};
+
+}  // namespace
+
+TEST_CASE("LinkEmulator forwards frames unchanged and in order by default") {
+    Link link;
+    link.run(500);
+
+    std::vector<uint32_t> seq = link.sink->seq();
+    REQUIRE(seq.size() == 500);
+    for (uint32_t i = 0; i < 500; ++i) CHECK(seq[i] == i);
+
+    CHECK(link.emu->getRxCount() == 500);
+    CHECK(link.emu->getLossCount() == 0);
+    CHECK(link.emu->getDupCount() == 0);
+}
+
+TEST_CASE("LinkEmulator loss and duplication repeat for the same seed") {
+    std::vector<uint32_t> runs[3];
+    uint64_t seeds[3] = {7, 7, 8};
+
+    for (uint32_t r = 0; r < 3; ++r) {
+        Link link;
+        link.emu->setSeed(seeds[r]);
+        link.emu->setLoss(0.2);
+        link.emu->setDuplicate(0.1);
+        link.run(2000);
+
+        runs[r] = link.sink->seq();
+        CHECK(link.emu->getLossCount() > 300);
+        CHECK(link.emu->getLossCount() < 500);
+        CHECK(link.emu->getDupCount() > 100);
+        CHECK(link.emu->getTxCount() == 2000 - link.emu->getLossCount() + link.emu->getDupCount());
+    }
+
+    CHECK(runs[0] == runs[1]);
+    CHECK(runs[0] != runs[2]);
+}
+
+TEST_CASE("LinkEmulator burst loss drops runs of frames") {
+    Link link;
+    link.emu->setSeed(3);
+    link.emu->setBurstLoss(0.02, 0.2, 1.0);
+    link.run(5000);
+
+    std::vector<uint32_t> seq = link.sink->seq();
+    uint32_t bursts           = 0;
+    uint32_t lost             = 0;
+    for (std::size_t i = 1; i < seq.size(); ++i) {
+        if (seq[i] != seq[i - 1] + 1) {
+            ++bursts;
+            lost += seq[i] - seq[i - 1] - 1;
+        }
+    }
+
+    // Stationary bad fraction is 0.02 / 0.22, mean burst length 1 / 0.2
+    CHECK(link.emu->getLossCount() > 250);
+    CHECK(link.emu->getLossCount() < 700);
+    REQUIRE(bursts > 0);
+    CHECK(static_cast<double>(lost) / bursts > 3.0);
+}
+
+TEST_CASE("LinkEmulator delays frames") {
+    Link link;
+    link.emu->setDelay(20000, 0);
+
+    Clock::time_point start = Clock::now();
+    sendSeq(link.src, 0, 64);
+    CHECK(link.emu->getDepth() == 1);
+    REQUIRE(rogue_test::waitUntil([&]() { return link.sink->count() == 1; }, 1000));
+    CHECK(link.sink->last() - start >= std::chrono::milliseconds(20));
+}
+
+TEST_CASE("LinkEmulator limits bandwidth and overflows its queue") {
+    Link link;
+    link.emu->setBandwidth(1000000);
+
+    Clock::time_point start = Clock::now();
+    link.run(100, 1000);
+    CHECK(link.sink->count() == 100);
+    CHECK(link.sink->last() - start >= std::chrono::milliseconds(95));
+
+    link.emu->clearCnt();
+    link.emu->setQueueDepth(10);
+    for (uint32_t i = 0; i < 50; ++i) sendSeq(link.src, i, 1000);
+
+    // Each frame takes 1ms on the wire, so the burst fills the queue almost at once
+    uint64_t overflow = link.emu->getOverflowCount();
+    CHECK(overflow >= 30);
+    REQUIRE(rogue_test::waitUntil([&]() { return link.emu->getTxCount() == 50 - overflow; }, 1000));
+}
+
+TEST_CASE("LinkEmulator reorders held back frames") {
+    Link link;
+    link.emu->setSeed(11);
+    link.emu->setReorder(0.05, 2000);
+
+    for (uint32_t i = 0; i < 400; ++i) {
+        sendSeq(link.src, i, 64);
+        if ((i % 20) == 19) std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    REQUIRE(rogue_test::waitUntil([&]() { return link.sink->count() == 400; }, 2000));
+
+    std::vector<uint32_t> seq = link.sink->seq();
+    uint32_t late             = 0;
+    for (std::size_t i = 1; i < seq.size(); ++i)
+        if (seq[i] < seq[i - 1]) ++late;
+
+    CHECK(link.emu->getReorderCount() > 0);
+    CHECK(late > 0);
+    CHECK(late <= link.emu->getReorderCount());
+}
+
+TEST_CASE("LinkEmulator rejects invalid probabilities") {
+    ris::LinkEmulatorPtr emu = ris::LinkEmulator::create();
+    CHECK_THROWS_AS(emu->setLoss(1.5), rogue::GeneralError);
+    CHECK_THROWS_AS(emu->setDuplicate(-0.1), rogue::GeneralError);
+    CHECK_THROWS_AS(emu->setBurstLoss(0.1, 2.0, 1.0), rogue::GeneralError);
+    CHECK_THROWS_AS(emu->setReorder(1.1, 10), rogue::GeneralError);
+}
@@ -4,8 +4,9 @@
  * ----------------------------------------------------------------------------
  * Description:
  * Shared helper utilities for the native C++ Rogue tests, including stream
- * pool/frame construction helpers, frame read/write convenience functions, and
- * a small polling helper for asynchronous test assertions.
+ * pool/frame construction helpers, frame read/write convenience functions, a
+ * small polling helper for asynchronous test assertions, and a recording
+ * memory slave with a builder for testing memory stages.
  * ----------------------------------------------------------------------------
  * This file is part of the rogue software platform. It is subject to
  * the license terms in the LICENSE.txt file found in the top-level directory
@@ -21,12 +22,22 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
+#include "rogue/interfaces/memory/Constants.h"
+#include "rogue/interfaces/memory/Master.h"
+#include "rogue/interfaces/memory/Slave.h"
+#include "rogue/interfaces/memory/Transaction.h"
+#include "rogue/interfaces/memory/TransactionLock.h"
 #include "rogue/interfaces/stream/Frame.h"
 #include "rogue/interfaces/stream/FrameIterator.h"
 #include "rogue/interfaces/stream/Pool.h"
@@ -70,6 +81,141 @@ inline bool waitUntil(const std::function<bool()>& predicate, uint32_t timeoutMs
     return predicate();
 }
 
+// Transaction seen by a MemorySlave
+struct MemoryRecord {
+    uint32_t type;
+    uint64_t address;
+    uint32_t size;
+    uint32_t priority;
+};
+
+// Byte array memory which records every transaction. Transactions complete in
+// the caller unless hold is set, then they wait for release(). A non zero
+// delay in milliseconds stalls each transaction before it is applied.
+class MemorySlave : public rogue::interfaces::memory::Slave {
+  public:
+    explicit MemorySlave(uint32_t maxAccess = 256, bool pattern = false)
+        : rogue::interfaces::memory::Slave(4, maxAccess),
+          memory(1024, 0),
+          fail(false),
+          hold(false),
+          delay(0) {
+        if (pattern)
+            for (uint32_t i = 0; i < memory.size(); ++i) memory[i] = i & 0xFF;
+    }
+
+    void doTransaction(std::shared_ptr<rogue::interfaces::memory::Transaction> tran) override {
+        uint32_t stall;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            records.push_back({tran->type(), tran->address(), tran->size(), tran->priority()});
+            if (hold) {
+                held_.push_back(tran);
+                return;
+            }
+            stall = delay;
+        }
+
+        if (stall != 0) std::this_thread::sleep_for(std::chrono::milliseconds(stall));
+        complete(tran, fail ? "bus error" : "");
+    }
+
+    // Complete the oldest held transaction
+    void release(const std::string& error = "") {
+        std::shared_ptr<rogue::interfaces::memory::Transaction> tran;
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (held_.empty()) return;
+            tran = held_.front();
+            held_.pop_front();
+        }
+        complete(tran, error);
+    }
+
+    uint32_t count() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return records.size();
+    }
+
+    uint32_t held() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return held_.size();
+    }
+
+    // Reads and verify reads seen so far
+    uint32_t reads() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return std::count_if(records.begin(), records.end(), [](const MemoryRecord& r) {
+            return r.type == rogue::interfaces::memory::Read || r.type == rogue::interfaces::memory::Verify;
+        });
+    }
+
+    // Addresses in the order transactions arrived
+    std::vector<uint64_t> addresses() {
+        std::lock_guard<std::mutex> guard(mutex_);
+        std::vector<uint64_t> ret;
+        for (const auto& r : records) ret.push_back(r.address);
+        return ret;
+    }
+
+    std::vector<MemoryRecord> records;
+    std::vector<uint8_t> memory;
+    std::atomic<bool> fail;
+    std::atomic<bool> hold;
+    std::atomic<uint32_t> delay;
+
+  private:
+    void complete(std::shared_ptr<rogue::interfaces::memory::Transaction> tran, const std::string& error) {
+        auto lock = tran->lock();
+        if (error != "") {
+            tran->errorStr(error);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            auto mem = memory.begin() + tran->address();
+            if (tran->type() == rogue::interfaces::memory::Write || tran->type() == rogue::interfaces::memory::Post)
+                std::copy(tran->begin(), tran->end(), mem);
+            else
+                std::copy(mem, mem + tran->size(), tran->begin());
+        }
+        tran->done();
+    }
+
+    std::mutex mutex_;
+    std::deque<std::shared_ptr<rogue::interfaces::memory::Transaction>> held_;
+};
+
+// Master, memory stage under test and MemorySlave connected in a row
+template <typename T>
+struct MemoryStage {
+    std::shared_ptr<MemorySlave> slave;
+    std::shared_ptr<T> stage;
+    std::shared_ptr<rogue::interfaces::memory::Master> master;
+    std::vector<uint8_t> data;
+
+    MemoryStage(std::shared_ptr<T> stg, uint32_t maxAccess = 256, bool pattern = false)
+        : slave(std::make_shared<MemorySlave>(maxAccess, pattern)),
+          stage(stg),
+          master(rogue::interfaces::memory::Master::create()),
+          data(1024, 0) {
+        stage->setSlave(slave);
+        master->setSlave(stage);
+    }
+
+    // Start a transaction on the same address of data
+    void start(uint64_t address, uint32_t size, uint32_t type = rogue::interfaces::memory::Read) {
+        master->reqTransaction(address, size, &data[address], type);
+    }
+
+    // Run a transaction on the same address of data and wait for it
+    void run(uint64_t address, uint32_t size, uint32_t type = rogue::interfaces::memory::Read) {
+        start(address, size, type);
+        master->waitTransaction(0);
+    }
+};
+
 }  // namespace rogue_test
 
 #endif
@@ -102,7 +102,7 @@ class OverlapMemoryDevice(pr.Device):
 
 
 class MemoryTransportRoot(pr.Root):
-    def __init__(self, *, port):
+    def __init__(self, *, port, waitReady=False):
         super().__init__(name='dummyTree', description="Dummy tree for example", timeout=2.0, pollEn=False)
 
         # Exercise the real TCP memory gateway path over a local emulator.
@@ -113,8 +113,10 @@ class MemoryTransportRoot(pr.Root):
         self.addInterface(ms)
         sim << ms
 
-        mc = rogue.interfaces.memory.TcpClient("127.0.0.1", port)
+        # Waiting for readiness also negotiates the pipelined protocol
+        mc = rogue.interfaces.memory.TcpClient("127.0.0.1", port, waitReady)
         self.addInterface(mc)
+        self.tcpClient = mc
 
         for i in range(4):
             self.add(OverlapMemoryDevice(
@@ -129,8 +131,10 @@ class MemoryTransportRoot(pr.Root):
             memBase = mc,
         ))
 
-def test_memory(free_tcp_port):
-    with MemoryTransportRoot(port=free_tcp_port) as root:
+@pytest.mark.parametrize("waitReady, version", [(False, 1), (True, 2)])
+def test_memory(free_tcp_port, waitReady, version):
+    with MemoryTransportRoot(port=free_tcp_port, waitReady=waitReady) as root:
+        assert root.tcpClient.getProtocolVersion() == version
 
         for dev in range(2):
             write_var = dev == 0
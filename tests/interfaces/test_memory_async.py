@@ -0,0 +1,98 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import asyncio
+import threading
+import time
+
+import pyrogue as pr
+import pyrogue.interfaces
+import rogue.interfaces.memory as rim
+import pytest
+
+
+class DeferredSlave(rim.Slave):
+    """Answers reads from a worker thread, last request first."""
+
+    def __init__(self):
+        rim.Slave.__init__(self, 4, 4096)
+        self._pending = []
+
+    def _doTransaction(self, transaction):
+        self._pending.append(transaction)
+
+    def respond(self):
+        while self._pending:
+            tran = self._pending.pop()
+            with tran.lock():
+                tran.setData(bytearray([tran.address() & 0xFF] * tran.size()), 0)
+                tran.done()
+
+
+def test_async_transaction_callback_from_slave_thread():
+    slave  = DeferredSlave()
+    master = rim.Master()
+    master._setSlave(slave)
+
+    results = []
+    bufs    = [bytearray(4) for _ in range(100)]
+    ids     = [master._reqTransactionAsync(i * 4, bufs[i], 4, 0, rim.Read, lambda tid, err: results.append((tid, err)))
+               for i in range(100)]
+    assert results == []
+
+    worker = threading.Thread(target=slave.respond)
+    worker.start()
+    worker.join()
+
+    assert sorted(tid for tid, _ in results) == sorted(ids)
+    assert all(err == "" for _, err in results)
+    assert bufs[5] == bytearray([20] * 4)
+
+
+def test_async_transaction_asyncio_gather():
+    slave  = DeferredSlave()
+    master = rim.Master()
+    master._setSlave(slave)
+
+    bufs = [bytearray(4) for _ in range(50)]
+
+    async def run():
+        futs = [pyrogue.interfaces.asyncTransaction(master, i * 4, bufs[i]) for i in range(50)]
+        asyncio.get_running_loop().call_later(0.01, lambda: threading.Thread(target=slave.respond).start())
+        return await asyncio.gather(*futs)
+
+    ids = asyncio.run(run())
+    assert len(set(ids)) == 50
+    assert bufs[10] == bytearray([40] * 4)
+
+
+def test_async_transaction_errors_raise_memory_error():
+    master = rim.Master()
+    master._setSlave(rim.Slave(4, 4))
+    master._setTimeout(10000)
+
+    async def unconnected():
+        await pyrogue.interfaces.asyncTransaction(master, 0, bytearray(4), type=rim.Write)
+
+    with pytest.raises(pr.MemoryError):
+        asyncio.run(unconnected())
+
+    # A slave that never answers is timed out by the master
+    master._setSlave(DeferredSlave())
+
+    async def timeout():
+        start = time.monotonic()
+        with pytest.raises(pr.MemoryError, match="Timeout"):
+            await pyrogue.interfaces.asyncTransaction(master, 0, bytearray(4))
+        return time.monotonic() - start
+
+    assert asyncio.run(timeout()) < 1.0
+    assert master._getError() == ""
+    master._stop()
@@ -0,0 +1,55 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import threading
+
+import pyrogue as pr
+import rogue.interfaces.memory as rim
+
+
+class RegDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i in range(8):
+            self.add(pr.RemoteVariable(name=f"Reg{i}", offset=i * 4, bitSize=32, mode="RW"))
+
+
+class SchedRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="SchedRoot", pollEn=False)
+
+        self.sim   = rim.Emulate(4, 0x1000)
+        self.sched = rim.PriorityScheduler(2)
+        self.sched >> self.sim
+
+        self.addInterface(self.sim, self.sched)
+        self.add(RegDev(name="Dev", offset=0, memBase=self.sched))
+
+
+def test_priority_scheduler_tree_access():
+    with SchedRoot() as root:
+        for i in range(8):
+            root.Dev.node(f"Reg{i}").set(i + 1)
+
+        # Background reads from another thread
+        def poll():
+            rim.Transaction.setThreadPriority(rim.PriorityBackground)
+            root.Dev.readBlocks(waitEach=True)
+
+        thread = threading.Thread(target=poll)
+        thread.start()
+        thread.join()
+
+        assert rim.Transaction.getThreadPriority() == rim.PriorityNormal
+        assert [root.Dev.node(f"Reg{i}").get() for i in range(8)] == [i + 1 for i in range(8)]
+        assert root.sched.getIssueCount(rim.PriorityBackground) > 0
+        assert root.sched.getIssueCount(rim.PriorityNormal) > 0
+        assert root.sched.getInFlight() == 0
@@ -0,0 +1,56 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue as pr
+import rogue.interfaces.memory as rim
+
+NumRegs = 64
+
+
+class RegDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i in range(NumRegs):
+            self.add(pr.RemoteVariable(
+                name=f"Reg{i}",
+                offset=i * 8,
+                bitSize=32,
+                mode="RW",
+            ))
+
+
+class CoalesceRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="CoalesceRoot", pollEn=False)
+
+        self.sim  = rim.Emulate(4, 0x1000)
+        self.coal = rim.ReadCoalescer(1000)
+        self.coal.addOverReadRange(0, NumRegs * 8, 4)
+        self.coal >> self.sim
+
+        self.addInterface(self.sim, self.coal)
+        self.add(RegDev(name="Dev", offset=0, memBase=self.coal))
+
+
+def test_read_coalescer_merges_device_reads():
+    with CoalesceRoot() as root:
+        for i in range(NumRegs):
+            root.Dev.node(f"Reg{i}").set(i + 100)
+
+        writes = root.coal.getIssueCount()
+        for i in range(NumRegs):
+            root.Dev.node(f"Reg{i}").set(0, write=False)
+
+        pr.bulkTransaction(root.Dev._blocks, type=rim.Read, window=NumRegs)
+
+        assert [root.Dev.node(f"Reg{i}").value() for i in range(NumRegs)] == [i + 100 for i in range(NumRegs)]
+        assert root.coal.getReadCount() >= NumRegs
+        assert root.coal.getIssueCount() - writes < NumRegs // 4
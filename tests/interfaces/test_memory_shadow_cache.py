@@ -0,0 +1,53 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue as pr
+import rogue.interfaces.memory as rim
+
+
+class RegDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        self.add(pr.RemoteVariable(name="Version", offset=0x00, bitSize=32, mode="RO"))
+        self.add(pr.RemoteVariable(name="Config",  offset=0x10, bitSize=32, mode="RW"))
+        self.add(pr.RemoteVariable(name="Status",  offset=0x20, bitSize=32, mode="RO"))
+
+
+class CacheRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="CacheRoot", pollEn=False)
+
+        self.sim   = rim.Emulate(4, 0x1000)
+        self.cache = rim.ShadowCache()
+        self.cache.addRange(0x00, 0x10, rim.CacheReadOnce)
+        self.cache.addRange(0x10, 0x10, rim.CacheWriteThrough)
+        self.cache >> self.sim
+
+        self.addInterface(self.sim, self.cache)
+        self.add(RegDev(name="Dev", offset=0, memBase=self.cache))
+
+
+def test_shadow_cache_serves_tree_reads():
+    with CacheRoot() as root:
+        root.Dev.Config.set(0x1234)
+        root.cache.resetCounters()
+
+        for _ in range(3):
+            assert root.Dev.Config.get() == 0x1234
+            root.Dev.Version.get()
+            root.Dev.Status.get()
+
+        assert root.cache.getHitCount() == 5
+        assert root.cache.getMissCount() == 1
+
+        root.cache.invalidate()
+        assert root.Dev.Config.get() == 0x1234
+        assert root.cache.getMissCount() == 2
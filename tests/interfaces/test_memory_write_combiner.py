@@ -0,0 +1,54 @@
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+
+import pyrogue as pr
+import rogue.interfaces.memory as rim
+
+NumRegs = 32
+
+
+class RegDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i in range(NumRegs):
+            self.add(pr.RemoteVariable(
+                name=f"Reg{i}",
+                offset=i * 4,
+                bitSize=32,
+                mode="RW",
+            ))
+
+
+class CombineRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="CombineRoot", pollEn=False)
+
+        self.sim  = rim.Emulate(4, 0x1000)
+        self.comb = rim.WriteCombiner(1000000, 0x1000)
+        self.comb >> self.sim
+
+        self.addInterface(self.sim, self.comb)
+        self.add(RegDev(name="Dev", offset=0, memBase=self.comb))
+
+
+def test_write_combiner_merges_posted_writes():
+    with CombineRoot() as root:
+        for i in range(NumRegs):
+            root.Dev.node(f"Reg{i}").set(i + 10, write=False)
+
+        pr.bulkTransaction(root.Dev._blocks, type=rim.Post, force=True)
+        assert root.comb.getPostCount() == NumRegs
+        assert root.comb.getIssueCount() == 0
+
+        # Reading back flushes the buffer first
+        assert [root.Dev.node(f"Reg{i}").get() for i in range(NumRegs)] == [i + 10 for i in range(NumRegs)]
+        assert root.comb.getIssueCount() == 1
+        assert root.comb.getErrorCount() == 0
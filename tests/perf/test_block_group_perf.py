@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Bulk block transaction benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import pyrogue as pr
+import rogue.interfaces.memory
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = pytest.mark.perf
+
+# Read a device with many single register blocks through the per block helpers
+# and through the bulk engine, both against an emulated memory.
+NumRegs = 2048
+Rounds  = 20
+
+
+class RegDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i in range(NumRegs):
+            self.add(pr.RemoteVariable(
+                name=f"Reg{i}",
+                offset=i * 4,
+                bitSize=32,
+                mode="RW",
+            ))
+
+
+class RegRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="RegRoot", pollEn=False)
+        sim = rogue.interfaces.memory.Emulate(4, 0x1000 * 4)
+        self.addInterface(sim)
+        self.add(RegDev(name="Dev", offset=0, memBase=sim))
+
+
+def test_block_group_rate():
+    with RegRoot() as root:
+        blocks = root.Dev._blocks
+
+        start = time.perf_counter()
+        for _ in range(Rounds):
+            pr.readAndWaitBlocks(blocks)
+        helperTime = time.perf_counter() - start
+
+        start = time.perf_counter()
+        for _ in range(Rounds):
+            pr.bulkTransaction(blocks, type=rogue.interfaces.memory.Read)
+        bulkTime = time.perf_counter() - start
+
+        result = emit_perf_result(
+            "block_group_read",
+            num_blocks=len(blocks),
+            rounds=Rounds,
+            helper_elapsed_sec=helperTime,
+            bulk_elapsed_sec=bulkTime,
+            helper_blocks_per_sec=len(blocks) * Rounds / helperTime if helperTime > 0 else 0.0,
+            bulk_blocks_per_sec=len(blocks) * Rounds / bulkTime if bulkTime > 0 else 0.0,
+        )
+
+        print(f"Perf metrics: {result}")
+        assert len(blocks) == NumRegs
+
+
+if __name__ == "__main__":
+    test_block_group_rate()
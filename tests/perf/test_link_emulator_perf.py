@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : RSSI over emulated link benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.utilities
+import rogue.protocols.rssi
+import rogue.interfaces.stream
+import rogue
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = [pytest.mark.integration, pytest.mark.perf]
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+# Two in-process RSSI controllers joined by seeded link emulators, one per
+# direction. Each profile is repeatable run to run for the same seed.
+FrameCount   = 10000
+FrameSize    = 1024
+SegmentSize  = 1400
+DrainTimeout = 60.0
+Seed         = 1234
+
+Profiles = {
+    'clean':   {},
+    'loss1':   {'loss': 0.01},
+    'burst':   {'burst': (0.005, 0.3, 1.0)},
+    'delay':   {'delay': (200, 50)},
+    'reorder': {'reorder': (0.01, 300)},
+    'dup':     {'dup': 0.01},
+    'wan':     {'loss': 0.002, 'delay': (1000, 100), 'bandwidth': 50000000, 'depth': 256},
+}
+
+
+def make_link(seed, cfg):
+    emu = rogue.interfaces.stream.LinkEmulator()
+    emu.setSeed(seed)
+
+    if 'loss' in cfg:
+        emu.setLoss(cfg['loss'])
+    if 'burst' in cfg:
+        emu.setBurstLoss(*cfg['burst'])
+    if 'delay' in cfg:
+        emu.setDelay(*cfg['delay'])
+    if 'reorder' in cfg:
+        emu.setReorder(*cfg['reorder'])
+    if 'dup' in cfg:
+        emu.setDuplicate(cfg['dup'])
+    if 'bandwidth' in cfg:
+        emu.setBandwidth(cfg['bandwidth'])
+    if 'depth' in cfg:
+        emu.setQueueDepth(cfg['depth'])
+
+    return emu
+
+
+def emulated_link(name, cfg):
+    print("Testing profile={}".format(name))
+
+    sRssi = rogue.protocols.rssi.Server(SegmentSize)
+    cRssi = rogue.protocols.rssi.Client(SegmentSize)
+
+    toServer = make_link(Seed, cfg)
+    toClient = make_link(Seed + 1, cfg)
+
+    cRssi.transport() >> toServer >> sRssi.transport()
+    sRssi.transport() >> toClient >> cRssi.transport()
+
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    prbsTx >> cRssi.application()
+    sRssi.application() >> prbsRx
+
+    sRssi._start()
+    cRssi._start()
+
+    cnt = 0
+    while not (cRssi.getOpen() and sRssi.getOpen()):
+        time.sleep(0.1)
+        cnt += 1
+        if cnt == 100:
+            cRssi._stop()
+            sRssi._stop()
+            raise AssertionError('RSSI timeout error. profile={}'.format(name))
+
+    start = time.perf_counter()
+    for _ in range(FrameCount):
+        prbsTx.genFrame(FrameSize)
+
+    drain_start = time.time()
+    while prbsRx.getRxCount() != FrameCount:
+        time.sleep(0.01)
+        if (time.time() - drain_start) > DrainTimeout:
+            break
+
+    elapsed  = time.perf_counter() - start
+    received = prbsRx.getRxCount()
+    errors   = prbsRx.getRxErrors()
+
+    cRssi._stop()
+    sRssi._stop()
+
+    result = emit_perf_result(
+        f"link_emulator_rssi_{name}",
+        profile=name,
+        seed=Seed,
+        frames_sent=FrameCount,
+        frames_received=received,
+        frame_size=FrameSize,
+        link_lost=toServer.getLossCount() + toClient.getLossCount(),
+        link_overflow=toServer.getOverflowCount() + toClient.getOverflowCount(),
+        link_dup=toServer.getDupCount() + toClient.getDupCount(),
+        link_reorder=toServer.getReorderCount() + toClient.getReorderCount(),
+        retransmits=cRssi.getRetranCount(),
+        rtt_mean_us=cRssi.getRttMean(),
+        link_down_count=cRssi.getDownCount(),
+        elapsed_sec=elapsed,
+        frame_rate_hz=received / elapsed if elapsed > 0 else 0.0,
+        throughput_mb_s=((received * FrameSize) / (1024.0 * 1024.0)) / elapsed if elapsed > 0 else 0.0,
+        rx_errors=errors,
+        drain_complete=(received == FrameCount),
+    )
+
+    print(f"Perf metrics: {result}")
+
+    assert received == FrameCount, f"Frames lost. profile={name}"
+    assert errors == 0, f"PRBS frame errors detected. profile={name}"
+
+    return result
+
+
+def test_rssi_emulated_link():
+    for name, cfg in Profiles.items():
+        emulated_link(name, cfg)
+
+
+if __name__ == "__main__":
+    test_rssi_emulated_link()
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : List variable numpy array access benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import numpy as np
+import pyrogue as pr
+import rogue.interfaces.memory
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = pytest.mark.perf
+
+# Stage and read back a 4k entry waveform style list variable as numpy arrays
+# without hardware transactions, so the block pack/unpack cost dominates.
+NumValues = 4096
+Rounds    = 200
+
+Layouts = {
+    "uint32_packed": (pr.UInt, 32, 32, np.uint32),
+    "uint12_stride13": (pr.UInt, 12, 13, np.uint16),
+    "int16_be": (pr.IntBE, 16, 16, np.int16),
+    "float32": (pr.Float, 32, 32, np.float32),
+    "fixed16": (pr.Fixed(16, 8), 16, 16, np.float64),
+}
+
+
+class ArrayDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i, (name, (base, bits, stride, _)) in enumerate(Layouts.items()):
+            self.add(pr.RemoteVariable(
+                name=name,
+                offset=i * 0x4000,
+                base=base,
+                mode="RW",
+                numValues=NumValues,
+                valueBits=bits,
+                valueStride=stride,
+            ))
+
+
+class ArrayRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="ArrayRoot", pollEn=False)
+        sim = rogue.interfaces.memory.Emulate(4, 0x20000)
+        self.addInterface(sim)
+        self.add(ArrayDev(name="Dev", offset=0, memBase=sim))
+
+
+def test_list_variable_array_rate():
+    with ArrayRoot() as root:
+        for name, (_, _, _, dtype) in Layouts.items():
+            var    = getattr(root.Dev, name)
+            values = np.arange(NumValues).astype(dtype)
+            if dtype == np.float64:
+                values = values / 256.0
+
+            start = time.perf_counter()
+            for _ in range(Rounds):
+                var.set(values, write=False)
+            setTime = time.perf_counter() - start
+
+            start = time.perf_counter()
+            for _ in range(Rounds):
+                got = var.get(read=False)
+            getTime = time.perf_counter() - start
+
+            result = emit_perf_result(
+                f"list_variable_array_{name}",
+                num_values=NumValues,
+                rounds=Rounds,
+                set_elapsed_sec=setTime,
+                get_elapsed_sec=getTime,
+                set_values_per_sec=NumValues * Rounds / setTime if setTime > 0 else 0.0,
+                get_values_per_sec=NumValues * Rounds / getTime if getTime > 0 else 0.0,
+            )
+
+            print(f"Perf metrics: {result}")
+            np.testing.assert_array_equal(got, values.astype(got.dtype))
+
+
+if __name__ == "__main__":
+    test_list_variable_array_rate()
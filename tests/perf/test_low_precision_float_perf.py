@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Low precision float list variable benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import numpy as np
+import pyrogue as pr
+import rogue.interfaces.memory
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = pytest.mark.perf
+
+# Load and read back a weight table style list variable in each low precision
+# float format without hardware transactions, so the conversion cost dominates.
+NumValues = 16384
+Rounds    = 50
+
+Formats = {
+    "float16": (pr.Float16, 16, np.float16),
+    "bfloat16": (pr.BFloat16, 16, np.float32),
+    "tensorfloat32": (pr.TensorFloat32, 32, np.float32),
+    "float8": (pr.Float8, 8, np.float32),
+    "float6": (pr.Float6, 8, np.float32),
+    "float4": (pr.Float4, 8, np.float32),
+}
+
+
+class WeightDev(pr.Device):
+    def __init__(self, **kwargs):
+        super().__init__(**kwargs)
+
+        for i, (name, (base, bits, _)) in enumerate(Formats.items()):
+            self.add(pr.RemoteVariable(
+                name=name,
+                offset=i * 0x10000,
+                base=base,
+                mode="RW",
+                numValues=NumValues,
+                valueBits=bits,
+                valueStride=bits,
+            ))
+
+
+class WeightRoot(pr.Root):
+    def __init__(self):
+        super().__init__(name="WeightRoot", pollEn=False)
+        sim = rogue.interfaces.memory.Emulate(4, 0x60000)
+        self.addInterface(sim)
+        self.add(WeightDev(name="Dev", offset=0, memBase=sim))
+
+
+def test_low_precision_float_rate():
+    rng = np.random.default_rng(44)
+
+    with WeightRoot() as root:
+        for name, (_, _, dtype) in Formats.items():
+            var    = getattr(root.Dev, name)
+            values = rng.uniform(-4.0, 4.0, NumValues).astype(dtype)
+
+            start = time.perf_counter()
+            for _ in range(Rounds):
+                var.set(values, write=False)
+            setTime = time.perf_counter() - start
+
+            start = time.perf_counter()
+            for _ in range(Rounds):
+                got = var.get(read=False)
+            getTime = time.perf_counter() - start
+
+            result = emit_perf_result(
+                f"low_precision_float_{name}",
+                num_values=NumValues,
+                rounds=Rounds,
+                set_elapsed_sec=setTime,
+                get_elapsed_sec=getTime,
+                set_values_per_sec=NumValues * Rounds / setTime if setTime > 0 else 0.0,
+                get_values_per_sec=NumValues * Rounds / getTime if getTime > 0 else 0.0,
+            )
+
+            print(f"Perf metrics: {result}")
+            assert len(got) == NumValues
+
+
+if __name__ == "__main__":
+    test_low_precision_float_rate()
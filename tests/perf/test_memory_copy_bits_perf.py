@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Memory bit copy benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.memory as rim
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = pytest.mark.perf
+
+# Master._copyBits across aligned, source unaligned, destination unaligned and
+# both unaligned offsets. Small sizes are dominated by the binding overhead,
+# the larger ones show the copy itself.
+Offsets  = [(0, 0), (0, 3), (5, 0), (3, 5)]
+Sizes    = [12, 64, 256, 4096, 65536]
+TotalBit = 50000000
+MaxIter  = 200000
+
+
+def copy_bits(dstLsb, srcLsb, size):
+    src   = bytearray((srcLsb + size + 7) // 8)
+    dst   = bytearray((dstLsb + size + 7) // 8)
+    count = max(100, min(MaxIter, TotalBit // size))
+
+    start = time.perf_counter()
+    for _ in range(count):
+        rim.Master._copyBits(dst, dstLsb, src, srcLsb, size)
+    elapsed = time.perf_counter() - start
+
+    result = emit_perf_result(
+        f"memory_copy_bits_{dstLsb}_{srcLsb}_{size}",
+        dst_lsb=dstLsb,
+        src_lsb=srcLsb,
+        size_bits=size,
+        iterations=count,
+        elapsed_sec=elapsed,
+        ns_per_copy=elapsed * 1e9 / count,
+        rate_mbits=(count * size) / elapsed / 1e6 if elapsed > 0 else 0.0,
+    )
+
+    print(f"Perf metrics: {result}")
+    return result
+
+
+def test_copy_bits():
+    for dstLsb, srcLsb in Offsets:
+        for size in Sizes:
+            copy_bits(dstLsb, srcLsb, size)
+
+
+if __name__ == "__main__":
+    test_copy_bits()
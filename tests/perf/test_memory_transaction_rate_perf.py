@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : Memory transaction request rate benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.memory as rim
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = pytest.mark.perf
+
+# Request and wait on single register accesses against the in-process memory
+# emulator, so the per transaction overhead in the master dominates. Block
+# rateTest runs one million reads and one million writes in C++, the python
+# loop adds the buffer and binding overhead seen by pure python masters.
+RateTestCount = 2000000
+PyCount       = 200000
+
+
+def test_block_rate_test():
+    emu   = rim.Emulate(4, 0x1000)
+    block = rim.Block(0, 4)
+    block._setSlave(emu)
+
+    start = time.perf_counter()
+    block._rateTest()
+    elapsed = time.perf_counter() - start
+
+    result = emit_perf_result(
+        "memory_transaction_rate_block",
+        transactions=RateTestCount,
+        elapsed_sec=elapsed,
+        transaction_rate_hz=RateTestCount / elapsed if elapsed > 0 else 0.0,
+        avg_ns=(elapsed * 1.0e9) / RateTestCount,
+    )
+
+    print(f"Perf metrics: {result}")
+
+
+def test_python_master_rate():
+    emu  = rim.Emulate(4, 0x1000)
+    mast = rim.Master()
+    mast._setSlave(emu)
+
+    buf = bytearray(4)
+
+    start = time.perf_counter()
+    for _ in range(PyCount):
+        mast._waitTransaction(mast._reqTransaction(0, buf, 4, 0, rim.Read))
+    elapsed = time.perf_counter() - start
+
+    result = emit_perf_result(
+        "memory_transaction_rate_python",
+        transactions=PyCount,
+        elapsed_sec=elapsed,
+        transaction_rate_hz=PyCount / elapsed if elapsed > 0 else 0.0,
+        avg_ns=(elapsed * 1.0e9) / PyCount,
+        error=mast._getError(),
+    )
+
+    print(f"Perf metrics: {result}")
+
+    assert mast._getError() == ""
+
+
+if __name__ == "__main__":
+    test_block_rate_test()
+    test_python_master_rate()
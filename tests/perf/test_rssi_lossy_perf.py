@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : RSSI lossy link benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.utilities
+import rogue.protocols.rssi
+import rogue.interfaces.stream
+import rogue
+import threading
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = [pytest.mark.integration, pytest.mark.perf]
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+# Two in-process RSSI controllers joined by copying link stages. Dropping data
+# segments on the way to the server forces later segments into the receive
+# out of order buffer until the retransmission fills the gap.
+FrameCount   = 20000
+FrameSize    = 1024
+SegmentSize  = 1400
+DrainTimeout = 60.0
+
+
+class DropLink(rogue.interfaces.stream.Slave, rogue.interfaces.stream.Master):
+    """Copy frames across like a wire, dropping every Nth data segment."""
+
+    def __init__(self, dropEvery=0):
+        rogue.interfaces.stream.Slave.__init__(self)
+        rogue.interfaces.stream.Master.__init__(self)
+
+        self._dropEvery = dropEvery
+        self._lock      = threading.Lock()
+        self._data      = 0
+        self.dropped    = 0
+
+    def _acceptFrame(self, frame):
+        data = frame.getBa()
+
+        with self._lock:
+            if self._dropEvery > 0 and len(data) > FrameSize:
+                self._data += 1
+                if (self._data % self._dropEvery) == 0:
+                    self.dropped += 1
+                    return
+
+        out = self._reqFrame(len(data), True)
+        out.write(data)
+        self._sendFrame(out)
+
+
+def lossy_link(dropEvery, adaptive=False):
+    print("Testing dropEvery={} adaptive={}".format(dropEvery,adaptive))
+
+    sRssi = rogue.protocols.rssi.Server(SegmentSize)
+    cRssi = rogue.protocols.rssi.Client(SegmentSize)
+
+    toServer = DropLink(dropEvery)
+    toClient = DropLink(0)
+
+    cRssi.transport() >> toServer >> sRssi.transport()
+    sRssi.transport() >> toClient >> cRssi.transport()
+
+    sRssi.setAdaptiveRetran(adaptive)
+    cRssi.setAdaptiveRetran(adaptive)
+
+    prbsTx = rogue.utilities.Prbs()
+    prbsRx = rogue.utilities.Prbs()
+
+    prbsTx >> cRssi.application()
+    sRssi.application() >> prbsRx
+
+    sRssi._start()
+    cRssi._start()
+
+    cnt = 0
+    while not (cRssi.getOpen() and sRssi.getOpen()):
+        time.sleep(0.1)
+        cnt += 1
+        if cnt == 100:
+            cRssi._stop()
+            sRssi._stop()
+            raise AssertionError('RSSI timeout error. dropEvery={}'.format(dropEvery))
+
+    start = time.perf_counter()
+    for _ in range(FrameCount):
+        prbsTx.genFrame(FrameSize)
+
+    drain_start = time.time()
+    while prbsRx.getRxCount() != FrameCount:
+        time.sleep(0.01)
+        if (time.time() - drain_start) > DrainTimeout:
+            break
+
+    elapsed  = time.perf_counter() - start
+    received = prbsRx.getRxCount()
+    errors   = prbsRx.getRxErrors()
+    retran   = cRssi.getRetranCount()
+    down     = cRssi.getDownCount()
+
+    cRssi._stop()
+    sRssi._stop()
+
+    result = emit_perf_result(
+        f"rssi_lossy_perf_drop{dropEvery}{'_adaptive' if adaptive else ''}",
+        drop_every=dropEvery,
+        adaptive=adaptive,
+        frames_sent=FrameCount,
+        frames_received=received,
+        frame_size=FrameSize,
+        segments_dropped=toServer.dropped,
+        retransmits=retran,
+        fast_retransmits=cRssi.getRetranFastCount(),
+        rtt_mean_us=cRssi.getRttMean(),
+        link_down_count=down,
+        elapsed_sec=elapsed,
+        frame_rate_hz=received / elapsed if elapsed > 0 else 0.0,
+        throughput_mb_s=((received * FrameSize) / (1024.0 * 1024.0)) / elapsed if elapsed > 0 else 0.0,
+        rx_errors=errors,
+        drain_complete=(received == FrameCount),
+    )
+
+    print(f"Perf metrics: {result}")
+
+    assert received == FrameCount, f"Frames lost. dropEvery={dropEvery}"
+    assert errors == 0, f"PRBS frame errors detected. dropEvery={dropEvery}"
+
+    return result
+
+
+def test_rssi_lossy_link():
+    for dropEvery in [0, 100, 20]:
+        lossy_link(dropEvery)
+    lossy_link(20, adaptive=True)
+
+
+if __name__ == "__main__":
+    test_rssi_lossy_link()
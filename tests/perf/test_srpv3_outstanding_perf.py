@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : SRPv3 outstanding transaction benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.interfaces.memory
+import rogue.interfaces.stream
+import rogue.protocols.srp
+import rogue
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = [pytest.mark.integration, pytest.mark.perf]
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+# SrpV3 against SrpV3Emulation with a delayed request path, so each burst of
+# reads is fully outstanding in the SrpV3 transaction table before the first
+# response arrives. Every response is then a table lookup under load.
+Outstanding = 1000
+Rounds      = 20
+ReadSize    = 4
+LinkDelay   = 50000
+
+
+def outstanding_reads(outstanding):
+    print("Testing outstanding={}".format(outstanding))
+
+    srp = rogue.protocols.srp.SrpV3()
+    emu = rogue.protocols.srp.SrpV3Emulation()
+
+    # Hold requests on the wire until the whole burst has been issued
+    link = rogue.interfaces.stream.LinkEmulator()
+    link.setDelay(LinkDelay, 0)
+
+    srp >> link >> emu
+    emu >> srp
+
+    mast = rogue.interfaces.memory.Master()
+    mast._setSlave(srp)
+    mast._setTimeout(5000000)
+
+    bufs = [bytearray(ReadSize) for _ in range(outstanding)]
+    peak = 0
+    wait = 0.0
+
+    start = time.perf_counter()
+    for _ in range(Rounds):
+        for i in range(outstanding):
+            mast._reqTransaction(i * ReadSize, bufs[i], ReadSize, 0, rogue.interfaces.memory.Read)
+
+        peak = max(peak, srp._getTransactionCount())
+
+        ws = time.perf_counter()
+        mast._waitTransaction(0)
+        wait += time.perf_counter() - ws
+
+    elapsed = time.perf_counter() - start
+    error   = mast._getError()
+    total   = outstanding * Rounds
+
+    result = emit_perf_result(
+        f"srpv3_outstanding_perf_{outstanding}",
+        outstanding=outstanding,
+        rounds=Rounds,
+        transactions=total,
+        read_size=ReadSize,
+        link_delay_us=LinkDelay,
+        peak_outstanding=peak,
+        elapsed_sec=elapsed,
+        drain_sec=wait,
+        transaction_rate_hz=total / elapsed if elapsed > 0 else 0.0,
+        drain_rate_hz=total / wait if wait > 0 else 0.0,
+        error=error,
+    )
+
+    print(f"Perf metrics: {result}")
+
+    assert error == "", f"Transaction error: {error}"
+    assert srp._getTransactionCount() == 0, "Transactions left in table"
+
+    return result
+
+
+def test_srpv3_outstanding():
+    for outstanding in [10, 100, Outstanding]:
+        outstanding_reads(outstanding)
+
+
+if __name__ == "__main__":
+    test_srpv3_outstanding()
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#-----------------------------------------------------------------------------
+# Title      : UDP batched socket call loopback benchmark
+#-----------------------------------------------------------------------------
+# This file is part of the rogue software platform. It is subject to
+# the license terms in the LICENSE.txt file found in the top-level directory
+# of this distribution and at:
+#    https://confluence.slac.stanford.edu/display/ppareg/LICENSE.html.
+# No part of the rogue software platform, including this file, may be
+# copied, modified, propagated, or distributed except according to the terms
+# contained in the LICENSE.txt file.
+#-----------------------------------------------------------------------------
+import rogue.utilities
+import rogue.protocols.udp
+import rogue.interfaces.stream
+import rogue
+import time
+import pytest
+
+from tests.perf._perf_metrics import emit_perf_result
+
+pytestmark = [pytest.mark.integration, pytest.mark.perf]
+
+#rogue.Logging.setLevel(rogue.Logging.Debug)
+
+# Each generated frame spans several datagrams so the transmit side exercises
+# sendmmsg() grouping as well as recvmmsg() on the receive side.
+FrameCount = 5000
+DatagramsPerFrame = 8
+DrainTimeout = 10.0
+RxBufferCount = 20000
+
+
+def udp_loopback(batch, jumbo):
+    print("Testing batch={} jumbo={}".format(batch,jumbo))
+
+    serv = rogue.protocols.udp.Server(0,jumbo)
+    client = rogue.protocols.udp.Client("127.0.0.1",serv.getPort(),jumbo)
+
+    serv.setRxBufferCount(RxBufferCount)
+    serv.setBatchSize(batch)
+    client.setBatchSize(batch)
+
+    prbsTx = rogue.utilities.Prbs()
+    sink = rogue.interfaces.stream.Slave()
+
+    prbsTx >> client
+    serv >> sink
+
+    frameSize = client.maxPayload() * DatagramsPerFrame
+    expected = FrameCount * DatagramsPerFrame
+
+    start = time.perf_counter()
+    for _ in range(FrameCount):
+        prbsTx.genFrame(frameSize)
+
+    # UDP may drop under load, wait until the count stops moving
+    drain_start = time.time()
+    last = -1
+    while sink.getFrameCount() != expected and sink.getFrameCount() != last:
+        last = sink.getFrameCount()
+        time.sleep(0.1)
+        if (time.time() - drain_start) > DrainTimeout:
+            break
+
+    elapsed = time.perf_counter() - start
+    received = sink.getFrameCount()
+
+    client._stop()
+    serv._stop()
+
+    result = emit_perf_result(
+        f"udp_batch_perf_b{batch}_{'jumbo' if jumbo else 'std'}",
+        batch=batch,
+        active_batch=serv.getBatchSize(),
+        jumbo=jumbo,
+        datagrams_sent=expected,
+        datagrams_received=received,
+        elapsed_sec=elapsed,
+        throughput_mb_s=((received * client.maxPayload()) / (1024.0 * 1024.0)) / elapsed if elapsed > 0 else 0.0,
+        loss_fraction=1.0 - (received / expected),
+    )
+
+    print(f"Perf metrics: {result}")
+
+    assert received > 0, f"No datagrams were received. Batch={batch} Jumbo={jumbo}"
+
+    return result
+
+
+def test_udp_batch_path():
+    for jumbo in [True, False]:
+        single = udp_loopback(1,jumbo)
+        batched = udp_loopback(32,jumbo)
+        print("Batch speedup jumbo={}: {:.2f}x".format(
+            jumbo, batched['throughput_mb_s'] / single['throughput_mb_s'] if single['throughput_mb_s'] > 0 else 0.0))
+
+
+if __name__ == "__main__":
+    test_udp_batch_path()